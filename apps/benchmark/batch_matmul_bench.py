@@ -0,0 +1,78 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for batch_matmul on CPU.
+It compares the generic x86 batch_matmul schedule with the small matrix schedule, and cblas
+when TVM is built with it, over a grid of (batch, M, N, K).
+see README.md for the usage of this script.
+"""
+import argparse
+import itertools
+
+import numpy as np
+
+import tvm
+from tvm import te
+from tvm import topi
+
+IMPLEMENTS = {
+    "batch_matmul": (topi.x86.batch_matmul, topi.x86.schedule_batch_matmul),
+    "batch_matmul_small": (topi.x86.batch_matmul_small, topi.x86.schedule_batch_matmul_small),
+    "cblas": (topi.x86.batch_matmul_cblas, topi.x86.schedule_batch_matmul_cblas),
+}
+
+
+def evaluate(impl, batch, m, n, k, target, repeat):
+    x = te.placeholder((batch, m, k), name="x")
+    y = te.placeholder((batch, n, k), name="y")
+    fcompute, fschedule = IMPLEMENTS[impl]
+    with tvm.target.Target(target):
+        out = fcompute(x, y)
+        s = fschedule([out])
+    f = tvm.build(s, [x, y, out], target)
+    ctx = tvm.cpu(0)
+    args = [
+        tvm.nd.array(np.random.uniform(size=(batch, m, k)).astype("float32"), ctx),
+        tvm.nd.array(np.random.uniform(size=(batch, n, k)).astype("float32"), ctx),
+        tvm.nd.empty((batch, m, n), "float32", ctx),
+    ]
+    ftimer = f.time_evaluator(f.entry_name, ctx, number=10, repeat=repeat)
+    cost = np.mean(ftimer(*args).results)
+    return cost * 1000, 2.0 * batch * m * n * k / cost / 1e9
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm -mcpu=core-avx2")
+    parser.add_argument("--batch", type=int, nargs="+", default=[12, 96, 768])
+    parser.add_argument("--m", type=int, nargs="+", default=[16, 64, 128])
+    parser.add_argument("--n", type=int, nargs="+", default=[64, 128])
+    parser.add_argument("--k", type=int, nargs="+", default=[64])
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    impls = ["batch_matmul", "batch_matmul_small"]
+    if tvm.get_global_func("tvm.contrib.cblas.batch_matmul", allow_missing=True):
+        impls.append("cblas")
+
+    header = "%-8s %-6s %-6s %-6s " % ("batch", "M", "N", "K")
+    print(header + " ".join("%-28s" % impl for impl in impls))
+    for batch, m, n, k in itertools.product(args.batch, args.m, args.n, args.k):
+        results = []
+        for impl in impls:
+            time_ms, gflops = evaluate(impl, batch, m, n, k, args.target, args.repeat)
+            results.append("%-28s" % ("%.3f ms %.1f GFLOPS" % (time_ms, gflops)))
+        print("%-8d %-6d %-6d %-6d " % (batch, m, n, k) + " ".join(results))
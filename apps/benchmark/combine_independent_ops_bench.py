@@ -0,0 +1,101 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for CombineIndependentOps on the heads of a detector.
+The heads of SSD and YOLO run a feature, a class and a box conv2d on every feature map. The
+script builds them with and without the pass, and reports the number of kernels of the graph
+and its latency.
+see README.md for the usage of this script.
+"""
+import argparse
+import json
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.contrib import graph_runtime
+
+
+def get_heads(num_heads, size, channels, num_anchors, num_classes):
+    params = {}
+
+    def conv2d(x, name, out_channels, in_channels):
+        w = relay.var(name + "_weight", shape=(out_channels, in_channels, 3, 3))
+        b = relay.var(name + "_bias", shape=(out_channels,))
+        params[w.name_hint] = np.random.uniform(-1, 1, size=(out_channels, in_channels, 3, 3))
+        params[b.name_hint] = np.random.uniform(-1, 1, size=(out_channels,))
+        return relay.nn.bias_add(relay.nn.conv2d(x, w, padding=(1, 1)), b)
+
+    outputs = []
+    for i in range(num_heads):
+        x = relay.var("x%d" % i, shape=(1, channels, size, size))
+        feature = relay.nn.relu(conv2d(x, "feature%d" % i, channels, channels))
+        cls = conv2d(feature, "class%d" % i, num_anchors * num_classes, channels)
+        outputs.append(relay.sigmoid(cls))
+        outputs.append(conv2d(feature, "box%d" % i, num_anchors * 4, channels))
+    outputs = relay.Tuple(outputs)
+    func = relay.Function(relay.analysis.free_vars(outputs), outputs)
+    params = {k: tvm.nd.array(v.astype("float32")) for k, v in params.items()}
+    return tvm.IRModule.from_expr(func), params
+
+
+def evaluate(mod, params, target, combine, repeat):
+    # CombineIndependentOps runs at opt_level 4.
+    disabled_pass = [] if combine else ["CombineIndependentOps"]
+    with tvm.transform.PassContext(opt_level=4, disabled_pass=disabled_pass):
+        lib = relay.build(mod, target, params=params)
+    graph = json.loads(lib.get_json())
+    num_kernels = sum(node["op"] == "tvm_op" for node in graph["nodes"])
+    ctx = tvm.context(str(target), 0)
+    m = graph_runtime.GraphModule(lib["default"](ctx))
+    for var in mod["main"].params:
+        if var.name_hint not in params:
+            shape = [int(dim) for dim in var.type_annotation.shape]
+            m.set_input(var.name_hint, np.random.uniform(size=shape).astype("float32"))
+    ftimer = m.module.time_evaluator("run", ctx, number=100, repeat=repeat)
+    return num_kernels, np.mean(ftimer().results) * 1000
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    # group_conv2d is not optimized for the CPUs, so the pass only combines the
+    # elementwise ops of the heads there.
+    parser.add_argument("--target", type=str, default="cuda")
+    parser.add_argument("--num-heads", type=int, nargs="+", default=[3, 6])
+    parser.add_argument("--size", type=int, nargs="+", default=[5, 10])
+    parser.add_argument("--channels", type=int, default=128)
+    parser.add_argument("--num-anchors", type=int, default=6)
+    parser.add_argument("--num-classes", type=int, default=21)
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    target = tvm.target.Target(args.target)
+    print(
+        "%-8s %-6s %-10s %-10s %-12s %-12s %-10s"
+        % ("heads", "size", "kernels", "combined", "ms", "combined", "speedup")
+    )
+    for num_heads in args.num_heads:
+        for size in args.size:
+            mod, params = get_heads(
+                num_heads, size, args.channels, args.num_anchors, args.num_classes
+            )
+            base_kernels, base = evaluate(mod, params, target, False, args.repeat)
+            num_kernels, cost = evaluate(mod, params, target, True, args.repeat)
+            print(
+                "%-8d %-6d %-10d %-10d %-12.3f %-12.3f %-10.2f"
+                % (num_heads, size, base_kernels, num_kernels, base, cost, base / cost)
+            )
@@ -0,0 +1,88 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the cost models of the auto_scheduler search.
+The script runs the same SketchPolicy search on a fixed task with GBDTModel and with XGBModel.
+Every round samples the initial population, runs the evolutionary search, measures the best
+states on the local cpu and updates the model with them. It reports the time per search
+round, the states the model predicts per second, and the time of the model update.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import te, topi, auto_scheduler
+
+
+@auto_scheduler.register_workload
+def conv2d_relu(N, H, W, CI, CO, KH, KW):
+    data = te.placeholder((N, CI, H, W), name="data")
+    kernel = te.placeholder((CO, CI, KH, KW), name="kernel")
+    conv = topi.nn.conv2d_nchw(data, kernel, 1, KH // 2, 1, out_dtype="float32")
+    return [data, kernel, topi.nn.relu(conv)]
+
+
+def make_model(name):
+    if name == "gbdt":
+        return auto_scheduler.GBDTModel()
+    return auto_scheduler.XGBModel(verbose_eval=0)
+
+
+def run_search(model_name, task, args):
+    model = make_model(model_name)
+    policy = auto_scheduler.SketchPolicy(task, model, seed=args.seed, verbose=0)
+    builder = auto_scheduler.LocalBuilder()
+    runner = auto_scheduler.LocalRunner(repeat=1, min_repeat_ms=100)
+    search_costs, predict_rates, update_costs = [], [], []
+    for _ in range(args.rounds):
+        start = time.time()
+        init_population = policy.sample_initial_population(args.population)
+        states = policy.evolutionary_search(init_population, args.batch_size)
+        search_costs.append(time.time() - start)
+
+        start = time.time()
+        model.predict(task, init_population)
+        predict_rates.append(len(init_population) / (time.time() - start))
+
+        inputs = [auto_scheduler.MeasureInput(task, state) for state in states]
+        results = runner.run(inputs, builder.build(inputs, verbose=0), verbose=0)
+        start = time.time()
+        model.update(inputs, results)
+        update_costs.append(time.time() - start)
+    return np.mean(search_costs), np.mean(predict_rates), np.mean(update_costs)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm -mcpu=core-avx2")
+    parser.add_argument("--models", type=str, nargs="+", default=["gbdt", "xgb"])
+    parser.add_argument("--rounds", type=int, default=5)
+    parser.add_argument("--population", type=int, default=2048)
+    parser.add_argument("--batch-size", type=int, default=64)
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    workload_key = auto_scheduler.make_workload_key(conv2d_relu, (1, 28, 28, 128, 128, 3, 3))
+    dag = auto_scheduler.ComputeDAG(workload_key)
+    task = auto_scheduler.SearchTask(dag, workload_key, tvm.target.Target(args.target))
+
+    print("%-8s %-16s %-22s %-16s" % ("model", "round (s)", "predicted states/s", "update (s)"))
+    for model_name in args.models:
+        search_cost, predict_rate, update_cost = run_search(model_name, task, args)
+        print("%-8s %-16.3f %-22.0f %-16.3f" % (model_name, search_cost, predict_rate, update_cost))
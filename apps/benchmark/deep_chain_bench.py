@@ -0,0 +1,90 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the compile time and the stack of relay.build on deep graphs.
+The script builds a chain of elementwise ops of every depth in a thread of a fixed stack size,
+and reports the compile time and the smallest power of two stack size the build runs within.
+Every build runs in a child process, as a stack overflow kills the process.
+see README.md for the usage of this script.
+"""
+import argparse
+import subprocess
+import sys
+import threading
+import time
+
+import tvm
+from tvm import relay
+
+
+def build_chain(depth, target, opt_level):
+    x = relay.var("x", shape=(10,))
+    y = x
+    for _ in range(depth):
+        y = relay.negative(y)
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    start = time.time()
+    with tvm.transform.PassContext(opt_level=opt_level):
+        relay.build(mod, target)
+    return time.time() - start
+
+
+def run_child(depth, stack_kb, target, opt_level):
+    """Build the chain in a thread of the stack size, the graph is freed in the thread too."""
+    result = []
+    threading.stack_size(stack_kb * 1024)
+    thread = threading.Thread(
+        target=lambda: result.append(build_chain(depth, target, opt_level))
+    )
+    thread.start()
+    thread.join()
+    print(result[0])
+
+
+def measure(depth, stack_kb, args):
+    cmd = [sys.executable, __file__, "--child", str(depth), str(stack_kb)]
+    cmd += ["--target", args.target, "--opt-level", str(args.opt_level)]
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, check=False)
+    if proc.returncode != 0:
+        return None
+    return float(proc.stdout.decode().strip().splitlines()[-1])
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm")
+    parser.add_argument("--opt-level", type=int, default=3)
+    parser.add_argument("--depth", type=int, nargs="+", default=[1000, 10000, 100000])
+    parser.add_argument("--min-stack-kb", type=int, default=256)
+    parser.add_argument("--max-stack-kb", type=int, default=1024 * 1024)
+    parser.add_argument("--child", type=int, nargs=2, help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.child:
+        run_child(args.child[0], args.child[1], args.target, args.opt_level)
+        sys.exit(0)
+
+    print("%-10s %-16s %-10s" % ("depth", "stack (KB)", "build (s)"))
+    for depth in args.depth:
+        stack_kb = args.min_stack_kb
+        cost = measure(depth, stack_kb, args)
+        while cost is None and stack_kb < args.max_stack_kb:
+            stack_kb *= 2
+            cost = measure(depth, stack_kb, args)
+        if cost is None:
+            print("%-10d %-16s %-10s" % (depth, "> %d" % args.max_stack_kb, "-"))
+        else:
+            print("%-10d %-16d %-10.2f" % (depth, stack_kb, cost))
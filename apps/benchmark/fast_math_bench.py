@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the fast math approximations of the float32 transcendentals on CPU.
+It reports the max error in ulp and the throughput of every accuracy tier of LowerIntrin,
+against the llvm intrinsics and libm calls used without fast math.
+see README.md for the usage of this script.
+"""
+import argparse
+import math
+
+import numpy as np
+
+import tvm
+from tvm import te
+
+# op, numpy reference, input range, and the error bounds of the tiers.
+OPS = {
+    "exp": (te.exp, np.exp, lambda n: np.linspace(-87, 88, n), [2, 8]),
+    "log": (te.log, np.log, lambda n: np.exp(np.linspace(-87, 88, n)), [2, 16]),
+    "sigmoid": (
+        te.sigmoid,
+        lambda x: 1 / (1 + np.exp(-x)),
+        lambda n: np.linspace(-80, 80, n),
+        [4, 8],
+    ),
+    "tanh": (te.tanh, np.tanh, lambda n: np.linspace(-10, 10, n), [2, 8]),
+    "erf": (te.erf, np.vectorize(math.erf), lambda n: np.linspace(-5, 5, n), [8]),
+}
+
+
+def build(op, n, target, max_ulp):
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: op(A[i]), name="B")
+    s = te.create_schedule(B.op)
+    xo, xi = s[B].split(B.op.axis[0], factor=16)
+    s[B].parallel(xo)
+    s[B].vectorize(xi)
+    with tvm.transform.PassContext(config={"tir.LowerIntrin": {"fast_math_max_ulp": max_ulp}}):
+        return tvm.build(s, [A, B], target)
+
+
+def evaluate(name, n, target, max_ulp, repeat):
+    op, fref, frange, _ = OPS[name]
+    ctx = tvm.cpu(0)
+    a_np = frange(n).astype("float32")
+    ref = fref(a_np.astype("float64"))
+    f = build(op, n, target, max_ulp)
+    a = tvm.nd.array(a_np, ctx)
+    b = tvm.nd.array(np.zeros(n, dtype="float32"), ctx)
+    f(a, b)
+    ulp = np.spacing(np.abs(ref.astype("float32"))).astype("float64")
+    err = np.max(np.abs(b.asnumpy().astype("float64") - ref) / ulp)
+    ftimer = f.time_evaluator(f.entry_name, ctx, number=10, repeat=repeat)
+    cost = np.mean(ftimer(a, b).results)
+    return err, n / cost / 1e9
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm")
+    parser.add_argument(
+        "--ops", type=str, nargs="+", default=list(OPS.keys()), choices=list(OPS.keys())
+    )
+    parser.add_argument("--n", type=int, default=1 << 22)
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    print(
+        "%-10s %-12s %-14s %-16s %-10s"
+        % ("op", "tier (ulp)", "max err (ulp)", "Gelem/s", "speedup")
+    )
+    for name in args.ops:
+        base = None
+        # 0 disables fast math, and is the baseline.
+        for max_ulp in [0] + OPS[name][3]:
+            err, throughput = evaluate(name, args.n, args.target, max_ulp, args.repeat)
+            base = base or throughput
+            print(
+                "%-10s %-12s %-14.2f %-16.3f %-10.2f"
+                % (name, max_ulp or "none", err, throughput, throughput / base)
+            )
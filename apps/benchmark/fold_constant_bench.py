@@ -0,0 +1,108 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for FoldConstant with and without the batched evaluation.
+The script times FoldConstant on a synthetic graph of dense layers whose weights go through
+a reshape and a transpose, and optionally on ONNX and TFLite models with their weights bound
+as constants, with the "batched" field of the "relay.FoldConstant" pass config on and off.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.relay import transform
+from tvm.relay.build_module import bind_params_by_name
+
+
+def synthetic_graph(num_layers, units):
+    """Dense layers with 2 foldable weight-side ops each, the weights are stored transposed."""
+    x = relay.var("x", shape=(1, units))
+    y = x
+    for _ in range(num_layers):
+        w = np.random.uniform(-1, 1, (units * units,)).astype("float32")
+        weight = relay.transpose(relay.reshape(relay.const(w), (units, units)), (1, 0))
+        y = relay.nn.relu(relay.nn.dense(y, weight))
+    return tvm.IRModule.from_expr(relay.Function([x], y))
+
+
+def onnx_graph(path):
+    import onnx  # pylint: disable=import-outside-toplevel
+
+    mod, params = relay.frontend.from_onnx(onnx.load(path))
+    return bind_graph(mod, params)
+
+
+def tflite_graph(path, input_name, input_shape):
+    import tflite  # pylint: disable=import-outside-toplevel
+
+    with open(path, "rb") as f:
+        model = tflite.Model.GetRootAsModel(f.read(), 0)
+    mod, params = relay.frontend.from_tflite(
+        model, shape_dict={input_name: input_shape}, dtype_dict={input_name: "float32"}
+    )
+    return bind_graph(mod, params)
+
+
+def bind_graph(mod, params):
+    """Bind the weights as constants, so that the weight-side ops can be folded."""
+    return tvm.IRModule.from_expr(bind_params_by_name(mod["main"], params))
+
+
+def time_fold(mod, batched, repeat):
+    mod = transform.InferType()(mod)
+    costs = []
+    for _ in range(repeat):
+        start = time.time()
+        with tvm.transform.PassContext(config={"relay.FoldConstant": {"batched": batched}}):
+            transform.FoldConstant()(mod)
+        costs.append(time.time() - start)
+    return np.mean(costs)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num-layers", type=int, nargs="+", default=[500, 2000])
+    parser.add_argument("--units", type=int, default=64)
+    parser.add_argument("--onnx", type=str, nargs="*", default=[], help="paths of ONNX models")
+    parser.add_argument("--tflite", type=str, nargs="*", default=[], help="paths of TFLite models")
+    parser.add_argument("--tflite-input-name", type=str, default="input")
+    parser.add_argument("--tflite-input-shape", type=int, nargs="+", default=[1, 224, 224, 3])
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    graphs = [
+        ("dense x %d" % n, lambda n=n: synthetic_graph(n, args.units)) for n in args.num_layers
+    ]
+    graphs += [(path, lambda path=path: onnx_graph(path)) for path in args.onnx]
+    graphs += [
+        (
+            path,
+            lambda path=path: tflite_graph(
+                path, args.tflite_input_name, args.tflite_input_shape
+            ),
+        )
+        for path in args.tflite
+    ]
+
+    print("%-40s %-16s %-16s" % ("graph", "one by one (s)", "batched (s)"))
+    for name, get_graph in graphs:
+        mod = get_graph()
+        costs = [time_fold(mod, batched, args.repeat) for batched in [False, True]]
+        print("%-40s %-16.3f %-16.3f" % (name[-40:], costs[0], costs[1]))
@@ -0,0 +1,90 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the full and the incremental mode of Relay type inference.
+The script builds a graph of conv2d, bias and activation blocks with the given number of nodes,
+infers its types once, rewrites the op at the top and times the inference of the rewritten
+graph in both modes, and optionally the time of relay.build in both modes.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.relay import transform
+
+
+def build_graph(num_nodes, channels):
+    """A chain of conv2d + bias_add + relu + add blocks, about 6 nodes each with the constants."""
+    x = relay.var("x", shape=(1, channels, 8, 8))
+    y = x
+    for _ in range(max(num_nodes // 6, 1)):
+        w = relay.const(np.random.uniform(-1, 1, (channels, channels, 1, 1)).astype("float32"))
+        b = relay.const(np.random.uniform(-1, 1, (channels,)).astype("float32"))
+        z = relay.nn.relu(relay.nn.bias_add(relay.nn.conv2d(y, w), b))
+        y = relay.add(y, z)
+    return tvm.IRModule.from_expr(relay.Function([x], relay.nn.max_pool2d(y)))
+
+
+def pass_config(incremental):
+    return {"relay.InferType": {"incremental": incremental}}
+
+
+def time_infer(mod, incremental, repeat):
+    """Rewrite the pooling on top of the typed graph and infer the types of the result."""
+    typed = transform.InferType()(mod)
+    params = typed["main"].params
+    body = typed["main"].body.args[0]
+    costs = []
+    for _ in range(repeat):
+        func = relay.Function(params, relay.nn.avg_pool2d(body, pool_size=(2, 2), strides=(2, 2)))
+        new_mod = tvm.IRModule.from_expr(func)
+        start = time.time()
+        with tvm.transform.PassContext(config=pass_config(incremental)):
+            transform.InferType()(new_mod)
+        costs.append(time.time() - start)
+    return np.mean(costs)
+
+
+def time_build(mod, incremental, target):
+    start = time.time()
+    with tvm.transform.PassContext(opt_level=3, config=pass_config(incremental)):
+        relay.build(mod, target)
+    return time.time() - start
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm")
+    parser.add_argument("--num-nodes", type=int, nargs="+", default=[1000, 10000])
+    parser.add_argument("--channels", type=int, default=16)
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--build", action="store_true", help="time relay.build too")
+    args = parser.parse_args()
+
+    columns = ["infer full (s)", "infer incr (s)"]
+    if args.build:
+        columns += ["build full (s)", "build incr (s)"]
+    print("%-10s " % "nodes" + " ".join("%-16s" % c for c in columns))
+    for num_nodes in args.num_nodes:
+        mod = build_graph(num_nodes, args.channels)
+        costs = [time_infer(mod, incremental, args.repeat) for incremental in [False, True]]
+        if args.build:
+            costs += [time_build(mod, incremental, args.target) for incremental in [False, True]]
+        print("%-10d " % num_nodes + " ".join("%-16.4f" % c for c in costs))
@@ -0,0 +1,101 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the uint8 x int8 dense with the int8 dot product microkernels on CPU.
+It compares dense_int8 with the float32 dense_pack schedule, and with the float32 GEMM of
+oneDNN and the int8 GEMM of MKL when TVM is built with them, over a grid of (M, N, K).
+see README.md for the usage of this script.
+"""
+import argparse
+import itertools
+
+import numpy as np
+
+import tvm
+from tvm import te
+from tvm import topi
+
+# compute, schedule, dtype of the data and the weight, and the extern function it needs.
+IMPLEMENTS = {
+    "int8": (topi.x86.dense_int8, topi.x86.schedule_dense_int8, ("uint8", "int8"), None),
+    "fp32": (topi.x86.dense_pack, topi.x86.schedule_dense_pack, ("float32", "float32"), None),
+    "onednn_fp32": (
+        topi.x86.dense_mkldnn,
+        topi.x86.schedule_dense_mkldnn,
+        ("float32", "float32"),
+        "tvm.contrib.mkldnn.matmul",
+    ),
+    "mkl_int8": (
+        topi.x86.dense_mkl,
+        topi.x86.schedule_dense_mkl,
+        ("uint8", "int8"),
+        "tvm.contrib.mkl.matmul_u8s8s32",
+    ),
+}
+
+
+def random_data(shape, dtype):
+    if dtype == "uint8":
+        return np.random.randint(0, 256, size=shape).astype(dtype)
+    if dtype == "int8":
+        return np.random.randint(-128, 128, size=shape).astype(dtype)
+    return np.random.uniform(-1, 1, size=shape).astype(dtype)
+
+
+def evaluate(impl, m, n, k, target, repeat):
+    fcompute, fschedule, (data_dtype, weight_dtype), _ = IMPLEMENTS[impl]
+    out_dtype = "int32" if data_dtype == "uint8" else "float32"
+    data = te.placeholder((m, k), name="data", dtype=data_dtype)
+    weight = te.placeholder((n, k), name="weight", dtype=weight_dtype)
+    with tvm.target.Target(target):
+        out = fcompute(data, weight, None, out_dtype)
+        s = fschedule([out])
+    f = tvm.build(s, [data, weight, out], target)
+    ctx = tvm.cpu(0)
+    args = [
+        tvm.nd.array(random_data((m, k), data_dtype), ctx),
+        tvm.nd.array(random_data((n, k), weight_dtype), ctx),
+        tvm.nd.empty((m, n), out_dtype, ctx),
+    ]
+    ftimer = f.time_evaluator(f.entry_name, ctx, number=10, repeat=repeat)
+    cost = np.mean(ftimer(*args).results)
+    return cost * 1000, 2.0 * m * n * k / cost / 1e9
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    # the int8 dot product microkernel needs AVX2, and VNNI for 16 int32 lanes
+    parser.add_argument("--target", type=str, default="llvm -mcpu=cascadelake")
+    parser.add_argument("--m", type=int, nargs="+", default=[1, 16, 128])
+    parser.add_argument("--n", type=int, nargs="+", default=[768, 3072])
+    parser.add_argument("--k", type=int, nargs="+", default=[768, 3072])
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    impls = [
+        impl
+        for impl, (_, _, _, extern) in IMPLEMENTS.items()
+        if extern is None or tvm.get_global_func(extern, allow_missing=True)
+    ]
+
+    header = "%-6s %-6s %-6s " % ("M", "N", "K")
+    print(header + " ".join("%-28s" % impl for impl in impls))
+    for m, n, k in itertools.product(args.m, args.n, args.k):
+        results = []
+        for impl in impls:
+            time_ms, gops = evaluate(impl, m, n, k, args.target, args.repeat)
+            results.append("%-28s" % ("%.3f ms %.1f GOPS" % (time_ms, gops)))
+        print("%-6d %-6d %-6d " % (m, n, k) + " ".join(results))
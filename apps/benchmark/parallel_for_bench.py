@@ -0,0 +1,85 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the scheduling of support::parallel_for in the auto_scheduler search.
+It times the sampling of the initial population of SketchPolicy and the feature extraction of
+the sampled states on a fixed task, with the round-robin static partition of the loops
+(TVM_PARALLEL_FOR_STATIC=1) and with the dynamic scheduling.
+Every mode runs in a child process, as the mode is read once per process.
+see README.md for the usage of this script.
+"""
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+import numpy as np
+
+import tvm
+from tvm import te, topi, auto_scheduler
+
+
+@auto_scheduler.register_workload
+def conv2d_relu(N, H, W, CI, CO, KH, KW):
+    data = te.placeholder((N, CI, H, W), name="data")
+    kernel = te.placeholder((CO, CI, KH, KW), name="kernel")
+    conv = topi.nn.conv2d_nchw(data, kernel, 1, KH // 2, 1, out_dtype="float32")
+    return [data, kernel, topi.nn.relu(conv)]
+
+
+def run_child(args):
+    workload_key = auto_scheduler.make_workload_key(conv2d_relu, (1, 56, 56, 64, 64, 3, 3))
+    dag = auto_scheduler.ComputeDAG(workload_key)
+    task = auto_scheduler.SearchTask(dag, workload_key, tvm.target.Target(args.target))
+    # the cache would skip the feature extraction of the states sampled again
+    auto_scheduler.feature.set_per_store_feature_cache_capacity(0)
+    policy = auto_scheduler.SketchPolicy(task, verbose=0)
+    sample_costs, feature_costs = [], []
+    for _ in range(args.repeat):
+        start = time.time()
+        states = policy.sample_initial_population(args.population)
+        sample_costs.append(time.time() - start)
+        start = time.time()
+        auto_scheduler.feature.get_per_store_features_from_states(states, task)
+        feature_costs.append(time.time() - start)
+    print(np.mean(sample_costs), np.mean(feature_costs))
+
+
+def measure(static, args):
+    env = dict(os.environ, TVM_PARALLEL_FOR_STATIC="1" if static else "0")
+    cmd = [sys.executable, __file__, "--child", "--target", args.target]
+    cmd += ["--population", str(args.population), "--repeat", str(args.repeat)]
+    out = subprocess.run(cmd, env=env, stdout=subprocess.PIPE, check=True).stdout
+    return [float(x) for x in out.decode().strip().splitlines()[-1].split()]
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm -mcpu=core-avx2")
+    parser.add_argument("--population", type=int, default=2048)
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--child", action="store_true", help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.child:
+        run_child(args)
+        sys.exit(0)
+
+    print("%-10s %-16s %-16s" % ("mode", "sample (s)", "features (s)"))
+    for mode, static in [("static", True), ("dynamic", False)]:
+        sample_cost, feature_cost = measure(static, args)
+        print("%-10s %-16.3f %-16.3f" % (mode, sample_cost, feature_cost))
@@ -0,0 +1,134 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for block sparse conv2d on CPU.
+It compares the dense conv2d with the conv2d converted by data_dep_optimization.bsr_conv2d,
+over the pointwise layers of MobileNet and a grid of sparsity.
+see README.md for the usage of this script.
+"""
+import argparse
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.contrib import graph_runtime
+
+# (in_channel, out_channel, size) of the pointwise conv2d of MobileNet v1
+MOBILENET_POINTWISE = [
+    (32, 64, 112),
+    (64, 128, 56),
+    (128, 128, 56),
+    (128, 256, 28),
+    (256, 256, 28),
+    (256, 512, 14),
+    (512, 512, 14),
+    (512, 1024, 7),
+    (1024, 1024, 7),
+]
+
+
+def block_sparse_kernel(co, ci, kernel_size, block_size, sparsity, layout):
+    """A random kernel whose (out_channel, rest) matrix has the sparsity in blocks."""
+    w = np.random.randn(co, ci * kernel_size * kernel_size).astype("float32")
+    bs_r, bs_c = block_size
+    mask = np.random.uniform(size=(co // bs_r, w.shape[1] // bs_c)) >= sparsity
+    w *= np.kron(mask, np.ones(block_size, dtype="float32"))
+    if layout == "NHWC":
+        return w.reshape((co, kernel_size, kernel_size, ci)).transpose((1, 2, 3, 0)).copy()
+    return w.reshape((co, ci, kernel_size, kernel_size))
+
+
+def conv2d_func(ci, co, size, kernel_size, layout):
+    padding = (kernel_size - 1) // 2
+    if layout == "NHWC":
+        data_shape = (1, size, size, ci)
+        kernel_shape = (kernel_size, kernel_size, ci, co)
+        kernel_layout = "HWIO"
+    else:
+        data_shape = (1, ci, size, size)
+        kernel_shape = (co, ci, kernel_size, kernel_size)
+        kernel_layout = "OIHW"
+    data = relay.var("data", shape=data_shape, dtype="float32")
+    weight = relay.var("weight", shape=kernel_shape, dtype="float32")
+    out = relay.nn.conv2d(
+        data,
+        weight,
+        channels=co,
+        kernel_size=(kernel_size, kernel_size),
+        padding=(padding, padding),
+        data_layout=layout,
+        kernel_layout=kernel_layout,
+    )
+    return relay.Function(relay.analysis.free_vars(out), out), data_shape
+
+
+def evaluate(func, params, data_shape, target, repeat):
+    with tvm.transform.PassContext(opt_level=3):
+        graph, lib, params = relay.build(func, target, params=params)
+    ctx = tvm.cpu(0)
+    module = graph_runtime.create(graph, lib, ctx)
+    module.set_input("data", tvm.nd.array(np.random.randn(*data_shape).astype("float32")))
+    module.set_input(**params)
+    ftimer = module.module.time_evaluator("run", ctx, number=10, repeat=repeat)
+    return np.mean(ftimer().results) * 1000
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm -mcpu=core-avx2")
+    parser.add_argument("--layout", type=str, default="NHWC", choices=["NHWC", "NCHW"])
+    parser.add_argument("--kernel-size", type=int, default=1, choices=[1, 3])
+    parser.add_argument("--block-size", type=int, nargs=2, default=[16, 1])
+    parser.add_argument("--sparsity", type=float, nargs="+", default=[0.7, 0.8, 0.9])
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+    block_size = tuple(args.block_size)
+
+    print(
+        "%-6s %-6s %-6s %-10s %-12s %-12s %-8s"
+        % ("ci", "co", "size", "sparsity", "dense", "sparse", "speedup")
+    )
+    for ci, co, size in MOBILENET_POINTWISE:
+        func, data_shape = conv2d_func(ci, co, size, args.kernel_size, args.layout)
+        for sparsity in args.sparsity:
+            kernel = block_sparse_kernel(
+                co, ci, args.kernel_size, block_size, sparsity, args.layout
+            )
+            dense_time = evaluate(
+                func, {"weight": tvm.nd.array(kernel)}, data_shape, args.target, args.repeat
+            )
+            sparse_func, params = relay.data_dep_optimization.bsr_conv2d.convert(
+                func,
+                {"weight": tvm.nd.array(kernel)},
+                block_size,
+                0.0,
+                args.layout,
+                args.kernel_size,
+            )
+            sparse_time = evaluate(sparse_func, params, data_shape, args.target, args.repeat)
+            print(
+                "%-6d %-6d %-6d %-10.2f %-12s %-12s %-8.2f"
+                % (
+                    ci,
+                    co,
+                    size,
+                    sparsity,
+                    "%.3f ms" % dense_time,
+                    "%.3f ms" % sparse_time,
+                    dense_time / sparse_time,
+                )
+            )
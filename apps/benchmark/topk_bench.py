@@ -0,0 +1,89 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for top-k of the contrib sort library on CPU.
+It compares topk with the full argsort over a grid of the number of rows, the row length and k.
+see README.md for the usage of this script.
+"""
+import argparse
+import itertools
+
+import numpy as np
+
+import tvm
+from tvm import te
+
+
+def build_extern(func, shape, k, dtype):
+    data = te.placeholder(shape, name="data", dtype=dtype)
+    if func == "topk":
+        out = te.extern(
+            [(shape[0], k)],
+            [data],
+            lambda ins, outs: tvm.tir.call_packed(
+                "tvm.contrib.sort.topk", ins[0], outs[0], k, 1, "indices", False
+            ),
+            dtype="int32",
+            name="topk_cpu",
+        )
+    else:
+        out = te.extern(
+            [shape],
+            [data],
+            lambda ins, outs: tvm.tir.call_packed(
+                "tvm.contrib.sort.argsort", ins[0], outs[0], 1, False
+            ),
+            dtype="int32",
+            name="argsort_cpu",
+        )
+    s = te.create_schedule(out.op)
+    return tvm.build(s, [data, out], "llvm"), [int(x) for x in out.shape]
+
+
+def evaluate(func, rows, n, k, dtype, repeat):
+    ctx = tvm.cpu(0)
+    f, out_shape = build_extern(func, (rows, n), k, dtype)
+    if dtype.startswith("int"):
+        np_data = np.random.randint(-128, 128, size=(rows, n)).astype(dtype)
+    else:
+        np_data = np.random.uniform(size=(rows, n)).astype(dtype)
+    data = tvm.nd.array(np_data, ctx)
+    out = tvm.nd.empty(out_shape, "int32", ctx)
+    ftimer = f.time_evaluator(f.entry_name, ctx, number=10, repeat=repeat)
+    return np.mean(ftimer(data, out).results) * 1000
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--rows", type=int, nargs="+", default=[1, 16, 128])
+    parser.add_argument("--n", type=int, nargs="+", default=[1000, 20000])
+    parser.add_argument("--k", type=int, nargs="+", default=[1, 5, 100])
+    parser.add_argument(
+        "--dtype", type=str, default="float32", choices=["float32", "float16", "int8"]
+    )
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    print("%-8s %-8s %-8s %-14s %-14s" % ("rows", "n", "k", "topk", "argsort"))
+    for rows, n, k in itertools.product(args.rows, args.n, args.k):
+        if k > n:
+            continue
+        topk_time = evaluate("topk", rows, n, k, args.dtype, args.repeat)
+        argsort_time = evaluate("argsort", rows, n, k, args.dtype, args.repeat)
+        print(
+            "%-8d %-8d %-8d %-14s %-14s"
+            % (rows, n, k, "%.3f ms" % topk_time, "%.3f ms" % argsort_time)
+        )
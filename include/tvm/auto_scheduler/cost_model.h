@@ -30,6 +30,8 @@
 #include <tvm/node/node.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <random>
+#include <string>
 #include <vector>
 
 namespace tvm {
@@ -159,6 +161,158 @@ class PythonBasedModel : public CostModel {
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(PythonBasedModel, CostModel, PythonBasedModelNode);
 };
 
+/*!
+ * \brief A binary regression tree stored in flat arrays.
+ * Node 0 is the root. A node is a leaf iff its left child is -1.
+ */
+struct RegressionTree {
+  /*! \brief The feature used by the split of each node */
+  std::vector<int> split_feature;
+  /*! \brief Rows whose feature value is less than this value go to the left child */
+  std::vector<float> split_value;
+  /*! \brief The index of the left child of each node, -1 for leaves */
+  std::vector<int> left_child;
+  /*! \brief The index of the right child of each node, -1 for leaves */
+  std::vector<int> right_child;
+  /*! \brief The output value of each leaf */
+  std::vector<float> leaf_value;
+
+  /*!
+   * \brief Append a new leaf node to the tree.
+   * \param value The output value of the leaf
+   * \return The index of the new node
+   */
+  int AddLeaf(float value);
+
+  /*!
+   * \brief Predict the output for one feature row
+   * \param row The pointer to the feature row
+   * \return The output value of the leaf this row falls into
+   */
+  float Predict(const float* row) const;
+};
+
+/*!
+ * \brief A gradient boosted decision tree model implemented natively in C++.
+ * It follows the formulation of the python XGBModel: the score of a program is the sum of the
+ * predictions for all its per-store feature rows, and trees are fitted to the "pack-sum"
+ * square error against the normalized throughputs. Compared with XGBModel, it avoids the
+ * python round trip and the feature serialization for every prediction batch.
+ * Histogram construction, training updates and predictions run in parallel with
+ * support::parallel_for.
+ */
+class GBDTModelNode : public CostModelNode {
+ public:
+  /*! \brief The maximum depth of a tree */
+  int max_depth;
+  /*! \brief The shrinkage applied to the leaf values of every new tree */
+  double learning_rate;
+  /*! \brief The L2 regularization on leaf values */
+  double reg_lambda;
+  /*! \brief The minimum loss reduction required to make a split */
+  double gamma;
+  /*! \brief The minimum sum of hessian required in a child */
+  double min_child_weight;
+  /*! \brief The maximum number of boosting rounds when training from scratch */
+  int num_boost_round;
+  /*! \brief The maximum number of boosting rounds appended by an incremental update */
+  int num_incremental_round;
+  /*! \brief Stop boosting if the training loss does not improve in this number of rounds */
+  int early_stopping_rounds;
+  /*! \brief The maximum number of histogram bins for each feature (at most 256) */
+  int max_bin;
+  /*! \brief Predict random scores until more than this number of samples are collected */
+  int num_warmup_sample;
+  /*! \brief The maximum number of extracted buffers for one statement */
+  int max_n_bufs;
+
+  void Update(const Array<MeasureInput>& inputs, const Array<MeasureResult>& results) final;
+
+  void Predict(const SearchTask& task, const Array<State>& states,
+               std::vector<float>* scores) final;
+
+  void PredictStages(const SearchTask& task, const Array<State>& states,
+                     std::vector<float>* state_scores,
+                     std::vector<std::vector<float>>* stage_scores) final;
+
+  /*!
+   * \brief Save the trained trees to a file
+   * \param file_name The filename
+   */
+  void Save(const std::string& file_name) const;
+
+  /*!
+   * \brief Load trained trees from a file. Later updates keep boosting on top of them.
+   * \param file_name The filename
+   */
+  void Load(const std::string& file_name);
+
+  /*! \brief The number of boosted trees */
+  size_t NumTrees() const { return trees_.size(); }
+
+  static constexpr const char* _type_key = "auto_scheduler.GBDTModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(GBDTModelNode, CostModelNode);
+
+ private:
+  friend class GBDTModel;
+
+  /*!
+   * \brief Compute the predictions for all feature rows of one state.
+   * \param feature The flatten per-store feature of the state
+   * \param row_scores If not nullptr, return the prediction of every row
+   * \return The sum of the row predictions
+   */
+  float PredictFeature(const std::vector<float>& feature, std::vector<float>* row_scores) const;
+
+  /*! \brief The number of float values in one per-store feature row */
+  int n_features_;
+  /*! \brief The measured inputs used as training data */
+  Array<MeasureInput> inputs_;
+  /*! \brief The measured results used as training data */
+  Array<MeasureResult> results_;
+  /*! \brief The cached per-store features of inputs_ */
+  std::vector<std::vector<float>> features_cache_;
+  /*! \brief The quantile cut points of every feature used for histogram binning */
+  std::vector<std::vector<float>> cuts_;
+  /*! \brief The boosted trees */
+  std::vector<RegressionTree> trees_;
+  /*! \brief The number of samples when the model was trained from scratch for the last time */
+  size_t n_samples_at_full_train_{0};
+  /*! \brief Whether the trees are loaded and no update has run on top of them yet */
+  bool loaded_{false};
+  /*! \brief Random generator for the warm-up predictions */
+  std::mt19937 rand_gen_;
+};
+
+/*!
+ * \brief Managed reference to GBDTModelNode.
+ * \sa GBDTModelNode
+ */
+class GBDTModel : public CostModel {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param max_depth The maximum depth of a tree
+   * \param learning_rate The shrinkage applied to the leaf values of every new tree
+   * \param reg_lambda The L2 regularization on leaf values
+   * \param gamma The minimum loss reduction required to make a split
+   * \param min_child_weight The minimum sum of hessian required in a child
+   * \param num_boost_round The maximum number of boosting rounds when training from scratch
+   * \param num_incremental_round The maximum number of rounds appended by an incremental update
+   * \param early_stopping_rounds Stop boosting if the loss does not improve in these rounds
+   * \param max_bin The maximum number of histogram bins for each feature
+   * \param num_warmup_sample Predict random scores until more samples than this are collected
+   * \param max_n_bufs The maximum number of extracted buffers for one statement
+   * \param seed The random seed
+   */
+  GBDTModel(int max_depth, double learning_rate, double reg_lambda, double gamma,
+            double min_child_weight, int num_boost_round, int num_incremental_round,
+            int early_stopping_rounds, int max_bin, int num_warmup_sample, int max_n_bufs,
+            int seed);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(GBDTModel, CostModel, GBDTModelNode);
+};
+
 }  // namespace auto_scheduler
 }  // namespace tvm
 
@@ -70,6 +70,23 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const SearchTask&
                                    int skip_first_n_feature_extraction, int max_n_bufs,
                                    std::vector<std::vector<float> >* features);
 
+/*!
+ * \brief Set the capacity of the global per-store feature cache.
+ * GetPerStoreFeaturesFromStates with a single task memorizes the features of states, keyed by
+ * the task and the transform steps of the state. The evolutionary search evaluates the same
+ * states many times (unmutated copies and survivors of previous generations), so these lookups
+ * skip the expensive lowering and feature extraction.
+ * \param capacity The maximum number of cached states. 0 disables the cache.
+ */
+void SetPerStoreFeatureCacheCapacity(size_t capacity);
+
+/*!
+ * \brief Get the statistics of the global per-store feature cache.
+ * \param hit_ct The returned number of cache hits
+ * \param miss_ct The returned number of cache misses
+ */
+void GetPerStoreFeatureCacheStats(size_t* hit_ct, size_t* miss_ct);
+
 /*!
  * \brief Get per-store feature from states of different tasks
  * \param states The input states
@@ -67,12 +67,15 @@
 
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace tvm {
 namespace auto_scheduler {
 
 class ProgramMeasurer;
+class MeasureInput;
+class MeasureResult;
 class SearchPolicyNode;
 
 /*!
@@ -130,6 +133,38 @@ class PreloadMeasuredStates : public SearchCallback {
                                         PreloadMeasuredStatesNode);
 };
 
+/*!
+ * \brief Preload states tuned for similar workloads (e.g., the same op with nearby shapes) to
+ * warm start the search. The states are replayed on the current task and used as extra starting
+ * points, but they are still measured on the current task before being trusted.
+ */
+class PreloadTransferredStatesNode : public SearchCallbackNode {
+ public:
+  /*! \brief The states of other tasks. Only their transform steps are used. */
+  Array<State> states;
+
+  void Callback(SearchPolicyNode* policy) final;
+
+  static constexpr const char* _type_key = "auto_scheduler.PreloadTransferredStates";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PreloadTransferredStatesNode, SearchCallbackNode);
+};
+
+/*!
+ * \brief Managed reference to PreloadTransferredStatesNode.
+ * \sa PreloadTransferredStatesNode
+ */
+class PreloadTransferredStates : public SearchCallback {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param states The states of other tasks. Only their transform steps are used.
+   */
+  explicit PreloadTransferredStates(Array<State> states);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(PreloadTransferredStates, SearchCallback,
+                                        PreloadTransferredStatesNode);
+};
+
 /*! \brief Attribute keys of ops used for SearchPolicy. */
 struct SearchPolicyKey {
   /*! \brief Always apply unroll to the inner most iterator of the specificed iterators. */
@@ -171,12 +206,30 @@ class SearchPolicyNode : public Object {
   virtual State Search(int num_measure_trials, int early_stopping, int num_measures_per_round,
                        ProgramMeasurer measurer) = 0;
 
+  /*!
+   * \brief Continue the search by doing one more search round: search for new candidates, measure
+   * them and update the policy (e.g., retrain the cost model) with the results.
+   * This is used by the task scheduler to interleave the searches of several tasks.
+   * \param num_measure The number of programs to be measured in this round.
+   * \param measurer A ProgramMeasurer to build and measure programs
+   * \return The measured inputs and results. They are empty if no new candidate can be found.
+   */
+  virtual std::pair<Array<MeasureInput>, Array<MeasureResult>> ContinueSearchOneRound(
+      int num_measure, ProgramMeasurer measurer) = 0;
+
   /*!
    * \brief Preload measured states from a log file to resume the state of the search policy.
    * \param log_file The name of the record log file.
    */
   void PreloadMeasuredStates(const String& log_file);
 
+  /*!
+   * \brief Replay states of similar workloads on the current task to warm start the search.
+   * States whose transform steps cannot be applied to the current task are dropped.
+   * \param states The states of other tasks. Only their transform steps are used.
+   */
+  void PreloadTransferredStates(const Array<State>& states);
+
   /*!
    * \brief Call SearchCallback with the current SearchPolicyNode
    * \param callbacks SearchCallback to be called.
@@ -198,6 +251,9 @@ class SearchPolicyNode : public Object {
   std::vector<State> measured_states_vector_;
   /*! \brief The throughputs of already measured states */
   std::vector<float> measured_states_throughputs_;
+  /*! \brief The states transferred from similar workloads. They are not measured on the current
+   *  task yet, but are promising starting points for the search. */
+  std::vector<State> transferred_states_;
 };
 
 /*!
@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/auto_scheduler/task_scheduler.h
+ * \brief The task scheduler that allocates the tuning budget across the tasks of a network.
+ *
+ * A network is split into several SearchTasks, and a task can appear several times in the
+ * network (its weight). Instead of tuning every task with a fixed number of trials, the task
+ * scheduler tunes the tasks round by round, and in each round it picks the task whose tuning is
+ * expected to reduce the end-to-end latency (sum of weight * latency) the most.
+ * All tasks share one ProgramMeasurer.
+ */
+
+#ifndef TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
+#define TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
+
+#include <tvm/auto_scheduler/auto_schedule.h>
+#include <tvm/auto_scheduler/measure.h>
+#include <tvm/auto_scheduler/search_policy.h>
+
+#include <vector>
+
+namespace tvm {
+namespace auto_scheduler {
+
+/*! \brief The task scheduler that tunes the tasks of a network with a shared budget. */
+class TaskSchedulerNode : public Object {
+ public:
+  /*! \brief The tasks to be tuned. */
+  Array<SearchTask> tasks;
+  /*! \brief The search policy of each task. */
+  Array<SearchPolicy> search_policies;
+  /*! \brief The weight of each task, i.e., the number of its occurrences in the network. */
+  std::vector<double> task_weights;
+  /*! \brief The strategy to pick the next task, "gradient" or "round-robin". */
+  String strategy;
+  /*! \brief The weight of the backward gradient (the improvement of the last rounds) against the
+   *  forward gradient (the expected improvement of the next round). */
+  double alpha;
+  /*! \brief The number of rounds used to compute the backward gradient. */
+  int backward_window_size;
+  /*! \brief Stops tuning a task if no improvement after n measurements of this task. */
+  int early_stopping_per_task;
+
+  /*! \brief The best latency (in seconds) of each task found so far. */
+  std::vector<double> best_costs;
+  /*! \brief The number of tuning rounds of each task. */
+  std::vector<int> task_cts;
+  /*! \brief The number of measured programs of each task. */
+  std::vector<int> task_trials;
+  /*! \brief The best latency of each task after each of its tuning rounds. */
+  std::vector<std::vector<double>> task_costs_history;
+  /*! \brief The tasks that do not need more tuning. */
+  std::vector<bool> dead_tasks;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("tasks", &tasks);
+    v->Visit("search_policies", &search_policies);
+    v->Visit("strategy", &strategy);
+    v->Visit("alpha", &alpha);
+    v->Visit("backward_window_size", &backward_window_size);
+    v->Visit("early_stopping_per_task", &early_stopping_per_task);
+  }
+
+  /*!
+   * \brief Tune all tasks.
+   * `tuning_options->num_measure_trials` is the total number of trials of all tasks, and
+   * `tuning_options->early_stopping` stops the tuning if the end-to-end latency is not improved
+   * after n measurements.
+   * \param tuning_options Tuning and measurement options.
+   */
+  void Tune(const TuningOptions& tuning_options);
+
+  /*! \brief The weighted sum of the best latencies of all tasks. */
+  double ComputeScore() const;
+
+  static constexpr const char* _type_key = "auto_scheduler.TaskScheduler";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TaskSchedulerNode, Object);
+
+ private:
+  /*!
+   * \brief Tune a task for one round and update the book keeping variables.
+   * \param task_idx The index of the task.
+   */
+  void TuneTask(int task_idx);
+  /*!
+   * \brief Pick the next task to tune.
+   * \return The index of the task, -1 if all tasks are dead.
+   */
+  int PickTask();
+  /*! \brief Print the best latency of all tasks. */
+  void PrintTableInfo() const;
+
+  /*! \brief The measurer shared by all tasks. */
+  ProgramMeasurer measurer_;
+  /*! \brief The number of programs to be measured in each round. */
+  int num_measures_per_round_;
+  /*! \brief The total number of trials. */
+  int num_measure_trials_;
+  /*! \brief The number of measured programs of all tasks. */
+  int ct_;
+  /*! \brief The number of measured programs of each task when its best latency is found. */
+  std::vector<int> task_best_cts_;
+  /*! \brief The number of rounds of each task without any valid measurement so far. */
+  std::vector<int> task_invalid_rounds_;
+  /*! \brief The index of the last tuned task. */
+  int last_task_idx_;
+  /*! \brief Verbosity level. */
+  int verbose_;
+};
+
+/*!
+ * \brief Managed reference to TaskSchedulerNode.
+ * \sa TaskSchedulerNode
+ */
+class TaskScheduler : public ObjectRef {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param tasks The tasks to be tuned.
+   * \param search_policies The search policy of each task.
+   * \param task_weights The weight of each task. All tasks have the same weight if it is empty.
+   * \param strategy The strategy to pick the next task, "gradient" or "round-robin".
+   * \param alpha The weight of the backward gradient against the forward gradient.
+   * \param backward_window_size The number of rounds used to compute the backward gradient.
+   * \param early_stopping_per_task Stops tuning a task if no improvement after n measurements of
+   * this task. -1 to disable it.
+   */
+  TaskScheduler(Array<SearchTask> tasks, Array<SearchPolicy> search_policies,
+                Array<FloatImm> task_weights, String strategy, double alpha,
+                int backward_window_size, int early_stopping_per_task);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(TaskScheduler, ObjectRef, TaskSchedulerNode);
+};
+
+}  // namespace auto_scheduler
+}  // namespace tvm
+
+#endif  // TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
@@ -0,0 +1,263 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/ir/instrument.h
+ *
+ * \brief This file introduces the pass instrumentation infrastructure.
+ *
+ * A PassInstrument is attached to a PassContext and gets notified when the context is entered
+ * and exited, and before and after every pass that runs in the context, including the passes
+ * nested in a Sequential:
+ *
+ * \code
+ *
+ *  auto ctx = PassContext::Create();
+ *  auto profiler = instrument::PassProfiler(true);
+ *  ctx->instruments = {profiler};
+ *  {
+ *    With<PassContext> scope(ctx);
+ *    mod = seq(mod);
+ *  }
+ *  LOG(INFO) << profiler->Render();
+ *
+ * \endcode
+ */
+#ifndef TVM_IR_INSTRUMENT_H_
+#define TVM_IR_INSTRUMENT_H_
+
+#include <tvm/ir/module.h>
+#include <tvm/node/container.h>
+#include <tvm/runtime/container.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+
+namespace transform {
+class PassInfo;
+}  // namespace transform
+
+namespace instrument {
+
+/*!
+ * \brief PassInstrumentNode is the base class of pass instrumentations.
+ * \sa PassInstrument
+ */
+class PassInstrumentNode : public Object {
+ public:
+  /*! \brief The name of the instrumentation. */
+  String name;
+
+  virtual ~PassInstrumentNode() {}
+
+  /*! \brief Called when the PassContext holding this instrumentation is entered. */
+  virtual void EnterPassContext() const = 0;
+
+  /*! \brief Called when the PassContext holding this instrumentation is exited. */
+  virtual void ExitPassContext() const = 0;
+
+  /*!
+   * \brief Called before a pass runs.
+   * \param mod The module that the pass runs on.
+   * \param info The pass information.
+   */
+  virtual void RunBeforePass(const IRModule& mod, const transform::PassInfo& info) const = 0;
+
+  /*!
+   * \brief Called after a pass runs.
+   * \param mod The module returned by the pass.
+   * \param info The pass information.
+   */
+  virtual void RunAfterPass(const IRModule& mod, const transform::PassInfo& info) const = 0;
+
+  void VisitAttrs(AttrVisitor* v) { v->Visit("name", &name); }
+
+  static constexpr const char* _type_key = "instrument.PassInstrument";
+  TVM_DECLARE_BASE_OBJECT_INFO(PassInstrumentNode, Object);
+};
+
+/*!
+ * \brief Managed reference class for PassInstrumentNode
+ * \sa PassInstrumentNode
+ */
+class PassInstrument : public ObjectRef {
+ public:
+  TVM_DEFINE_OBJECT_REF_METHODS(PassInstrument, ObjectRef, PassInstrumentNode);
+};
+
+/*!
+ * \brief A pass instrumentation whose callbacks are PackedFuncs, e.g. Python functions.
+ * \sa PassInstrumentNode
+ */
+class BasePassInstrumentNode : public PassInstrumentNode {
+ public:
+  /*! \brief Callback of EnterPassContext, can be null. */
+  runtime::TypedPackedFunc<void()> enter_pass_ctx_callback;
+  /*! \brief Callback of ExitPassContext, can be null. */
+  runtime::TypedPackedFunc<void()> exit_pass_ctx_callback;
+  /*! \brief Callback of RunBeforePass, can be null. */
+  runtime::TypedPackedFunc<void(const IRModule&, const transform::PassInfo&)>
+      run_before_pass_callback;
+  /*! \brief Callback of RunAfterPass, can be null. */
+  runtime::TypedPackedFunc<void(const IRModule&, const transform::PassInfo&)>
+      run_after_pass_callback;
+
+  void EnterPassContext() const final;
+  void ExitPassContext() const final;
+  void RunBeforePass(const IRModule& mod, const transform::PassInfo& info) const final;
+  void RunAfterPass(const IRModule& mod, const transform::PassInfo& info) const final;
+
+  static constexpr const char* _type_key = "instrument.BasePassInstrument";
+  TVM_DECLARE_FINAL_OBJECT_INFO(BasePassInstrumentNode, PassInstrumentNode);
+};
+
+/*!
+ * \brief Managed reference class for BasePassInstrumentNode
+ * \sa BasePassInstrumentNode
+ */
+class BasePassInstrument : public PassInstrument {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param name The name of the instrumentation.
+   * \param enter_pass_ctx_callback Callback of EnterPassContext, can be null.
+   * \param exit_pass_ctx_callback Callback of ExitPassContext, can be null.
+   * \param run_before_pass_callback Callback of RunBeforePass, can be null.
+   * \param run_after_pass_callback Callback of RunAfterPass, can be null.
+   */
+  TVM_DLL BasePassInstrument(
+      String name, runtime::TypedPackedFunc<void()> enter_pass_ctx_callback,
+      runtime::TypedPackedFunc<void()> exit_pass_ctx_callback,
+      runtime::TypedPackedFunc<void(const IRModule&, const transform::PassInfo&)>
+          run_before_pass_callback,
+      runtime::TypedPackedFunc<void(const IRModule&, const transform::PassInfo&)>
+          run_after_pass_callback);
+
+  TVM_DEFINE_OBJECT_REF_METHODS(BasePassInstrument, PassInstrument, BasePassInstrumentNode);
+};
+
+/*! \brief The profile of one pass run, recorded by PassProfiler. */
+struct PassProfileEvent {
+  /*! \brief The name of the pass. */
+  std::string name;
+  /*! \brief The nesting depth, 0 for the passes run directly in the context. */
+  int depth;
+  /*! \brief The start time in microseconds since the context is entered. */
+  double start_us;
+  /*! \brief The wall time in microseconds. */
+  double duration_us;
+  /*! \brief The increase of the peak resident set size of the process in KB. */
+  int64_t peak_rss_delta_kb;
+  /*! \brief The number of IR nodes of the module before the pass, -1 if not counted. */
+  int64_t nodes_before;
+  /*! \brief The number of IR nodes of the module after the pass, -1 if not counted. */
+  int64_t nodes_after;
+};
+
+/*!
+ * \brief A built-in pass instrumentation that records the wall time, the peak RSS increase and
+ * the IR node counts before and after each pass.
+ * \sa PassProfiler
+ */
+class PassProfilerNode : public PassInstrumentNode {
+ public:
+  /*! \brief Whether to count the IR nodes before and after each pass. It traverses the whole
+   *  module twice per pass, so it is slow on large modules. */
+  bool count_nodes;
+
+  void EnterPassContext() const final;
+  void ExitPassContext() const final;
+  void RunBeforePass(const IRModule& mod, const transform::PassInfo& info) const final;
+  void RunAfterPass(const IRModule& mod, const transform::PassInfo& info) const final;
+
+  /*! \brief The events of the finished passes, in the order of their ends. */
+  const std::vector<PassProfileEvent>& events() const { return events_; }
+
+  /*! \brief Clear the recorded events. */
+  void Reset() const;
+
+  /*!
+   * \brief Render the events as a table, with the nested passes indented.
+   * \return The table.
+   */
+  String Render() const;
+
+  /*!
+   * \brief Dump the events in the Chrome trace event format, which can be loaded in
+   * chrome://tracing or https://ui.perfetto.dev.
+   * \return The JSON string.
+   */
+  String AsChromeTrace() const;
+
+  void VisitAttrs(AttrVisitor* v) {
+    PassInstrumentNode::VisitAttrs(v);
+    v->Visit("count_nodes", &count_nodes);
+  }
+
+  static constexpr const char* _type_key = "instrument.PassProfiler";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PassProfilerNode, PassInstrumentNode);
+
+ private:
+  /*! \brief The state of a running pass. */
+  struct RunningPass {
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+    int64_t peak_rss_kb;
+    int64_t nodes_before;
+  };
+
+  /*! \brief The time when the context is entered. */
+  mutable std::chrono::steady_clock::time_point origin_;
+  /*! \brief The stack of running passes. */
+  mutable std::vector<RunningPass> running_;
+  /*! \brief The events of the finished passes. */
+  mutable std::vector<PassProfileEvent> events_;
+};
+
+/*!
+ * \brief Managed reference class for PassProfilerNode
+ * \sa PassProfilerNode
+ */
+class PassProfiler : public PassInstrument {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param count_nodes Whether to count the IR nodes before and after each pass.
+   */
+  TVM_DLL explicit PassProfiler(bool count_nodes);
+
+  TVM_DEFINE_OBJECT_REF_METHODS(PassProfiler, PassInstrument, PassProfilerNode);
+};
+
+/*!
+ * \brief Count the IR nodes reachable from a module, e.g. expressions, statements, types and
+ * attributes. Every node is counted once even if it is shared.
+ * \param mod The module.
+ * \return The number of nodes.
+ */
+TVM_DLL int64_t CountIRNodes(const IRModule& mod);
+
+}  // namespace instrument
+}  // namespace tvm
+
+#endif  // TVM_IR_INSTRUMENT_H_
@@ -57,6 +57,7 @@
 #define TVM_IR_TRANSFORM_H_
 
 #include <tvm/ir/error.h>
+#include <tvm/ir/instrument.h>
 #include <tvm/ir/module.h>
 #include <tvm/node/container.h>
 #include <tvm/runtime/container.h>
@@ -98,6 +99,9 @@ class PassContextNode : public Object {
   Array<String> disabled_pass;
   /*! \brief Trace function to be invoked before and after each pass. */
   TraceFunc trace_func;
+  /*! \brief The instrumentations notified on entering/exiting the context and before/after each
+   *  pass. */
+  Array<instrument::PassInstrument> instruments;
 
   /*! \brief Pass specific configurations. */
   Map<String, ObjectRef> config;
@@ -138,6 +142,7 @@ class PassContextNode : public Object {
     v->Visit("opt_level", &opt_level);
     v->Visit("required_pass", &required_pass);
     v->Visit("disabled_pass", &disabled_pass);
+    v->Visit("instruments", &instruments);
     v->Visit("config", &config);
   }
 
@@ -199,6 +204,20 @@ class PassContext : public ObjectRef {
    */
   TVM_DLL void Trace(const IRModule& module, const PassInfo& info, bool is_before) const;
 
+  /*!
+   * \brief Call the RunBeforePass methods of the instrumentations of the context.
+   * \param module The IRModule that the pass runs on.
+   * \param info The pass information.
+   */
+  TVM_DLL void InstrumentBeforePass(const IRModule& module, const PassInfo& info) const;
+
+  /*!
+   * \brief Call the RunAfterPass methods of the instrumentations of the context.
+   * \param module The IRModule returned by the pass.
+   * \param info The pass information.
+   */
+  TVM_DLL void InstrumentAfterPass(const IRModule& module, const PassInfo& info) const;
+
   /*!
    * \brief Register a valid configuration option and its ValueType for validation.
    *
@@ -345,23 +364,18 @@ class Pass : public ObjectRef {
    * \return The transformed module.
    */
   IRModule operator()(IRModule mod) const {
-    const PassNode* node = operator->();
-    CHECK(node != nullptr);
-    return node->operator()(std::move(mod));
+    return this->operator()(std::move(mod), PassContext::Current());
   }
   /*!
    * \brief Transform mod using a functor under a given pass context.
+   * The instrumentations of the pass context are notified before and after the pass.
    *
    * \param mod The module that an optimization pass runs on.
    * \param pass_ctx The pass context that can provide information for the optimization.
    *
    * \return The transformed module.
    */
-  IRModule operator()(IRModule mod, const PassContext& pass_ctx) const {
-    const PassNode* node = operator->();
-    CHECK(node != nullptr);
-    return node->operator()(std::move(mod), pass_ctx);
-  }
+  TVM_DLL IRModule operator()(IRModule mod, const PassContext& pass_ctx) const;
 
   TVM_DEFINE_OBJECT_REF_METHODS(Pass, ObjectRef, PassNode);
 };
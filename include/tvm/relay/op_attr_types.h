@@ -87,6 +87,15 @@ using TNonComputational = bool;
  */
 using TShapeDataDependant = bool;
 
+/*!
+ * \brief Mark the operator whose input loading can absorb its injective producers,
+ *  e.g. pad, cast and layout_transform.
+ *
+ *  FuseOps fuses such producers into the operator when relay.FuseOps.fuse_prologue
+ *  is set, and the compile engine inlines them into the schedule of the operator.
+ */
+using TFusePrologue = bool;
+
 /*!
  * \brief Computation description interface.
  *
@@ -265,6 +265,20 @@ TVM_DLL Pass CombineParallelDense(uint64_t min_num_branches = 3, bool to_batch_m
  */
 TVM_DLL Pass CombineParallelBatchMatmul(uint64_t min_num_branches = 3);
 
+/*!
+ * \brief Combine the independent calls of the same elementwise op, pool or conv2d, which do
+ *  not depend on each other and have the same attributes and argument types, into a single
+ *  call on the inputs concatenated along the batch axis, or the channel axis for the conv2d
+ *  with different weights, if the number of them is not less than `min_num_ops` and their
+ *  outputs are small enough to be launch bound.
+ *
+ * \param min_num_ops The minimum number of ops to combine.
+ * \param max_num_elements The maximum number of output elements of a combined op.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass CombineIndependentOps(uint64_t min_num_ops = 3, int64_t max_num_elements = 16384);
+
 /*!
  * \brief Backward fold axis scaling into weights of conv/dense operators.
  *
@@ -325,6 +339,25 @@ TVM_DLL Pass AlterOpLayout();
  */
 TVM_DLL Pass ConvertLayout(const Map<String, Array<String>>& desired_layouts);
 
+/*!
+ * \brief Convert the layouts like ConvertLayout, but only convert the calls for which the
+ * conversion pays off globally. Every call of the ops in desired_layouts either keeps its layout
+ * or is converted, and the choice minimizes the total cost of the calls and of the
+ * layout_transforms inserted where the layouts of producers and consumers disagree.
+ *
+ * \param desired_layouts Specify mapping of op_name to array of desired layouts for each input,
+ *                        the same as ConvertLayout.
+ * \param op_cost The cost of a call, with signature (Call call, bool converted) -> float. It
+ *                returns None to use the default cost. Can be null.
+ * \param desired_speedup The default cost of a call is its MAC count, or its output size if it
+ *                        has no MAC count, divided by desired_speedup if it is converted.
+ * \param transform_cost_per_byte The cost of a layout_transform per byte of its input.
+ * \return The pass.
+ */
+TVM_DLL Pass PlanLayout(const Map<String, Array<String>>& desired_layouts,
+                        runtime::PackedFunc op_cost, double desired_speedup,
+                        double transform_cost_per_byte);
+
 /*!
  * \brief Legalizes an expr with another expression.
  * \param legalize_map_attr_name The Op's attr name which corresponds to the legalize rule function.
@@ -419,6 +452,14 @@ TVM_DLL Expr Bind(const Expr& expr, const tvm::Map<Var, Expr>& binds);
  */
 TVM_DLL Function InferType(const Function& f, const IRModule& mod, const GlobalVar& var);
 
+/*!
+ * \brief Check whether type inference in the current pass context is incremental, i.e., it
+ *  reuses the checked types of the subgraphs that are unchanged since the last inference.
+ *
+ * \return The "incremental" field of the "relay.InferType" pass config option.
+ */
+TVM_DLL bool IsIncrementalTypeInference();
+
 /*!
  * \brief Apply rewrite rules to rewrite the expr in post DFS order. This
  * function is used as a helper function to rewrtie an expression in a pass.
@@ -55,17 +55,23 @@ TVM_DLL std::vector<std::vector<int>> rr_partitioner(int begin, int end, int ste
  *   parallel_for(0, 10, [&a](int index) {
  *     a[i] = i;
  *   });
+ * The loop runs on a persistent pool of compiler-side threads together with the calling thread.
  * \param begin The start index of this parallel loop(inclusive).
  * \param end The end index of this parallel loop(exclusive).
  * \param f The task function to be excuted. Assert to take an int index as input with no output.
  * \param step The traversal step to the index.
- * \param partitioner A partition function to split tasks to different threads. Use Round-robin
- * partitioner by default.
- * \note 1. Currently do not support nested parallel_for; 2. The order of execution in each thread
- * is not guaranteed, the for loop task should be thread independent and thread safe.
+ * \param partitioner A partition function to split tasks to different threads. If not given, the
+ * loop is split into small chunks that are claimed dynamically by idle threads, which balances
+ * iterations with uneven cost. The environment variable TVM_PARALLEL_FOR_STATIC=1 selects
+ * rr_partitioner instead, for benchmarking.
+ * \note 1. A nested parallel_for (called inside the task function) runs inline in the calling
+ * thread; 2. The first exception thrown by the task function is rethrown to the caller after the
+ * other running iterations finish, and the remaining iterations are skipped; 3. The order of
+ * execution in each thread is not guaranteed, the for loop task should be thread independent and
+ * thread safe.
  */
 TVM_DLL void parallel_for(int begin, int end, const std::function<void(int)>& f, int step = 1,
-                          const PartitionerFuncType partitioner = rr_partitioner);
+                          const PartitionerFuncType partitioner = nullptr);
 
 }  // namespace support
 }  // namespace tvm
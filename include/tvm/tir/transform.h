@@ -145,6 +145,16 @@ TVM_DLL Pass InjectDoubleBuffer();
  */
 TVM_DLL Pass StorageRewrite();
 
+/*!
+ * \brief Insert software prefetch for the loads of the innermost loops
+ *  that move by at least a cache line per iteration.
+ *  The prefetch distance comes from the pass config tir.InsertPrefetch,
+ *  and from the pragma prefetch_distance of the enclosing loops.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass InsertPrefetch();
+
 /*!
  * \brief unroll the constant loop marked by unroll.
  * This pass also automatically attach pragma unroll tag to loops which meets the standard.
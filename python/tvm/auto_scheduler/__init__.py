@@ -24,11 +24,13 @@ from . import loop_state
 from . import utils
 from . import workload_registry
 from . import feature
+from . import tuning_database
+from . import task_scheduler
 
 # Shortcut
 from .auto_schedule import SearchTask, TuningOptions, HardwareParams, create_task, auto_schedule
 from .compute_dag import ComputeDAG
-from .cost_model import RandomModel, XGBModel
+from .cost_model import RandomModel, XGBModel, GBDTModel
 from .measure import (
     MeasureInput,
     MeasureResult,
@@ -38,5 +40,12 @@ from .measure import (
     LocalRPCMeasureContext,
 )
 from .measure_record import RecordToFile, RecordReader, load_best, load_records, save_records
-from .search_policy import EmptyPolicy, SketchPolicy, PreloadMeasuredStates
+from .search_policy import (
+    EmptyPolicy,
+    SketchPolicy,
+    PreloadMeasuredStates,
+    PreloadTransferredStates,
+)
+from .task_scheduler import TaskScheduler
+from .tuning_database import TuningDatabase
 from .workload_registry import register_workload, make_workload_key
@@ -18,4 +18,5 @@
 """ Cost model that estimates the performance of programs """
 
 from .cost_model import RandomModel
+from .gbdt_model import GBDTModel
 from .xgb_model import XGBModel
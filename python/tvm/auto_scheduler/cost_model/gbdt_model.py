@@ -0,0 +1,163 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""Cost model based on gradient boosted decision trees implemented in C++"""
+import tvm._ffi
+
+from .cost_model import CostModel
+from .. import _ffi_api
+from ..feature import DEFAULT_MAX_N_BUFS
+
+
+@tvm._ffi.register_object("auto_scheduler.GBDTModel")
+class GBDTModel(CostModel):
+    """Train gradient boosted decision trees to predict the normalized throughputs of programs.
+
+    This model uses the same pack-sum formulation as :any:`XGBModel`, but the training and
+    the prediction run entirely in C++. There is no python round trip or feature serialization
+    during the search, and the model is updated incrementally: new trees are boosted on top
+    of the existing ones, and the model is only retrained from scratch when the number of
+    collected samples doubles.
+
+    Parameters
+    ----------
+    max_depth : int = 10
+        The maximum depth of a tree.
+    learning_rate : float = 0.2
+        The shrinkage applied to the leaf values of every new tree.
+    reg_lambda : float = 1.0
+        The L2 regularization on leaf values.
+    gamma : float = 0.001
+        The minimum loss reduction required to make a split.
+    min_child_weight : float = 0.0
+        The minimum sum of hessian required in a child.
+    num_boost_round : int = 300
+        The maximum number of boosting rounds when training from scratch.
+    num_incremental_round : int = 30
+        The maximum number of boosting rounds appended by an incremental update.
+    early_stopping_rounds : int = 50
+        Stop boosting if the training loss does not improve in this number of rounds.
+    max_bin : int = 64
+        The maximum number of histogram bins for each feature. Must be at most 256.
+    num_warmup_sample : int = 100
+        Predict random scores until more than this number of samples are collected.
+    seed : Optional[int]
+        The random seed.
+    """
+
+    def __init__(
+        self,
+        max_depth=10,
+        learning_rate=0.2,
+        reg_lambda=1.0,
+        gamma=0.001,
+        min_child_weight=0.0,
+        num_boost_round=300,
+        num_incremental_round=30,
+        early_stopping_rounds=50,
+        max_bin=64,
+        num_warmup_sample=100,
+        seed=None,
+    ):
+        self.__init_handle_by_constructor__(
+            _ffi_api.GBDTModel,
+            max_depth,
+            learning_rate,
+            reg_lambda,
+            gamma,
+            min_child_weight,
+            num_boost_round,
+            num_incremental_round,
+            early_stopping_rounds,
+            max_bin,
+            num_warmup_sample,
+            DEFAULT_MAX_N_BUFS,
+            seed or 43,
+        )
+
+    def update(self, inputs, results):
+        """Update the cost model according to new measurement results (training data).
+
+        Parameters
+        ----------
+        inputs : List[auto_scheduler.measure.MeasureInput]
+            The measurement inputs
+        results : List[auto_scheduler.measure.MeasureResult]
+            The measurement results
+        """
+        _ffi_api.CostModelUpdate(self, inputs, results)
+
+    def predict(self, search_task, states):
+        """Predict the scores of states
+
+        Parameters
+        ----------
+        search_task : SearchTask
+            The search task of states
+        states : List[State]
+            The input states
+
+        Returns
+        -------
+        scores: List[float]
+            The predicted scores for all states
+        """
+        return [x.value for x in _ffi_api.CostModelPredict(self, search_task, states)]
+
+    def update_from_file(self, file_name, n_lines=None):
+        """Load measure records from a log file to update the cost model.
+        This function can be used to pre-train the cost model with history log files.
+
+        Parameters
+        ----------
+        file_name: str
+            The filename
+        n_lines: Optional[int]
+            Only load first n lines of the log file
+        """
+        _ffi_api.GBDTModelUpdateFromFile(self, file_name, n_lines or -1)
+
+    def save(self, file_name: str):
+        """Save the model to a file
+
+        Parameters
+        ----------
+        file_name: str
+            The filename
+        """
+        _ffi_api.GBDTModelSave(self, file_name)
+
+    def load(self, file_name: str):
+        """Load the model from a file. Later updates keep boosting on top of the loaded model,
+        until the samples collected after the load double and the model is retrained.
+
+        Parameters
+        ----------
+        file_name: str
+            The filename
+        """
+        _ffi_api.GBDTModelLoad(self, file_name)
+
+    def num_trees(self):
+        """The number of boosted trees of the model
+
+        Returns
+        -------
+        num_trees: int
+            The number of trees
+        """
+        return _ffi_api.GBDTModelNumTrees(self)
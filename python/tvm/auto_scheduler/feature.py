@@ -256,3 +256,32 @@ def get_per_store_feature_names(max_n_bufs: Optional[int] = None) -> List[str]:
         The names of elements in the flatten feature vector
     """
     return _ffi_api.GetPerStoreFeatureNames(max_n_bufs or DEFAULT_MAX_N_BUFS)
+
+
+def set_per_store_feature_cache_capacity(capacity: int):
+    """Set the capacity of the global per-store feature cache.
+
+    The features extracted by :any:`get_per_store_features_from_states` are memorized by the
+    search task and the transform steps of the states, so states that are evaluated again
+    (e.g., during evolutionary search) skip the lowering and feature extraction.
+
+    Parameters
+    ----------
+    capacity: int
+        The maximum number of cached states. 0 disables the cache.
+    """
+    _ffi_api.SetPerStoreFeatureCacheCapacity(capacity)
+
+
+def get_per_store_feature_cache_stats() -> Tuple[int, int]:
+    """Get the statistics of the global per-store feature cache.
+
+    Returns
+    -------
+    hit_ct: int
+        The number of cache hits
+    miss_ct: int
+        The number of cache misses
+    """
+    hit_ct, miss_ct = _ffi_api.GetPerStoreFeatureCacheStats()
+    return hit_ct.value, miss_ct.value
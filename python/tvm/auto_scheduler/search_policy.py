@@ -59,6 +59,25 @@ class PreloadMeasuredStates(SearchCallback):
         self.__init_handle_by_constructor__(_ffi_api.PreloadMeasuredStates, filename)
 
 
+@tvm._ffi.register_object("auto_scheduler.PreloadTransferredStates")
+class PreloadTransferredStates(SearchCallback):
+    """A SearchCallback to warm start a search policy with states tuned for similar workloads.
+
+    The transform steps of the states are replayed on the task of the search policy. States that
+    do not fit the task are dropped. The others are used as starting points of the search and
+    are measured on the task like any other candidate.
+
+    Parameters
+    ----------
+    states : List[Union[State, StateObject]]
+        The states of other tasks.
+    """
+
+    def __init__(self, states):
+        states = [s if not hasattr(s, "state_object") else s.state_object for s in states]
+        self.__init_handle_by_constructor__(_ffi_api.PreloadTransferredStates, states)
+
+
 @tvm._ffi.register_object("auto_scheduler.SearchPolicy")
 class SearchPolicy(Object):
     """ The base class of search policies. """
@@ -107,6 +126,7 @@ class SketchPolicy(SearchPolicy):
         Possible callbacks:
 
           - auto_scheduler.PreloadMeasuredStates
+          - auto_scheduler.PreloadTransferredStates
           - auto_scheduler.PreloadCustomSketchRule
 
         TODO(jcf94): Add these search callback implementations.
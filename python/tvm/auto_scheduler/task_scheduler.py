@@ -0,0 +1,118 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""
+The task scheduler that allocates the tuning budget across the tasks of a whole network.
+
+A network is split into several SearchTasks. Instead of tuning every task with a fixed number of
+trials, the task scheduler tunes the tasks round by round. In each round, it picks the task whose
+tuning is expected to reduce the end-to-end latency (the sum of weight * latency of all tasks)
+the most, where the weight of a task is the number of its occurrences in the network.
+
+Reference:
+L. Zheng, C. Jia, M. Sun, Z. Wu, C. Yu, et al. "Ansor : Generating High-Performance Tensor
+Programs for Deep Learning." arXiv preprint arXiv:2006.06762 (2020).
+"""
+
+import tvm._ffi
+from tvm.runtime import Object
+from .auto_schedule import TuningOptions
+from .cost_model import XGBModel
+from .search_policy import SketchPolicy
+from . import _ffi_api
+
+
+@tvm._ffi.register_object("auto_scheduler.TaskScheduler")
+class TaskScheduler(Object):
+    """Tune the tasks of a network with a shared measurement budget.
+
+    Parameters
+    ----------
+    tasks : List[SearchTask]
+        All tasks of the network.
+    task_weights : Optional[List[float]]
+        The weight of each task, i.e., the number of its occurrences in the network.
+        All tasks have the same weight if it is None.
+    search_policies : Optional[List[SearchPolicy]]
+        The search policy of each task. If it is None, a SketchPolicy with an XGBModel is
+        created for each task.
+    strategy : str = "gradient"
+        The strategy to pick the next task.
+
+          - "gradient": pick the task with the largest estimated end-to-end latency reduction.
+          - "round-robin": tune the tasks in turn.
+    alpha : float = 0.2
+        The weight of the backward gradient (the improvement of the last rounds) against the
+        forward gradient (the expected improvement of the next round).
+    backward_window_size : int = 3
+        The number of rounds used to compute the backward gradient.
+    early_stopping_per_task : Optional[int]
+        Stop tuning a task if getting no improvement after n measurements of this task.
+    verbose : int = 1
+        Verbosity level of the default search policies.
+    """
+
+    def __init__(
+        self,
+        tasks,
+        task_weights=None,
+        search_policies=None,
+        strategy="gradient",
+        alpha=0.2,
+        backward_window_size=3,
+        early_stopping_per_task=None,
+        verbose=1,
+    ):
+        if task_weights is not None and len(task_weights) != len(tasks):
+            raise ValueError("The number of task weights should be equal to the number of tasks")
+        if search_policies is None:
+            search_policies = [SketchPolicy(task, XGBModel(), verbose=verbose) for task in tasks]
+
+        self.__init_handle_by_constructor__(
+            _ffi_api.TaskScheduler,
+            tasks,
+            search_policies,
+            [float(x) for x in task_weights] if task_weights is not None else [],
+            strategy,
+            alpha,
+            backward_window_size,
+            early_stopping_per_task if early_stopping_per_task is not None else -1,
+        )
+
+    def tune(self, tuning_options=TuningOptions()):
+        """Tune all tasks.
+
+        Parameters
+        ----------
+        tuning_options : TuningOptions
+            Tuning and measurement options. `num_measure_trials` is the total number of trials of
+            all tasks, and `early_stopping` stops the tuning if the end-to-end latency is not
+            improved after n measurements.
+            Use `auto_scheduler.RecordToFile` in `measure_callbacks` and `auto_scheduler.load_best`
+            to get the best schedule of each task after tuning.
+        """
+        _ffi_api.TaskSchedulerTune(self, tuning_options)
+
+    @property
+    def best_costs(self):
+        """The best latency (in seconds) of each task found by the last tuning."""
+        return [x.value for x in _ffi_api.TaskSchedulerGetBestCosts(self)]
+
+    @property
+    def task_trials(self):
+        """The number of measured programs of each task in the last tuning."""
+        return [x.value for x in _ffi_api.TaskSchedulerGetTaskTrials(self)]
@@ -0,0 +1,316 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""
+A local tuning database shared across tuning runs, with cross-workload warm start.
+
+The measurement records of all runs are stored in a SQLite file, indexed by the workload and
+the target. When a new task is tuned, the records of similar workloads (the same compute
+function with nearby arguments, e.g. conv2d with slightly different shapes) are used to
+
+  - pre-train the cost model, and
+  - seed the initial population of :any:`SketchPolicy` through
+    :any:`PreloadTransferredStates`.
+"""
+
+import json
+import logging
+import math
+import sqlite3
+
+import numpy as np
+
+from .measure import MeasureErrorNo
+from .measure_record import RecordReader
+from .search_policy import PreloadTransferredStates
+from .workload_registry import WORKLOAD_FUNC_REGISTRY
+from . import _ffi_api
+
+logger = logging.getLogger("auto_scheduler")
+
+
+def _parse_workload_key(workload_key):
+    """Split a workload key into the function name and the flattened arguments."""
+    try:
+        workload = json.loads(workload_key)
+    except ValueError:
+        return workload_key, []
+    if not isinstance(workload, list) or not workload or not isinstance(workload[0], str):
+        return workload_key, []
+
+    def flatten(args, out):
+        for arg in args:
+            if isinstance(arg, (list, tuple)):
+                flatten(arg, out)
+            else:
+                out.append(arg)
+        return out
+
+    return workload[0], flatten(workload[1:], [])
+
+
+def workload_distance(args_a, args_b):
+    """The distance between the arguments of two workloads of the same function.
+
+    The distance is the mean absolute log2 ratio of the numeric arguments.
+    Non-numeric arguments (e.g., layouts and dtypes) must be equal.
+
+    Parameters
+    ----------
+    args_a : List
+        The flattened arguments of the first workload.
+    args_b : List
+        The flattened arguments of the second workload.
+
+    Returns
+    -------
+    distance : float
+        The distance. `inf` if the two workloads are not comparable.
+    """
+    if len(args_a) != len(args_b):
+        return float("inf")
+    diffs = []
+    for a, b in zip(args_a, args_b):
+        numeric_a = isinstance(a, (int, float)) and not isinstance(a, bool)
+        numeric_b = isinstance(b, (int, float)) and not isinstance(b, bool)
+        if numeric_a and numeric_b:
+            if a == b:
+                diffs.append(0.0)
+            elif a > 0 and b > 0:
+                diffs.append(abs(math.log2(a / b)))
+            else:
+                return float("inf")
+        elif a != b:
+            return float("inf")
+    return float(np.mean(diffs)) if diffs else 0.0
+
+
+class TuningDatabase:
+    """A local database of auto_scheduler measurement records backed by SQLite.
+
+    Parameters
+    ----------
+    path : str = "auto_scheduler_tuning.db"
+        The file of the database. It is created if it does not exist.
+    """
+
+    def __init__(self, path="auto_scheduler_tuning.db"):
+        self.path = path
+        self.conn = sqlite3.connect(path)
+        self.conn.execute(
+            "CREATE TABLE IF NOT EXISTS records ("
+            "  workload_key TEXT NOT NULL,"
+            "  func_name TEXT NOT NULL,"
+            "  args TEXT NOT NULL,"
+            "  target TEXT NOT NULL,"
+            "  target_kind TEXT NOT NULL,"
+            "  cost REAL NOT NULL,"
+            "  record TEXT NOT NULL UNIQUE)"
+        )
+        self.conn.execute(
+            "CREATE INDEX IF NOT EXISTS records_workload ON records (workload_key, target)"
+        )
+        self.conn.execute(
+            "CREATE INDEX IF NOT EXISTS records_func ON records (func_name, target_kind)"
+        )
+        self.conn.commit()
+
+    def close(self):
+        """Close the database."""
+        self.conn.close()
+
+    def __len__(self):
+        return self.conn.execute("SELECT COUNT(*) FROM records").fetchone()[0]
+
+    def add(self, inputs, results):
+        """Add measurement records. Failed measurements and duplicated records are skipped.
+
+        Parameters
+        ----------
+        inputs : List[MeasureInput]
+            The measurement inputs.
+        results : List[MeasureResult]
+            The measurement results.
+
+        Returns
+        -------
+        count : int
+            The number of added records.
+        """
+        rows = []
+        for inp, res in zip(inputs, results):
+            if res.error_no != MeasureErrorNo.NO_ERROR:
+                continue
+            workload_key = str(inp.task.workload_key)
+            func_name, args = _parse_workload_key(workload_key)
+            target = inp.task.target
+            rows.append(
+                (
+                    workload_key,
+                    func_name,
+                    json.dumps(args),
+                    str(target),
+                    target.kind.name,
+                    float(np.mean([x.value for x in res.costs])),
+                    str(_ffi_api.SerializeMeasureRecord(inp, res)),
+                )
+            )
+        before = self.conn.total_changes
+        self.conn.executemany("INSERT OR IGNORE INTO records VALUES (?, ?, ?, ?, ?, ?, ?)", rows)
+        self.conn.commit()
+        return self.conn.total_changes - before
+
+    def add_from_file(self, filename):
+        """Add all records of a log file.
+
+        Parameters
+        ----------
+        filename : str
+            The log file.
+
+        Returns
+        -------
+        count : int
+            The number of added records.
+        """
+        inputs, results = RecordReader(filename).read_lines()
+        return self.add(inputs, results)
+
+    @staticmethod
+    def _decode(rows):
+        inputs, results = [], []
+        for (record,) in rows:
+            inp, res = _ffi_api.DeserializeMeasureRecord(record)
+            inputs.append(inp)
+            results.append(res)
+        return inputs, results
+
+    def query(self, task, top_k=None):
+        """Get the best records of exactly the same workload and target.
+
+        Parameters
+        ----------
+        task : SearchTask
+            The task to query.
+        top_k : Optional[int]
+            Only return the k fastest records.
+
+        Returns
+        -------
+        inputs : List[MeasureInput]
+            The measurement inputs, ordered from the fastest.
+        results : List[MeasureResult]
+            The measurement results.
+        """
+        rows = self.conn.execute(
+            "SELECT record FROM records WHERE workload_key = ? AND target = ? "
+            "ORDER BY cost LIMIT ?",
+            (str(task.workload_key), str(task.target), top_k if top_k is not None else -1),
+        ).fetchall()
+        return self._decode(rows)
+
+    def query_similar(self, task, max_distance=1.0, max_workloads=4, top_k_per_workload=32):
+        """Get the best records of workloads similar to the task on the same kind of target.
+
+        Two workloads are similar if they come from the same compute function and
+        :any:`workload_distance` between their arguments is at most `max_distance`.
+        Records of the task's own workload are not returned, use :any:`query` for them.
+
+        Parameters
+        ----------
+        task : SearchTask
+            The task to query.
+        max_distance : float = 1.0
+            The maximum workload distance. 1.0 allows, e.g., every dimension to be up to twice
+            as large or as small on average.
+        max_workloads : int = 4
+            The maximum number of similar workloads to use, the nearest first.
+        top_k_per_workload : int = 32
+            The number of fastest records returned for each similar workload.
+
+        Returns
+        -------
+        inputs : List[MeasureInput]
+            The measurement inputs.
+        results : List[MeasureResult]
+            The measurement results.
+        """
+        workload_key = str(task.workload_key)
+        func_name, args = _parse_workload_key(workload_key)
+        candidates = self.conn.execute(
+            "SELECT DISTINCT workload_key, args FROM records "
+            "WHERE func_name = ? AND target_kind = ? AND workload_key != ?",
+            (func_name, task.target.kind.name, workload_key),
+        ).fetchall()
+
+        neighbors = []
+        for key, other_args in candidates:
+            distance = workload_distance(args, json.loads(other_args))
+            if distance <= max_distance:
+                neighbors.append((distance, key))
+        neighbors.sort()
+
+        inputs, results = [], []
+        for _, key in neighbors[:max_workloads]:
+            rows = self.conn.execute(
+                "SELECT record FROM records WHERE workload_key = ? AND target_kind = ? "
+                "ORDER BY cost LIMIT ?",
+                (key, task.target.kind.name, top_k_per_workload),
+            ).fetchall()
+            new_inputs, new_results = self._decode(rows)
+            inputs.extend(new_inputs)
+            results.extend(new_results)
+        return inputs, results
+
+    def warm_start(self, task, cost_model=None, **query_kwargs):
+        """Warm start the tuning of a task with the records of similar workloads.
+
+        Parameters
+        ----------
+        task : SearchTask
+            The task to be tuned.
+        cost_model : Optional[CostModel]
+            If given, the cost model is pre-trained with the records of similar workloads whose
+            compute functions are registered in this process.
+        query_kwargs : Dict
+            The arguments passed to :any:`query_similar`.
+
+        Returns
+        -------
+        callbacks : List[SearchCallback]
+            The callbacks to pass as `init_search_callbacks` of :any:`SketchPolicy`.
+        """
+        inputs, results = self.query_similar(task, **query_kwargs)
+        if not inputs:
+            return []
+        logger.info(
+            "TuningDatabase: Warm start %s with %d records of similar workloads",
+            task.workload_key,
+            len(inputs),
+        )
+
+        if cost_model is not None:
+            # Features of other workloads are extracted from their own compute DAGs
+            train_pairs = [
+                (inp, res)
+                for inp, res in zip(inputs, results)
+                if _parse_workload_key(str(inp.task.workload_key))[0] in WORKLOAD_FUNC_REGISTRY
+            ]
+            if train_pairs:
+                cost_model.update([x[0] for x in train_pairs], [x[1] for x in train_pairs])
+
+        return [PreloadTransferredStates([inp.state for inp in inputs])]
@@ -185,6 +185,7 @@ def lower(sch, args, name="main", binds=None, simple_mode=False):
         tvm.tir.transform.InjectVirtualThread(),
         tvm.tir.transform.InjectDoubleBuffer(),
         tvm.tir.transform.StorageRewrite(),
+        tvm.tir.transform.InsertPrefetch(),
         tvm.tir.transform.UnrollLoop(),
     ]
     pass_list += lower_phase2
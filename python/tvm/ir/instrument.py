@@ -0,0 +1,170 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Common pass instrumentation across IR variants.
+
+Instrumentations are attached to a :py:class:`tvm.transform.PassContext` and are notified when
+the context is entered and exited, and before and after every pass run in the context:
+
+.. code-block:: python
+
+    profiler = tvm.instrument.PassProfiler()
+    with tvm.transform.PassContext(opt_level=3, instruments=[profiler]):
+        lib = relay.build(mod, target="llvm", params=params)
+    print(profiler.render())
+    profiler.save_chrome_trace("passes.json")
+"""
+import tvm._ffi
+import tvm.runtime
+
+from . import _ffi_instrument_api
+
+
+@tvm._ffi.register_object("instrument.PassInstrument")
+class PassInstrument(tvm.runtime.Object):
+    """The base class of pass instrumentations.
+
+    Subclass it and override any of `enter_pass_ctx`, `exit_pass_ctx`, `run_before_pass` and
+    `run_after_pass`. Only the overridden methods are called.
+
+    Parameters
+    ----------
+    name : Optional[str]
+        The name of the instrumentation, defaults to the class name.
+    """
+
+    def __init__(self, name=None):
+        cls = type(self)
+
+        def callback(method):
+            if getattr(cls, method) is getattr(PassInstrument, method):
+                return None
+            return getattr(self, method)
+
+        self.__init_handle_by_constructor__(
+            _ffi_instrument_api.PassInstrument,
+            name or cls.__name__,
+            callback("enter_pass_ctx"),
+            callback("exit_pass_ctx"),
+            callback("run_before_pass"),
+            callback("run_after_pass"),
+        )
+
+    def enter_pass_ctx(self):
+        """Called when entering the pass context."""
+
+    def exit_pass_ctx(self):
+        """Called when exiting the pass context."""
+
+    def run_before_pass(self, mod, info):
+        """Called before a pass runs.
+
+        Parameters
+        ----------
+        mod : tvm.IRModule
+            The module that the pass runs on.
+        info : tvm.transform.PassInfo
+            The pass information.
+        """
+
+    def run_after_pass(self, mod, info):
+        """Called after a pass runs.
+
+        Parameters
+        ----------
+        mod : tvm.IRModule
+            The module returned by the pass.
+        info : tvm.transform.PassInfo
+            The pass information.
+        """
+
+
+@tvm._ffi.register_object("instrument.PassProfiler")
+class PassProfiler(PassInstrument):
+    """A built-in instrumentation that records the wall time, the increase of the peak resident
+    set size of the process and the IR node counts before and after each pass, including the
+    passes nested in a Sequential.
+
+    Parameters
+    ----------
+    count_nodes : bool = True
+        Whether to count the IR nodes before and after each pass. It traverses the whole module
+        twice per pass, disable it to profile large models faster.
+    """
+
+    def __init__(self, count_nodes=True):  # pylint: disable=super-init-not-called
+        self.__init_handle_by_constructor__(_ffi_instrument_api.PassProfiler, count_nodes)
+
+    @property
+    def events(self):
+        """The profile of each finished pass, in the order of their ends.
+
+        Returns
+        -------
+        events : List[Dict[str, Union[str, int, float]]]
+            The name, the nesting depth, the start time and the wall time in microseconds, the
+            peak RSS increase in KB, and the IR node counts before and after (-1 if not counted)
+            of each pass.
+        """
+        events = []
+        for event in _ffi_instrument_api.PassProfilerGetEvents(self):
+            events.append(
+                {
+                    "name": str(event["name"]),
+                    "depth": event["depth"].value,
+                    "start_us": event["start_us"].value,
+                    "duration_us": event["duration_us"].value,
+                    "peak_rss_delta_kb": event["peak_rss_delta_kb"].value,
+                    "nodes_before": event["nodes_before"].value,
+                    "nodes_after": event["nodes_after"].value,
+                }
+            )
+        return events
+
+    def render(self):
+        """Render the profile as a table, with the nested passes indented.
+
+        Returns
+        -------
+        table : str
+            The table.
+        """
+        return str(_ffi_instrument_api.PassProfilerRender(self))
+
+    def as_chrome_trace(self):
+        """Dump the profile in the Chrome trace event format.
+
+        Returns
+        -------
+        trace : str
+            The JSON string, which can be loaded in chrome://tracing or https://ui.perfetto.dev.
+        """
+        return str(_ffi_instrument_api.PassProfilerAsChromeTrace(self))
+
+    def save_chrome_trace(self, path):
+        """Save the profile in the Chrome trace event format.
+
+        Parameters
+        ----------
+        path : str
+            The output file.
+        """
+        with open(path, "w") as f:
+            f.write(self.as_chrome_trace())
+
+    def reset(self):
+        """Clear the recorded profile."""
+        _ffi_instrument_api.PassProfilerReset(self)
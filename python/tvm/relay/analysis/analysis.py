@@ -402,6 +402,30 @@ def search_fc_transpose(expr):
     return ret
 
 
+def estimate_compiler_regions(expr, cost_model=None):
+    """Estimate the costs of the compiler regions of an annotated expression, i.e. the
+    partition report of PruneCompilerRegions.
+
+    Parameters
+    ----------
+    expr : tvm.relay.Expr
+        The type checked expression after MergeCompilerRegions.
+
+    cost_model : Optional[tvm.relay.transform.RegionCostModel]
+        The cost model, a default RegionCostModel if it is None.
+
+    Returns
+    -------
+    estimates : List[CompilerRegionEstimate]
+        The estimate of every region that is not on the host, ordered by the region ID, with
+        the number of ops, the host and target costs, the number of transfers and bytes moved
+        per run, and whether the region is kept on its target.
+    """
+    if cost_model is None:
+        cost_model = transform.RegionCostModel()
+    return list(_ffi_api.EstimateCompilerRegions(expr, cost_model))
+
+
 def get_calibration_data(mod, data):
     """Get the calibration data of a given relay graph
 
@@ -113,6 +113,16 @@ def vsi_npu_pattern_table():
         pattern = pattern.optional(lambda x: (is_op("nn.bias_add")(x, is_constant()) | is_op("add")(x, is_constant())))
         return pattern
 
+    def check_conv(extract):
+        """Check that the float convolution runs in float32 or float16, the convolutions of
+        other precisions, e.g. the int16 layers of a mixed-precision quantized model, stay on
+        the CPU."""
+        call = extract
+        while call.op.name != "nn.conv2d":
+            call = call.args[0]
+        dtypes = {call.args[0].checked_type.dtype, call.args[1].checked_type.dtype}
+        return len(dtypes) == 1 and dtypes.pop() in ("float32", "float16")
+
     def qnn_conv_pattern():
         """Create a quantized convolution pattern.
 
@@ -187,7 +197,7 @@ def vsi_npu_pattern_table():
     vsi_npu_patterns = [
             ("vsi_npu.dense", dense_pattern()),
             ("vsi_npu.max_pool2d", max_pool2d_pattern()),
-            ("vsi_npu.conv2d", conv_pattern()),
+            ("vsi_npu.conv2d", conv_pattern(), check_conv),
             ("vsi_npu.qnn_dense", qnn_dense_pattern()),
             ("vsi_npu.qnn_conv2d", qnn_conv_pattern()),
             ("vsi_npu.qnn_softmax", qnn_softmax_pattern()),
@@ -2027,6 +2027,41 @@ def sparse_dense(data, weight):
     return _make.sparse_dense(data, weight.data, weight.indices, weight.indptr)
 
 
+def sparse_conv2d(data, weight, layout="NHWC", kernel_size=1):
+    r"""
+    Computes the 2D convolution of `data` with a block sparse `weight`, where `weight` is
+    a BSR namedtuple with fields `data`, `indices`, and `indptr`. The 1x1 kernel has
+    stride 1 and no padding, the 3x3 kernel has stride 1 and padding 1.
+
+    The weight is the convolution kernel as a matrix of shape
+    [out_channels, in_channels * kernel_size * kernel_size], its columns are ordered as
+    (in_channels, kh, kw) for the NCHW layout, and as (kh, kw, in_channels) for the NHWC
+    layout.
+
+    Parameters
+    ----------
+    data : tvm.relay.Expr
+        The input data for the convolution, 4-D in the layout `layout`.
+
+    weight : namedtuple.
+        The sparse weight matrix of the convolution.
+
+    layout : str, optional
+        Layout of the input data, "NHWC" or "NCHW".
+
+    kernel_size : int, optional
+        The size of the square kernel, 1 or 3.
+
+    Returns
+    -------
+    result: tvm.relay.Expr
+        The computed result.
+    """
+    return _make.sparse_conv2d(
+        data, weight.data, weight.indices, weight.indptr, layout, kernel_size
+    )
+
+
 def sparse_transpose(x):
     r"""
     Computes the fast matrix transpose of x,
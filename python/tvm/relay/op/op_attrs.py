@@ -509,6 +509,11 @@ class SparseDenseAttrs(Attrs):
     """Attributes used in sparse_dense operators"""
 
 
+@tvm._ffi.register_object("relay.attrs.SparseConv2DAttrs")
+class SparseConv2DAttrs(Attrs):
+    """Attributes used in sparse_conv2d operators"""
+
+
 @tvm._ffi.register_object("relay.attrs.SparseToDenseAttrs")
 class SparseToDenseAttrs(Attrs):
     """Attributes used in sparse_to_dense operators"""
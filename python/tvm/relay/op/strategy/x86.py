@@ -111,6 +111,28 @@ def conv2d_strategy_cpu(attrs, inputs, out_type, target):
                     wrap_topi_schedule(topi.x86.schedule_conv2d_nchw),
                     name="conv2d_nchw.x86",
                 )
+            _, in_channel, _, _ = get_const_tuple(data.shape)
+            _, _, kh, kw = get_const_tuple(kernel.shape)
+            stride_h, stride_w = get_const_tuple(attrs.strides)
+            if (
+                kh == 3
+                and kw == 3
+                and stride_h == 1
+                and stride_w == 1
+                and dilation_h == 1
+                and dilation_w == 1
+                and data.dtype in ("uint8", "int8")
+                and kernel.dtype == "int8"
+                and out_type.dtype == "int32"
+                and isinstance(in_channel, int)
+                and in_channel <= topi.x86.winograd_int8_max_in_channel(data.dtype, kernel.dtype)
+            ):
+                strategy.add_implementation(
+                    wrap_compute_conv2d(topi.x86.conv2d_nchw_winograd_int8),
+                    wrap_topi_schedule(topi.x86.schedule_conv2d_nchw_winograd_int8),
+                    name="conv2d_nchw_winograd_int8.x86",
+                    plevel=5,
+                )
         elif _NCHWc_matcher.match(layout):  # check if layout is NCHWxc
             assert _OIHWio_matcher.match(kernel_layout)  # check if kernel is OIHWio
             return conv2d_NCHWc_strategy_cpu(attrs, inputs, out_type, target)
@@ -122,6 +144,26 @@ def conv2d_strategy_cpu(attrs, inputs, out_type, target):
                 wrap_topi_schedule(topi.x86.schedule_conv2d_nhwc),
                 name="conv2d_nhwc.x86",
             )
+            kh, kw, in_channel, num_filter = get_const_tuple(kernel.shape)
+            if (
+                kh == 1
+                and kw == 1
+                and all(p == 0 for p in get_const_tuple(attrs.padding))
+                and _is_int8_gemm_supported(
+                    data.dtype,
+                    kernel.dtype,
+                    out_type.dtype,
+                    get_const_tuple(data.shape)[2],
+                    num_filter,
+                    in_channel,
+                )
+            ):
+                strategy.add_implementation(
+                    wrap_compute_conv2d(topi.x86.conv2d_nhwc_1x1_int8),
+                    wrap_topi_schedule(topi.x86.schedule_conv2d_nhwc_1x1_int8),
+                    name="conv2d_nhwc_1x1_int8.x86",
+                    plevel=15,
+                )
         elif layout == "HWCN":
             assert kernel_layout == "HWIO"
             logger.warning("conv2d HWCN layout is not optimized for x86.")
@@ -207,6 +249,33 @@ def conv2d_NCHWc_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+@conv2d_winograd_without_weight_transfrom_strategy.register("cpu")
+def conv2d_winograd_without_weight_transfrom_strategy_cpu(attrs, inputs, out_type, target):
+    """conv2d_winograd_without_weight_transfrom x86 strategy"""
+    dilation = attrs.get_int_tuple("dilation")
+    groups = attrs.get_int("groups")
+    layout = attrs.data_layout
+    strides = attrs.get_int_tuple("strides")
+    data, kernel = inputs
+    assert dilation == (1, 1), "Do not support dilate now"
+    assert strides == (1, 1), "Do not support strides now"
+    assert groups == 1, "Do not supoort arbitrary group number"
+    strategy = _op.OpStrategy()
+    if layout == "NCHW" and len(kernel.shape) == 5 and data.dtype in ("uint8", "int8"):
+        # kernel is pre-transformed by the int16 winograd weight transform
+        strategy.add_implementation(
+            wrap_compute_conv2d(topi.x86.conv2d_nchw_winograd_int8),
+            wrap_topi_schedule(topi.x86.schedule_conv2d_nchw_winograd_int8),
+            name="conv2d_nchw_winograd_int8.x86",
+        )
+    else:
+        raise RuntimeError(
+            "Unsupported conv2d_winograd_without_weight_transfrom layout {} "
+            "and data type {}".format(layout, data.dtype)
+        )
+    return strategy
+
+
 @depthwise_conv2d_NCHWc_strategy.register("cpu")
 def depthwise_conv2d_NCHWc_strategy_cpu(attrs, inputs, out_type, target):
     """depthwise_conv2d x86 strategy"""
@@ -302,6 +371,21 @@ def conv1d_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+def _is_int8_gemm_supported(data_dtype, weight_dtype, out_dtype, m, n, k):
+    """Whether the uint8 x int8 GEMM of m rows, n columns and k reduction elements
+    can use the int8 dot product microkernel of the target"""
+    int32_lanes = topi.x86.get_int8_dot_lanes()
+    return (
+        data_dtype == "uint8"
+        and weight_dtype == "int8"
+        and out_dtype == "int32"
+        and int32_lanes != 0
+        and all(isinstance(x, int) for x in (m, n, k))
+        and n % int32_lanes == 0
+        and k % 4 == 0
+    )
+
+
 @dense_strategy.register("cpu")
 def dense_strategy_cpu(attrs, inputs, out_type, target):
     """dense x86 strategy"""
@@ -340,6 +424,16 @@ def dense_strategy_cpu(attrs, inputs, out_type, target):
                 name="dense_mkldnn.x86",
                 plevel=15,
             )
+    n, k = get_const_tuple(inputs[1].shape)
+    if _is_int8_gemm_supported(
+        dtype, inputs[1].dtype, out_type.dtype, get_const_tuple(inputs[0].shape)[0], n, k
+    ):
+        strategy.add_implementation(
+            wrap_compute_dense(topi.x86.dense_int8),
+            wrap_topi_schedule(topi.x86.schedule_dense_int8),
+            name="dense_int8.x86",
+            plevel=12,
+        )
     with SpecializedCondition(m >= 16):
         # this implementation may not be well-optimized, so use plevel=8 for now.
         strategy.add_implementation(
@@ -361,6 +455,16 @@ def batch_matmul_strategy_cpu(attrs, inputs, out_type, target):
         name="batch_matmul.x86",
         plevel=10,
     )
+    x, y = inputs
+    batch, M, K = get_const_tuple(x.shape)
+    N = get_const_tuple(y.shape)[1]
+    if topi.x86.is_small_batch_matmul(batch, M, N, K):
+        strategy.add_implementation(
+            wrap_compute_batch_matmul(topi.x86.batch_matmul_small),
+            wrap_topi_schedule(topi.x86.schedule_batch_matmul_small),
+            name="batch_matmul_small.x86",
+            plevel=12,
+        )
     if "cblas" in target.libs:
         strategy.add_implementation(
             wrap_compute_batch_matmul(topi.x86.batch_matmul_cblas),
@@ -381,6 +485,27 @@ def sparse_dense_strategy_cpu(attrs, inputs, out_type, target):
         name="sparse_dense.x86",
         plevel=10,
     )
+    data, weight_data = inputs[0], inputs[1]
+    if len(weight_data.shape) == 3 and isinstance(get_const_tuple(data.shape)[0], int):
+        strategy.add_implementation(
+            wrap_compute_sparse_dense(topi.x86.sparse_dense_bsr),
+            wrap_topi_schedule(topi.x86.schedule_sparse_dense_bsr),
+            name="sparse_dense_bsr.x86",
+            plevel=15,
+        )
+    return strategy
+
+
+@sparse_conv2d_strategy.register("cpu")
+def sparse_conv2d_strategy_cpu(attrs, inputs, out_type, target):
+    """sparse conv2d x86 strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_sparse_conv2d(topi.x86.sparse_conv2d),
+        wrap_topi_schedule(topi.x86.schedule_sparse_conv2d),
+        name="sparse_conv2d.x86",
+        plevel=10,
+    )
     return strategy
 
 
@@ -398,6 +523,68 @@ def roi_align_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+@multibox_transform_loc_strategy.register("cpu")
+def multibox_transform_loc_strategy_cpu(attrs, inputs, out_type, target):
+    """multibox_transform_loc x86 strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_multibox_transform_loc(topi.vision.ssd.multibox_transform_loc),
+        wrap_topi_schedule(topi.generic.schedule_multibox_transform_loc),
+        name="multibox_transform_loc.generic",
+    )
+    if topi.x86.nms.native_vision_enabled() and inputs[0].dtype in ["float32", "float64"]:
+        strategy.add_implementation(
+            wrap_compute_multibox_transform_loc(topi.x86.nms.multibox_transform_loc),
+            wrap_topi_schedule(topi.generic.schedule_extern),
+            name="multibox_transform_loc.x86",
+            plevel=15,
+        )
+    return strategy
+
+
+@get_valid_counts_strategy.register("cpu")
+def get_valid_counts_strategy_cpu(attrs, inputs, out_type, target):
+    """get_valid_counts x86 strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_get_valid_counts(topi.vision.get_valid_counts),
+        wrap_topi_schedule(topi.generic.schedule_get_valid_counts),
+        name="get_valid_counts.generic",
+    )
+    if topi.x86.nms.native_vision_enabled() and inputs[0].dtype in ["float32", "float64"]:
+        strategy.add_implementation(
+            wrap_compute_get_valid_counts(topi.x86.nms.get_valid_counts),
+            wrap_topi_schedule(topi.generic.schedule_extern),
+            name="get_valid_counts.x86",
+            plevel=15,
+        )
+    return strategy
+
+
+@nms_strategy.register("cpu")
+def nms_strategy_cpu(attrs, inputs, out_type, target):
+    """nms x86 strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_nms(topi.vision.non_max_suppression),
+        wrap_topi_schedule(topi.generic.schedule_nms),
+        name="nms.generic",
+    )
+    # The native kernel takes max_output_size as an attribute rather than a tensor.
+    if (
+        topi.x86.nms.native_vision_enabled()
+        and attrs.max_output_size is not None
+        and inputs[0].dtype in ["float32", "float64"]
+    ):
+        strategy.add_implementation(
+            wrap_compute_nms(topi.x86.nms.non_max_suppression),
+            wrap_topi_schedule(topi.generic.schedule_extern),
+            name="nms.x86",
+            plevel=15,
+        )
+    return strategy
+
+
 @bitserial_conv2d_strategy.register("cpu")
 def bitserial_conv2d_strategy_cpu(attrs, inputs, out_type, target):
     """bitserial_conv2d x86 strategy"""
@@ -112,7 +112,7 @@ def register_annotate_function(op_name, frewrite=None, level=10):
     return _register(frewrite) if frewrite is not None else _register
 
 
-def attach_simulated_quantize(data, kind, sign=True, rounding="round"):
+def attach_simulated_quantize(data, kind, sign=True, rounding="round", nbit=0):
     """Attach a simulated quantize operation after input data expr.
 
     Parameters
@@ -122,21 +122,31 @@ def attach_simulated_quantize(data, kind, sign=True, rounding="round"):
 
     kind: QAnnotateKind
         the kind of annotation field.
+
+    nbit: int
+        the number of bits of the quantized values, 0 to use the qconfig setting of the kind.
     """
     quantize_op = _op.get("relay.op.annotation.simulated_quantize")
     if isinstance(data, _expr.Call) and data.op == quantize_op:
-        if data.attrs.kind == kind and data.attrs.sign == sign and data.attrs.rounding == rounding:
+        if (
+            data.attrs.kind == kind
+            and data.attrs.sign == sign
+            and data.attrs.rounding == rounding
+            and data.attrs.nbit == nbit
+        ):
             return data
 
     qctx = quantize_context()
-    key = tuple([data, kind, sign, rounding])
+    key = tuple([data, kind, sign, rounding, nbit])
     if key in qctx.qnode_map:
         return qctx.qnode_map[key]
 
     dom_scale = _expr.var("dom_scale")
     clip_min = _expr.var("clip_min")
     clip_max = _expr.var("clip_max")
-    qnode = _quantize.simulated_quantize(data, dom_scale, clip_min, clip_max, kind, sign, rounding)
+    qnode = _quantize.simulated_quantize(
+        data, dom_scale, clip_min, clip_max, kind, sign, rounding, nbit
+    )
     qctx.qnode_map[key] = qnode
     return qnode
 
@@ -161,11 +171,18 @@ def conv2d_rewrite(ref_call, new_args, ctx):
     if quantize_context().check_to_skip(ref_call):
         return None
 
+    precision = quantize_context().conv2d_precision()
+    if precision == "float32":
+        return None
+    if precision == "float16":
+        return _float16_conv2d(ref_call, new_args)
+    nbit = 16 if precision == "int16" else 0
+
     lhs_expr, lhs_kind = _get_expr_kind(new_args[0])
     rhs_expr, rhs_kind = _get_expr_kind(new_args[1])
 
     if lhs_kind is None or lhs_kind == QAnnotateKind.ACTIVATION:
-        lhs_expr = attach_simulated_quantize(lhs_expr, QAnnotateKind.INPUT)
+        lhs_expr = attach_simulated_quantize(lhs_expr, QAnnotateKind.INPUT, nbit=nbit)
 
     assert rhs_kind is None
     rhs_expr = attach_simulated_quantize(rhs_expr, QAnnotateKind.WEIGHT)
@@ -175,6 +192,29 @@ def conv2d_rewrite(ref_call, new_args, ctx):
     return QAnnotateExpr(expr, QAnnotateKind.ACTIVATION)
 
 
+def _float16_conv2d(ref_call, new_args):
+    """Run a conv2d layer selected for float16 precision in float16, the output is cast back to
+    float32 so that the following layers see a normal expression."""
+    lhs_expr = _op.cast(_get_expr_kind(new_args[0])[0], "float16")
+    rhs_expr = _op.cast(_get_expr_kind(new_args[1])[0], "float16")
+    attrs = ref_call.attrs
+    expr = _op.nn.conv2d(
+        lhs_expr,
+        rhs_expr,
+        strides=attrs.strides,
+        padding=attrs.padding,
+        dilation=attrs.dilation,
+        groups=attrs.groups,
+        channels=attrs.channels,
+        kernel_size=attrs.kernel_size,
+        data_layout=attrs.data_layout,
+        kernel_layout=attrs.kernel_layout,
+        out_layout=attrs.out_layout,
+        out_dtype="float16",
+    )
+    return _op.cast(expr, "float32")
+
+
 @register_annotate_function("nn.dense")
 def dense_rewrite(ref_call, new_args, ctx):
     """Rewrite function for dense. Lhs of dense will be quantized to input field, and rhs of
@@ -321,7 +361,9 @@ def cast_hint_rewrite(ref_call, new_args, ctx):
     if x_kind is None:
         return new_args[0]
     if x_kind == QAnnotateKind.ACTIVATION:
-        expr = attach_simulated_quantize(expr, QAnnotateKind.INPUT)
+        # int16 hints are inserted by partition before the layers selected for int16 precision
+        nbit = 16 if ref_call.attrs.dtype == "int16" else 0
+        expr = attach_simulated_quantize(expr, QAnnotateKind.INPUT, nbit=nbit)
 
     expr = _forward_op(ref_call, [expr])
     return QAnnotateExpr(expr, QAnnotateKind.INPUT)
@@ -17,11 +17,13 @@
 """Find scales for quantization on the dataset."""
 from __future__ import absolute_import
 import logging
-import multiprocessing as mp
+import os
+import time
 import numpy as np
 import tvm
 import tvm.driver
 from tvm.ir import IRModule
+from tvm.runtime import Object
 
 from . import _quantize
 from . import quantize
@@ -30,13 +32,19 @@ from .. import expr as _expr
 from .. import analysis as _analysis
 from .. import build_module as _build_module
 from ...contrib import graph_runtime
-from .kl_divergence import _find_scale_by_kl
+
+
+# The number of batches between two saves of the calibration checkpoint
+_CHECKPOINT_INTERVAL = 16
 
 
 def _get_profile_runtime(mod):
     func = mod["main"]
     func = _quantize.CreateStatsCollector(func)
+    return _build_runtime(func)
 
+
+def _build_runtime(func):
     if tvm.target.Target.current():
         target = tvm.target.Target.current()
         ctx = tvm.context(target.kind.name)
@@ -51,53 +59,158 @@ def _get_profile_runtime(mod):
     return runtime
 
 
-def collect_stats(mod, dataset, chunk_by=-1):
-    """Given an annotated graph, create a profile graph to collect profile data from the
-    calibration dataset. This pass collects simulated_quantize op input into a tuple.
-    Simulated_quantize ops are rewritten to identity mode. The tuple is the output of the profile
-    graph.
+@tvm._ffi.register_object("relay.quantize.CalibrationStats")
+class CalibrationStats(Object):
+    """The streaming histograms of the profiled layers on the calibration dataset.
+
+    The histograms are updated batch by batch, so the memory does not grow with the dataset,
+    and the thresholds of all layers are searched in parallel in C++.
+
+    Parameters
+    ----------
+    num_bins : int
+        The number of bins of each histogram, which should be odd.
+    """
+
+    def __init__(self, num_bins=8001):
+        self.__init_handle_by_constructor__(_quantize.CalibrationStats, num_bins)
+
+    def update(self, outputs, batch_size):
+        """Add the outputs of the profile graph on a batch.
+
+        Parameters
+        ----------
+        outputs : List[NDArray]
+            The float32 output of each layer on CPU.
+
+        batch_size : int
+            The number of samples in the batch.
+        """
+        _quantize.CalibrationStatsUpdate(self, outputs, batch_size)
+
+    def find_scales(self, mode="kl_divergence", percentile=99.99, num_quantized_bins=255):
+        """Find the threshold of every layer.
+
+        Parameters
+        ----------
+        mode : str
+            "kl_divergence" or "percentile".
+
+        percentile : float
+            The percentile of the values to cover in the percentile mode.
+
+        num_quantized_bins : int
+            The number of quantized bins in the kl_divergence mode.
+
+        Returns
+        -------
+        scales : List[float]
+            The threshold of each layer.
+        """
+        scales = _quantize.CalibrationStatsFindScales(self, mode, percentile, num_quantized_bins)
+        return [x.value for x in scales]
+
+    def find_divergences(self, num_quantized_bins=255):
+        """Find the KL divergence between the distribution of every layer and its quantized
+        distribution under the best threshold, a proxy of the accuracy loss of quantization.
+
+        Parameters
+        ----------
+        num_quantized_bins : int
+            The number of quantized bins, at most the number of bins of the histograms.
+
+        Returns
+        -------
+        divergences : List[float]
+            The divergence of each layer.
+        """
+        divergences = _quantize.CalibrationStatsFindDivergences(self, num_quantized_bins)
+        return [x.value for x in divergences]
+
+    def save(self, path):
+        """Save the statistics to a file."""
+        _quantize.CalibrationStatsSave(self, path)
+
+    @staticmethod
+    def load(path):
+        """Load the statistics from a file."""
+        return _quantize.CalibrationStatsLoad(path)
+
+
+def _get_batch_size(batch):
+    for data in batch.values():
+        shape = data.shape
+        return int(shape[0]) if len(shape) > 0 else 1
+    return 1
+
+
+def collect_histograms(mod, dataset, checkpoint=""):
+    """Run the profile graph of an annotated graph on the calibration dataset and accumulate
+    the histograms of the profiled layers.
 
     Parameters
     ----------
     mod: Module
         The simulation graph after annotation.
 
-    dataset: Iterable[NDArray]
-        The calibration dataset.
+    dataset: Iterable[Dict[str, NDArray]]
+        The calibration dataset, which is iterated only once.
 
-    chunk_by: optional, int
-        The size of chunk to be returned in one iteration. It is meant to be
-        used for reducing memory usage. If not specified, return samples for
-        all layers in one chunk.
+    checkpoint: str
+        If not empty, the file to save the statistics to every few batches and at the end. If
+        the file exists, the statistics are loaded from it and the collected batches are skipped.
 
     Returns
     -------
-    ret: Iterable[list of ndarray]
-        List of output data of each layer, chunked by the chunk_by parameter
+    stats: CalibrationStats
+        The histograms.
     """
+    if checkpoint and os.path.exists(checkpoint):
+        stats = CalibrationStats.load(checkpoint)
+        logging.info("resuming calibration after %d batches", stats.num_batches)
+    else:
+        stats = CalibrationStats()
+
     logging.info("collecting statistics for calibration...")
     runtime = _get_profile_runtime(mod)
     num_outputs = runtime.get_num_outputs()
-    chunk_by = num_outputs if chunk_by == -1 else chunk_by
-
-    for i in range(0, num_outputs, chunk_by):
-        outputs = [[] for i in range(min(chunk_by, num_outputs - i))]
-        for batch in dataset:
-            runtime.set_input(**batch)
-            runtime.run()
-            for j in range(i, min(i + chunk_by, num_outputs)):
-                outputs[j - i].append(runtime.get_output(j).asnumpy())
-        yield [np.concatenate(output).reshape(-1) for output in outputs]
-
-
-def _kl_scale(mod, dataset):
+    num_skipped = stats.num_batches
+    num_samples = 0
+    update_time = stats.update_time
+    tic = time.time()
+    for i, batch in enumerate(dataset):
+        if i < num_skipped:
+            continue
+        runtime.set_input(**batch)
+        runtime.run()
+        outputs = []
+        for j in range(num_outputs):
+            output = runtime.get_output(j)
+            if output.ctx.device_type != tvm.cpu().device_type:
+                output = output.copyto(tvm.cpu())
+            outputs.append(output)
+        stats.update(outputs, _get_batch_size(batch))
+        num_samples += _get_batch_size(batch)
+        if checkpoint and stats.num_batches % _CHECKPOINT_INTERVAL == 0:
+            stats.save(checkpoint)
+    if checkpoint:
+        stats.save(checkpoint)
+
+    if num_samples > 0:
+        logging.info(
+            "calibrated on %d samples, %.2f ms per sample (%.2f ms in histogram updates)",
+            num_samples,
+            (time.time() - tic) * 1e3 / num_samples,
+            (stats.update_time - update_time) * 1e3 / num_samples,
+        )
+    return stats
+
+
+def _calibrated_scale(mod, dataset):
     cfg = quantize.current_qconfig()
-    chunk_by = cfg.calibrate_chunk_by
-    scales = []
-    for samples in collect_stats(mod, dataset, chunk_by):
-        logging.info("finding threshold with kl for calibration...")
-        with mp.Pool() as pool:
-            scales += list(pool.map(_find_scale_by_kl, samples))
+    stats = collect_histograms(mod, dataset, cfg.calibrate_checkpoint)
+    logging.info("finding threshold with %s for calibration...", cfg.calibrate_mode)
+    scales = stats.find_scales(cfg.calibrate_mode, cfg.calibrate_percentile)
 
     def func(_):
         scale = scales[func.scale_idx]
@@ -120,7 +233,7 @@ def _set_params(mod, input_scale_func, weight_scale_func):
             _, ndom_scale, nclip_min, nclip_max = expr.args
             attrs = expr.attrs
             kind = attrs.kind
-            nbit = cfg.get_nbit_by_kind(kind)
+            nbit = attrs.nbit if attrs.nbit > 0 else cfg.get_nbit_by_kind(kind)
             valid_bit = nbit - attrs.sign
 
             # set scale
@@ -191,8 +304,8 @@ def calibrate(dataset=None):
         """make transform.module pass happy"""
         cfg = quantize.current_qconfig()
 
-        if cfg.calibrate_mode == "kl_divergence":
-            input_scale_func = _kl_scale(mod, dataset)
+        if cfg.calibrate_mode in ("kl_divergence", "percentile"):
+            input_scale_func = _calibrated_scale(mod, dataset)
         elif cfg.calibrate_mode == "global_scale":
             input_scale_func = _global_scale
         else:
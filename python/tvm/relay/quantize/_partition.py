@@ -20,7 +20,7 @@ import tvm
 from .. import expr as _expr
 from .. import analysis as _analysis
 from . import _quantize
-from .quantize import _forward_op
+from .quantize import _forward_op, quantize_context
 
 
 def register_partition_function(op_name, frewrite=None, level=10):
@@ -42,12 +42,16 @@ def partition_expr_check(expr):
 @register_partition_function("nn.conv2d")
 def conv2d_partition_function(ref_call, new_args, ctx):
     """Rewrite function for conv2d for partition"""
+    precision = quantize_context().next_partition_conv2d_precision()
     data_cond, data = partition_expr_check(new_args[0])
     kernel_cond, kernel = partition_expr_check(new_args[1])
 
     assert not kernel_cond
     if data_cond:
-        data = new_args[0].realize()
+        if precision == "int16":
+            data = _quantize.realize_partition_expr(new_args[0], "int16")
+        else:
+            data = new_args[0].realize()
     ret = _forward_op(ref_call, [data, kernel])
     return QPartitionExpr(ret)
 
@@ -0,0 +1,220 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Search the precision of every conv2d layer for mixed-precision quantization.
+
+The accuracy loss of quantizing a layer to a precision is estimated by the KL divergence between
+the distributions of the layer input and weight, measured on the calibration dataset, and their
+quantized distributions. For every layer, the search picks the cheapest precision by a latency
+table of the target whose divergence is within a threshold. The result is the
+`layer_precisions` of `qconfig`.
+"""
+import logging
+
+import numpy as np
+import tvm
+from tvm.ir import IRModule
+
+from .. import expr as _expr
+from .. import function as _function
+from .. import analysis as _analysis
+from .. import transform as _transform
+from ._calibrate import CalibrationStats, _build_runtime, _get_batch_size
+from .quantize import LAYER_PRECISIONS, prerequisite_optimize
+
+
+# The relative cost of a multiply-accumulate of every precision on the supported targets.
+LATENCY_TABLES = {
+    # The CPU kernels: int16 doubles the register and memory traffic of int8, and float16 has no
+    # native arithmetic, so it is computed through conversions and is slower than float32.
+    "cpu": {"int8": 1.0, "int16": 2.0, "float16": 6.0, "float32": 4.0},
+    # VSI NPU: the float convolutions are offloaded and run natively in float16, while the
+    # integer layers of the quantized graph run on the CPU.
+    "vsi_npu": {"int8": 2.0, "int16": 4.0, "float16": 1.0, "float32": 3.0},
+}
+
+# The largest finite float16 value
+_FLOAT16_MAX = 65504.0
+
+
+def _collect_conv2d(func):
+    """Collect the conv2d calls in the order that quantization counts them."""
+    convs = []
+
+    def fvisit(expr):
+        if isinstance(expr, _expr.Call) and expr.op == tvm.ir.Op.get("nn.conv2d"):
+            convs.append(expr)
+
+    _analysis.post_order_visit(func, fvisit)
+    return convs
+
+
+def _num_macs(conv):
+    out_shape = [int(x) for x in conv.checked_type.shape]
+    weight_shape = [int(x) for x in conv.args[1].checked_type.shape]
+    out_channels = weight_shape[conv.attrs.kernel_layout.index("O")]
+    return int(np.prod(out_shape)) * int(np.prod(weight_shape)) // out_channels
+
+
+def _profile_inputs(func, convs, dataset, num_bins):
+    """Collect the histograms of the inputs of the conv2d layers on the dataset."""
+    profile = _function.Function(func.params, _expr.Tuple([conv.args[0] for conv in convs]))
+    runtime = _build_runtime(profile)
+    stats = CalibrationStats(num_bins)
+    for batch in dataset:
+        runtime.set_input(**batch)
+        runtime.run()
+        outputs = []
+        for i in range(runtime.get_num_outputs()):
+            output = runtime.get_output(i)
+            if output.ctx.device_type != tvm.cpu().device_type:
+                output = output.copyto(tvm.cpu())
+            outputs.append(output)
+        stats.update(outputs, _get_batch_size(batch))
+    return stats
+
+
+def _profile_weights(convs, num_bins):
+    """Collect the histograms of the constant weights of the conv2d layers, the layers whose
+    weights are not constant are reported as exact."""
+    weights = []
+    for conv in convs:
+        if isinstance(conv.args[1], _expr.Constant):
+            weights.append(conv.args[1].data)
+        else:
+            weights.append(tvm.nd.array(np.zeros((1,), "float32")))
+    stats = CalibrationStats(num_bins)
+    stats.update(weights, 1)
+    return stats
+
+
+def _get_latency_table(latency_table, num_layers):
+    """Normalize the latency table to a per-layer table of per-MAC costs or latencies."""
+    if isinstance(latency_table, str):
+        if latency_table not in LATENCY_TABLES:
+            raise ValueError(
+                "Unknown latency table %s, should be one of %s"
+                % (latency_table, list(LATENCY_TABLES.keys()))
+            )
+        return [LATENCY_TABLES[latency_table]] * num_layers, True
+    if isinstance(latency_table, dict):
+        return [latency_table] * num_layers, True
+    if len(latency_table) != num_layers:
+        raise ValueError(
+            "The latency table has %d layers, but the model has %d conv2d layers"
+            % (len(latency_table), num_layers)
+        )
+    return list(latency_table), False
+
+
+def search_layer_precisions(
+    mod,
+    params=None,
+    dataset=None,
+    kl_threshold=0.05,
+    latency_table="cpu",
+    candidates=LAYER_PRECISIONS,
+    num_bins=8001,
+):
+    """Search the precision of every conv2d layer.
+
+    Parameters
+    ----------
+    mod : Module
+        The original module, the same as the input of `quantize`.
+
+    params : dict of str to NDArray
+        The parameters of the module.
+
+    dataset : Iterable[Dict[str, NDArray]]
+        The calibration dataset, which is iterated only once.
+
+    kl_threshold : float
+        The largest KL divergence of a layer that is considered accurate enough, the sum of the
+        divergences of the quantized input and weight.
+
+    latency_table : str, dict of str to float, or list of dict of str to float
+        The cost of every precision. It is either the name of a built-in table in
+        `LATENCY_TABLES`, i.e. "cpu" or "vsi_npu", a dict of the relative cost of a
+        multiply-accumulate of every precision, or a list of the measured latency of every
+        precision of every conv2d layer.
+
+    candidates : List[str]
+        The candidate precisions, a subset of "int8", "int16", "float16" and "float32".
+
+    num_bins : int
+        The number of bins of the histograms.
+
+    Returns
+    -------
+    layer_precisions : List[str]
+        The precision of every conv2d layer, to be passed to `qconfig(layer_precisions=...)`.
+    """
+    for precision in candidates:
+        if precision not in LAYER_PRECISIONS:
+            raise ValueError(
+                "Unknown layer precision %s, should be one of %s" % (precision, LAYER_PRECISIONS)
+            )
+    # prerequisite_optimize binds the params into the module in place
+    mod = IRModule(mod.functions, mod.type_definitions)
+    mod = prerequisite_optimize(mod, params)
+    mod = _transform.InferType()(mod)
+    func = mod["main"]
+    convs = _collect_conv2d(func)
+    if not convs:
+        return []
+    tables, per_mac = _get_latency_table(latency_table, len(convs))
+
+    input_stats = _profile_inputs(func, convs, dataset, num_bins)
+    weight_stats = _profile_weights(convs, num_bins)
+    divergences = {
+        "int8": [
+            x + y
+            for x, y in zip(input_stats.find_divergences(255), weight_stats.find_divergences(255))
+        ],
+        # int16 layers keep 8-bit weights
+        "int16": [
+            x + y
+            for x, y in zip(
+                input_stats.find_divergences(min(2 ** 16 - 1, num_bins)),
+                weight_stats.find_divergences(255),
+            )
+        ],
+    }
+    input_max = input_stats.find_scales("percentile", 100.0)
+    weight_max = weight_stats.find_scales("percentile", 100.0)
+    divergences["float16"] = [
+        0.0 if max(x, y) < _FLOAT16_MAX else float("inf") for x, y in zip(input_max, weight_max)
+    ]
+    divergences["float32"] = [0.0] * len(convs)
+
+    layer_precisions = []
+    for i, conv in enumerate(convs):
+        macs = _num_macs(conv) if per_mac else 1
+        costs = sorted((tables[i][precision] * macs, precision) for precision in candidates)
+        accurate = [p for _, p in costs if divergences[p][i] <= kl_threshold]
+        if accurate:
+            precision = accurate[0]
+        else:
+            precision = min(candidates, key=lambda p, i=i: divergences[p][i])
+        layer_precisions.append(precision)
+        logging.info(
+            "conv2d layer %d: %s, divergence %s",
+            i,
+            precision,
+            ", ".join("%s %.4g" % (p, divergences[p][i]) for p in candidates),
+        )
+    return layer_precisions
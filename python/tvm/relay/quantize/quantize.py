@@ -16,6 +16,8 @@
 # under the License.
 # pylint: disable=unused-argument, not-context-manager
 """Automatic quantization toolkit."""
+import warnings
+
 import tvm.ir
 import tvm
 from tvm.runtime import Object
@@ -81,11 +83,14 @@ class QConfig(Object):
         "weight_scale": "power2",
         "skip_dense_layer": True,
         "skip_conv_layers": [0],
+        "layer_precisions": None,
         "do_simulation": False,
         "round_for_shift": True,
         "debug_enabled_ops": None,
         "rounding": "UPWARD",
         "calibrate_chunk_by": -1,
+        "calibrate_percentile": 99.99,
+        "calibrate_checkpoint": "",
         "partition_conversions": "disabled",
     }
 
@@ -146,9 +151,22 @@ def qconfig(**kwargs):
         Number of bit for every kind of annotate field.
 
     calibrate_mode: str
-        The calibration mode. 'global_scale' or 'kl_divergence'.
+        The calibration mode. 'global_scale', 'kl_divergence' or 'percentile'.
         global_scale: use global scale
         kl_divergence: find scales by kl divergence on the dataset.
+        percentile: find scales that cover calibrate_percentile of the values on the dataset.
+
+    calibrate_percentile: float
+        The percentile of the values that the scales cover in the percentile mode.
+
+    calibrate_chunk_by: int
+        Deprecated and ignored. The calibration keeps a streaming histogram per layer, so
+        the memory does not grow with the dataset, and the layers need not be chunked.
+
+    calibrate_checkpoint: str
+        If not empty, the file to save the calibration statistics to periodically. If the file
+        exists when calibration starts, the statistics are loaded from it and the batches that
+        have been collected are skipped, so an interrupted calibration can be resumed.
 
     global_scale: float
         The global scale for calibration.
@@ -166,6 +184,14 @@ def qconfig(**kwargs):
         Specifying which layers to be skipped. Provide a list of indices
         that indicate which conv2d layers to leave untouched. Start from 0.
 
+    layer_precisions: None or list of str
+        The precision of every conv2d layer, in the same order as skip_conv_layers.
+        Every entry is one of 'int8', 'int16', 'float16' and 'float32'. 'int8' uses the
+        nbit/dtype setting above. 'int16' quantizes the input of the layer to 16 bits and keeps
+        8-bit weights, with accumulation in dtype_activation, so large kernels may overflow an
+        int32 accumulator. 'float16' runs the layer in float16 and 'float32' leaves it
+        unquantized. Layers beyond the list use 'int8'. See `search_layer_precisions`.
+
     do_simulation: boolean
         Whether to do simulation with float operation only.
 
@@ -196,6 +222,12 @@ def qconfig(**kwargs):
     config: QConfig
         The quantization configuration
     """
+    if "calibrate_chunk_by" in kwargs:
+        warnings.warn(
+            "calibrate_chunk_by is deprecated and ignored, the calibration statistics are "
+            "streaming histograms whose memory does not grow with the dataset",
+            DeprecationWarning,
+        )
     node_args = {k: v if k not in kwargs else kwargs[k] for k, v in QConfig._node_defaults.items()}
     return tvm.ir.make_node("relay.quantize.QConfig", **node_args)
 
@@ -209,6 +241,7 @@ class QuantizeContext(object):
     def __init__(self):
         self.qnode_map = dict()
         self._conv2d_counter = 0
+        self._partition_conv2d_counter = 0
         self._stop_quantize = False
 
     def check_to_skip(self, ref_call):
@@ -217,23 +250,33 @@ class QuantizeContext(object):
         if self._stop_quantize:
             return True
 
+        skip = False
         if current_qconfig().skip_conv_layers is not None:
             # check skip conv layers
             skipped_indices = [int(x) for x in current_qconfig().skip_conv_layers]
-            if self._conv2d_counter in skipped_indices:
-                if ref_call.op.name == "nn.conv2d":
-                    self._conv2d_counter += 1
-                return True
-            if ref_call.op.name == "nn.conv2d":
-                self._conv2d_counter += 1
+            skip = self._conv2d_counter in skipped_indices
+        if ref_call.op.name == "nn.conv2d":
+            self._conv2d_counter += 1
+
+        return skip
 
-        return False
+    def conv2d_precision(self):
+        """Get the precision of the conv2d layer last checked by `check_to_skip`,
+        None for the precision of the qconfig."""
+        return _layer_precision(self._conv2d_counter - 1)
+
+    def next_partition_conv2d_precision(self):
+        """Count a conv2d layer in partition and get its precision,
+        None for the precision of the qconfig."""
+        self._partition_conv2d_counter += 1
+        return _layer_precision(self._partition_conv2d_counter - 1)
 
     def stop_quantize(self):
         self._stop_quantize = True
 
     def reset(self):
         self._conv2d_counter = 0
+        self._partition_conv2d_counter = 0
         self._stop_quantize = False
 
     def __enter__(self):
@@ -244,6 +287,21 @@ class QuantizeContext(object):
         pass
 
 
+LAYER_PRECISIONS = ("int8", "int16", "float16", "float32")
+
+
+def _layer_precision(index):
+    precisions = current_qconfig().layer_precisions
+    if precisions is None or index < 0 or index >= len(precisions):
+        return None
+    precision = str(precisions[index])
+    if precision not in LAYER_PRECISIONS:
+        raise ValueError(
+            "Unknown layer precision %s, should be one of %s" % (precision, LAYER_PRECISIONS)
+        )
+    return None if precision == "int8" else precision
+
+
 def quantize_context():
     """Get the global singleton scope"""
     if QuantizeContext.Current is None:
@@ -374,6 +432,9 @@ def quantize(mod, params=None, dataset=None):
     assert q_cfg.partition_conversions in ["disabled", "enabled", "fully_integral"]
     if q_cfg.partition_conversions != "disabled":
         quantized_dtypes = {q_cfg.dtype_input, q_cfg.dtype_weight, q_cfg.dtype_activation}
+        if q_cfg.layer_precisions is not None:
+            if "int16" in [str(x) for x in q_cfg.layer_precisions]:
+                quantized_dtypes.add("int16")
         ensure_fully_integral = q_cfg.partition_conversions == "fully_integral"
         return partition_conversions(mod, quantized_dtypes, ensure_fully_integral)
 
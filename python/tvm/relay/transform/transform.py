@@ -56,6 +56,7 @@ def build_config(opt_level=2, required_pass=None, disabled_pass=None, trace=None
                 "CombineParallelConv2D": 4,
                 "CombineParallelDense": 4,
                 "CombineParallelBatchMatmul": 4,
+                "CombineIndependentOps": 4,
                 "FastMath": 4
             }
 
@@ -359,6 +360,51 @@ def CombineParallelBatchMatmul(min_num_branches=3):
     return _ffi_api.CombineParallelBatchMatmul(min_num_branches)
 
 
+def CombineIndependentOps(min_num_ops=3, max_num_elements=16384):
+    """Combine independent elementwise ops or pools of the same kind into one. For example:
+
+    .. code-block
+                x (1, 8, 4, 4)        y (1, 8, 4, 4)
+                    |                     |
+                sigmoid (1, 8, 4, 4)  sigmoid (1, 8, 4, 4)
+
+    Would become:
+
+    .. code-block
+
+                x (1, 8, 4, 4)        y (1, 8, 4, 4)
+                    |                     |
+                    concatenate (2, 8, 4, 4)
+                            |
+                     sigmoid (2, 8, 4, 4)
+                            |
+                   split (1, 8, 4, 4) x 2
+
+    The combined ops have the same op, attributes and argument types, and do not depend on
+    each other. The pools are concatenated along the batch axis of their layout. The NCHW
+    conv2d with different weights are combined into a grouped conv2d on the inputs concatenated
+    along the channel axis, except for the CPU targets, whose group_conv2d is not optimized.
+    The ops whose inputs are fused into them by FuseOps are not combined, unless the producers
+    of the inputs were combined too, and the ops on the same arguments are left to
+    EliminateCommonSubexpr.
+
+    Parameters
+    ----------
+    min_num_ops : int
+        The minimum number of ops to combine.
+
+    max_num_elements : int
+        The maximum number of output elements of a combined op. Larger ops are not bound by
+        the kernel launch, and the concatenation only adds memory traffic to them.
+
+    Returns
+    -------
+    ret: tvm.transform.Pass
+        The registered pass that combines independent ops.
+    """
+    return _ffi_api.CombineIndependentOps(min_num_ops, max_num_elements)
+
+
 def BatchingOps():
     """Batching parallel operators into one for Conv2D, Dense and BatchMatmul.
 
@@ -417,6 +463,40 @@ def ConvertLayout(desired_layouts):
     return _ffi_api.ConvertLayout(desired_layouts)
 
 
+def PlanLayout(desired_layouts, op_cost=None, desired_speedup=2.0, transform_cost_per_byte=1.0):
+    """Convert the layouts like ConvertLayout, but only convert the ops for which the
+    conversion pays off globally.
+
+    Every call of the ops in `desired_layouts` either keeps its layout or is converted. The
+    layout of the ops that adapt to their inputs follows their producers, so a layout_transform
+    is inserted wherever a producer and a consumer disagree, and the inputs and outputs of the
+    function are in the original layout. The choice minimizes the total cost of the calls and of
+    the transforms, which is found exactly as a minimum cut of the graph of the calls.
+
+    Parameters
+    ----------
+    desired_layouts : map of op_name to list of layouts
+        The layouts to convert to, the same as ConvertLayout.
+
+    op_cost : Optional[Callable[[tvm.relay.Call, bool], Optional[float]]]
+        The cost of a call if it keeps its layout or is converted, usually measured per layout.
+        Returning None falls back to the default cost.
+
+    desired_speedup : float
+        The default cost of a call is its MAC count, or its output size if it has no MAC count,
+        divided by `desired_speedup` if it is converted.
+
+    transform_cost_per_byte : float
+        The cost of a layout_transform per byte of its input.
+
+    Returns
+    -------
+    pass: FunctionPass
+      The pass.
+    """
+    return _ffi_api.PlanLayout(desired_layouts, op_cost, desired_speedup, transform_cost_per_byte)
+
+
 def Legalize(legalize_map_attr_name="FTVMLegalize"):
     """Legalizes an expression with another expression.
     This pass can be used to replace an expr with another expr for target
@@ -484,6 +564,89 @@ def MergeCompilerRegions():
     return _ffi_api.MergeCompilerRegions()
 
 
+@tvm._ffi.register_object("relay.transform.RegionCostModel")
+class RegionCostModel(tvm.runtime.Object):
+    """The cost model of PruneCompilerRegions. The costs are in an arbitrary unit shared by the
+    ops and the transfers, the default estimates count MACs.
+
+    Parameters
+    ----------
+    op_cost : Optional[Union[Callable, Dict[str, Tuple[float, float]]]]
+        The costs of an op, either a function (call, target) -> (host cost, target cost), where
+        the call is an op call or a call to a composite function, or a static table from the op
+        or composite name to (host cost, target cost). The ops that the function returns None
+        for, or that are not in the table, use the default estimate: the MAC count, or the number
+        of output elements for the ops without MACs, on the host and that divided by
+        target_speedup on the target.
+
+    target_speedup : float
+        How many times a target runs an op faster than the host in the default estimate.
+
+    transfer_latency : float
+        The fixed cost of every tensor moved between the host and a target.
+
+    transfer_cost_per_byte : float
+        The cost of every byte moved between the host and a target.
+
+    min_region_size : int
+        The smallest number of ops of a region to offload.
+    """
+
+    def __init__(
+        self,
+        op_cost=None,
+        target_speedup=8.0,
+        transfer_latency=1e5,
+        transfer_cost_per_byte=1.0,
+        min_region_size=1,
+    ):
+        if isinstance(op_cost, dict):
+            table = op_cost
+
+            def _table_cost(call, target):
+                if isinstance(call.op, tvm.ir.Op):
+                    name = call.op.name
+                else:
+                    name = call.op.attrs["Composite"]
+                return table.get(name, None)
+
+            op_cost = _table_cost
+
+        self.__init_handle_by_constructor__(
+            _ffi_api.RegionCostModel,
+            op_cost,
+            target_speedup,
+            transfer_latency,
+            transfer_cost_per_byte,
+            min_region_size,
+        )
+
+
+def PruneCompilerRegions(cost_model=None):
+    """Fall back the compiler regions that are too small or not profitable to the host.
+
+    The cost of a region on its target is the cost of its ops on the target plus the cost of
+    moving its inputs and outputs between the host and the target. A region stays on the target
+    only if that is lower than the cost of its ops on the host, so that a few unsupported ops
+    in the middle of a graph do not split it into many tiny external functions. It should run
+    after MergeCompilerRegions and before PartitionGraph, and
+    `relay.analysis.estimate_compiler_regions` reports the estimates that it uses.
+
+    Parameters
+    ----------
+    cost_model : Optional[RegionCostModel]
+        The cost model, a default RegionCostModel if it is None.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass that prunes compiler regions.
+    """
+    if cost_model is None:
+        cost_model = RegionCostModel()
+    return _ffi_api.PruneCompilerRegions(cost_model)
+
+
 def RewriteAnnotatedOps(fallback_device):
     """Rewrite the annotated program where annotation operators, e.g.
     `on_deivce`, mark which device an expression should be scheduled to.
@@ -1003,6 +1166,34 @@ def DenseToSparse(weight_name, weight_shape):
     return _ffi_api.DenseToSparse(weight_name, weight_shape)
 
 
+def Conv2dToSparse(weight_name, weight_shape, layout, kernel_size):
+    """
+    Rewrite qualified ```nn.conv2d operation``` to ```nn.sparse_conv2d```
+    This pass is used in ```data_dep_optimization.bsr_conv2d```
+    Parameters of this pass is generated by ```analysis.sparse_conv2d.process_params```
+
+    Parameters
+    ----------
+    weight_name: Array[String]
+      Names of weights which qualified sparse contrains
+
+    weight_shape: Array[Array[IntImm]]
+      Weights shape in BSR format.
+
+    layout : str
+      Layout of the data of the conv2d to rewrite, "NHWC" or "NCHW".
+
+    kernel_size : int
+      Kernel size of the conv2d to rewrite, 1 or 3.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered Conv2dToSparse pass.
+    """
+    return _ffi_api.Conv2dToSparse(weight_name, weight_shape, layout, kernel_size)
+
+
 def SimplifyFCTranspose(target_weight_name):
     """
     Rewrite ```y = nn.dense(x, transpose(w, [1, 0]))``` to ```y = nn.dense(x, wt)```
@@ -205,6 +205,27 @@ def StorageRewrite():
     return _ffi_api.StorageRewrite()
 
 
+def InsertPrefetch():
+    """Insert software prefetch for the strided loads of the innermost loops.
+
+    Loads whose address moves by at least a cache line per iteration are
+    prefetched a number of iterations ahead. The distance is set by the pass
+    config "tir.InsertPrefetch", or per loop nest by the "prefetch_distance"
+    pragma, which makes it a schedule knob that autotvm templates can tune:
+
+    .. code-block:: python
+
+        cfg.define_knob("prefetch_distance", [0, 4, 8, 16])
+        s[C].pragma(ko, "prefetch_distance", cfg["prefetch_distance"].val)
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InsertPrefetch()
+
+
 def UnrollLoop():
     """Unroll the constant loop marked by unroll.
 
@@ -443,6 +464,15 @@ def LowerTVMBuiltin():
 def LowerIntrin():
     """Lower target specific intrinsic calls.
 
+    When the pass config "tir.LowerIntrin" sets fast_math_max_ulp, the float32
+    transcendentals are lowered to the cheapest polynomial approximation of the
+    target whose error is within that many ulp, if there is one:
+
+    .. code-block:: python
+
+        with tvm.transform.PassContext(config={"tir.LowerIntrin": {"fast_math_max_ulp": 8}}):
+            f = tvm.build(s, [A, B], "llvm")
+
     Returns
     -------
     fpass : tvm.transform.Pass
@@ -21,6 +21,7 @@ import tvm
 from tvm import te
 
 from ..util import get_const_tuple
+from .pad import pad
 
 
 def sparse_dense(data, weight_data, weight_indices, weight_indptr):
@@ -103,6 +104,139 @@ def _sparse_dense_bsrmm(data, weight_data, weight_indices, weight_indptr):
     )
 
 
+def sparse_conv2d(
+    dense_data, sparse_data, sparse_indices, sparse_indptr, layout="NHWC", kernel_size=1
+):
+    """
+    Computes the 2D convolution of `dense_data` with the block sparse kernel
+    `(sparse_data, sparse_indices, sparse_indptr)`. The 1x1 kernel has stride 1 and
+    no padding, the 3x3 kernel has stride 1 and padding 1.
+
+    The kernel is a BSR matrix of shape [out_channels, in_channels * kernel_size * kernel_size],
+    its columns are ordered as (in_channels, kh, kw) for the NCHW layout, i.e. the OIHW kernel
+    reshaped to 2-D, and as (kh, kw, in_channels) for the NHWC layout, i.e. the HWIO kernel
+    transposed to OHWI and reshaped to 2-D.
+
+    Parameters
+    ----------
+    dense_data : tvm.te.Tensor
+        4-D with shape [batch, height, width, in_channels] (NHWC) or
+        [batch, in_channels, height, width] (NCHW)
+
+    sparse_data : tvm.te.Tensor
+        3-D with shape [num_blocks, bs_r, bs_c]
+
+    sparse_indices : tvm.te.Tensor
+        1-D with shape [num_blocks]
+
+    sparse_indptr : tvm.te.Tensor
+        1-D with shape [out_channels // bs_r + 1]
+
+    layout : str
+        The layout of the data and the output, "NHWC" or "NCHW".
+
+    kernel_size : int
+        The size of the square kernel, 1 or 3.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        4-D with shape [batch, height, width, out_channels] (NHWC) or
+        [batch, out_channels, height, width] (NCHW)
+    """
+    assert len(sparse_data.shape) == 3, "sparse_conv2d only supports the BSR kernel"
+    assert kernel_size in (1, 3), "sparse_conv2d only supports the kernel size 1 and 3"
+    if layout == "NHWC":
+        func = _sparse_conv2d_bsr_nhwc
+    elif layout == "NCHW":
+        func = _sparse_conv2d_bsr_nchw
+    else:
+        raise ValueError("Unsupported layout {} for sparse_conv2d".format(layout))
+    return func(dense_data, sparse_data, sparse_indices, sparse_indptr, kernel_size)
+
+
+def _sparse_conv2d_bsr_nhwc(data, weight_data, weight_indices, weight_indptr, kernel_size):
+    (batch, height, width, in_channel) = get_const_tuple(data.shape)
+    (_, bs_r, bs_c) = get_const_tuple(weight_data.shape)
+    (num_blocks_plus_1,) = get_const_tuple(weight_indptr.shape)
+    num_blocks = num_blocks_plus_1 - 1
+
+    idxd = tvm.tir.indexdiv
+    idxm = tvm.tir.indexmod
+
+    if kernel_size == 3:
+        data = pad(data, [0, 1, 1, 0], name="data_pad")
+
+    def _compute_block(n, h, w, nb_j, j):
+        row_start = weight_indptr[nb_j]
+        row_end = weight_indptr[nb_j + 1]
+        row_elems = row_end - row_start
+        elem_idx = te.reduce_axis((0, row_elems), name="elem_idx")
+        block_offset = row_start + elem_idx
+        c = te.reduce_axis((0, bs_c), name="c")
+        block_j = weight_indices[block_offset]
+        block_ij_val = weight_data[block_offset][j][c]
+        k = bs_c * block_j + c
+        if kernel_size == 1:
+            x_val = data[n, h, w, k]
+        else:
+            kh = idxd(k, 3 * in_channel)
+            kw = idxm(idxd(k, in_channel), 3)
+            x_val = data[n, h + kh, w + kw, idxm(k, in_channel)]
+        return te.sum(block_ij_val * x_val, axis=[elem_idx, c])
+
+    bsr_block = te.compute(
+        (batch, height, width, num_blocks, bs_r),
+        _compute_block,
+        tag="sparse_conv2d_nhwc_bsr_block",
+    )
+    return te.compute(
+        (batch, height, width, num_blocks * bs_r),
+        lambda n, h, w, oc: bsr_block[n, h, w, idxd(oc, bs_r), idxm(oc, bs_r)],
+        tag="sparse_conv2d_nhwc_bsr",
+    )
+
+
+def _sparse_conv2d_bsr_nchw(data, weight_data, weight_indices, weight_indptr, kernel_size):
+    (batch, _, height, width) = get_const_tuple(data.shape)
+    (_, bs_r, bs_c) = get_const_tuple(weight_data.shape)
+    (num_blocks_plus_1,) = get_const_tuple(weight_indptr.shape)
+    num_blocks = num_blocks_plus_1 - 1
+
+    idxd = tvm.tir.indexdiv
+    idxm = tvm.tir.indexmod
+
+    if kernel_size == 3:
+        data = pad(data, [0, 0, 1, 1], name="data_pad")
+
+    def _compute_block(n, nb_j, j, h, w):
+        row_start = weight_indptr[nb_j]
+        row_end = weight_indptr[nb_j + 1]
+        row_elems = row_end - row_start
+        elem_idx = te.reduce_axis((0, row_elems), name="elem_idx")
+        block_offset = row_start + elem_idx
+        c = te.reduce_axis((0, bs_c), name="c")
+        block_j = weight_indices[block_offset]
+        block_ij_val = weight_data[block_offset][j][c]
+        k = bs_c * block_j + c
+        if kernel_size == 1:
+            x_val = data[n, k, h, w]
+        else:
+            x_val = data[n, idxd(k, 9), h + idxm(idxd(k, 3), 3), w + idxm(k, 3)]
+        return te.sum(block_ij_val * x_val, axis=[elem_idx, c])
+
+    bsr_block = te.compute(
+        (batch, num_blocks, bs_r, height, width),
+        _compute_block,
+        tag="sparse_conv2d_nchw_bsr_block",
+    )
+    return te.compute(
+        (batch, num_blocks * bs_r, height, width),
+        lambda n, oc, h, w: bsr_block[n, idxd(oc, bs_r), idxm(oc, bs_r), h, w],
+        tag="sparse_conv2d_nchw_bsr",
+    )
+
+
 def sparse_transpose(sparse_data, sparse_indices, sparse_indptr):
     """
     Transpose a square sparse matrix,
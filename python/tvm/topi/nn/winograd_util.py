@@ -174,3 +174,40 @@ def winograd_transform_matrices(tile_size, kernel_size, out_dtype):
         const_matrix(B_data.astype(out_dtype), "B"),
         const_matrix(G_data.astype(out_dtype), "G"),
     )
+
+
+def winograd_integer_transform_matrices(tile_size, kernel_size):
+    """Compute the A, B, and G transform matrices for `tile_size` as integer numpy arrays,
+    for Winograd convolutions of integer data.
+
+    A and B are integral for the small tile sizes. G is scaled by the smallest integer
+    that makes it integral, so the result of the integer transforms is the convolution
+    multiplied by scale * scale.
+
+    Returns
+    -------
+    A, B, G : numpy.ndarray
+        The int64 transform matrices.
+    scale : int
+        The scale of G.
+    """
+    degree = tile_size + kernel_size - 2
+    intp_pts = _interpolation_points(degree)
+    A_data, B_data, G_data = _cook_toom_convolution(intp_pts, tile_size, kernel_size)
+
+    def _is_integral(matrix):
+        return np.allclose(matrix, np.round(matrix))
+
+    if not _is_integral(A_data) or not _is_integral(B_data):
+        raise ValueError("Unsupported tile size for integer Winograd: {}".format(tile_size))
+    for scale in range(1, 65):
+        if _is_integral(G_data * scale):
+            break
+    else:
+        raise ValueError("Unsupported tile size for integer Winograd: {}".format(tile_size))
+    return (
+        np.round(A_data).astype("int64"),
+        np.round(B_data).astype("int64"),
+        np.round(G_data * scale).astype("int64"),
+        scale,
+    )
@@ -26,6 +26,7 @@ from .binarize_pack import schedule_binarize_pack
 from .binary_dense import schedule_binary_dense
 from .nn import *
 from .conv2d_int8 import *
+from .conv2d_winograd import *
 from .injective import *
 from .reduction import *
 from .pooling import schedule_pool, schedule_adaptive_pool
@@ -35,6 +36,7 @@ from .depthwise_conv2d import *
 from .dense import *
 from .batch_matmul import *
 from .roi_align import roi_align_nchw
+from . import nms
 from .conv2d_transpose import *
 from .conv3d_transpose import *
 from .sparse import *
@@ -16,12 +16,15 @@
 # under the License.
 # pylint: disable=invalid-name,too-many-locals,unused-variable
 """x86 batch_matmul operators"""
+import tvm
 from tvm import te
 from tvm import autotvm
 from tvm.autotvm.task.space import SplitEntity
 from tvm.contrib import cblas
 from .. import generic
 from ..util import traverse_inline, get_const_tuple, get_max_power2_factor
+from .dense import _define_int8_gemm_config, _schedule_int8_gemm
+from .util import get_fp32_len, get_int8_dot_lanes
 
 
 @autotvm.register_topi_compute("batch_matmul.x86")
@@ -128,6 +131,212 @@ def _default_batch_matmul_config(cfg, M, N, K):
     cfg["tile_y"] = SplitEntity([M // y_bn, y_bn])
 
 
+# The min batch for batch_matmul_small.x86, which only parallelizes over the batch.
+# Below it batch_matmul.x86 uses more cores, as it parallelizes over the tiles of
+# every matrix too. It is a fixed floor rather than the thread count of the host,
+# since the host that compiles is not always the one that runs.
+SMALL_BATCH_MATMUL_MIN_BATCH = 16
+
+
+def is_small_batch_matmul(batch, M, N, K):
+    """Whether the batch_matmul is a large batch of matrices small enough for the
+    batch_matmul_small.x86 template, i.e. one matrix of B fits in the L1 cache and
+    the batch has at least SMALL_BATCH_MATMUL_MIN_BATCH parallel tasks."""
+    if not all(isinstance(v, int) for v in (batch, M, N, K)):
+        return False
+    return (
+        batch >= SMALL_BATCH_MATMUL_MIN_BATCH
+        and N * K <= 128 * 128
+        and M * N * K <= 128 * 128 * 128
+    )
+
+
+@autotvm.register_topi_compute("batch_matmul_small.x86")
+def batch_matmul_small(cfg, x, y):
+    """Computes batch matrix multiplication of `x` and `y` for a large batch of
+    small matrices.
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        Autotvm tuning space config file
+    x : tvm.te.Tensor
+        3-D with shape [batch, M, K]
+    y : tvm.te.Tensor
+        3-D with shape [batch, N, K]
+    Returns
+    -------
+    output : tvm.te.Tensor
+        3-D with shape [batch, M, N]
+    """
+    assert len(x.shape) == 3 and len(y.shape) == 3, "only support 3-dim batch_matmul"
+    XB, M, XK = get_const_tuple(x.shape)
+    YB, N, YK = get_const_tuple(y.shape)
+    assert XB == YB, "batch dimension doesn't match"
+    assert XK == YK, "shapes of x and y is inconsistant"
+    B = XB
+    K = XK
+    cfg.define_split("tile_y", M, num_outputs=2, filter=lambda x: x.size[-1] <= 8)
+    cfg.define_split("tile_x", N, num_outputs=2, filter=lambda x: x.size[-1] <= 64)
+    if cfg.is_fallback:
+        y_bn = get_max_power2_factor(M, 4)
+        cfg["tile_y"] = SplitEntity([M // y_bn, y_bn])
+        x_bn = get_max_power2_factor(N, 2 * get_fp32_len())
+        cfg["tile_x"] = SplitEntity([N // x_bn, x_bn])
+    cfg.add_flop(B * M * N * K * 2)
+
+    # The transpose of y is computed per matrix inside the parallel loop of the batch,
+    # so it stays in the cache and no separate packing pass is needed.
+    y_t = te.compute((B, K, N), lambda b, k, j: y[b, j, k], name="y_t")
+    k = te.reduce_axis((0, K), name="k")
+    C = te.compute(
+        (B, M, N),
+        lambda b, i, j: te.sum(x[b, i, k] * y_t[b, k, j], axis=k),
+        tag="batch_matmul_small",
+    )
+    return C
+
+
+@autotvm.register_topi_schedule("batch_matmul_small.x86")
+def schedule_batch_matmul_small(cfg, outs):
+    """Schedule for batch_matmul_small. Every task computes one matrix of the batch
+    with a register blocked microkernel of tile_y rows and tile_x columns.
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        AutoTVM tuning space config file.
+    outs : Array of Tensor
+        The computation graph description of batch_matmul_small
+        in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "batch_matmul_small" in op.tag:
+            C = op.output(0)
+            y_t = op.input_tensors[1]
+
+            if op not in s.outputs:
+                s[C].compute_inline()
+                O = outs[0]
+            else:
+                O = C
+
+            CC = s.cache_write(C, "global")
+
+            b, y, x = s[O].op.axis
+            yo, yi = cfg["tile_y"].apply(s, O, y)
+            xo, xi = cfg["tile_x"].apply(s, O, x)
+            s[O].reorder(b, yo, xo, yi, xi)
+            s[O].parallel(b)
+            s[O].vectorize(xi)
+
+            _, k, j = s[y_t].op.axis
+            s[y_t].compute_at(s[O], b)
+            s[y_t].vectorize(j)
+
+            s[CC].compute_at(s[O], xo)
+            _, cy, cx = s[CC].op.axis
+            (k,) = s[CC].op.reduce_axis
+            s[CC].reorder(k, cy, cx)
+            s[CC].unroll(cy)
+            s[CC].vectorize(cx)
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
+@autotvm.register_topi_compute("batch_matmul_int8.x86")
+def batch_matmul_int8(cfg, x, y, out_dtype="int32"):
+    """Computes uint8 x int8 batch matrix multiplication of `x` and `y` with the
+    int8 dot product microkernel of the target.
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        Autotvm tuning space config file
+    x : tvm.te.Tensor
+        3-D uint8 with shape [batch, M, K], K must be a multiple of 4
+    y : tvm.te.Tensor
+        3-D int8 with shape [batch, N, K], N must be a multiple of the int32 lanes
+        of the microkernel
+    out_dtype : str
+        The output type, only int32 is supported
+    Returns
+    -------
+    output : tvm.te.Tensor
+        3-D with shape [batch, M, N]
+    """
+    assert len(x.shape) == 3 and len(y.shape) == 3, "only support 3-dim batch_matmul"
+    assert out_dtype == "int32", "batch_matmul_int8 only supports int32 output"
+    XB, M, XK = get_const_tuple(x.shape)
+    YB, N, YK = get_const_tuple(y.shape)
+    assert XB == YB, "batch dimension doesn't match"
+    assert XK == YK, "shapes of x and y is inconsistant"
+    B = XB
+    K = XK
+    int32_lanes = get_int8_dot_lanes()
+    assert int32_lanes != 0, "The target has no int8 dot product instructions"
+    assert N % int32_lanes == 0 and K % 4 == 0
+    _define_int8_gemm_config(cfg, M, N, K, int32_lanes)
+    cfg.add_flop(B * M * N * K * 2)
+
+    packed_y = te.compute(
+        (B, N // int32_lanes, K // 4, int32_lanes, 4),
+        lambda b, z, k, n, w: y[b, z * int32_lanes + n, k * 4 + w],
+        name="packed_y",
+    )
+    idxdiv = tvm.tir.indexdiv
+    idxmod = tvm.tir.indexmod
+    ko = te.reduce_axis((0, K // 4), name="ko")
+    ki = te.reduce_axis((0, 4), name="ki")
+    C = te.compute(
+        (B, M, N),
+        lambda b, i, j: te.sum(
+            x[b, i, ko * 4 + ki].astype(out_dtype)
+            * packed_y[b, idxdiv(j, int32_lanes), ko, idxmod(j, int32_lanes), ki].astype(
+                out_dtype
+            ),
+            axis=[ko, ki],
+        ),
+        tag="batch_matmul_int8",
+    )
+    return C
+
+
+@autotvm.register_topi_schedule("batch_matmul_int8.x86")
+def schedule_batch_matmul_int8(cfg, outs):
+    """Schedule for batch_matmul_int8
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        AutoTVM tuning space config file.
+    outs : Array of Tensor
+        The computation graph description of batch_matmul_int8
+        in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "batch_matmul_int8" in op.tag:
+            _schedule_int8_gemm(cfg, s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
 @autotvm.register_topi_compute("batch_matmul_cblas.x86")
 def batch_matmul_cblas(cfg, x, y):
     """Computes batch matrix multiplication of `x` and `y` when `x` and `y` are
@@ -29,6 +29,7 @@ from .conv2d_int8 import is_int8_hw_support, _get_default_config_int8
 from ..util import get_const_tuple
 from ..nn import conv2d_legalize, conv2d_alter_layout
 from ..nn.util import get_pad_tuple
+from ..nn.winograd_util import winograd_integer_transform_matrices
 
 logger = logging.getLogger("topi")
 
@@ -170,6 +171,41 @@ def _alter_conv2d_layout(attrs, inputs, tinfos, out_type):
 
         return relay.nn.contrib_conv2d_nchwc(data_expr, kernel_OIHWioe, **new_attrs)
 
+    if topi_tmpl == "conv2d_nchw_winograd_int8.x86":
+        assert data_layout == "NCHW" and kernel_layout == "OIHW"
+        out_channel, in_channel, kh, kw = get_const_tuple(kernel_tensor.shape)
+        tile_size = 2
+        alpha = tile_size + kh - 1
+        VC = cfg["tile_k"].size[-1]
+        _, _, G_data, _ = winograd_integer_transform_matrices(tile_size, kh)
+
+        # pre-compute the scaled weight transformation in int16, G * kernel * G^T
+        G = relay.const(G_data.astype("int16"))
+        weight_expr = relay.cast(inputs[1], "int16")
+        weight_expr = relay.nn.dense(weight_expr, G, out_dtype="int16")
+        weight_expr = relay.transpose(weight_expr, axes=(0, 1, 3, 2))
+        weight_expr = relay.nn.dense(weight_expr, G, out_dtype="int16")
+        weight_expr = relay.transpose(weight_expr, axes=(3, 2, 0, 1))
+        weight_expr = relay.reshape(
+            weight_expr, newshape=(alpha, alpha, out_channel // VC, VC, in_channel)
+        )
+        weight_expr = relay.transpose(weight_expr, axes=[0, 1, 2, 4, 3])
+
+        new_attrs["tile_size"] = tile_size
+        new_attrs["channels"] = out_channel
+
+        new_kernel = te.placeholder(
+            (alpha, alpha, out_channel // VC, in_channel, VC), dtype="int16"
+        )
+        new_workload = autotvm.task.args_to_workload(
+            [data_tensor, new_kernel, strides, padding, dilation, out_dtype],
+            topi_tmpl,
+        )
+        dispatch_ctx.update(target, new_workload, cfg)
+        return relay.nn.contrib_conv2d_winograd_without_weight_transform(
+            inputs[0], weight_expr, **new_attrs
+        )
+
     if topi_tmpl == "depthwise_conv2d_NCHWc.x86":
         if data_layout == "NCHW" and kernel_layout == "OIHW":
             if cfg.is_fallback:
@@ -30,6 +30,8 @@ from ..nn.depthwise_conv2d import _get_workload as _get_depthwise_conv2d_workloa
 from ..util import get_const_tuple, traverse_inline
 from .. import nn
 from . import conv2d_avx_1x1, conv2d_avx_common
+from .dense import _define_int8_gemm_config, _schedule_int8_gemm
+from .util import get_int8_dot_lanes
 
 
 def _get_default_config_int8(
@@ -249,3 +251,59 @@ def schedule_conv2d_nhwc_pack_int8(cfg, outs):
 
     traverse(output_op)
     return s
+
+
+@autotvm.register_topi_compute("conv2d_nhwc_1x1_int8.x86")
+def conv2d_nhwc_1x1_int8(cfg, data, kernel, strides, padding, dilation, out_dtype):
+    """Compute 1x1 conv2d with NHWC layout and int8 dtype as a GEMM over the pixels
+    with the int8 dot product microkernel of the target. The kernel is in HWIO layout,
+    the input channels must be a multiple of 4, the output channels a multiple of the
+    int32 lanes of the microkernel and the padding must be zero."""
+    assert out_dtype == "int32", "conv2d_nhwc_1x1_int8 only supports int32 output"
+    batch, in_height, in_width, in_channel = get_const_tuple(data.shape)
+    kernel_h, kernel_w, _, num_filter = get_const_tuple(kernel.shape)
+    assert kernel_h == 1 and kernel_w == 1, "Only support 1x1 kernel"
+    stride_h, stride_w = strides if isinstance(strides, (tuple, list)) else (strides, strides)
+    pad_top, pad_left, pad_down, pad_right = get_pad_tuple(padding, (1, 1))
+    assert pad_top == pad_left == pad_down == pad_right == 0, "Padding is not supported"
+    int32_lanes = get_int8_dot_lanes()
+    assert int32_lanes != 0, "The target has no int8 dot product instructions"
+    assert num_filter % int32_lanes == 0 and in_channel % 4 == 0
+
+    out_height = (in_height - 1) // stride_h + 1
+    out_width = (in_width - 1) // stride_w + 1
+    _define_int8_gemm_config(cfg, out_width, num_filter, in_channel, int32_lanes)
+    cfg.add_flop(batch * out_height * out_width * num_filter * in_channel * 2)
+
+    packed_kernel = te.compute(
+        (num_filter // int32_lanes, in_channel // 4, int32_lanes, 4),
+        lambda z, y, x, w: kernel[0, 0, y * 4 + w, z * int32_lanes + x],
+        name="packed_kernel",
+    )
+    idxd = tvm.tir.indexdiv
+    idxm = tvm.tir.indexmod
+    ko = te.reduce_axis((0, in_channel // 4), name="ko")
+    ki = te.reduce_axis((0, 4), name="ki")
+    return te.compute(
+        (batch, out_height, out_width, num_filter),
+        lambda n, h, w, f: te.sum(
+            data[n, h * stride_h, w * stride_w, ko * 4 + ki].astype(out_dtype)
+            * packed_kernel[idxd(f, int32_lanes), ko, idxm(f, int32_lanes), ki].astype(out_dtype),
+            axis=[ko, ki],
+        ),
+        name="conv2d_nhwc_1x1_int8",
+        tag="conv2d_nhwc_1x1_int8",
+    )
+
+
+@autotvm.register_topi_schedule("conv2d_nhwc_1x1_int8.x86")
+def schedule_conv2d_nhwc_1x1_int8(cfg, outs):
+    """Create the schedule for conv2d_nhwc_1x1_int8"""
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "conv2d_nhwc_1x1_int8" in op.tag:
+            _schedule_int8_gemm(cfg, s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
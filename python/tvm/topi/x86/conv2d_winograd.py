@@ -0,0 +1,329 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,unused-variable,unused-argument,no-member
+"""Winograd conv2d of quantized data on x86.
+
+The transforms are done with the integer Winograd matrices, the kernel transform G is
+scaled to be integral, so the data and the kernel are transformed exactly in int16 and
+the batched GEMM accumulates in int32. The result is exact as long as the accumulators
+do not overflow, which bounds the number of input channels, see
+winograd_int8_max_in_channel.
+"""
+import numpy as np
+
+import tvm
+from tvm import te
+from tvm import autotvm
+
+from .. import nn
+from ..nn.util import get_pad_tuple
+from ..nn.winograd_util import winograd_integer_transform_matrices
+from ..util import get_const_int, get_const_tuple, traverse_inline, const_matrix
+
+_INT16_MAX = 2 ** 15 - 1
+_INT32_MAX = 2 ** 31 - 1
+
+
+def _dtype_max_abs(dtype):
+    if dtype == "uint8":
+        return 255
+    if dtype == "int8":
+        return 128
+    raise ValueError("Unsupported data type {} for int8 winograd conv2d".format(dtype))
+
+
+def _winograd_int8_bounds(data_dtype, kernel_dtype, tile_size, kernel_size):
+    """The bounds of the transformed data and kernel, and the bounds contributed by one
+    input channel to the batched GEMM and to the output of the inverse transform."""
+    A, B, G, _ = winograd_integer_transform_matrices(tile_size, kernel_size)
+    b = np.abs(B).sum(axis=0)
+    g = np.abs(G).sum(axis=1)
+    V = np.outer(b, b) * _dtype_max_abs(data_dtype)
+    U = np.outer(g, g) * _dtype_max_abs(kernel_dtype)
+    M = U * V
+    Y = np.abs(A).T.dot(M).dot(np.abs(A))
+    return V.max(), U.max(), M.max(), Y.max()
+
+
+def winograd_int8_max_in_channel(data_dtype, kernel_dtype, tile_size=2, kernel_size=3):
+    """The accuracy guard of the int8 winograd conv2d.
+
+    Parameters
+    ----------
+    data_dtype : str
+        The data type of the data, uint8 or int8.
+    kernel_dtype : str
+        The data type of the kernel, uint8 or int8.
+    tile_size : int
+        The output tile size of the winograd transform.
+    kernel_size : int
+        The size of the kernel.
+
+    Returns
+    -------
+    max_in_channel : int
+        The max number of input channels for which the int32 accumulators of the batched
+        GEMM cannot overflow, 0 if the transformed data or kernel do not fit in int16.
+    """
+    V, U, M, _ = _winograd_int8_bounds(data_dtype, kernel_dtype, tile_size, kernel_size)
+    if V > _INT16_MAX or U > _INT16_MAX:
+        return 0
+    return int(_INT32_MAX // M)
+
+
+@autotvm.register_topi_compute("conv2d_nchw_winograd_int8.x86")
+def conv2d_nchw_winograd_int8(cfg, data, kernel, strides, padding, dilation, out_dtype):
+    """Compute conv2d with NCHW layout and int8 dtype by winograd F(2x2, 3x3).
+    The kernel is either OIHW, or pre-transformed by the int16 winograd weight transform
+    with the layout [alpha, alpha, CO // VC, CI, VC]."""
+    tile_size = 2
+    return _decl_winograd_int8(
+        cfg, data, kernel, strides, padding, dilation, out_dtype, tile_size
+    )
+
+
+@autotvm.register_topi_schedule("conv2d_nchw_winograd_int8.x86")
+def schedule_conv2d_nchw_winograd_int8(cfg, outs):
+    """Create schedule for conv2d_nchw_winograd_int8"""
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "winograd_int8_conv2d_output" in op.tag:
+            output = op.output(0)
+            _schedule_winograd_int8(cfg, s, output, outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
+def _decl_winograd_int8(cfg, data, kernel, strides, padding, dilation, out_dtype, tile_size):
+    N, CI, IH, IW = get_const_tuple(data.shape)
+    if not all(isinstance(x, int) for x in (N, CI, IH, IW)):
+        raise RuntimeError("x86 int8 winograd conv2d doesn't support dynamic shape.")
+    assert out_dtype == "int32", "int8 winograd conv2d only supports int32 output"
+
+    dilation_h, dilation_w = dilation if isinstance(dilation, (tuple, list)) else (dilation, dilation)
+    assert (dilation_h, dilation_w) == (1, 1), "Does not support dilation"
+    if len(kernel.shape) == 4:
+        pre_computed = False
+        CO, _, KH, KW = get_const_tuple(kernel.shape)
+        kernel_dtype = kernel.dtype
+    else:
+        pre_computed = True
+        H_CAT, W_CAT, CO, CI, VC = get_const_tuple(kernel.shape)
+        CO *= VC
+        KH, KW = H_CAT - tile_size + 1, W_CAT - tile_size + 1
+        # the kernel is transformed from int8 by the alter op layout
+        kernel_dtype = "int8"
+    HSTR, WSTR = strides if isinstance(strides, (tuple, list)) else (strides, strides)
+    pt, pl, pb, pr = get_pad_tuple(padding, (KH, KW))
+
+    assert KH == 3 and KW == 3 and HSTR == 1 and WSTR == 1
+    max_in_channel = winograd_int8_max_in_channel(data.dtype, kernel_dtype, tile_size, KH)
+    assert CI <= max_in_channel, (
+        "int8 winograd conv2d supports at most %d input channels without overflow" % max_in_channel
+    )
+    data_pad = nn.pad(data, (0, 0, pt, pl), (0, 0, pb, pr), name="data_pad")
+
+    idxd = tvm.tir.indexdiv
+    idxm = tvm.tir.indexmod
+
+    r = KW
+    m = tile_size
+    alpha = m + r - 1
+    A_data, B_data, G_data, scale = winograd_integer_transform_matrices(m, r)
+    # the inverse transform sums up to alpha * alpha accumulators of the batched GEMM
+    _, _, _, Y_bound = _winograd_int8_bounds(data.dtype, kernel_dtype, m, r)
+    inverse_dtype = "int32" if CI * Y_bound <= _INT32_MAX else "int64"
+    A = const_matrix(A_data.astype(inverse_dtype), "A")
+    B = const_matrix(B_data.astype("int16"), "B")
+    G = const_matrix(G_data.astype("int16"), "G")
+
+    K = CO
+    C = CI
+
+    H = (IH + pt + pb - 3) // HSTR + 1
+    W = (IW + pl + pr - 3) // WSTR + 1
+    nH, nW = (H + m - 1) // m, (W + m - 1) // m
+    P = N * nH * nW
+
+    cfg.define_split("tile_p", cfg.axis(P), num_outputs=2, filter=lambda x: x.size[-1] <= 16)
+    cfg.define_split("tile_k", cfg.axis(K), num_outputs=2, filter=lambda x: x.size[-1] <= 16)
+    VP = cfg["tile_p"].size[-1]
+    VK = cfg["tile_k"].size[-1]
+
+    # pack input tile
+    input_tile = te.compute(
+        (C, idxd(P, VP), alpha, alpha, VP),
+        lambda c, b, eps, nu, bb: data_pad[
+            idxd(b * VP + bb, nH * nW),
+            c,
+            idxm(idxd(b * VP + bb, nW), nH) * m + eps,
+            idxm(b * VP + bb, nW) * m + nu,
+        ],
+        name="d",
+    )
+
+    if autotvm.GLOBAL_SCOPE.in_tuning:
+        kvshape = (alpha, alpha, idxd(CO, VK), CI, VK)
+        U = tvm.te.placeholder(kvshape, "int16", name="U")
+    else:
+        # transform kernel
+        if pre_computed:
+            U = kernel
+        else:
+            r_kh = te.reduce_axis((0, KH), "r_kh")
+            r_kw = te.reduce_axis((0, KW), "r_kw")
+            U = te.compute(
+                (alpha, alpha, idxd(K, VK), C, VK),
+                lambda eps, nu, k, c, kk: te.sum(
+                    kernel[k * VK + kk][c][r_kh][r_kw].astype("int16")
+                    * G[eps][r_kh]
+                    * G[nu][r_kw],
+                    axis=[r_kh, r_kw],
+                ),
+                name="U",
+            )
+
+    # transform image
+    r_eps = te.reduce_axis((0, alpha), "r_eps")
+    r_nu = te.reduce_axis((0, alpha), "r_nu")
+    V = te.compute(
+        (alpha, alpha, idxd(P, VP), C, VP),
+        lambda eps, nu, b, c, bb: te.sum(
+            input_tile[c][b][r_eps][r_nu][bb].astype("int16") * B[r_eps][eps] * B[r_nu][nu],
+            axis=[r_eps, r_nu],
+        ),
+        name="V",
+    )
+
+    # batch gemm
+    c = te.reduce_axis((0, C), name="c")
+    M = te.compute(
+        (alpha, alpha, K, P),
+        lambda eps, nu, k, b: te.sum(
+            U[eps][nu][idxd(k, VK)][c][idxm(k, VK)].astype("int32")
+            * V[eps][nu][idxd(b, VP)][c][idxm(b, VP)].astype("int32"),
+            axis=c,
+        ),
+        name="M",
+    )
+
+    # inverse transform
+    r_eps = te.reduce_axis((0, alpha), "r_eps")
+    r_nu = te.reduce_axis((0, alpha), "r_nu")
+    Y = te.compute(
+        (K, P, m, m),
+        lambda k, b, vh, vw: te.sum(
+            M[r_eps][r_nu][k][b].astype(inverse_dtype) * A[r_eps][vh] * A[r_nu][vw],
+            axis=[r_eps, r_nu],
+        ),
+        name="Y",
+    )
+
+    # unpack output, the scaled kernel transform makes Y exactly scale * scale times the output
+    output = te.compute(
+        (N, K, H, W),
+        lambda n, k, h, w: tvm.tir.floordiv(
+            Y[k][n * nH * nW + idxd(h, m) * nW + idxd(w, m), idxm(h, m), idxm(w, m)],
+            scale * scale,
+        ).astype(out_dtype),
+        name="output",
+        tag="winograd_int8_conv2d_output",
+    )
+
+    # we have to manually assign effective GFLOP for winograd
+    cfg.add_flop(2 * N * K * H * W * KH * KW * C)
+    return output
+
+
+def _schedule_winograd_int8(cfg, s, output, last):
+    Y = output.op.input_tensors[0]
+    M, A = Y.op.input_tensors
+    U, V = M.op.input_tensors
+    d, B = V.op.input_tensors
+    data_pad = d.op.input_tensors[0]
+
+    # padding
+    s[data_pad].compute_inline()
+
+    # pack input tiles
+    s[d].compute_inline()
+
+    # transform kernel
+    if isinstance(U.op, tvm.te.ComputeOp):
+        kernel, G = U.op.input_tensors
+        s[G].compute_inline()
+        eps, nu, k, c, kk = s[U].op.axis
+        if autotvm.GLOBAL_SCOPE.in_tuning:
+            # kernel transformation will be pre-computed during compilation, so we skip
+            # this part to make tuning records correct
+            s[U].pragma(eps, "debug_skip_region")
+        else:
+            r_kh, r_kw = s[U].op.reduce_axis
+            s[U].reorder(k, c, eps, nu, r_kh, r_kw, kk)
+            for axis in [eps, nu, r_kh, r_kw]:
+                s[U].unroll(axis)
+            s[U].vectorize(kk)
+            s[U].parallel(k)
+
+    # transform image
+    DD = s.cache_read(d, "global", [V])
+    s[B].compute_inline()
+    eps, nu, b, c, bb = s[V].op.axis
+    r_eps, r_nu = s[V].op.reduce_axis
+    s[V].reorder(b, c, eps, nu, r_eps, r_nu, bb)
+    for axis in [eps, nu, r_eps, r_nu]:
+        s[V].unroll(axis)
+    s[DD].compute_at(s[V], c)
+    s[V].vectorize(bb)
+    s[V].parallel(b)
+
+    # batch gemm
+    eps, nu, k, b = s[M].op.axis
+    c = s[M].op.reduce_axis[0]
+    cfg.define_split("tile_c", c, num_outputs=2, filter=lambda x: x.size[-1] <= 16)
+    co, ci = cfg["tile_c"].apply(s, M, c)
+    xo, xi = cfg["tile_p"].apply(s, M, b)
+    s[M].reorder(eps, nu, xo, co, k, ci, xi)
+    cfg.define_annotate("ann_reduce", [ci], policy="try_unroll")
+    cfg.define_annotate("ann_spatial", [k, xi], policy="try_unroll_vec")
+    cfg["ann_reduce"].apply(s, M, [ci], axis_lens=[cfg["tile_c"].size[-1]], max_unroll=16, cfg=cfg)
+    cfg["ann_spatial"].apply(s, M, [k, xi])
+
+    # inverse transform
+    s[A].compute_inline()
+    k, b, vh, vw = s[Y].op.axis
+    r_eps, r_nu = s[Y].op.reduce_axis
+    for axis in [vh, vw, r_eps, r_nu]:
+        s[Y].unroll(axis)
+
+    # output
+    n, co, h, w = s[last].op.axis
+    co, coi = cfg["tile_k"].apply(s, last, co)
+    p = s[last].fuse(n, co)
+    s[M].compute_at(s[last], p)
+    s[last].parallel(p)
+
+    MM = s.cache_read(M, "global", [Y])
+    m = get_const_int(V.shape[0]) + 1 - 3
+    ho, wo, hi, wi = s[last].tile(h, w, m, m)
+    s[Y].compute_at(s[last], wo)
+    s[MM].compute_at(s[last], wo)
+
+    if output != last:
+        s[output].compute_inline()
@@ -25,9 +25,10 @@ from tvm.contrib import cblas
 from tvm.contrib import mkl
 from tvm.contrib import mkldnn
 
-from .util import get_fp32_len
+from .util import get_fp32_len, get_int8_dot_lanes
+from .tensor_intrin import dot_uint8_int8_int32
 from .. import generic, tag
-from ..util import traverse_inline, get_const_tuple
+from ..util import traverse_inline, get_const_tuple, get_max_power2_factor
 
 
 def _schedule_dense_pack_template(cfg, s, C):
@@ -232,6 +233,118 @@ def schedule_dense_pack(cfg, outs):
     return s
 
 
+def _define_int8_gemm_config(cfg, M, N, K, int32_lanes):
+    # N and K are tiled in units of the microkernel, int32_lanes outputs by 4 int8 elements
+    cfg.define_split("tile_y", M, num_outputs=2)
+    cfg.define_split("tile_x", N // int32_lanes, num_outputs=2)
+    cfg.define_split("tile_k", K // 4, num_outputs=2)
+    if cfg.is_fallback:
+        # keep the accumulators of a tile in the vector registers
+        x_bn = get_max_power2_factor(N // int32_lanes, 4 if int32_lanes == 16 else 2)
+        y_bn = get_max_power2_factor(M, 4)
+        k_bn = get_max_power2_factor(K // 4, 16)
+        cfg["tile_y"] = SplitEntity([M // y_bn, y_bn])
+        cfg["tile_x"] = SplitEntity([N // int32_lanes // x_bn, x_bn])
+        cfg["tile_k"] = SplitEntity([K // 4 // k_bn, k_bn])
+
+
+def _schedule_int8_gemm(cfg, s, C, O):
+    """Schedule the uint8 x int8 GEMM C with the int8 dot product microkernel.
+    The last two axes of C are the rows and columns of the GEMM, the others are
+    batch axes. The second input of C is the weight packed by blocks of
+    int32_lanes x 4 elements. O is the output that C is fused into.
+    """
+    int32_lanes = get_int8_dot_lanes()
+    packed_weight = C.op.input_tensors[1]
+    # the weight is packed in every run, so the tuning measures the packing too
+    axes = s[packed_weight].op.axis
+    s[packed_weight].parallel(s[packed_weight].fuse(*axes[:-3]))
+    s[packed_weight].vectorize(s[packed_weight].fuse(*axes[-2:]))
+
+    CC = s.cache_write(C, "global")
+
+    def _tile(stage):
+        axes = stage.op.axis
+        yo, yi = cfg["tile_y"].apply(s, stage, axes[-2])
+        xo, xi = stage.split(axes[-1], factor=int32_lanes)
+        xoo, xoi = cfg["tile_x"].apply(s, stage, xo)
+        stage.reorder(*axes[:-2], yo, xoo, yi, xoi, xi)
+        stage.vectorize(xi)
+        return stage.fuse(*axes[:-2], yo, xoo)
+
+    fused = _tile(s[O])
+    s[O].parallel(fused)
+    if C != O:
+        s[C].compute_at(s[O], fused)
+        _tile(s[C])
+    s[CC].compute_at(s[O], fused)
+
+    axes = s[CC].op.axis
+    ko, ki = s[CC].op.reduce_axis
+    y = axes[-2]
+    xo, xi = s[CC].split(axes[-1], factor=int32_lanes)
+    koo, koi = cfg["tile_k"].apply(s, CC, ko)
+    s[CC].reorder(*axes[:-2], koo, koi, y, xo, xi, ki)
+    s[CC].tensorize(xi, dot_uint8_int8_int32(int32_lanes))
+    s[CC].unroll(y)
+    s[CC].unroll(xo)
+    return s
+
+
+@autotvm.register_topi_compute("dense_int8.x86")
+def dense_int8(cfg, data, weight, bias=None, out_dtype=None):
+    """Compute uint8 x int8 dense with the int8 dot product microkernel of the target.
+    The weight is packed by blocks of int32_lanes x 4 elements, which requires out_dim
+    to be a multiple of int32_lanes and in_dim to be a multiple of 4."""
+    if out_dtype is None:
+        out_dtype = "int32"
+    assert out_dtype == "int32", "dense_int8 only supports int32 output"
+    M, K = get_const_tuple(data.shape)
+    N, _ = get_const_tuple(weight.shape)
+    int32_lanes = get_int8_dot_lanes()
+    assert int32_lanes != 0, "The target has no int8 dot product instructions"
+    assert N % int32_lanes == 0 and K % 4 == 0
+    _define_int8_gemm_config(cfg, M, N, K, int32_lanes)
+    cfg.add_flop(M * N * K * 2)
+
+    packw_shape = (N // int32_lanes, K // 4, int32_lanes, 4)
+    packw = te.compute(
+        packw_shape,
+        lambda z, y, x, w: weight[z * int32_lanes + x, y * 4 + w],
+        name="packed_weight",
+    )
+
+    idxdiv = tvm.tir.indexdiv
+    idxmod = tvm.tir.indexmod
+    ko = te.reduce_axis((0, K // 4), name="ko")
+    ki = te.reduce_axis((0, 4), name="ki")
+    C = te.compute(
+        (M, N),
+        lambda y, x: te.sum(
+            data[y, ko * 4 + ki].astype(out_dtype)
+            * packw[idxdiv(x, int32_lanes), ko, idxmod(x, int32_lanes), ki].astype(out_dtype),
+            axis=[ko, ki],
+        ),
+        tag="dense_int8",
+    )
+    if bias is not None:
+        C = te.compute((M, N), lambda i, j: C[i, j] + bias[j].astype(out_dtype), tag=tag.BROADCAST)
+    return C
+
+
+@autotvm.register_topi_schedule("dense_int8.x86")
+def schedule_dense_int8(cfg, outs):
+    """Create the schedule for dense_int8"""
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "dense_int8" in op.tag:
+            _schedule_int8_gemm(cfg, s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
 def dense_blas_common(cfg, data, weight, bias, out_dtype, lib):
     """Compute dense using a BLAS library"""
     M, K = get_const_tuple(data.shape)
@@ -0,0 +1,226 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name, too-many-arguments
+"""Detection post-processing operators computed by the native CPU kernels of contrib sort.
+
+They compute the same results as the hybrid script versions in topi.vision, but run in parallel
+over the batches and the classes, and select the top k boxes without sorting all of them.
+"""
+import tvm
+from tvm import te
+from ..util import get_const_int
+
+
+def native_vision_enabled():
+    """Whether the native kernels are available, they are built with contrib sort."""
+    func = tvm.get_global_func("tvm.contrib.vision.non_max_suppression", allow_missing=True)
+    return func is not None
+
+
+def get_valid_counts(data, score_threshold=0, id_index=0, score_index=1):
+    """Get valid count of bounding boxes given a score threshold.
+    Also moves valid boxes to the top of input data.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        Input data. 3-D tensor with shape [batch_size, num_anchors, 6]
+        or [batch_size, num_anchors, 5].
+
+    score_threshold : optional, float
+        Lower limit of score for valid bounding boxes.
+
+    id_index : optional, int
+        index of the class categories, -1 to disable.
+
+    score_index: optional, int
+        Index of the scores/confidence of boxes.
+
+    Returns
+    -------
+    valid_count : tvm.te.Tensor
+        1-D tensor for valid number of boxes.
+
+    out_tensor : tvm.te.Tensor
+        Rearranged data tensor.
+
+    out_indices: tvm.te.Tensor
+        Related index in input data.
+    """
+    batch_size, num_anchors, _ = data.shape
+    return te.extern(
+        [(batch_size,), data.shape, (batch_size, num_anchors)],
+        [data],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.vision.get_valid_counts",
+            ins[0],
+            outs[0],
+            outs[1],
+            outs[2],
+            float(score_threshold),
+            id_index,
+            score_index,
+        ),
+        dtype=["int32", data.dtype, "int32"],
+        name="get_valid_counts_cpu",
+        tag="get_valid_counts_cpu",
+    )
+
+
+def non_max_suppression(
+    data,
+    valid_count,
+    indices,
+    max_output_size=-1,
+    iou_threshold=0.5,
+    force_suppress=False,
+    top_k=-1,
+    coord_start=2,
+    score_index=1,
+    id_index=0,
+    return_indices=True,
+    invalid_to_bottom=False,
+):
+    """Non-maximum suppression operator for object detection.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        3-D tensor with shape [batch_size, num_anchors, 6] or [batch_size, num_anchors, 5].
+
+    valid_count : tvm.te.Tensor
+        1-D tensor for valid number of boxes.
+
+    indices : tvm.te.Tensor
+        2-D tensor with shape [batch_size, num_anchors].
+
+    max_output_size : optional, int
+        Max number of output valid boxes for each instance.
+        Return all valid boxes if the value of max_output_size is less than 0.
+
+    iou_threshold : optional, float
+        Non-maximum suppression threshold.
+
+    force_suppress : optional, boolean
+        Whether to suppress all detections regardless of class_id.
+
+    top_k : optional, int
+        Keep maximum top k detections before nms, -1 for no limit.
+
+    coord_start : required, int
+        Start index of the consecutive 4 coordinates.
+
+    score_index: optional, int
+        Index of the scores/confidence of boxes.
+
+    id_index : optional, int
+        index of the class categories, -1 to disable.
+
+    return_indices : optional, boolean
+        Whether to return box indices in input data.
+
+    invalid_to_bottom : optional, boolean
+        Whether to move all valid bounding boxes to the top.
+
+    Returns
+    -------
+    out : tvm.te.Tensor or list of tvm.te.Tensor
+        3-D tensor with shape [batch_size, num_anchors, 6] or [batch_size, num_anchors, 5], or
+        the 2-D tensor of the box indices with shape [batch_size, num_anchors] and the number of
+        valid boxes with shape [batch_size, 1] if return_indices is True.
+    """
+    batch_size, num_anchors, _ = data.shape
+    if return_indices:
+        out_shapes = [(batch_size, num_anchors), (batch_size, 1)]
+        out_dtypes = ["int32", "int32"]
+    else:
+        out_shapes = [data.shape]
+        out_dtypes = [data.dtype]
+    out = te.extern(
+        out_shapes,
+        [data, valid_count, indices],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.vision.non_max_suppression",
+            ins[0],
+            ins[1],
+            ins[2],
+            *outs,
+            get_const_int(max_output_size),
+            float(iou_threshold),
+            force_suppress,
+            top_k,
+            coord_start,
+            score_index,
+            id_index,
+            return_indices,
+            invalid_to_bottom,
+        ),
+        dtype=out_dtypes,
+        name="nms_cpu",
+        tag="nms_cpu",
+    )
+    return out
+
+
+def multibox_transform_loc(
+    cls_prob, loc_pred, anchor, clip=True, threshold=0.01, variances=(0.1, 0.1, 0.2, 0.2)
+):
+    """Location transformation for multibox detection
+
+    Parameters
+    ----------
+    cls_prob : tvm.te.Tensor
+        Class probabilities.
+
+    loc_pred : tvm.te.Tensor
+        Location regression predictions.
+
+    anchor : tvm.te.Tensor
+        Prior anchor boxes.
+
+    clip : boolean
+        Whether to clip out-of-boundary boxes.
+
+    threshold : float
+        Threshold to be a positive prediction.
+
+    variances : tuple of float
+        Variances to be decoded from box regression output.
+
+    Returns
+    -------
+    ret : tuple of tvm.te.Tensor
+    """
+    batch_size, _, num_anchors = cls_prob.shape
+    return te.extern(
+        [(batch_size, num_anchors, 6), (batch_size,)],
+        [cls_prob, loc_pred, anchor],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.vision.multibox_transform_loc",
+            ins[0],
+            ins[1],
+            ins[2],
+            outs[0],
+            outs[1],
+            clip,
+            float(threshold),
+            *[float(v) for v in variances],
+        ),
+        dtype=[loc_pred.dtype, "int32"],
+        name="multibox_transform_loc_cpu",
+        tag="multibox_transform_loc_cpu",
+    )
@@ -15,10 +15,13 @@
 # specific language governing permissions and limitations
 # under the License.
 
-"""sparse_dense schedule on x86"""
+"""sparse_dense and sparse_conv2d schedules on x86"""
 from tvm import te
+from tvm import autotvm
+from tvm.autotvm.task.space import SplitEntity
 
-from ..util import traverse_inline, get_const_int
+from .. import nn
+from ..util import traverse_inline, get_const_int, get_const_tuple
 from .util import get_fp32_len
 
 
@@ -58,3 +61,152 @@ def schedule_sparse_dense(outs):
 
     traverse_inline(s, outs[0].op, _callback)
     return s
+
+
+def _largest_factor(n, max_value):
+    for factor in range(min(n, max_value), 0, -1):
+        if n % factor == 0:
+            return factor
+    return 1
+
+
+@autotvm.register_topi_compute("sparse_dense_bsr.x86")
+def sparse_dense_bsr(cfg, data, weight_data, weight_indices, weight_indptr):
+    """Compute sparse_dense with a block sparse weight on x86, see topi.nn.sparse_dense.
+
+    The reduction of the weight is data dependent, so tuning the template needs the real
+    weight as the reference input of the runner instead of random data.
+    """
+    assert len(weight_data.shape) == 3, "sparse_dense_bsr.x86 only supports BSR weights"
+    m, _ = get_const_tuple(data.shape)
+    cfg.define_split("tile_m", m, num_outputs=2, filter=lambda x: x.size[-1] <= 16)
+    cfg.define_knob("unroll_rows", [True, False])
+    if cfg.is_fallback:
+        cfg["tile_m"] = SplitEntity([-1, _largest_factor(m, 8)])
+    return nn.sparse_dense(data, weight_data, weight_indices, weight_indptr)
+
+
+@autotvm.register_topi_schedule("sparse_dense_bsr.x86")
+def schedule_sparse_dense_bsr(cfg, outs):
+    """Create schedule for sparse_dense_bsr.
+
+    Every task computes a tile of the rows of data for one block row of the weight, the
+    accumulators of the tile stay in registers while the non-zero blocks of the row are
+    streamed. The rows of a block are vectorized.
+    """
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if op.tag == "sparse_dense_bsrmm":
+            _schedule_sparse_dense_bsr(cfg, s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
+def _schedule_sparse_dense_bsr(cfg, s, output, last):
+    bsr_block = output.op.input_tensors[0]
+    if output.op != last.op:
+        s[output].compute_inline()
+
+    bs_r = get_const_int(bsr_block.op.axis[2].dom.extent)
+    m, n = s[last].op.axis
+    mo, mi = cfg["tile_m"].apply(s, last, m)
+    no, ni = s[last].split(n, bs_r)
+    s[last].reorder(mo, no, mi, ni)
+    fused = s[last].fuse(mo, no)
+    s[last].parallel(fused)
+    s[last].vectorize(ni)
+    s[bsr_block].compute_at(s[last], fused)
+
+    b_m, b_nb, b_r = s[bsr_block].op.axis
+    elem_idx, c = s[bsr_block].op.reduce_axis
+    s[bsr_block].reorder(b_nb, elem_idx, c, b_m, b_r)
+    if cfg["unroll_rows"].val:
+        s[bsr_block].unroll(b_m)
+    s[bsr_block].vectorize(b_r)
+
+
+@autotvm.register_topi_compute("sparse_conv2d.x86")
+def sparse_conv2d(
+    cfg, dense_data, sparse_data, sparse_indices, sparse_indptr, layout="NHWC", kernel_size=1
+):
+    """Compute sparse_conv2d with a block sparse kernel on x86, see topi.nn.sparse_conv2d.
+
+    The reduction of the kernel is data dependent, so tuning the template needs the real
+    kernel as the reference input of the runner instead of random data.
+    """
+    if layout == "NHWC":
+        width = get_const_tuple(dense_data.shape)[2]
+        max_tile = 16
+    else:
+        width = get_const_tuple(dense_data.shape)[3]
+        max_tile = 4 * get_fp32_len()
+    cfg.define_split("tile_w", width, num_outputs=2, filter=lambda x: x.size[-1] <= max_tile)
+    cfg.define_knob("unroll_kernel", [True, False])
+    if cfg.is_fallback:
+        cfg["tile_w"] = SplitEntity([-1, _largest_factor(width, max_tile // 2)])
+    return nn.sparse_conv2d(
+        dense_data, sparse_data, sparse_indices, sparse_indptr, layout, kernel_size
+    )
+
+
+@autotvm.register_topi_schedule("sparse_conv2d.x86")
+def schedule_sparse_conv2d(cfg, outs):
+    """Create schedule for sparse_conv2d.
+
+    Every task computes a tile of the output width for one block row of the kernel, the
+    accumulators of the tile stay in registers while the non-zero blocks of the row are
+    streamed. NHWC vectorizes over the rows of a block, NCHW over the width.
+    """
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if op.tag in ("sparse_conv2d_nhwc_bsr", "sparse_conv2d_nchw_bsr"):
+            _schedule_sparse_conv2d(cfg, s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
+def _schedule_sparse_conv2d(cfg, s, output, last):
+    bsr_block = output.op.input_tensors[0]
+    data = bsr_block.op.input_tensors[0]
+    if isinstance(data.op, te.ComputeOp) and "pad" in data.op.tag:
+        s[data].compute_inline()
+    if output.op != last.op:
+        s[output].compute_inline()
+
+    elem_idx, c = s[bsr_block].op.reduce_axis
+    if output.op.tag == "sparse_conv2d_nhwc_bsr":
+        bs_r = get_const_int(bsr_block.op.axis[4].dom.extent)
+        n, h, w, oc = s[last].op.axis
+        wo, wi = cfg["tile_w"].apply(s, last, w)
+        oco, oci = s[last].split(oc, bs_r)
+        s[last].reorder(n, h, wo, oco, wi, oci)
+        fused = s[last].fuse(n, h, wo)
+        s[last].parallel(fused)
+        s[last].vectorize(oci)
+        s[bsr_block].compute_at(s[last], oco)
+
+        b_n, b_h, b_w, b_nb, b_r = s[bsr_block].op.axis
+        s[bsr_block].reorder(b_n, b_h, b_nb, elem_idx, c, b_w, b_r)
+        if cfg["unroll_kernel"].val:
+            s[bsr_block].unroll(b_w)
+        s[bsr_block].vectorize(b_r)
+    else:
+        bs_r = get_const_int(bsr_block.op.axis[2].dom.extent)
+        n, oc, h, w = s[last].op.axis
+        oco, oci = s[last].split(oc, bs_r)
+        wo, wi = cfg["tile_w"].apply(s, last, w)
+        s[last].reorder(n, oco, h, wo, oci, wi)
+        fused = s[last].fuse(n, oco, h)
+        s[last].parallel(fused)
+        s[last].vectorize(wi)
+        s[bsr_block].compute_at(s[last], wo)
+
+        b_n, b_nb, b_r, b_h, b_w = s[bsr_block].op.axis
+        s[bsr_block].reorder(b_n, b_nb, b_h, elem_idx, c, b_r, b_w)
+        if cfg["unroll_kernel"].val:
+            s[bsr_block].unroll(b_r)
+        s[bsr_block].vectorize(b_w)
@@ -35,6 +35,121 @@ def dot_16x1x16_uint8_int8_int32():
     return dot_16x1x16_uint8_int8_int32_cascadelake()
 
 
+def dot_uint8_int8_int32(int32_lanes):
+    """Dispatch the exact uint8 x int8 dot product microkernel with int32_lanes outputs.
+    The 16 lanes microkernel uses the VNNI instructions, the 8 lanes one the AVX2
+    instructions. Neither saturates its intermediate sums, unlike vpmaddubsw."""
+    if int32_lanes == 16:
+        return dot_16x1x16_uint8_int8_int32_cascadelake()
+    assert int32_lanes == 8, "No int8 dot product microkernel with %d lanes" % int32_lanes
+    return dot_8x1x8_uint8_int8_int32_avx2()
+
+
+def dot_8x1x8_uint8_int8_int32_avx2():
+    """
+    Int8 dot product by every 4 elements using AVX2 instructions.
+    This function takes two arrays of uint8 and int8 datatype -- data[4] and
+    kernel[8][4] -- and computes a dot product of data[4] with every
+    4 elements of kernels, resulting in output[8] of int32 datatype.
+    The pseudo code is as follows.
+    .. code-block:: c
+        void dot_8x1x8_uint8_int8_int32_avx2(uint8 data[4], int8 kernel[8][4],
+                int32 output[8]){
+            for (int i = 0; i < 8; i++){
+                output[i] = 0;
+                for (int k = 0; k < 4; k++){
+                    output[i] += data[k] * kernel[i][k]
+                }
+            }
+        }
+
+    Physically, the kernel array is widened to int16 in two AVX2 vector registers,
+    and the data[4] is widened to int16 and broadcasted to another AVX2 vector
+    register. vpmaddwd computes the sums of the pairs of products in int32, which
+    unlike the int16 sums of vpmaddubsw cannot saturate, and vphaddd adds up the
+    pairs. This function returns a TensorIntrin that can be used to tensorize
+    a schedule.
+
+    Returns
+    -------
+    intrin : TensorIntrin
+        The AVX2 int8 TensorIntrin that can be used in tensorizing schedule
+    """
+
+    int32_lanes = 8  # 8 int32 lanes in AVX2
+    num_int8_elements = 4  # 4 int8 elements in int32
+    data = te.placeholder((num_int8_elements,), dtype="uint8", name="data")
+    kernel = te.placeholder((int32_lanes, num_int8_elements), dtype="int8", name="kernel")
+    k = te.reduce_axis((0, num_int8_elements), name="k")
+    C = te.compute(
+        (int32_lanes,),
+        lambda i: te.sum(data[k].astype("int32") * kernel[i, k].astype("int32"), axis=k),
+        name="C",
+    )
+
+    a_buffer = tvm.tir.decl_buffer(
+        data.shape, dtype="uint8", name="a_buffer", offset_factor=1, strides=[1]
+    )
+    b_buffer = tvm.tir.decl_buffer(
+        kernel.shape, dtype="int8", name="b_buffer", offset_factor=1, strides=[te.var("ldw"), 1]
+    )
+
+    def _intrin_func(ins, outs):
+        def _instr(index):
+            ib = tvm.tir.ir_builder.create()
+            if index == 1:
+                ib.emit(outs[0].vstore(0, tvm.tir.const(0, "int32x8")))
+                return ib.get()
+
+            a_int16 = ins[0].vload([0], "uint8x4").astype("int16x4")
+            re_int64 = tvm.tir.call_intrin("int64", "tir.reinterpret", a_int16)
+            vec_ai64 = re_int64.astype("int64x4")
+            vec_a = tvm.tir.call_intrin("int16x16", "tir.reinterpret", vec_ai64)
+            # the rows 0-3 and 4-7 of the kernel
+            vec_b_lo = ins[1].vload([0, 0], "int8x16").astype("int16x16")
+            vec_b_hi = ins[1].vload([4, 0], "int8x16").astype("int16x16")
+            pair_lo = tvm.tir.call_llvm_pure_intrin(
+                "int32x8",
+                "llvm.x86.avx2.pmadd.wd",
+                tvm.tir.const(0, "uint32"),
+                vec_b_lo,
+                vec_a,
+            )
+            pair_hi = tvm.tir.call_llvm_pure_intrin(
+                "int32x8",
+                "llvm.x86.avx2.pmadd.wd",
+                tvm.tir.const(0, "uint32"),
+                vec_b_hi,
+                vec_a,
+            )
+            # vphaddd adds up the pairs within the 128-bit lanes, which gives the
+            # rows in the order 0, 1, 4, 5, 2, 3, 6, 7
+            quad_reduction = tvm.tir.call_llvm_pure_intrin(
+                "int32x8",
+                "llvm.x86.avx2.phadd.d",
+                tvm.tir.const(0, "uint32"),
+                pair_lo,
+                pair_hi,
+            )
+            quad_reduction = tvm.tir.Shuffle([quad_reduction], [0, 1, 4, 5, 2, 3, 6, 7])
+            if index == 0:
+                ib.emit(outs[0].vstore(0, quad_reduction))
+            else:
+                ib.emit(outs[0].vstore(0, quad_reduction + outs[0].vload([0], "int32x8")))
+            return ib.get()
+
+        # body, reset, update
+        return _instr(0), _instr(1), _instr(2)
+
+    buffer_params = {"offset_factor": 1}
+    return te.decl_tensor_intrin(
+        C.op,
+        _intrin_func,
+        binds={data: a_buffer, kernel: b_buffer},
+        default_buffer_params=buffer_params,
+    )
+
+
 def dot_16x1x16_uint8_int8_int32_skylake():
     """
     Int8 dot product by every 4 elements using AVX512 Skylake instructions.
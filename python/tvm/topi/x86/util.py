@@ -24,3 +24,26 @@ def get_fp32_len():
     if mcpu in ("skylake-avx512", "cascadelake"):
         fp32_vec_len = 16
     return fp32_vec_len
+
+
+def get_int8_dot_lanes():
+    """The number of int32 lanes of the uint8 x int8 dot product microkernel of the
+    current target, 0 if the target has no fast int8 dot product. The AVX-512 cpus
+    without VNNI use the AVX2 microkernel, as vpmaddubsw saturates."""
+    target = tvm.target.Target.current(allow_none=True)
+    if target is None:
+        return 0
+    mcpu = target.mcpu
+    if mcpu == "cascadelake":
+        return 16
+    if mcpu in (
+        "core-avx2",
+        "haswell",
+        "broadwell",
+        "skylake",
+        "skylake-avx512",
+        "znver1",
+        "znver2",
+    ):
+        return 8
+    return 0
@@ -37,7 +37,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <list>
+#include <mutex>
 #include <numeric>
+#include <sstream>
 #include <unordered_map>
 #include <vector>
 
@@ -1330,6 +1333,112 @@ void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, i
   }
 }
 
+/*! \brief A thread-safe LRU cache for the per-store features of states */
+class PerStoreFeatureCache {
+ public:
+  /*! \brief Get the global cache */
+  static PerStoreFeatureCache* Global() {
+    static PerStoreFeatureCache inst;
+    return &inst;
+  }
+
+  /*!
+   * \brief Look up the feature of a state
+   * \param key The key of the state
+   * \param feature The returned feature
+   * \return Whether the key is found
+   */
+  bool Get(const std::string& key, std::vector<float>* feature) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      miss_ct_++;
+      return false;
+    }
+    hit_ct_++;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *feature = it->second->second;
+    return true;
+  }
+
+  /*!
+   * \brief Insert the feature of a state and evict the least recently used entries
+   * \param key The key of the state
+   * \param feature The feature of the state
+   */
+  void Put(const std::string& key, const std::vector<float>& feature) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0 || index_.count(key)) {
+      return;
+    }
+    entries_.emplace_front(key, feature);
+    index_[key] = entries_.begin();
+    Shrink();
+  }
+
+  void SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    Shrink();
+  }
+
+  size_t capacity() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+  }
+
+  void GetStats(size_t* hit_ct, size_t* miss_ct) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *hit_ct = hit_ct_;
+    *miss_ct = miss_ct_;
+  }
+
+ private:
+  void Shrink() {
+    while (entries_.size() > capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+  std::mutex mutex_;
+  /*! \brief The maximum number of cached states */
+  size_t capacity_{8192};
+  /*! \brief The cached (key, feature) pairs, from the most to the least recently used */
+  std::list<std::pair<std::string, std::vector<float>>> entries_;
+  /*! \brief Map from the key to its position in entries_ */
+  std::unordered_map<std::string, std::list<std::pair<std::string, std::vector<float>>>::iterator>
+      index_;
+  size_t hit_ct_{0};
+  size_t miss_ct_{0};
+};
+
+void SetPerStoreFeatureCacheCapacity(size_t capacity) {
+  PerStoreFeatureCache::Global()->SetCapacity(capacity);
+}
+
+void GetPerStoreFeatureCacheStats(size_t* hit_ct, size_t* miss_ct) {
+  PerStoreFeatureCache::Global()->GetStats(hit_ct, miss_ct);
+}
+
+/*!
+ * \brief Serialize the transform steps of a state. The lowered program, and thus its feature, is
+ * fully determined by the search task and these steps, so this is used as the cache key.
+ */
+std::string SerializeStepsForFeatureCache(const State& state) {
+  std::ostringstream os;
+  dmlc::JSONWriter writer(&os);
+  writer.BeginArray(false);
+  for (const auto& step : state->transform_steps) {
+    writer.WriteArraySeperator();
+    writer.BeginArray(false);
+    step->WriteToRecord(&writer);
+    writer.EndArray();
+  }
+  writer.EndArray();
+  return os.str();
+}
+
 void GetPerStoreFeaturesFromStates(const Array<State>& states, const SearchTask& task,
                                    int skip_first_n_feature_extraction, int max_n_bufs,
                                    std::vector<std::vector<float>>* features) {
@@ -1338,11 +1447,29 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const SearchTask&
 
   std::atomic<int> error_ct(0);
 
-  support::parallel_for(skip_first_n_feature_extraction, states.size(),
-                        [&task, &states, &max_n_bufs, &features, &error_ct](int i) {
-                          GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs,
-                                                        &(*features)[i], &error_ct);
-                        });
+  PerStoreFeatureCache* cache = PerStoreFeatureCache::Global();
+  if (cache->capacity() == 0) {
+    support::parallel_for(skip_first_n_feature_extraction, states.size(),
+                          [&task, &states, &max_n_bufs, &features, &error_ct](int i) {
+                            GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs,
+                                                          &(*features)[i], &error_ct);
+                          });
+  } else {
+    std::ostringstream prefix_os;
+    prefix_os << task->workload_key << "|" << task->target->str() << "|"
+              << task->hardware_params->cache_line_bytes << "|" << max_n_bufs << "|";
+    const std::string prefix = prefix_os.str();
+    support::parallel_for(
+        skip_first_n_feature_extraction, states.size(),
+        [&task, &states, &max_n_bufs, &features, &error_ct, &prefix, cache](int i) {
+          std::string key = prefix + SerializeStepsForFeatureCache(states[i]);
+          if (!cache->Get(key, &(*features)[i])) {
+            GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs, &(*features)[i],
+                                          &error_ct);
+            cache->Put(key, (*features)[i]);
+          }
+        });
+  }
 
   if (error_ct > 0) {
     std::cerr << "Encountered " << error_ct
@@ -1632,6 +1759,18 @@ TVM_REGISTER_GLOBAL("auto_scheduler.GetPerStoreFeaturesFromStates")
                                std::move(task_ids), &byte_data);
     });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.SetPerStoreFeatureCacheCapacity")
+    .set_body_typed([](int capacity) {
+      CHECK_GE(capacity, 0);
+      SetPerStoreFeatureCacheCapacity(capacity);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.GetPerStoreFeatureCacheStats").set_body_typed([]() {
+  size_t hit_ct, miss_ct;
+  GetPerStoreFeatureCacheStats(&hit_ct, &miss_ct);
+  return Array<Integer>{Integer(static_cast<int>(hit_ct)), Integer(static_cast<int>(miss_ct))};
+});
+
 TVM_REGISTER_GLOBAL("auto_scheduler.GetPerStoreFeatureNames")
     .set_body([](TVMArgs args, TVMRetValue* ret) {
       int max_n_bufs = args[0];
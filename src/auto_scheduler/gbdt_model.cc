@@ -0,0 +1,650 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_scheduler/gbdt_model.cc
+ * \brief A gradient boosted decision tree cost model implemented in C++.
+ */
+
+#include <tvm/auto_scheduler/cost_model.h>
+#include <tvm/auto_scheduler/feature.h>
+#include <tvm/auto_scheduler/measure_record.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
+
+namespace tvm {
+namespace auto_scheduler {
+
+TVM_REGISTER_OBJECT_TYPE(GBDTModelNode);
+
+/*! \brief The magic string at the beginning of a saved model file */
+static const char* GBDT_MODEL_MAGIC = "tvm.auto_scheduler.GBDTModel";
+/*! \brief The version of the saved model file format */
+static const int GBDT_MODEL_VERSION = 1;
+
+int RegressionTree::AddLeaf(float value) {
+  split_feature.push_back(-1);
+  split_value.push_back(0.0f);
+  left_child.push_back(-1);
+  right_child.push_back(-1);
+  leaf_value.push_back(value);
+  return static_cast<int>(leaf_value.size()) - 1;
+}
+
+float RegressionTree::Predict(const float* row) const {
+  int nid = 0;
+  while (left_child[nid] != -1) {
+    nid = row[split_feature[nid]] < split_value[nid] ? left_child[nid] : right_child[nid];
+  }
+  return leaf_value[nid];
+}
+
+/*!
+ * \brief The training data of GBDTModel in the pack-sum format.
+ * All per-store feature rows of a state form a "pack", and the prediction of a state is the
+ * sum of the predictions of the rows in its pack.
+ */
+class GBDTTrainer {
+ public:
+  GBDTTrainer(const GBDTModelNode* model, int n_features)
+      : model_(model), n_features_(n_features) {}
+
+  /*!
+   * \brief Add the feature rows of one state to the training set
+   * \param feature The flatten per-store feature of the state
+   * \param label The normalized throughput of the state
+   */
+  void AddPack(const std::vector<float>& feature, float label) {
+    if (feature.empty()) {
+      // The state failed to be lowered
+      return;
+    }
+    int n_stmts = static_cast<int>(feature[0]);
+    CHECK_EQ(feature.size(), 1 + static_cast<size_t>(n_stmts) * n_features_);
+    if (n_stmts == 0) {
+      return;
+    }
+    int pack_id = static_cast<int>(labels_.size());
+    rows_.insert(rows_.end(), feature.begin() + 1, feature.end());
+    pack_ids_.insert(pack_ids_.end(), n_stmts, pack_id);
+    labels_.push_back(label);
+    // Weight samples by their throughputs, so the model focuses on the good programs
+    weights_.push_back(label);
+  }
+
+  /*! \return The number of feature rows in the training set */
+  size_t NumRows() const { return pack_ids_.size(); }
+
+  /*!
+   * \brief Compute the quantile cut points of all features from the training set
+   * \param cuts The returned cut points
+   */
+  void ComputeCuts(std::vector<std::vector<float>>* cuts) const {
+    size_t n_rows = NumRows();
+    int max_bin = model_->max_bin;
+    cuts->assign(n_features_, std::vector<float>());
+    support::parallel_for(0, n_features_, [this, n_rows, max_bin, &cuts](int f) {
+      std::vector<float> values(n_rows);
+      for (size_t r = 0; r < n_rows; ++r) {
+        values[r] = rows_[r * n_features_ + f];
+      }
+      std::sort(values.begin(), values.end());
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+
+      // A row goes to bin b iff cut[b - 1] <= value < cut[b]
+      std::vector<float>& cut = (*cuts)[f];
+      if (static_cast<int>(values.size()) <= max_bin) {
+        cut.assign(values.begin() + std::min<size_t>(1, values.size()), values.end());
+      } else {
+        for (int k = 1; k < max_bin; ++k) {
+          float value = values[values.size() * k / max_bin];
+          if (cut.empty() || value > cut.back()) {
+            cut.push_back(value);
+          }
+        }
+      }
+    });
+  }
+
+  /*!
+   * \brief Boost new trees on top of the existing trees.
+   * \param cuts The cut points used for histogram binning
+   * \param max_rounds The maximum number of trees to add
+   * \param trees The existing trees. The new trees are appended to it.
+   */
+  void Boost(const std::vector<std::vector<float>>& cuts, int max_rounds,
+             std::vector<RegressionTree>* trees) {
+    size_t n_rows = NumRows();
+    if (n_rows == 0) {
+      return;
+    }
+    CHECK_EQ(cuts.size(), static_cast<size_t>(n_features_));
+    BuildBins(cuts);
+
+    // Initialize the row predictions with the existing trees
+    row_preds_.assign(n_rows, 0.0f);
+    support::parallel_for(0, static_cast<int>(n_rows), [this, &trees](int r) {
+      const float* row = &rows_[static_cast<size_t>(r) * n_features_];
+      for (const auto& tree : *trees) {
+        row_preds_[r] += tree.Predict(row);
+      }
+    });
+
+    double best_loss = ComputeLoss();
+    size_t best_n_trees = trees->size();
+    std::vector<float> grad(n_rows), hess(n_rows);
+    std::vector<int> row_leaf;
+    for (int round = 0; round < max_rounds; ++round) {
+      // Gradients of the pack-sum square error
+      for (size_t r = 0; r < n_rows; ++r) {
+        int pack_id = pack_ids_[r];
+        grad[r] = (pack_preds_[pack_id] - labels_[pack_id]) * weights_[pack_id];
+        hess[r] = weights_[pack_id];
+      }
+
+      trees->push_back(BuildTree(cuts, grad, hess, &row_leaf));
+      const RegressionTree& tree = trees->back();
+      for (size_t r = 0; r < n_rows; ++r) {
+        row_preds_[r] += tree.leaf_value[row_leaf[r]];
+      }
+
+      double loss = ComputeLoss();
+      if (loss < best_loss) {
+        best_loss = loss;
+        best_n_trees = trees->size();
+      } else if (static_cast<int>(trees->size() - best_n_trees) >= model_->early_stopping_rounds) {
+        break;
+      }
+    }
+    trees->resize(best_n_trees);
+  }
+
+ private:
+  /*! \brief A split candidate of a tree node */
+  struct SplitEntry {
+    /*! \brief The loss reduction of this split */
+    double gain{0.0};
+    /*! \brief The feature to split on, -1 if no valid split is found */
+    int feature{-1};
+    /*! \brief Rows with bin index less than or equal to this go to the left child */
+    int bin{-1};
+    /*! \brief The gradient and hessian sums of the left child */
+    double left_grad{0.0}, left_hess{0.0};
+  };
+
+  /*! \brief Quantize all feature values into bin indices */
+  void BuildBins(const std::vector<std::vector<float>>& cuts) {
+    size_t n_rows = NumRows();
+    bins_.resize(n_rows * n_features_);
+    support::parallel_for(0, n_features_, [this, n_rows, &cuts](int f) {
+      const std::vector<float>& cut = cuts[f];
+      uint8_t* col = &bins_[f * n_rows];
+      for (size_t r = 0; r < n_rows; ++r) {
+        col[r] = static_cast<uint8_t>(
+            std::upper_bound(cut.begin(), cut.end(), rows_[r * n_features_ + f]) - cut.begin());
+      }
+    });
+  }
+
+  /*! \brief Sum up the row predictions and return the root mean square error of all packs */
+  double ComputeLoss() {
+    pack_preds_.assign(labels_.size(), 0.0f);
+    for (size_t r = 0; r < row_preds_.size(); ++r) {
+      pack_preds_[pack_ids_[r]] += row_preds_[r];
+    }
+    double sum = 0.0;
+    for (size_t i = 0; i < labels_.size(); ++i) {
+      double diff = pack_preds_[i] - labels_[i];
+      sum += diff * diff;
+    }
+    return std::sqrt(sum / labels_.size());
+  }
+
+  /*! \brief The (unshrunk) optimal leaf value for the given gradient statistics */
+  double CalcWeight(double grad, double hess) const { return -grad / (hess + model_->reg_lambda); }
+
+  /*! \brief The loss reduction contributed by a node with the given gradient statistics */
+  double CalcGain(double grad, double hess) const {
+    return grad * grad / (hess + model_->reg_lambda);
+  }
+
+  /*!
+   * \brief Grow one tree level by level with histograms.
+   * \param cuts The cut points used for histogram binning
+   * \param grad The gradient of every row
+   * \param hess The hessian of every row
+   * \param row_leaf The returned leaf index of every row
+   * \return The new tree
+   */
+  RegressionTree BuildTree(const std::vector<std::vector<float>>& cuts,
+                           const std::vector<float>& grad, const std::vector<float>& hess,
+                           std::vector<int>* row_leaf) {
+    size_t n_rows = NumRows();
+    RegressionTree tree;
+    std::vector<int>& row_node = *row_leaf;
+    row_node.assign(n_rows, 0);
+
+    double sum_grad = 0.0, sum_hess = 0.0;
+    for (size_t r = 0; r < n_rows; ++r) {
+      sum_grad += grad[r];
+      sum_hess += hess[r];
+    }
+    tree.AddLeaf(0.0f);
+    std::vector<int> level{0};
+    std::vector<std::pair<double, double>> level_stats{{sum_grad, sum_hess}};
+
+    auto finalize_leaf = [this, &tree](int nid, const std::pair<double, double>& stat) {
+      tree.leaf_value[nid] =
+          static_cast<float>(model_->learning_rate * CalcWeight(stat.first, stat.second));
+    };
+
+    for (int depth = 0; depth < model_->max_depth && !level.empty(); ++depth) {
+      size_t n_level = level.size();
+      std::vector<int> node_pos(tree.leaf_value.size(), -1);
+      for (size_t i = 0; i < n_level; ++i) {
+        node_pos[level[i]] = static_cast<int>(i);
+      }
+
+      // Find the best split of every node in this level. Each task handles one feature.
+      std::vector<SplitEntry> best(n_features_ * n_level);
+      support::parallel_for(0, n_features_, [&](int f) {
+        int n_bins = static_cast<int>(cuts[f].size()) + 1;
+        if (n_bins <= 1) {
+          return;
+        }
+        std::vector<double> hist_grad(n_level * n_bins, 0.0), hist_hess(n_level * n_bins, 0.0);
+        const uint8_t* col = &bins_[f * n_rows];
+        for (size_t r = 0; r < n_rows; ++r) {
+          int pos = node_pos[row_node[r]];
+          if (pos >= 0) {
+            hist_grad[pos * n_bins + col[r]] += grad[r];
+            hist_hess[pos * n_bins + col[r]] += hess[r];
+          }
+        }
+        for (size_t pos = 0; pos < n_level; ++pos) {
+          double grad_all = level_stats[pos].first, hess_all = level_stats[pos].second;
+          double parent_gain = CalcGain(grad_all, hess_all);
+          double left_grad = 0.0, left_hess = 0.0;
+          SplitEntry& entry = best[f * n_level + pos];
+          for (int b = 0; b < n_bins - 1; ++b) {
+            left_grad += hist_grad[pos * n_bins + b];
+            left_hess += hist_hess[pos * n_bins + b];
+            double right_grad = grad_all - left_grad, right_hess = hess_all - left_hess;
+            if (left_hess < model_->min_child_weight || right_hess < model_->min_child_weight) {
+              continue;
+            }
+            double gain = 0.5 * (CalcGain(left_grad, left_hess) +
+                                 CalcGain(right_grad, right_hess) - parent_gain) -
+                          model_->gamma;
+            if (gain > entry.gain) {
+              entry.gain = gain;
+              entry.feature = f;
+              entry.bin = b;
+              entry.left_grad = left_grad;
+              entry.left_hess = left_hess;
+            }
+          }
+        }
+      });
+
+      // Apply the splits
+      std::vector<int> next_level;
+      std::vector<std::pair<double, double>> next_level_stats;
+      std::vector<SplitEntry> node_split(n_level);
+      for (size_t pos = 0; pos < n_level; ++pos) {
+        for (int f = 0; f < n_features_; ++f) {
+          const SplitEntry& entry = best[f * n_level + pos];
+          if (entry.feature >= 0 && entry.gain > node_split[pos].gain) {
+            node_split[pos] = entry;
+          }
+        }
+
+        int nid = level[pos];
+        const SplitEntry& split = node_split[pos];
+        if (split.feature < 0) {
+          finalize_leaf(nid, level_stats[pos]);
+          continue;
+        }
+        int left = tree.AddLeaf(0.0f);
+        int right = tree.AddLeaf(0.0f);
+        tree.split_feature[nid] = split.feature;
+        tree.split_value[nid] = cuts[split.feature][split.bin];
+        tree.left_child[nid] = left;
+        tree.right_child[nid] = right;
+        next_level.push_back(left);
+        next_level_stats.emplace_back(split.left_grad, split.left_hess);
+        next_level.push_back(right);
+        next_level_stats.emplace_back(level_stats[pos].first - split.left_grad,
+                                      level_stats[pos].second - split.left_hess);
+      }
+
+      // Move the rows to the new children
+      for (size_t r = 0; r < n_rows; ++r) {
+        int pos = node_pos[row_node[r]];
+        if (pos >= 0 && node_split[pos].feature >= 0) {
+          int nid = row_node[r];
+          const SplitEntry& split = node_split[pos];
+          row_node[r] = bins_[split.feature * n_rows + r] <= split.bin ? tree.left_child[nid]
+                                                                         : tree.right_child[nid];
+        }
+      }
+
+      level = std::move(next_level);
+      level_stats = std::move(next_level_stats);
+    }
+
+    for (size_t pos = 0; pos < level.size(); ++pos) {
+      finalize_leaf(level[pos], level_stats[pos]);
+    }
+    return tree;
+  }
+
+  /*! \brief The model that holds the hyper-parameters */
+  const GBDTModelNode* model_;
+  /*! \brief The number of float values in one feature row */
+  int n_features_;
+  /*! \brief The feature rows in row-major order */
+  std::vector<float> rows_;
+  /*! \brief The pack (state) index of every row */
+  std::vector<int> pack_ids_;
+  /*! \brief The label of every pack */
+  std::vector<float> labels_;
+  /*! \brief The weight of every pack */
+  std::vector<float> weights_;
+  /*! \brief The bin indices of all feature values in column-major order */
+  std::vector<uint8_t> bins_;
+  /*! \brief The current prediction of every row */
+  std::vector<float> row_preds_;
+  /*! \brief The current prediction of every pack */
+  std::vector<float> pack_preds_;
+};
+
+GBDTModel::GBDTModel(int max_depth, double learning_rate, double reg_lambda, double gamma,
+                     double min_child_weight, int num_boost_round, int num_incremental_round,
+                     int early_stopping_rounds, int max_bin, int num_warmup_sample,
+                     int max_n_bufs, int seed) {
+  CHECK_GT(max_bin, 1);
+  CHECK_LE(max_bin, 256) << "GBDTModel stores bin indices in uint8";
+  auto node = make_object<GBDTModelNode>();
+  node->max_depth = max_depth;
+  node->learning_rate = learning_rate;
+  node->reg_lambda = reg_lambda;
+  node->gamma = gamma;
+  node->min_child_weight = min_child_weight;
+  node->num_boost_round = num_boost_round;
+  node->num_incremental_round = num_incremental_round;
+  node->early_stopping_rounds = early_stopping_rounds;
+  node->max_bin = max_bin;
+  node->num_warmup_sample = num_warmup_sample;
+  node->max_n_bufs = max_n_bufs;
+  node->rand_gen_ = std::mt19937(seed);
+
+  std::vector<std::string> names;
+  GetPerStoreFeatureName(max_n_bufs, &names);
+  node->n_features_ = static_cast<int>(names.size());
+  data_ = std::move(node);
+}
+
+void GBDTModelNode::Update(const Array<MeasureInput>& inputs,
+                           const Array<MeasureResult>& results) {
+  if (inputs.empty()) {
+    return;
+  }
+  CHECK_EQ(inputs.size(), results.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    inputs_.push_back(inputs[i]);
+    results_.push_back(results[i]);
+  }
+
+  // Only extract features for the new samples
+  std::vector<std::vector<float>> features;
+  std::vector<float> normalized_throughputs;
+  std::vector<int> task_ids;
+  size_t n_cached = features_cache_.size();
+  GetPerStoreFeaturesFromMeasurePairs(inputs_, results_, n_cached, max_n_bufs, &features,
+                                      &normalized_throughputs, &task_ids);
+  for (size_t i = 0; i < n_cached; ++i) {
+    std::swap(features[i], features_cache_[i]);
+  }
+  features_cache_ = std::move(features);
+
+  GBDTTrainer trainer(this, n_features_);
+  for (size_t i = 0; i < features_cache_.size(); ++i) {
+    trainer.AddPack(features_cache_[i], normalized_throughputs[i]);
+  }
+
+  // Boosting is incremental: new trees are fitted to the residuals of the current ensemble.
+  // Retrain from scratch whenever the training set doubles, so the cut points and the early
+  // trees follow the distribution of the collected data. This keeps the amortized training
+  // cost linear in the number of samples. The samples of a loaded model are not known, so
+  // the first update after Load counts as the last training from scratch.
+  if (loaded_) {
+    n_samples_at_full_train_ = inputs_.size();
+    loaded_ = false;
+  }
+  if (trees_.empty() || cuts_.empty() || inputs_.size() >= 2 * n_samples_at_full_train_) {
+    trees_.clear();
+    trainer.ComputeCuts(&cuts_);
+    trainer.Boost(cuts_, num_boost_round, &trees_);
+    n_samples_at_full_train_ = inputs_.size();
+  } else {
+    trainer.Boost(cuts_, num_incremental_round, &trees_);
+  }
+}
+
+float GBDTModelNode::PredictFeature(const std::vector<float>& feature,
+                                    std::vector<float>* row_scores) const {
+  int n_stmts = static_cast<int>(feature[0]);
+  CHECK_EQ(feature.size(), 1 + static_cast<size_t>(n_stmts) * n_features_);
+  float sum = 0.0f;
+  for (int i = 0; i < n_stmts; ++i) {
+    const float* row = &feature[1 + static_cast<size_t>(i) * n_features_];
+    float pred = 0.0f;
+    for (const auto& tree : trees_) {
+      pred += tree.Predict(row);
+    }
+    if (row_scores != nullptr) {
+      row_scores->push_back(pred);
+    }
+    sum += pred;
+  }
+  return sum;
+}
+
+void GBDTModelNode::Predict(const SearchTask& task, const Array<State>& states,
+                            std::vector<float>* scores) {
+  PredictStages(task, states, scores, nullptr);
+}
+
+void GBDTModelNode::PredictStages(const SearchTask& task, const Array<State>& states,
+                                  std::vector<float>* state_scores,
+                                  std::vector<std::vector<float>>* stage_scores) {
+  std::vector<std::vector<float>> features;
+  GetPerStoreFeaturesFromStates(states, task, 0, max_n_bufs, &features);
+
+  size_t n_states = states.size();
+  state_scores->assign(n_states, 0.0f);
+  std::vector<std::vector<float>> row_scores(n_states);
+  bool use_model = !trees_.empty() && static_cast<int>(inputs_.size()) > num_warmup_sample;
+
+  if (use_model) {
+    support::parallel_for(0, static_cast<int>(n_states), [&](int i) {
+      if (!features[i].empty()) {
+        (*state_scores)[i] = PredictFeature(features[i], &row_scores[i]);
+      }
+    });
+  } else {
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+    for (size_t i = 0; i < n_states; ++i) {
+      (*state_scores)[i] = dis(rand_gen_);
+    }
+  }
+
+  // Predict -inf for invalid states that failed to be lowered
+  for (size_t i = 0; i < n_states; ++i) {
+    if (features[i].empty()) {
+      (*state_scores)[i] = -std::numeric_limits<float>::infinity();
+    }
+  }
+
+  if (stage_scores == nullptr) {
+    return;
+  }
+
+  // Assign the row scores to the stages that generate buffer stores, using the same
+  // correspondence as PythonBasedModelNode::PredictStages.
+  stage_scores->clear();
+  for (size_t i = 0; i < n_states; ++i) {
+    std::vector<float> scores;
+    size_t offset = 0;
+    if (use_model && !features[i].empty()) {
+      for (const Stage& stage : states[i]->stages) {
+        if (stage->op_type == StageKind::kPlaceholder ||
+            stage->compute_at == ComputeAtKind::kInlined) {
+          scores.push_back(0);
+        } else if (offset < row_scores[i].size()) {
+          scores.push_back(row_scores[i][offset++]);
+        } else {
+          break;
+        }
+      }
+      if (offset != row_scores[i].size() || scores.size() != states[i]->stages.size()) {
+        // The stores do not match the stages one by one. Do not provide the breakdown.
+        scores.clear();
+      }
+    }
+    stage_scores->push_back(std::move(scores));
+  }
+}
+
+void GBDTModelNode::Save(const std::string& file_name) const {
+  std::ofstream fout(file_name);
+  CHECK(fout.is_open()) << "Cannot open file " << file_name;
+  fout << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+  fout << GBDT_MODEL_MAGIC << " " << GBDT_MODEL_VERSION << "\n";
+  fout << n_features_ << "\n";
+  for (const auto& cut : cuts_) {
+    fout << cut.size();
+    for (float value : cut) {
+      fout << " " << value;
+    }
+    fout << "\n";
+  }
+  fout << trees_.size() << "\n";
+  for (const auto& tree : trees_) {
+    fout << tree.leaf_value.size() << "\n";
+    for (size_t i = 0; i < tree.leaf_value.size(); ++i) {
+      fout << tree.split_feature[i] << " " << tree.split_value[i] << " " << tree.left_child[i]
+           << " " << tree.right_child[i] << " " << tree.leaf_value[i] << "\n";
+    }
+  }
+  CHECK(fout.good()) << "Failed to write file " << file_name;
+}
+
+void GBDTModelNode::Load(const std::string& file_name) {
+  std::ifstream fin(file_name);
+  CHECK(fin.is_open()) << "Cannot open file " << file_name;
+
+  std::string magic;
+  int version, n_features;
+  fin >> magic >> version >> n_features;
+  CHECK(fin.good() && magic == GBDT_MODEL_MAGIC) << file_name << " is not a GBDTModel file";
+  CHECK_EQ(version, GBDT_MODEL_VERSION) << "Unsupported GBDTModel file version";
+  CHECK_EQ(n_features, n_features_)
+      << "The feature length of the saved model does not match max_n_bufs=" << max_n_bufs;
+
+  std::vector<std::vector<float>> cuts(n_features);
+  for (auto& cut : cuts) {
+    size_t n_cut;
+    fin >> n_cut;
+    cut.resize(n_cut);
+    for (auto& value : cut) {
+      fin >> value;
+    }
+  }
+
+  size_t n_trees;
+  fin >> n_trees;
+  std::vector<RegressionTree> trees(n_trees);
+  for (auto& tree : trees) {
+    size_t n_nodes;
+    fin >> n_nodes;
+    for (size_t i = 0; i < n_nodes; ++i) {
+      int feature, left, right;
+      float split_value, leaf_value;
+      fin >> feature >> split_value >> left >> right >> leaf_value;
+      tree.AddLeaf(leaf_value);
+      tree.split_feature[i] = feature;
+      tree.split_value[i] = split_value;
+      tree.left_child[i] = left;
+      tree.right_child[i] = right;
+    }
+  }
+  CHECK(!fin.fail()) << "Failed to parse GBDTModel file " << file_name;
+
+  cuts_ = std::move(cuts);
+  trees_ = std::move(trees);
+  // Trust the loaded model immediately, and boost on top of it in later updates
+  num_warmup_sample = -1;
+  loaded_ = true;
+}
+
+TVM_REGISTER_GLOBAL("auto_scheduler.GBDTModel")
+    .set_body_typed([](int max_depth, double learning_rate, double reg_lambda, double gamma,
+                       double min_child_weight, int num_boost_round, int num_incremental_round,
+                       int early_stopping_rounds, int max_bin, int num_warmup_sample,
+                       int max_n_bufs, int seed) {
+      return GBDTModel(max_depth, learning_rate, reg_lambda, gamma, min_child_weight,
+                       num_boost_round, num_incremental_round, early_stopping_rounds, max_bin,
+                       num_warmup_sample, max_n_bufs, seed);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.GBDTModelSave")
+    .set_body_typed([](GBDTModel model, String file_name) { model->Save(file_name); });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.GBDTModelLoad")
+    .set_body_typed([](GBDTModel model, String file_name) { model->Load(file_name); });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.GBDTModelNumTrees").set_body_typed([](GBDTModel model) {
+  return static_cast<int64_t>(model->NumTrees());
+});
+
+TVM_REGISTER_GLOBAL("auto_scheduler.GBDTModelUpdateFromFile")
+    .set_body_typed([](GBDTModel model, String file_name, int n_lines) {
+      Array<MeasureInput> inputs;
+      Array<MeasureResult> results;
+      std::tie(inputs, results) = RecordReader(file_name)->ReadLines(n_lines);
+      model->Update(inputs, results);
+    });
+
+}  // namespace auto_scheduler
+}  // namespace tvm
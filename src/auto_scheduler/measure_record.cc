@@ -340,5 +340,22 @@ TVM_REGISTER_GLOBAL("auto_scheduler.SaveRecords")
       std::ofstream ofs(filename, std::ofstream::app);
       WriteMeasureRecords(&ofs, in, res);
     });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.SerializeMeasureRecord")
+    .set_body_typed([](MeasureInput inp, MeasureResult res) {
+      std::ostringstream os;
+      WriteMeasureRecords(&os, {inp}, {res});
+      std::string str = os.str();
+      // Strip the trailing newline
+      return String(str.substr(0, str.size() - 1));
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.DeserializeMeasureRecord").set_body_typed([](String str) {
+  auto inp = make_object<MeasureInputNode>();
+  auto res = make_object<MeasureResultNode>();
+  std::string log_version;
+  ReadMeasureRecord(str, inp.get(), res.get(), &log_version);
+  return Array<ObjectRef>{ObjectRef(inp), ObjectRef(res)};
+});
 }  // namespace auto_scheduler
 }  // namespace tvm
@@ -84,6 +84,26 @@ State EmptyPolicyNode::Search(int num_measure_trials, int early_stopping,
   }
 }
 
+std::pair<Array<MeasureInput>, Array<MeasureResult>> EmptyPolicyNode::ContinueSearchOneRound(
+    int num_measure, ProgramMeasurer measurer) {
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+
+  // Search one round to get promising states
+  const auto& res = SearchOneRound();
+  for (const auto& state : res) {
+    if (static_cast<int>(inputs.size()) >= num_measure) {
+      break;
+    }
+    inputs.push_back(MeasureInput(search_task, state));
+  }
+
+  // Measure candidate states
+  measurer->Measure(search_task, GetRef<SearchPolicy>(this), inputs, &results);
+
+  return std::make_pair(std::move(inputs), std::move(results));
+}
+
 // As an example policy, EmptyPolicy always returns a init state
 Array<State> EmptyPolicyNode::SearchOneRound() {
   Array<State> res;
@@ -34,6 +34,7 @@ namespace auto_scheduler {
 TVM_REGISTER_OBJECT_TYPE(SearchCallbackNode);
 TVM_REGISTER_OBJECT_TYPE(SearchPolicyNode);
 TVM_REGISTER_OBJECT_TYPE(PreloadMeasuredStatesNode);
+TVM_REGISTER_OBJECT_TYPE(PreloadTransferredStatesNode);
 
 void SearchPolicyNode::PreloadMeasuredStates(const String& log_file) {
   RecordReader reader = RecordReader(log_file);
@@ -81,6 +82,41 @@ void SearchPolicyNode::PreloadMeasuredStates(const String& log_file) {
   }
 }
 
+void SearchPolicyNode::PreloadTransferredStates(const Array<State>& states) {
+  Array<State> replayed_states;
+  for (const auto& transferred : states) {
+    State state = search_task->compute_dag->init_state;
+    auto pstate = state.CopyOnWrite();
+    pstate->transform_steps = transferred->transform_steps;
+    try {
+      for (const auto& step : pstate->transform_steps) {
+        StepApplyToState(step, &state, search_task->compute_dag);
+      }
+    } catch (dmlc::Error& e) {
+      // The steps do not fit the stages or loops of the current task
+      continue;
+    }
+    replayed_states.push_back(std::move(state));
+  }
+
+  // States that fail to infer bound are returned as undefined
+  replayed_states = search_task->compute_dag.InferBound(replayed_states);
+  std::unordered_set<std::string> added;
+  for (const auto& state : replayed_states) {
+    if (!state.defined()) {
+      continue;
+    }
+    std::string state_str = state.ToStr();
+    if (!measured_states_set_.count(state_str) && added.insert(state_str).second) {
+      transferred_states_.push_back(state);
+    }
+  }
+
+  StdCout(verbose) << "SearchPolicy: Transferred " << added.size() << " of " << states.size()
+                   << " states from similar workloads for " << search_task->workload_key
+                   << std::endl;
+}
+
 void SearchPolicyNode::RunCallbacks(const Array<SearchCallback>& callbacks) {
   for (const auto& callback : callbacks) {
     callback->Callback(this);
@@ -97,6 +133,16 @@ void PreloadMeasuredStatesNode::Callback(SearchPolicyNode* policy) {
   policy->PreloadMeasuredStates(filename);
 }
 
+PreloadTransferredStates::PreloadTransferredStates(Array<State> states) {
+  auto node = make_object<PreloadTransferredStatesNode>();
+  node->states = std::move(states);
+  data_ = std::move(node);
+}
+
+void PreloadTransferredStatesNode::Callback(SearchPolicyNode* policy) {
+  policy->PreloadTransferredStates(states);
+}
+
 TVM_REGISTER_GLOBAL("auto_scheduler.SearchPolicyRunCallbacks")
     .set_body_typed([](SearchPolicy policy, Optional<Array<SearchCallback>> callbacks) {
       if (callbacks) {
@@ -114,5 +160,8 @@ TVM_REGISTER_GLOBAL("auto_scheduler.PreloadMeasuredStates").set_body_typed([](St
   return PreloadMeasuredStates(filename);
 });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.PreloadTransferredStates")
+    .set_body_typed([](Array<State> states) { return PreloadTransferredStates(states); });
+
 }  // namespace auto_scheduler
 }  // namespace tvm
@@ -218,6 +218,48 @@ State SketchPolicyNode::Search(int n_trials, int early_stopping, int num_measure
   }
 }
 
+std::pair<Array<MeasureInput>, Array<MeasureResult>> SketchPolicyNode::ContinueSearchOneRound(
+    int num_measure, ProgramMeasurer measurer) {
+  num_measure_per_iter_ = num_measure;
+
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  int num_random =
+      static_cast<int>(GetDoubleParam(params, SketchParamKey::eps_greedy) * num_measure);
+
+  // Search one round to get promising states
+  PrintTitle("Search", verbose);
+  Array<State> random_states;
+  Array<State> best_states = SearchOneRound(num_random, &random_states);
+
+  // Infer bound. This is necessary for computing the correct ToStr() for redundancy check
+  best_states = search_task->compute_dag.InferBound(best_states);
+  random_states = search_task->compute_dag.InferBound(random_states);
+
+  // Pick `num_measure` states to measure, check hash to remove already measured state
+  // Also pick some random states to do eps-greedy
+  inputs = PickStatesWithEpsGreedy(best_states, random_states, num_measure);
+  if (inputs.empty()) {
+    return std::make_pair(std::move(inputs), std::move(results));
+  }
+
+  // Measure candidate states
+  PrintTitle("Measure", verbose);
+  measurer->Measure(search_task, GetRef<SearchPolicy>(this), inputs, &results);
+
+  // Update measured states throughputs. These states will join the EvolutionarySearch in later
+  // search rounds.
+  for (const auto& res : results) {
+    measured_states_throughputs_.push_back(1.0 / FloatArrayMean(res->costs));
+  }
+
+  // Update the cost model
+  PrintTitle("Train cost model", verbose);
+  program_cost_model->Update(inputs, results);
+
+  return std::make_pair(std::move(inputs), std::move(results));
+}
+
 Array<State> SketchPolicyNode::SearchOneRound(int num_random_states, Array<State>* random_states) {
   // Temporal object to be used if the input pointer is nullptr
   Array<State> temp_random_states;
@@ -236,6 +278,20 @@ Array<State> SketchPolicyNode::SearchOneRound(int num_random_states, Array<State
                    population));
   bool is_cost_model_reasonable = !program_cost_model->IsInstance<RandomModelNode>();
 
+  // States transferred from similar workloads that are not measured yet
+  Array<State> transferred_states;
+  int max_transferred = static_cast<int>(
+      GetDoubleParam(params, SketchParamKey::EvolutionarySearch::use_measured_ratio) * population);
+  for (const auto& state : transferred_states_) {
+    if (static_cast<int>(transferred_states.size()) >= max_transferred) {
+      break;
+    }
+    if (!measured_states_set_.count(state.ToStr())) {
+      transferred_states.push_back(state);
+    }
+  }
+  int num_transferred = static_cast<int>(transferred_states.size());
+
   // 1. Generate sketches
   if (sketch_cache_.empty()) {
     sketch_cache_ = GenerateSketches();
@@ -243,7 +299,9 @@ Array<State> SketchPolicyNode::SearchOneRound(int num_random_states, Array<State
 
   // 2. Sample the init population
   Array<State> init_population = SampleInitPopulation(
-      sketch_cache_, is_cost_model_reasonable ? population - num_use_measured : population);
+      sketch_cache_, is_cost_model_reasonable
+                         ? std::max(population - num_use_measured - num_transferred, 1)
+                         : population);
 
   // 3. If the cost model is useless (i.e. RandomCostModel), just random pick some generated
   // states, else perform evolutionary search
@@ -253,12 +311,22 @@ Array<State> SketchPolicyNode::SearchOneRound(int num_random_states, Array<State
     for (int i = 0; i < num_use_measured; i++) {
       init_population.push_back(measured_states_vector_[indices[i]]);
     }
+    // Also insert the states transferred from similar workloads
+    for (const auto& state : transferred_states) {
+      init_population.push_back(state);
+    }
     // Sample some random states for eps-greedy
     *random_states = RandomSampleStates(init_population, &rand_gen, num_random_states * 3);
     return EvolutionarySearch(init_population, num_measure_per_iter_ * 2);
   } else {
     PruneInvalidState(search_task, &init_population);
-    return RandomSampleStates(init_population, &rand_gen, num_measure_per_iter_ * 3);
+    // Without a cost model, measure the transferred states first
+    Array<State> out_states = transferred_states;
+    for (const auto& state :
+         RandomSampleStates(init_population, &rand_gen, num_measure_per_iter_ * 3)) {
+      out_states.push_back(state);
+    }
+    return out_states;
   }
 }
 
@@ -409,6 +477,16 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
   std::unordered_set<std::string> in_heap(measured_states_set_);
   heap.reserve(out_size);
 
+  // Scores of the states evaluated in this search. The cost model does not change during the
+  // evolution, and the population contains many duplicated states (unmutated copies and
+  // survivors of previous generations), so every distinct state is only predicted once.
+  std::unordered_map<std::string, float> score_cache;
+  std::vector<std::string> state_strs;
+  Array<State> unscored_states;
+  std::vector<std::string> unscored_strs;
+  std::vector<float> unscored_scores;
+  size_t num_evaluated = 0, num_predicted = 0;
+
   // auxiliary global variables
   std::vector<float> pop_scores;
   std::vector<double> pop_selection_probs;
@@ -432,11 +510,34 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
     // Maintain the heap
     *pnow = search_task->compute_dag.InferBound(*pnow);
     PruneInvalidState(search_task, pnow);
-    program_cost_model->Predict(search_task, *pnow, &pop_scores);
+
+    state_strs.clear();
+    unscored_states.clear();
+    unscored_strs.clear();
+    for (const State& state : *pnow) {
+      state_strs.push_back(state.ToStr());
+      const std::string& state_str = state_strs.back();
+      if (score_cache.emplace(state_str, 0.0f).second) {
+        unscored_states.push_back(state);
+        unscored_strs.push_back(state_str);
+      }
+    }
+    if (!unscored_states.empty()) {
+      program_cost_model->Predict(search_task, unscored_states, &unscored_scores);
+    }
+    for (size_t i = 0; i < unscored_strs.size(); ++i) {
+      score_cache[unscored_strs[i]] = unscored_scores[i];
+    }
+    pop_scores.resize(pnow->size());
+    for (size_t i = 0; i < pnow->size(); ++i) {
+      pop_scores[i] = score_cache[state_strs[i]];
+    }
+    num_evaluated += pnow->size();
+    num_predicted += unscored_states.size();
 
     for (size_t i = 0; i < pnow->size(); ++i) {
       const State& state = (*pnow)[i];
-      std::string state_str = state.ToStr();
+      const std::string& state_str = state_strs[i];
 
       if (in_heap.count(state_str) == 0) {
         if (static_cast<int>(heap.size()) < out_size) {
@@ -505,6 +606,10 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
   StdCout(verbose) << "EvolutionarySearch\t\t#s: " << best_states.size()
                    << "\tTime elapsed: " << std::fixed << std::setprecision(2) << duration
                    << std::endl;
+  StdCout(verbose) << "EvolutionarySearch\t\t#Evaluated: " << num_evaluated
+                   << "\t#Predicted: " << num_predicted << "\tStates/s: " << std::fixed
+                   << std::setprecision(2) << num_evaluated / std::max(duration, 1e-9)
+                   << std::endl;
   return best_states;
 }
 
@@ -0,0 +1,302 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_scheduler/task_scheduler.cc
+ * \brief The task scheduler that allocates the tuning budget across the tasks of a network.
+ */
+
+#include <tvm/auto_scheduler/task_scheduler.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <tuple>
+
+#include "search_policy/utils.h"
+#include "utils.h"
+
+namespace tvm {
+namespace auto_scheduler {
+
+TVM_REGISTER_NODE_TYPE(TaskSchedulerNode);
+
+/*! \brief The latency of a task that has no valid measurement yet. */
+static const double kInvalidCost = 1e10;
+// A task without any valid measurement after this number of rounds is retired, as it
+// would otherwise keep the largest gradient and take the rest of the budget.
+static const int kMaxInvalidRounds = 3;
+
+TaskScheduler::TaskScheduler(Array<SearchTask> tasks, Array<SearchPolicy> search_policies,
+                             Array<FloatImm> task_weights, String strategy, double alpha,
+                             int backward_window_size, int early_stopping_per_task) {
+  CHECK_EQ(tasks.size(), search_policies.size())
+      << "Every task should have exactly one search policy";
+  CHECK(task_weights.empty() || task_weights.size() == tasks.size())
+      << "The number of task weights should be equal to the number of tasks";
+  CHECK(strategy == "gradient" || strategy == "round-robin")
+      << "Invalid task scheduling strategy: " << strategy;
+  CHECK_GT(backward_window_size, 0);
+
+  auto node = make_object<TaskSchedulerNode>();
+  node->tasks = std::move(tasks);
+  node->search_policies = std::move(search_policies);
+  for (const auto& weight : task_weights) {
+    CHECK_GE(weight->value, 0) << "Task weights should be non-negative";
+    node->task_weights.push_back(weight->value);
+  }
+  if (node->task_weights.empty()) {
+    node->task_weights.assign(node->tasks.size(), 1.0);
+  }
+  node->strategy = std::move(strategy);
+  node->alpha = alpha;
+  node->backward_window_size = backward_window_size;
+  node->early_stopping_per_task = early_stopping_per_task;
+  data_ = std::move(node);
+}
+
+double TaskSchedulerNode::ComputeScore() const {
+  double score = 0.0;
+  for (size_t i = 0; i < best_costs.size(); ++i) {
+    score += task_weights[i] * best_costs[i];
+  }
+  return score;
+}
+
+void TaskSchedulerNode::Tune(const TuningOptions& tuning_options) {
+  size_t num_tasks = tasks.size();
+  CHECK_GT(num_tasks, 0) << "No task to tune";
+
+  // Reset book keeping variables
+  best_costs.assign(num_tasks, kInvalidCost);
+  task_cts.assign(num_tasks, 0);
+  task_trials.assign(num_tasks, 0);
+  task_costs_history.assign(num_tasks, std::vector<double>());
+  dead_tasks.assign(num_tasks, false);
+  task_best_cts_.assign(num_tasks, 0);
+  task_invalid_rounds_.assign(num_tasks, 0);
+  last_task_idx_ = -1;
+  ct_ = 0;
+  verbose_ = tuning_options->verbose;
+  num_measure_trials_ = tuning_options->num_measure_trials;
+  // Use small rounds when the budget is small, so that every task can get several rounds
+  num_measures_per_round_ =
+      std::max(1, std::min(tuning_options->num_measures_per_round,
+                           num_measure_trials_ / static_cast<int>(num_tasks)));
+  int early_stopping = tuning_options->early_stopping < 0 ? std::numeric_limits<int>::max() >> 1
+                                                          : tuning_options->early_stopping;
+
+  // All tasks share one measurer
+  measurer_ = ProgramMeasurer(tuning_options->builder, tuning_options->runner,
+                              tuning_options->measure_callbacks, tuning_options->verbose);
+  measurer_->Reset();
+
+  // Warm up: tune every task for one round, so that every task gets an initial latency
+  for (size_t i = 0; i < num_tasks && ct_ < num_measure_trials_; ++i) {
+    TuneTask(static_cast<int>(i));
+  }
+
+  double best_score = ComputeScore();
+  int best_ct = ct_;
+  while (ct_ < num_measure_trials_) {
+    int task_idx = PickTask();
+    if (task_idx < 0) {
+      StdCout(verbose_) << "All tasks are converged or have traversed their search spaces."
+                        << std::endl;
+      break;
+    }
+    TuneTask(task_idx);
+
+    // Check if reach the early stopping condition
+    double score = ComputeScore();
+    if (score < best_score) {
+      best_score = score;
+      best_ct = ct_;
+    } else if (ct_ - best_ct > early_stopping) {
+      StdCout(verbose_) << "Stop early since no end-to-end improvement in the last "
+                        << early_stopping << " measure steps." << std::endl;
+      break;
+    }
+  }
+  PrintTitle("Done", verbose_);
+}
+
+void TaskSchedulerNode::TuneTask(int task_idx) {
+  int num_measure = std::min(num_measures_per_round_, num_measure_trials_ - ct_);
+
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  std::tie(inputs, results) =
+      search_policies[task_idx]->ContinueSearchOneRound(num_measure, measurer_);
+  last_task_idx_ = task_idx;
+  task_cts[task_idx]++;
+
+  if (inputs.empty()) {
+    StdCout(verbose_) << "Task " << task_idx << ": it seems all candidates in the search space "
+                      << "have been measured." << std::endl;
+    dead_tasks[task_idx] = true;
+  }
+
+  ct_ += inputs.size();
+  task_trials[task_idx] += inputs.size();
+  for (const auto& res : results) {
+    if (res->error_no == static_cast<int>(MeasureErrorNO::kNoError)) {
+      double cost = FloatArrayMean(res->costs);
+      if (cost < best_costs[task_idx]) {
+        best_costs[task_idx] = cost;
+        task_best_cts_[task_idx] = task_trials[task_idx];
+      }
+    }
+  }
+  task_costs_history[task_idx].push_back(best_costs[task_idx]);
+
+  if (best_costs[task_idx] >= kInvalidCost &&
+      ++task_invalid_rounds_[task_idx] >= kMaxInvalidRounds) {
+    StdCout(verbose_) << "Task " << task_idx << ": stop since no valid measurement in "
+                      << kMaxInvalidRounds << " rounds." << std::endl;
+    dead_tasks[task_idx] = true;
+  }
+
+  if (early_stopping_per_task >= 0 &&
+      task_trials[task_idx] - task_best_cts_[task_idx] > early_stopping_per_task) {
+    StdCout(verbose_) << "Task " << task_idx << ": stop early since no performance improvement "
+                      << "in the last " << early_stopping_per_task << " measure steps."
+                      << std::endl;
+    dead_tasks[task_idx] = true;
+  }
+
+  PrintTableInfo();
+}
+
+int TaskSchedulerNode::PickTask() {
+  int num_tasks = static_cast<int>(tasks.size());
+
+  if (strategy == "round-robin") {
+    for (int i = 1; i <= num_tasks; ++i) {
+      int task_idx = (last_task_idx_ + i) % num_tasks;
+      if (!dead_tasks[task_idx]) {
+        return task_idx;
+      }
+    }
+    return -1;
+  }
+
+  // The end-to-end latency is f = sum_i(w_i * g_i(t_i)), where g_i(t_i) is the best latency of
+  // task i after t_i rounds. Its gradient w.r.t. t_i is w_i * dg_i/dt_i, and dg_i/dt_i is
+  // estimated with two terms:
+  //  - backward: the improvement of the last `backward_window_size` rounds,
+  //  - forward: the optimistic expectation that the next round improves the latency as much as
+  //    the average round so far, i.e., g_i(t_i + 1) = g_i(t_i) - g_i(t_i) / t_i.
+  // The task with the most negative gradient is tuned next.
+  int best_idx = -1;
+  double best_grad = 0.0;
+  for (int i = 0; i < num_tasks; ++i) {
+    if (dead_tasks[i]) {
+      continue;
+    }
+    // A task without a valid measurement has no latency to improve, it is only tuned when
+    // no other task is expected to improve.
+    if (best_costs[i] >= kInvalidCost) {
+      if (best_idx < 0) {
+        best_idx = i;
+      }
+      continue;
+    }
+    const std::vector<double>& history = task_costs_history[i];
+    double backward_grad = 0.0;
+    if (static_cast<int>(history.size()) > backward_window_size) {
+      backward_grad = (history.back() - history[history.size() - 1 - backward_window_size]) /
+                      backward_window_size;
+    }
+    double forward_grad = -best_costs[i] / std::max(task_cts[i], 1);
+    double grad = task_weights[i] * (alpha * backward_grad + (1 - alpha) * forward_grad);
+
+    // Break ties by the number of trials, so that tasks with zero weight are still tuned in turn
+    if (best_idx < 0 || grad < best_grad ||
+        (grad == best_grad && task_trials[i] < task_trials[best_idx])) {
+      best_idx = i;
+      best_grad = grad;
+    }
+  }
+  return best_idx;
+}
+
+void TaskSchedulerNode::PrintTableInfo() const {
+  if (verbose_ < 1) {
+    return;
+  }
+  std::ostream& os = StdCout(verbose_);
+  os << "|  ID  | Latency (ms) | Speed (GFLOPS) | Weight | Trials |" << std::endl;
+  os << Chars('-', 58) << std::endl;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    os << "| " << std::setw(4) << i << " | ";
+    if (best_costs[i] < kInvalidCost) {
+      os << std::setw(12) << std::fixed << std::setprecision(3) << best_costs[i] * 1e3 << " | "
+         << std::setw(14) << std::setprecision(2)
+         << tasks[i]->compute_dag->flop_ct / best_costs[i] / 1e9 << " | ";
+    } else {
+      os << std::setw(12) << "-" << " | " << std::setw(14) << "-" << " | ";
+    }
+    os << std::setw(6) << std::setprecision(1) << task_weights[i] << " | " << std::setw(6)
+       << task_trials[i] << " |" << std::endl;
+  }
+  os << Chars('-', 58) << std::endl;
+  os << "Estimated total latency: ";
+  if (*std::max_element(best_costs.begin(), best_costs.end()) < kInvalidCost) {
+    os << std::fixed << std::setprecision(3) << ComputeScore() * 1e3 << " ms";
+  } else {
+    os << "-";
+  }
+  os << "\tTrials: " << ct_ << std::endl;
+}
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskScheduler")
+    .set_body_typed([](Array<SearchTask> tasks, Array<SearchPolicy> search_policies,
+                       Array<FloatImm> task_weights, String strategy, double alpha,
+                       int backward_window_size, int early_stopping_per_task) {
+      return TaskScheduler(tasks, search_policies, task_weights, strategy, alpha,
+                           backward_window_size, early_stopping_per_task);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerTune")
+    .set_body_typed([](TaskScheduler scheduler, TuningOptions tuning_options) {
+      scheduler->Tune(tuning_options);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerGetBestCosts")
+    .set_body_typed([](TaskScheduler scheduler) {
+      Array<FloatImm> ret;
+      for (double cost : scheduler->best_costs) {
+        ret.push_back(FloatImm(DataType::Float(64), cost));
+      }
+      return ret;
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerGetTaskTrials")
+    .set_body_typed([](TaskScheduler scheduler) {
+      Array<Integer> ret;
+      for (int trials : scheduler->task_trials) {
+        ret.push_back(trials);
+      }
+      return ret;
+    });
+
+}  // namespace auto_scheduler
+}  // namespace tvm
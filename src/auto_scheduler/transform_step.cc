@@ -612,6 +612,10 @@ void PragmaStepNode::ApplyToState(State* state) const {
     CHECK_LT(pos, pragma_type.size()) << "max step value not found.";
     stage.CopyOnWrite()->attrs.auto_unroll_max_step = atoi(pragma_type.c_str() + pos + 1);
     pstate->stages.Set(stage_id, std::move(stage));
+  } else if (StrStartsWith(pragma_type, "prefetch_distance")) {
+    // Only takes effect in the lowered loops, the state does not change.
+    CHECK_NE(std::string(pragma_type).find('$'), std::string::npos)
+        << "prefetch distance value not found.";
   } else {
     LOG(FATAL) << "Unsupported pragma: " << pragma_type;
   }
@@ -632,6 +636,11 @@ void PragmaStepNode::ApplyToSchedule(Array<te::Stage>* stages,
     int value = atoi(pragma_type.c_str() + pos + 1);
     stage.pragma(axes[iter_id], "auto_unroll_max_step", value);
     stage.pragma(axes[iter_id], "unroll_explicit", true);
+  } else if (StrStartsWith(pragma_type, "prefetch_distance")) {
+    size_t pos = std::string(pragma_type).find('$');
+    CHECK_NE(pos, std::string::npos) << "prefetch distance value not found.";
+    int value = atoi(pragma_type.c_str() + pos + 1);
+    stage.pragma(axes[iter_id], "prefetch_distance", value);
   } else {
     stage.pragma(axes[iter_id], pragma_type);
   }
@@ -659,6 +668,13 @@ String PragmaStepNode::PrintAsPythonAPI(Array<te::Stage>* stages,
     ss << "s[" << op_name << "].pragma("
        << CleanName((*stage_to_axes)[stage][iter_id]->var->name_hint, op_name)
        << ", \"unroll_explicit\", True)\n";
+  } else if (StrStartsWith(pragma_type, "prefetch_distance")) {
+    size_t pos = std::string(pragma_type).find('$');
+    CHECK_NE(pos, std::string::npos) << "prefetch distance value not found.";
+    int value = atoi(pragma_type.c_str() + pos + 1);
+    ss << "s[" << op_name << "].pragma("
+       << CleanName((*stage_to_axes)[stage][iter_id]->var->name_hint, op_name)
+       << ", \"prefetch_distance\", " << value << ")\n";
   } else {
     ss << "s[" << op_name << "].pragma("
        << CleanName((*stage_to_axes)[stage][iter_id]->var->name_hint, op_name) << ", \""
@@ -170,6 +170,7 @@ IRModule lower(te::Schedule sch, const Array<te::Tensor>& args, const std::strin
   pass_list.push_back(tir::transform::InjectVirtualThread());
   pass_list.push_back(tir::transform::InjectDoubleBuffer());
   pass_list.push_back(tir::transform::StorageRewrite());
+  pass_list.push_back(tir::transform::InsertPrefetch());
   pass_list.push_back(tir::transform::UnrollLoop());
   // Phase 2
   pass_list.push_back(tir::transform::Simplify());
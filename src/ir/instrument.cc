@@ -0,0 +1,318 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/ir/instrument.cc
+ * \brief Infrastructure for instrumentation of passes.
+ */
+#include <dmlc/json.h>
+#include <tvm/ir/instrument.h>
+#include <tvm/ir/transform.h>
+#include <tvm/node/reflection.h>
+#include <tvm/runtime/registry.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace instrument {
+
+BasePassInstrument::BasePassInstrument(
+    String name, runtime::TypedPackedFunc<void()> enter_pass_ctx_callback,
+    runtime::TypedPackedFunc<void()> exit_pass_ctx_callback,
+    runtime::TypedPackedFunc<void(const IRModule&, const transform::PassInfo&)>
+        run_before_pass_callback,
+    runtime::TypedPackedFunc<void(const IRModule&, const transform::PassInfo&)>
+        run_after_pass_callback) {
+  auto n = make_object<BasePassInstrumentNode>();
+  n->name = std::move(name);
+  n->enter_pass_ctx_callback = std::move(enter_pass_ctx_callback);
+  n->exit_pass_ctx_callback = std::move(exit_pass_ctx_callback);
+  n->run_before_pass_callback = std::move(run_before_pass_callback);
+  n->run_after_pass_callback = std::move(run_after_pass_callback);
+  data_ = std::move(n);
+}
+
+void BasePassInstrumentNode::EnterPassContext() const {
+  if (enter_pass_ctx_callback != nullptr) {
+    enter_pass_ctx_callback();
+  }
+}
+
+void BasePassInstrumentNode::ExitPassContext() const {
+  if (exit_pass_ctx_callback != nullptr) {
+    exit_pass_ctx_callback();
+  }
+}
+
+void BasePassInstrumentNode::RunBeforePass(const IRModule& mod,
+                                           const transform::PassInfo& info) const {
+  if (run_before_pass_callback != nullptr) {
+    run_before_pass_callback(mod, info);
+  }
+}
+
+void BasePassInstrumentNode::RunAfterPass(const IRModule& mod,
+                                          const transform::PassInfo& info) const {
+  if (run_after_pass_callback != nullptr) {
+    run_after_pass_callback(mod, info);
+  }
+}
+
+/*! \brief Traverse all nodes reachable from a root, in the same way as the JSON serializer. */
+class IRNodeCounter : public AttrVisitor {
+ public:
+  int64_t Count(const ObjectRef& root) {
+    Push(root.get());
+    while (!stack_.empty()) {
+      Object* node = stack_.back();
+      stack_.pop_back();
+      if (node->IsInstance<ArrayNode>()) {
+        for (const ObjectRef& elem : *static_cast<ArrayNode*>(node)) {
+          Push(elem.get());
+        }
+      } else if (node->IsInstance<MapNode>()) {
+        for (const auto& kv : *static_cast<MapNode*>(node)) {
+          Push(kv.first.get());
+          Push(kv.second.get());
+        }
+      } else if (!reflection_->GetReprBytes(node, nullptr)) {
+        reflection_->VisitAttrs(node, this);
+      }
+    }
+    return static_cast<int64_t>(visited_.size());
+  }
+
+  void Visit(const char* key, double* value) final {}
+  void Visit(const char* key, int64_t* value) final {}
+  void Visit(const char* key, uint64_t* value) final {}
+  void Visit(const char* key, int* value) final {}
+  void Visit(const char* key, bool* value) final {}
+  void Visit(const char* key, std::string* value) final {}
+  void Visit(const char* key, void** value) final {}
+  void Visit(const char* key, DataType* value) final {}
+  void Visit(const char* key, runtime::NDArray* value) final {}
+  void Visit(const char* key, ObjectRef* value) final { Push(value->get()); }
+
+ private:
+  void Push(const Object* node) {
+    if (node != nullptr && visited_.insert(node).second) {
+      stack_.push_back(const_cast<Object*>(node));
+    }
+  }
+
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+  std::unordered_set<const Object*> visited_;
+  std::vector<Object*> stack_;
+};
+
+int64_t CountIRNodes(const IRModule& mod) { return IRNodeCounter().Count(mod); }
+
+/*! \brief Get the peak resident set size of the process in KB, 0 if not supported. */
+static int64_t GetPeakRSSKB() {
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    // ru_maxrss is in bytes on macOS.
+    return static_cast<int64_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<int64_t>(usage.ru_maxrss);
+#endif
+  }
+#endif
+  return 0;
+}
+
+PassProfiler::PassProfiler(bool count_nodes) {
+  auto n = make_object<PassProfilerNode>();
+  n->name = "PassProfiler";
+  n->count_nodes = count_nodes;
+  n->origin_ = std::chrono::steady_clock::now();
+  data_ = std::move(n);
+}
+
+void PassProfilerNode::EnterPassContext() const {
+  origin_ = std::chrono::steady_clock::now();
+  running_.clear();
+}
+
+void PassProfilerNode::ExitPassContext() const { running_.clear(); }
+
+void PassProfilerNode::RunBeforePass(const IRModule& mod, const transform::PassInfo& info) const {
+  RunningPass pass;
+  pass.name = info->name;
+  pass.nodes_before = count_nodes ? CountIRNodes(mod) : -1;
+  pass.peak_rss_kb = GetPeakRSSKB();
+  // Start the timer after counting the nodes, so the counting is not included in the wall time.
+  pass.start = std::chrono::steady_clock::now();
+  running_.push_back(std::move(pass));
+}
+
+void PassProfilerNode::RunAfterPass(const IRModule& mod, const transform::PassInfo& info) const {
+  auto end = std::chrono::steady_clock::now();
+  // The stack is unbalanced if a pass threw an exception, drop the passes that never finished.
+  while (!running_.empty() && running_.back().name != info->name) {
+    running_.pop_back();
+  }
+  if (running_.empty()) {
+    return;
+  }
+  const RunningPass& pass = running_.back();
+
+  PassProfileEvent event;
+  event.name = pass.name;
+  event.depth = static_cast<int>(running_.size()) - 1;
+  event.start_us = std::chrono::duration<double, std::micro>(pass.start - origin_).count();
+  event.duration_us = std::chrono::duration<double, std::micro>(end - pass.start).count();
+  event.peak_rss_delta_kb = GetPeakRSSKB() - pass.peak_rss_kb;
+  event.nodes_before = pass.nodes_before;
+  event.nodes_after = count_nodes ? CountIRNodes(mod) : -1;
+  events_.push_back(std::move(event));
+  running_.pop_back();
+}
+
+void PassProfilerNode::Reset() const {
+  running_.clear();
+  events_.clear();
+}
+
+String PassProfilerNode::Render() const {
+  // Events are recorded when the passes end, so a nested pass comes before its parent.
+  // Sort by the start time to print the parents first.
+  std::vector<const PassProfileEvent*> sorted;
+  for (const auto& event : events_) {
+    sorted.push_back(&event);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const PassProfileEvent* a, const PassProfileEvent* b) {
+                     return a->start_us < b->start_us;
+                   });
+
+  std::ostringstream os;
+  os << std::left << std::setw(48) << "Pass" << std::right << std::setw(14) << "Time (ms)"
+     << std::setw(18) << "Peak RSS +(MB)" << std::setw(14) << "Nodes before" << std::setw(14)
+     << "Nodes after" << "\n";
+  for (const PassProfileEvent* event : sorted) {
+    std::string name = std::string(2 * event->depth, ' ') + event->name;
+    os << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(3)
+       << std::setw(14) << event->duration_us / 1e3 << std::setw(18)
+       << event->peak_rss_delta_kb / 1024.0;
+    if (event->nodes_before >= 0) {
+      os << std::setw(14) << event->nodes_before << std::setw(14) << event->nodes_after;
+    } else {
+      os << std::setw(14) << "-" << std::setw(14) << "-";
+    }
+    os << "\n";
+  }
+  return os.str();
+}
+
+String PassProfilerNode::AsChromeTrace() const {
+  std::ostringstream os;
+  dmlc::JSONWriter writer(&os);
+  writer.BeginObject();
+  writer.WriteObjectKeyValue("displayTimeUnit", std::string("ms"));
+  writer.WriteObjectKeyValue("otherData",
+                             std::map<std::string, std::string>{{"name", std::string(name)}});
+  writer.WriteObjectKey("traceEvents");
+  writer.BeginArray();
+  for (const auto& event : events_) {
+    writer.WriteArraySeperator();
+    writer.BeginObject();
+    writer.WriteObjectKeyValue("name", event.name);
+    writer.WriteObjectKeyValue("cat", std::string("pass"));
+    writer.WriteObjectKeyValue("ph", std::string("X"));
+    writer.WriteObjectKeyValue("ts", event.start_us);
+    writer.WriteObjectKeyValue("dur", event.duration_us);
+    writer.WriteObjectKeyValue("pid", 0);
+    writer.WriteObjectKeyValue("tid", 0);
+    writer.WriteObjectKey("args");
+    writer.BeginObject();
+    writer.WriteObjectKeyValue("depth", event.depth);
+    writer.WriteObjectKeyValue("peak_rss_delta_kb", event.peak_rss_delta_kb);
+    if (event.nodes_before >= 0) {
+      writer.WriteObjectKeyValue("nodes_before", event.nodes_before);
+      writer.WriteObjectKeyValue("nodes_after", event.nodes_after);
+    }
+    writer.EndObject();
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return os.str();
+}
+
+TVM_REGISTER_NODE_TYPE(BasePassInstrumentNode);
+TVM_REGISTER_NODE_TYPE(PassProfilerNode);
+
+TVM_REGISTER_GLOBAL("instrument.PassInstrument")
+    .set_body_typed(
+        [](String name, runtime::TypedPackedFunc<void()> enter_pass_ctx,
+           runtime::TypedPackedFunc<void()> exit_pass_ctx,
+           runtime::TypedPackedFunc<void(const IRModule&, const transform::PassInfo&)>
+               run_before_pass,
+           runtime::TypedPackedFunc<void(const IRModule&, const transform::PassInfo&)>
+               run_after_pass) {
+          return BasePassInstrument(name, enter_pass_ctx, exit_pass_ctx, run_before_pass,
+                                    run_after_pass);
+        });
+
+TVM_REGISTER_GLOBAL("instrument.PassProfiler").set_body_typed([](bool count_nodes) {
+  return PassProfiler(count_nodes);
+});
+
+TVM_REGISTER_GLOBAL("instrument.PassProfilerRender").set_body_typed([](PassProfiler profiler) {
+  return profiler->Render();
+});
+
+TVM_REGISTER_GLOBAL("instrument.PassProfilerAsChromeTrace")
+    .set_body_typed([](PassProfiler profiler) { return profiler->AsChromeTrace(); });
+
+TVM_REGISTER_GLOBAL("instrument.PassProfilerReset").set_body_typed([](PassProfiler profiler) {
+  profiler->Reset();
+});
+
+TVM_REGISTER_GLOBAL("instrument.PassProfilerGetEvents").set_body_typed([](PassProfiler profiler) {
+  Array<Map<String, ObjectRef>> ret;
+  for (const auto& event : profiler->events()) {
+    Map<String, ObjectRef> item;
+    item.Set("name", String(event.name));
+    item.Set("depth", Integer(event.depth));
+    item.Set("start_us", FloatImm(DataType::Float(64), event.start_us));
+    item.Set("duration_us", FloatImm(DataType::Float(64), event.duration_us));
+    item.Set("peak_rss_delta_kb", IntImm(DataType::Int(64), event.peak_rss_delta_kb));
+    item.Set("nodes_before", IntImm(DataType::Int(64), event.nodes_before));
+    item.Set("nodes_after", IntImm(DataType::Int(64), event.nodes_after));
+    ret.push_back(item);
+  }
+  return ret;
+});
+
+}  // namespace instrument
+}  // namespace tvm
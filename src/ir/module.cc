@@ -185,7 +185,12 @@ tvm::Array<T> concat(const tvm::Array<T>& l, const tvm::Array<T>& r) {
 
 // helper function to run type check
 relay::Function RunTypeCheck(const IRModule& mod, const GlobalVar& var, relay::Function f) {
-  auto func = Downcast<relay::Function>(relay::DeDup(std::move(f)));
+  // DeDup rebuilds every node that uses a variable and drops the checked types that incremental
+  // inference reuses, so it is skipped if the variables are unique already.
+  auto func = f;
+  if (!relay::IsIncrementalTypeInference() || !relay::WellFormed(f)) {
+    func = Downcast<relay::Function>(relay::DeDup(std::move(f)));
+  }
   // Type check the item before we add it to the module.
   auto fv = relay::FreeVars(func);
   auto ftv = relay::FreeTypeVars(func, mod);
@@ -56,12 +56,18 @@ typedef dmlc::ThreadLocalStore<PassContextThreadLocalEntry> RelayPassContextThre
 void PassContext::EnterWithScope() {
   PassContextThreadLocalEntry* entry = RelayPassContextThreadLocalStore::Get();
   entry->context_stack.push(*this);
+  for (const instrument::PassInstrument& pi : (*this)->instruments) {
+    pi->EnterPassContext();
+  }
 }
 
 void PassContext::ExitWithScope() {
   PassContextThreadLocalEntry* entry = RelayPassContextThreadLocalStore::Get();
   CHECK(!entry->context_stack.empty());
   CHECK(entry->context_stack.top().same_as(*this));
+  for (const instrument::PassInstrument& pi : (*this)->instruments) {
+    pi->ExitPassContext();
+  }
   entry->context_stack.pop();
 }
 
@@ -147,6 +153,31 @@ void PassContext::Trace(const IRModule& module, const PassInfo& info, bool is_be
   }
 }
 
+void PassContext::InstrumentBeforePass(const IRModule& module, const PassInfo& info) const {
+  for (const instrument::PassInstrument& pi : (*this)->instruments) {
+    pi->RunBeforePass(module, info);
+  }
+}
+
+void PassContext::InstrumentAfterPass(const IRModule& module, const PassInfo& info) const {
+  for (const instrument::PassInstrument& pi : (*this)->instruments) {
+    pi->RunAfterPass(module, info);
+  }
+}
+
+IRModule Pass::operator()(IRModule mod, const PassContext& pass_ctx) const {
+  const PassNode* node = operator->();
+  CHECK(node != nullptr);
+  if (pass_ctx->instruments.empty()) {
+    return node->operator()(std::move(mod), pass_ctx);
+  }
+  const PassInfo& pass_info = node->Info();
+  pass_ctx.InstrumentBeforePass(mod, pass_info);
+  mod = node->operator()(std::move(mod), pass_ctx);
+  pass_ctx.InstrumentAfterPass(mod, pass_info);
+  return mod;
+}
+
 class ModulePass;
 
 /*!
@@ -454,13 +485,15 @@ TVM_REGISTER_NODE_TYPE(PassContextNode);
 
 TVM_REGISTER_GLOBAL("transform.PassContext")
     .set_body_typed([](int opt_level, Array<String> required, Array<String> disabled,
-                       TraceFunc trace_func, Optional<Map<String, ObjectRef>> config) {
+                       TraceFunc trace_func, Optional<Map<String, ObjectRef>> config,
+                       Array<instrument::PassInstrument> instruments) {
       auto pctx = PassContext::Create();
       pctx->opt_level = opt_level;
 
       pctx->required_pass = std::move(required);
       pctx->disabled_pass = std::move(disabled);
       pctx->trace_func = std::move(trace_func);
+      pctx->instruments = std::move(instruments);
       if (config.defined()) {
         pctx->config = config.value();
       }
@@ -486,6 +519,12 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
         p->stream << it << " ";
       }
       p->stream << "]\n";
+
+      p->stream << "\tinstruments: [";
+      for (const auto& it : node->instruments) {
+        p->stream << it->name << " ";
+      }
+      p->stream << "]\n";
       p->stream << "\tconfig: " << node->config;
     });
 
@@ -255,6 +255,10 @@ Doc RelayTextPrinter::PrintExpr(const Expr& expr, bool meta, bool try_inline, bo
   auto it = memo_.find(expr);
   if (it != memo_.end()) return it->second;
 
+  if (!meta) {
+    PrintDataflowInputs(expr);
+  }
+
   Doc printed_expr;
 
   if (meta) {
@@ -291,6 +295,52 @@ Doc RelayTextPrinter::PrintExpr(const Expr& expr, bool meta, bool try_inline, bo
   }
 }
 
+void RelayTextPrinter::PrintDataflowInputs(const Expr& expr) {
+  // The inputs are printed in the order of the visitors below, in post order with a stack,
+  // so that deep dataflow graphs print with the same temp vars as with a recursion.
+  auto get_inputs = [](const Expr& e) {
+    std::vector<Expr> inputs;
+    if (const auto* call = e.as<CallNode>()) {
+      for (const Expr& arg : call->args) {
+        inputs.push_back(arg);
+      }
+      if (!call->op.as<ConstructorNode>()) {
+        inputs.push_back(call->op);
+      }
+    } else if (const auto* tuple = e.as<TupleNode>()) {
+      for (const Expr& field : tuple->fields) {
+        inputs.push_back(field);
+      }
+    } else if (const auto* get = e.as<TupleGetItemNode>()) {
+      inputs.push_back(get->tuple);
+    }
+    return inputs;
+  };
+  std::vector<std::pair<Expr, bool>> stack;
+  auto push_inputs = [&](const Expr& e) {
+    std::vector<Expr> inputs = get_inputs(e);
+    for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+      if (!memo_.count(*it)) {
+        stack.push_back({*it, false});
+      }
+    }
+  };
+  push_inputs(expr);
+  while (!stack.empty()) {
+    Expr e = stack.back().first;
+    if (memo_.count(e)) {
+      stack.pop_back();
+    } else if (stack.back().second ||
+               !(e.as<CallNode>() || e.as<TupleNode>() || e.as<TupleGetItemNode>())) {
+      stack.pop_back();
+      Print(e);
+    } else {
+      stack.back().second = true;
+      push_inputs(e);
+    }
+  }
+}
+
 // Should only be triggered when op is a free variable being visited for the
 // first time.
 Doc RelayTextPrinter::VisitExpr_(const VarNode* op) { return AllocVar(GetRef<Var>(op)); }
@@ -109,6 +109,8 @@ class RelayTextPrinter : public ExprFunctor<Doc(const Expr&)>,
   // Overload of Expr printing functions
   //------------------------------------
   Doc PrintExpr(const Expr& expr, bool meta, bool try_inline, bool optional_info = true);
+  // Print the dataflow inputs of expr ahead of it, without recursing on them.
+  void PrintDataflowInputs(const Expr& expr);
   // Should only be triggered when op is a free variable being visited for the
   // first time.
   Doc VisitExpr_(const VarNode* op) final;
@@ -27,6 +27,7 @@
 
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace tvm {
 namespace relay {
@@ -74,14 +75,26 @@ class DependencyGraph::Creator : private ExprFunctor<void(const Expr& e)> {
   }
 
   void VisitExpr(const Expr& e) final {
-    if (visited_.count(e) == 0) {
-      if (graph_.expr_node.count(e) == 0) {
-        graph_.expr_node[e] = NewNode(false);
-      }
-      visited_.insert(e);
-      ExprFunctor<void(const Expr&)>::VisitExpr(e);
-      graph_.post_dfs_order.push_back(graph_.expr_node[e]);
+    if (visited_.count(e) != 0) return;
+    if (e.as<CallNode>() || e.as<TupleNode>() || e.as<TupleGetItemNode>()) {
+      // Visit the dataflow inputs in post order iteratively, so that the recursion does not grow
+      // with the length of the chains of calls.
+      auto fcheck_visited = [this](const Expr& expr) { return visited_.count(expr) != 0; };
+      auto fvisit_leaf = [this](const Expr& expr) { VisitNode(expr); };
+      ExpandDataflow(e, fcheck_visited, fvisit_leaf);
+    } else {
+      VisitNode(e);
+    }
+  }
+
+  // Visit a node whose dataflow inputs may have been visited already.
+  void VisitNode(const Expr& e) {
+    if (graph_.expr_node.count(e) == 0) {
+      graph_.expr_node[e] = NewNode(false);
     }
+    visited_.insert(e);
+    ExprFunctor<void(const Expr&)>::VisitExpr(e);
+    graph_.post_dfs_order.push_back(graph_.expr_node[e]);
   }
 
   void VisitExpr_(const CallNode* c) final {
@@ -145,13 +158,35 @@ class DependencyGraph::Creator : private ExprFunctor<void(const Expr& e)> {
   }
 
   void VisitExpr_(const LetNode* l) final {
-    DependencyGraph::Node* n = graph_.expr_node[GetRef<Expr>(l)];
-    DependencyGraph::Node* b = NewNode(true);
-    Depend(n, b);
-    Depend(b, l->var);
-    Depend(b, l->value);
-    Depend(b, l->body);
-    graph_.post_dfs_order.push_back(b);
+    // Visit the let chains iteratively, in the same order as the recursion on their bodies.
+    std::vector<Expr> lets;
+    std::vector<DependencyGraph::Node*> scopes;
+    Expr e = GetRef<Expr>(l);
+    while (const auto* let = e.as<LetNode>()) {
+      if (!lets.empty()) {
+        if (visited_.count(e) != 0) break;
+        if (graph_.expr_node.count(e) == 0) {
+          graph_.expr_node[e] = NewNode(false);
+        }
+        visited_.insert(e);
+      }
+      DependencyGraph::Node* n = graph_.expr_node[e];
+      DependencyGraph::Node* b = NewNode(true);
+      Depend(n, b);
+      Depend(b, let->var);
+      Depend(b, let->value);
+      lets.push_back(e);
+      scopes.push_back(b);
+      e = let->body;
+    }
+    Depend(scopes.back(), e);
+    for (size_t i = scopes.size(); i-- > 0;) {
+      graph_.post_dfs_order.push_back(scopes[i]);
+      if (i > 0) {
+        graph_.post_dfs_order.push_back(graph_.expr_node[lets[i]]);
+        Depend(scopes[i - 1], graph_.expr_node[lets[i]]);
+      }
+    }
   }
 
   void VisitExpr_(const MatchNode* m) final {
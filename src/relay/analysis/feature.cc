@@ -38,12 +38,34 @@ FeatureSet DetectFeature(const Expr& expr) {
   }
   struct FeatureDetector : ExprVisitor {
     std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual> visited_;
+    // The dataflow inputs visited ahead of their first consumer.
+    std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual> prefetched_;
     FeatureSet fs = FeatureSet::No();
 
     void VisitExpr(const Expr& expr) final {
-      if (visited_.count(expr) == 0) {
+      if (prefetched_.count(expr) != 0) {
+        prefetched_.erase(expr);
         visited_.insert(expr);
-        ExprVisitor::VisitExpr(expr);
+      } else if (visited_.count(expr) == 0) {
+        if (expr.as<CallNode>() || expr.as<TupleNode>() || expr.as<TupleGetItemNode>()) {
+          // Visit the dataflow inputs with a stack, so that the recursion does not grow with
+          // the depth of the dataflow.
+          auto fcheck_visited = [this](const Expr& e) {
+            return visited_.count(e) != 0 || prefetched_.count(e) != 0;
+          };
+          auto fvisit_leaf = [this, &expr](const Expr& e) {
+            if (e.same_as(expr)) {
+              visited_.insert(e);
+            } else {
+              prefetched_.insert(e);
+            }
+            ExprFunctor::VisitExpr(e);
+          };
+          ExpandDataflow(expr, fcheck_visited, fvisit_leaf);
+        } else {
+          visited_.insert(expr);
+          ExprVisitor::VisitExpr(expr);
+        }
       } else {
         if (!IsAtomic(expr)) {
           fs += fGraph;
@@ -67,12 +89,23 @@ FeatureSet DetectFeature(const Expr& expr) {
     DETECT_DEFAULT_CONSTRUCT(Op)
     DETECT_DEFAULT_CONSTRUCT(Call)
     DETECT_CONSTRUCT(Let, {
-      for (const Var& v : FreeVars(op->value)) {
-        if (op->var == v) {
-          fs += fLetRec;
+      // Visit the let chain in a loop, so that the recursion does not grow with its length.
+      Expr body = GetRef<Expr>(op);
+      while (const auto* let = body.as<LetNode>()) {
+        if (let != op) {
+          if (visited_.count(body) != 0) break;
+          visited_.insert(body);
+        }
+        for (const Var& v : FreeVars(let->value)) {
+          if (let->var == v) {
+            fs += fLetRec;
+          }
         }
+        VisitExpr(let->var);
+        VisitExpr(let->value);
+        body = let->body;
       }
-      ExprVisitor::VisitExpr_(op);
+      VisitExpr(body);
     })
     DETECT_DEFAULT_CONSTRUCT(If)
     DETECT_DEFAULT_CONSTRUCT(RefCreate)
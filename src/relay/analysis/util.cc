@@ -71,7 +71,7 @@ class TypeVarTVisitor : public TypeVisitor {
   InsertionSet<TypeVar>* bound_type_vars_;
 };
 
-class TypeVarEVisitor : private ExprVisitor {
+class TypeVarEVisitor : private MixedModeVisitor {
  public:
   explicit TypeVarEVisitor(const IRModule& mod) : mod_(mod) {}
 
@@ -149,6 +149,13 @@ class TypeVarEVisitor : private ExprVisitor {
     ExprVisitor::VisitExpr_(cn);
   }
 
+  void VisitExpr_(const CallNode* call) final {
+    // The arguments are visited before the call by MixedModeVisitor.
+    for (const auto& ty_arg : call->type_args) {
+      VisitType(ty_arg);
+    }
+  }
+
   void VisitType(const Type& t) final {
     TypeVarTVisitor(&type_vars_, &bound_type_vars_).VisitType(t);
   }
@@ -159,7 +166,7 @@ class TypeVarEVisitor : private ExprVisitor {
   const IRModule& mod_;
 };
 
-class VarVisitor : protected ExprVisitor, protected PatternVisitor {
+class VarVisitor : protected MixedModeVisitor, protected PatternVisitor {
  public:
   Array<Var> Free(const Expr& expr) {
     this->VisitExpr(expr);
@@ -112,6 +112,21 @@ class WellFormedChecker : private ExprVisitor, PatternVisitor {
   void VisitExpr(const Expr& e) final {
     if (auto v = e.as<VarNode>()) {
       VisitExpr_(v);
+    } else if (!visit_counter_.count(e.get()) &&
+               (e.as<CallNode>() || e.as<TupleNode>() || e.as<TupleGetItemNode>())) {
+      // Visit the dataflow inputs in post order iteratively, so that the recursion does not grow
+      // with the length of the chains of calls. The variables are checked at every use.
+      auto fcheck_visited = [this](const Expr& expr) {
+        return !expr.as<VarNode>() && visit_counter_.count(expr.get());
+      };
+      auto fvisit_leaf = [this](const Expr& expr) {
+        if (auto v = expr.as<VarNode>()) {
+          VisitExpr_(v);
+        } else {
+          ExprVisitor::VisitExpr(expr);
+        }
+      };
+      ExpandDataflow(e, fcheck_visited, fvisit_leaf);
     } else {
       ExprVisitor::VisitExpr(e);
     }
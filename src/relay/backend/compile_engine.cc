@@ -38,10 +38,12 @@
 #include <tvm/te/schedule_pass.h>
 #include <tvm/topi/tags.h>
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -155,6 +157,7 @@ class ScheduleGetter : public backend::MemoizedExprTranslator<Array<te::Tensor>>
           schedule[scalar].compute_inline();
         }
       }
+      InlinePrologue(schedule, tensor_outs);
     }
     cache_node->schedule = std::move(schedule);
     return CachedFunc(cache_node);
@@ -234,10 +237,12 @@ class ScheduleGetter : public backend::MemoizedExprTranslator<Array<te::Tensor>>
           << " master=" << master_op_ << " current=" << op;
     }
     if (op_pattern >= master_op_pattern_) {
+      static auto ffuse_prologue = Op::GetAttrMap<TFusePrologue>("TFusePrologue");
       master_op_ = op;
       master_attrs_ = call_node->attrs;
       master_op_pattern_ = op_pattern;
       master_implementation_ = impl;
+      master_inputs_ = ffuse_prologue.get(op, false) ? inputs : Array<te::Tensor>();
     }
     if (outputs.size() != 1) {
       const auto* tuple_type = call_node->checked_type().as<TupleTypeNode>();
@@ -288,11 +293,43 @@ class ScheduleGetter : public backend::MemoizedExprTranslator<Array<te::Tensor>>
   }
 
  private:
+  /*!
+   * \brief Inline the injective producers that FuseOps fused into the input loading of a
+   *  master op marked TFusePrologue. The schedule of the master op only handles its own
+   *  stages, so the producers would otherwise be computed as separate loop nests.
+   */
+  void InlinePrologue(const te::Schedule& schedule, const Array<te::Tensor>& outputs) {
+    std::unordered_set<te::Operation, ObjectPtrHash, ObjectPtrEqual> visited;
+    std::vector<te::Operation> stack;
+    for (const auto& tensor : master_inputs_) {
+      stack.push_back(tensor->op);
+    }
+    while (!stack.empty()) {
+      te::Operation op = stack.back();
+      stack.pop_back();
+      if (!visited.insert(op).second) continue;
+      const auto* compute = op.as<te::ComputeOpNode>();
+      if (compute == nullptr) continue;
+      for (const auto& tensor : op->InputTensors()) {
+        stack.push_back(tensor->op);
+      }
+      bool is_output = std::any_of(outputs.begin(), outputs.end(),
+                                   [&](const te::Tensor& tensor) { return tensor->op.same_as(op); });
+      if (is_output || !compute->reduce_axis.empty() || !schedule->Contain(op)) continue;
+      te::Stage stage = schedule[op];
+      if (stage->attach_type == te::kGroupRoot) {
+        stage.compute_inline();
+      }
+    }
+  }
+
   tvm::Target target_;
   Op master_op_;
   Attrs master_attrs_;
   int master_op_pattern_{0};
   OpImplementation master_implementation_;
+  // The inputs of the master op if it absorbs its injective producers.
+  Array<te::Tensor> master_inputs_;
   std::ostringstream readable_name_stream_;
   Array<te::Operation> scalars_;
   // Cache device copy op for equivalence checking to reduce registry lookup
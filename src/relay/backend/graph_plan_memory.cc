@@ -48,7 +48,7 @@ struct StorageToken {
   int64_t storage_id{-1};
 };
 
-class StorageAllocaBaseVisitor : public ExprVisitor {
+class StorageAllocaBaseVisitor : public MixedModeVisitor {
  public:
   // run the visitor on a function.
   void Run(const Function& func) {
@@ -317,6 +317,20 @@ class GraphRuntimeCodegen : public backend::MemoizedExprTranslator<std::vector<G
     return AddNode(node, expr);
   }
 
+  std::vector<GraphNodeRef> VisitExpr(const Expr& expr) override {
+    // Translate the dataflow inputs first in post order, so that the recursion does not grow
+    // with the depth of the graph. The callees are left to the call visitor.
+    auto fcheck_visited = [this](const Expr& e) {
+      return memo_.count(e) != 0 || e.as<FunctionNode>() || e.as<OpNode>() ||
+             e.as<GlobalVarNode>();
+    };
+    auto fvisit_leaf = [this](const Expr& e) {
+      backend::MemoizedExprTranslator<std::vector<GraphNodeRef>>::VisitExpr(e);
+    };
+    ExpandDataflow(expr, fcheck_visited, fvisit_leaf);
+    return backend::MemoizedExprTranslator<std::vector<GraphNodeRef>>::VisitExpr(expr);
+  }
+
   std::vector<GraphNodeRef> VisitExpr_(const TupleNode* op) override {
     std::vector<GraphNodeRef> fields;
     for (auto field : op->fields) {
@@ -39,7 +39,7 @@ namespace vm {
 /**
  * \brief Detects all the functions that can be possibly called by entry function.
  */
-struct CallTracer : ExprVisitor {
+struct CallTracer : MixedModeVisitor {
   IRModule module_;
 
   // Record the names of all encountered functions
@@ -61,9 +61,9 @@ struct CallTracer : ExprVisitor {
     if (visiting_.find(func) == visiting_.end()) {
       visiting_.insert(func);
       for (auto param : func_node->params) {
-        ExprVisitor::VisitExpr(param);
+        VisitExpr(param);
       }
-      ExprVisitor::VisitExpr(func_node->body);
+      VisitExpr(func_node->body);
     }
   }
 
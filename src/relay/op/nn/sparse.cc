@@ -19,13 +19,15 @@
 
 /*!
  * \file sparse.cc
- * \brief Property def of nn.sparse_dense operator.
+ * \brief Property def of nn.sparse_dense and nn.sparse_conv2d operators.
  */
 
 #include <tvm/relay/attrs/nn.h>
 #include <tvm/relay/op.h>
 #include <tvm/tir/data_layout.h>
 
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "../../transforms/infer_layout_util.h"
@@ -92,6 +94,72 @@ RELAY_REGISTER_OP("nn.sparse_dense")
     .set_support_level(1)
     .add_type_rel("SparseDense", SparseDenseRel);
 
+// relay.nn.sparse_conv2d
+TVM_REGISTER_NODE_TYPE(SparseConv2DAttrs);
+
+bool SparseConv2DRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                     const TypeReporter& reporter) {
+  CHECK_EQ(types.size(), 5);
+  const auto* param = attrs.as<SparseConv2DAttrs>();
+  CHECK(param != nullptr);
+  const auto* data = types[0].as<TensorTypeNode>();
+  const auto* weight_data = types[1].as<TensorTypeNode>();
+  const auto* weight_indptr = types[3].as<TensorTypeNode>();
+  if (data == nullptr || weight_data == nullptr || weight_indptr == nullptr) return false;
+  CHECK_EQ(data->shape.size(), 4) << "nn.sparse_conv2d only supports 4-D data";
+  CHECK(weight_data->shape.size() == 3)
+      << "nn.sparse_conv2d only supports the BSR weight, with 3-D weight data";
+  CHECK(param->kernel_size == 1 || param->kernel_size == 3)
+      << "nn.sparse_conv2d only supports the kernel size 1 and 3, but got "
+      << param->kernel_size;
+
+  IndexExpr channels = (weight_indptr->shape[0] - 1) * weight_data->shape[1];
+  Array<IndexExpr> oshape;
+  if (param->layout == "NHWC") {
+    oshape = {data->shape[0], data->shape[1], data->shape[2], channels};
+  } else if (param->layout == "NCHW") {
+    oshape = {data->shape[0], channels, data->shape[2], data->shape[3]};
+  } else {
+    LOG(FATAL) << "Unsupported layout " << param->layout << " for nn.sparse_conv2d";
+    return false;
+  }
+  reporter->Assign(types[4], TensorType(oshape, data->dtype));
+  return true;
+}
+
+Expr MakeSparseConv2D(Expr data, Expr weight_data, Expr weight_indices, Expr weight_indptr,
+                      std::string layout, int kernel_size) {
+  auto attrs = make_object<SparseConv2DAttrs>();
+  attrs->layout = std::move(layout);
+  attrs->kernel_size = kernel_size;
+  static const Op& op = Op::Get("nn.sparse_conv2d");
+  return Call(op, {data, weight_data, weight_indices, weight_indptr}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.sparse_conv2d").set_body_typed(MakeSparseConv2D);
+
+RELAY_REGISTER_OP("nn.sparse_conv2d")
+    .describe(R"code(Applies a 2D convolution with a block sparse (BSR) weight.
+The 1x1 kernel has stride 1 and no padding, the 3x3 kernel has stride 1 and padding 1.
+
+- **data**: `(batch, in_channels, height, width)` if `layout` is `NCHW`,
+            `(batch, height, width, in_channels)` if `layout` is `NHWC`.
+- **weight**: `(out_channels, in_channels * kernel_size * kernel_size)` in BSR format.
+              The columns are ordered as `(in_channels, kh, kw)` if `layout` is `NCHW`,
+              as `(kh, kw, in_channels)` if `layout` is `NHWC`.
+- **out**: `(batch, out_channels, height, width)` if `layout` is `NCHW`,
+           `(batch, height, width, out_channels)` if `layout` is `NHWC`.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<SparseConv2DAttrs>()
+    .set_num_inputs(4)
+    .add_argument("data", "4D Tensor", "Input data.")
+    .add_argument("weight_data", "3D Tensor", "Weight data matrix.")
+    .add_argument("weight_indices", "1D Tensor", "Weight indices matrix.")
+    .add_argument("weight_indptr", "1D Tensor", "Weight indptr matrix.")
+    .set_support_level(1)
+    .add_type_rel("SparseConv2D", SparseConv2DRel);
+
 // relay.nn.sparse_transpose
 TVM_REGISTER_NODE_TYPE(SparseTransposeAttrs);
 
@@ -23,11 +23,20 @@
  *
  * \brief Create profile graph and calibrate on dataset
  */
+#include <dmlc/json.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op.h>
+#include <tvm/support/parallel_for.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
 #include <numeric>
+#include <string>
+#include <vector>
 
 #include "./quantize.h"
 
@@ -79,8 +88,8 @@ static float ComputeEntropy(float* p, float* q, size_t size) {
   return ret;
 }
 
-float MinimizeKL(const std::vector<int>& hist, const std::vector<float>& hist_edges, int num_bins,
-                 int num_quantized_bins) {
+float MinimizeKL(const std::vector<int64_t>& hist, const std::vector<float>& hist_edges,
+                 int num_bins, int num_quantized_bins, float* min_divergence = nullptr) {
   const int zero_bin_idx = num_bins / 2;
   const int num_half_quantized_bins = num_quantized_bins / 2;
   std::vector<float> thresholds(num_bins / 2 + 1 - num_quantized_bins / 2, 0.f);
@@ -91,7 +100,7 @@ float MinimizeKL(const std::vector<int>& hist, const std::vector<float>& hist_ed
     const int p_bin_idx_stop = zero_bin_idx + i + 1;
     thresholds[i - num_half_quantized_bins] = hist_edges[p_bin_idx_stop];
 
-    std::vector<int> sliced_nd_hist(p_bin_idx_stop - p_bin_idx_start);
+    std::vector<int64_t> sliced_nd_hist(p_bin_idx_stop - p_bin_idx_start);
     std::vector<float> p(sliced_nd_hist.size());
     p[0] = 0;
     p.back() = 0;
@@ -110,19 +119,19 @@ float MinimizeKL(const std::vector<int>& hist, const std::vector<float>& hist_ed
     for (int j = 0; j < num_quantized_bins; j++) {
       const int start = j * num_merged_bins;
       const int stop = (j + 1) * num_merged_bins;
-      quantized_bins[j] =
-          std::accumulate(sliced_nd_hist.begin() + start, sliced_nd_hist.begin() + stop, 0);
+      quantized_bins[j] = std::accumulate(sliced_nd_hist.begin() + start,
+                                          sliced_nd_hist.begin() + stop, int64_t{0});
     }
     quantized_bins.back() += std::accumulate(
         sliced_nd_hist.begin() + static_cast<int>(num_quantized_bins * num_merged_bins),
-        sliced_nd_hist.end(), 0);
+        sliced_nd_hist.end(), int64_t{0});
     // expand quantized_bins into p.size bins
     std::vector<float> q(sliced_nd_hist.size(), 0);
     for (int j = 0; j < num_quantized_bins; j++) {
       const int start = j * num_merged_bins;
       const int stop = (j == num_quantized_bins - 1) ? q.size() : ((j + 1) * num_merged_bins);
       int norm = std::count_if(sliced_nd_hist.begin() + start, sliced_nd_hist.begin() + stop,
-                               [](size_t i) { return i != 0; });
+                               [](int64_t i) { return i != 0; });
       if (norm) {
         for (int k = start; k < stop; k++) {
           if (p[k]) q[k] = quantized_bins[j] / norm;
@@ -140,9 +149,337 @@ float MinimizeKL(const std::vector<int>& hist, const std::vector<float>& hist_ed
   }
   auto min_divergence_idx =
       std::distance(divergence.begin(), std::min_element(divergence.begin(), divergence.end()));
+  if (min_divergence != nullptr) {
+    *min_divergence = divergence[min_divergence_idx];
+  }
   return thresholds[min_divergence_idx];
 }
 
+/*!
+ * \brief Find the smallest symmetric threshold that covers the given percentile of the values.
+ * \param hist The histogram over [hist_edges.front(), hist_edges.back()], symmetric around zero.
+ * \param hist_edges The edges of the bins.
+ * \param percentile The percentile in (0, 100].
+ * \return The threshold.
+ */
+float FindThresholdByPercentile(const std::vector<int64_t>& hist,
+                                const std::vector<float>& hist_edges, double percentile) {
+  const int num_bins = hist.size();
+  const int zero_bin_idx = num_bins / 2;
+  const int64_t total = std::accumulate(hist.begin(), hist.end(), int64_t{0});
+  const double target = total * percentile / 100.0;
+  int64_t count = hist[zero_bin_idx];
+  int i = 0;
+  while (count < target && i < zero_bin_idx) {
+    ++i;
+    count += hist[zero_bin_idx - i] + hist[zero_bin_idx + i];
+  }
+  return hist_edges[zero_bin_idx + i + 1];
+}
+
+/*!
+ * \brief The streaming histogram of the values of one layer on the calibration dataset.
+ *
+ * Like np.histogram, it has num_bins bins over [-threshold, threshold]. The threshold starts at
+ * the largest absolute value of the first batch. When a later batch exceeds it, the threshold is
+ * multiplied by a power of two and every existing bin is moved to the new bin that contains its
+ * center. The range may therefore be up to twice the largest absolute value instead of exactly
+ * it, but the previous batches never need to be kept or visited again.
+ */
+class LayerHistogram {
+ public:
+  /*! \brief The range of the histogram, 0 if no nonzero value has been seen. */
+  float threshold = 0.f;
+  /*! \brief The counts of the bins. */
+  std::vector<int64_t> hist;
+  /*! \brief The number of zeros seen before the range is known. */
+  int64_t num_pending_zeros = 0;
+
+  LayerHistogram() = default;
+  explicit LayerHistogram(int num_bins) : hist(num_bins, 0) {}
+
+  /*!
+   * \brief Add the values of a batch to the histogram.
+   * \param data The values.
+   * \param size The number of values.
+   */
+  void Update(const float* data, int64_t size) {
+    float max_abs = MaxAbs(data, size);
+    CHECK(std::isfinite(max_abs)) << "The calibration data contains infinite or NaN values";
+    if (max_abs == 0.f && threshold == 0.f) {
+      num_pending_zeros += size;
+      return;
+    }
+    if (max_abs > threshold) {
+      Expand(max_abs);
+    }
+
+    const int num_bins = hist.size();
+    const float scale = num_bins / (2 * threshold);
+    // Compute the bin indices of a block first, which is vectorized, and then scatter them.
+    constexpr int kBlock = 256;
+    int indices[kBlock];
+    for (int64_t begin = 0; begin < size; begin += kBlock) {
+      const int n = static_cast<int>(std::min<int64_t>(kBlock, size - begin));
+      const float* block = data + begin;
+      for (int j = 0; j < n; ++j) {
+        int idx = static_cast<int>((block[j] + threshold) * scale);
+        indices[j] = idx < 0 ? 0 : (idx < num_bins ? idx : num_bins - 1);
+      }
+      for (int j = 0; j < n; ++j) {
+        hist[indices[j]]++;
+      }
+    }
+  }
+
+  /*!
+   * \brief Get the counts and the bin edges to search the threshold on.
+   * \param counts The counts of the bins.
+   * \param edges The num_bins + 1 edges of the bins.
+   */
+  void Finalize(std::vector<int64_t>* counts, std::vector<float>* edges) const {
+    const int num_bins = hist.size();
+    *counts = hist;
+    // np.histogram uses [-0.5, 0.5] for an all-zero array
+    float range = threshold;
+    if (range == 0.f) {
+      range = 0.5f;
+    }
+    (*counts)[num_bins / 2] += num_pending_zeros;
+    edges->resize(num_bins + 1);
+    for (int i = 0; i <= num_bins; ++i) {
+      (*edges)[i] = -range + 2 * range * i / num_bins;
+    }
+  }
+
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("threshold", threshold);
+    writer->WriteObjectKeyValue("num_pending_zeros", num_pending_zeros);
+    writer->WriteObjectKeyValue("hist", hist);
+    writer->EndObject();
+  }
+
+  void Load(dmlc::JSONReader* reader) {
+    dmlc::JSONObjectReadHelper helper;
+    helper.DeclareField("threshold", &threshold);
+    helper.DeclareField("num_pending_zeros", &num_pending_zeros);
+    helper.DeclareField("hist", &hist);
+    helper.ReadAllFields(reader);
+  }
+
+ private:
+  // The maximum absolute value, with independent lanes so that the reduction is vectorized
+  // without relaxing the floating point semantics. It is NaN if any value is NaN, which the
+  // comparisons of the maximum alone would drop.
+  static float MaxAbs(const float* data, int64_t size) {
+    constexpr int kLanes = 8;
+    float lanes[kLanes] = {0.f};
+    int is_nan[kLanes] = {0};
+    int64_t i = 0;
+    for (; i + kLanes <= size; i += kLanes) {
+      for (int j = 0; j < kLanes; ++j) {
+        float v = std::fabs(data[i + j]);
+        lanes[j] = lanes[j] < v ? v : lanes[j];
+        is_nan[j] |= v != v;
+      }
+    }
+    float ret = 0.f;
+    for (; i < size; ++i) {
+      float v = std::fabs(data[i]);
+      if (std::isnan(v)) return v;
+      ret = std::max(ret, v);
+    }
+    for (int j = 0; j < kLanes; ++j) {
+      if (is_nan[j]) return std::numeric_limits<float>::quiet_NaN();
+      ret = std::max(ret, lanes[j]);
+    }
+    return ret;
+  }
+
+  // Grow the range to cover max_abs.
+  void Expand(float max_abs) {
+    const int num_bins = hist.size();
+    if (threshold == 0.f) {
+      threshold = max_abs;
+      hist[num_bins / 2] += num_pending_zeros;
+      num_pending_zeros = 0;
+      return;
+    }
+    float new_threshold = threshold;
+    while (new_threshold < max_abs) {
+      new_threshold *= 2;
+    }
+    const float width = 2 * threshold / num_bins;
+    const float new_scale = num_bins / (2 * new_threshold);
+    std::vector<int64_t> new_hist(num_bins, 0);
+    for (int i = 0; i < num_bins; ++i) {
+      if (hist[i] != 0) {
+        float center = -threshold + (i + 0.5f) * width;
+        int idx = static_cast<int>((center + new_threshold) * new_scale);
+        new_hist[std::min(idx, num_bins - 1)] += hist[i];
+      }
+    }
+    hist.swap(new_hist);
+    threshold = new_threshold;
+  }
+};
+
+/*!
+ * \brief The calibration statistics of all profiled layers, accumulated batch by batch.
+ *
+ * The histograms of the layers are updated and searched in parallel. The statistics can be
+ * saved and loaded, so that a calibration over a long data iterator can be resumed.
+ */
+class CalibrationStatsNode : public Object {
+ public:
+  /*! \brief The number of bins of each histogram. */
+  int num_bins;
+  /*! \brief The number of batches collected. */
+  int64_t num_batches = 0;
+  /*! \brief The number of samples collected, e.g. images. */
+  int64_t num_samples = 0;
+  /*! \brief The time in seconds spent in updating the histograms. */
+  double update_time = 0.0;
+  /*! \brief The histograms of the layers. */
+  std::vector<LayerHistogram> layers;
+
+  void VisitAttrs(AttrVisitor* v) {
+    v->Visit("num_bins", &num_bins);
+    v->Visit("num_batches", &num_batches);
+    v->Visit("num_samples", &num_samples);
+    v->Visit("update_time", &update_time);
+  }
+
+  /*!
+   * \brief Add the outputs of the profile graph on a batch.
+   * \param outputs The output of each layer, float32 arrays on CPU.
+   * \param batch_size The number of samples in the batch.
+   */
+  void Update(const Array<runtime::NDArray>& outputs, int64_t batch_size) {
+    auto tstart = std::chrono::high_resolution_clock::now();
+    if (layers.empty()) {
+      layers.assign(outputs.size(), LayerHistogram(num_bins));
+    }
+    CHECK_EQ(layers.size(), outputs.size()) << "The number of profiled layers has changed";
+    std::vector<const float*> data(outputs.size());
+    std::vector<int64_t> sizes(outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      const DLTensor* tensor = outputs[i].operator->();
+      CHECK_EQ(tensor->ctx.device_type, kDLCPU) << "Calibration data should be on CPU";
+      CHECK(tensor->dtype.code == kDLFloat && tensor->dtype.bits == 32 && tensor->dtype.lanes == 1)
+          << "Calibration data should be float32";
+      CHECK(outputs[i].IsContiguous()) << "Calibration data should be contiguous";
+      data[i] = reinterpret_cast<const float*>(static_cast<const char*>(tensor->data) +
+                                               tensor->byte_offset);
+      sizes[i] = runtime::GetDataSize(*tensor) / sizeof(float);
+    }
+    support::parallel_for(0, static_cast<int>(outputs.size()),
+                          [&](int i) { layers[i].Update(data[i], sizes[i]); });
+    num_batches++;
+    num_samples += batch_size;
+    update_time += std::chrono::duration_cast<std::chrono::duration<double>>(
+                       std::chrono::high_resolution_clock::now() - tstart)
+                       .count();
+  }
+
+  /*!
+   * \brief Search the threshold of every layer in parallel.
+   * \param mode "kl_divergence" or "percentile".
+   * \param percentile The percentile of the values to cover in the percentile mode.
+   * \param num_quantized_bins The number of quantized bins in the kl_divergence mode.
+   * \return The thresholds.
+   */
+  Array<FloatImm> FindScales(const std::string& mode, double percentile,
+                             int num_quantized_bins) const {
+    CHECK(mode == "kl_divergence" || mode == "percentile") << "Unknown calibrate mode " << mode;
+    CHECK(percentile > 0 && percentile <= 100) << "Invalid percentile " << percentile;
+    std::vector<float> scales(layers.size());
+    support::parallel_for(0, static_cast<int>(layers.size()), [&](int i) {
+      std::vector<int64_t> hist;
+      std::vector<float> hist_edges;
+      layers[i].Finalize(&hist, &hist_edges);
+      if (mode == "kl_divergence") {
+        scales[i] = MinimizeKL(hist, hist_edges, num_bins, num_quantized_bins);
+      } else {
+        scales[i] = FindThresholdByPercentile(hist, hist_edges, percentile);
+      }
+    });
+    Array<FloatImm> ret;
+    for (float scale : scales) {
+      ret.push_back(FloatImm(DataType::Float(32), scale));
+    }
+    return ret;
+  }
+
+  /*!
+   * \brief Compute the KL divergence between the distribution of every layer and its quantized
+   *  distribution under the best threshold, as a proxy of the accuracy loss of the layer.
+   * \param num_quantized_bins The number of quantized bins, at most num_bins.
+   * \return The divergences.
+   */
+  Array<FloatImm> FindDivergences(int num_quantized_bins) const {
+    CHECK(num_quantized_bins > 0 && num_quantized_bins <= num_bins)
+        << "Invalid number of quantized bins " << num_quantized_bins;
+    std::vector<float> divergences(layers.size());
+    support::parallel_for(0, static_cast<int>(layers.size()), [&](int i) {
+      std::vector<int64_t> hist;
+      std::vector<float> hist_edges;
+      layers[i].Finalize(&hist, &hist_edges);
+      MinimizeKL(hist, hist_edges, num_bins, num_quantized_bins, &divergences[i]);
+    });
+    Array<FloatImm> ret;
+    for (float divergence : divergences) {
+      ret.push_back(FloatImm(DataType::Float(32), divergence));
+    }
+    return ret;
+  }
+
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("num_bins", num_bins);
+    writer->WriteObjectKeyValue("num_batches", num_batches);
+    writer->WriteObjectKeyValue("num_samples", num_samples);
+    writer->WriteObjectKeyValue("update_time", update_time);
+    writer->WriteObjectKeyValue("layers", layers);
+    writer->EndObject();
+  }
+
+  void Load(dmlc::JSONReader* reader) {
+    dmlc::JSONObjectReadHelper helper;
+    helper.DeclareField("num_bins", &num_bins);
+    helper.DeclareField("num_batches", &num_batches);
+    helper.DeclareField("num_samples", &num_samples);
+    helper.DeclareField("update_time", &update_time);
+    helper.DeclareField("layers", &layers);
+    helper.ReadAllFields(reader);
+  }
+
+  static constexpr const char* _type_key = "relay.quantize.CalibrationStats";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CalibrationStatsNode, Object);
+};
+
+/*!
+ * \brief Managed reference to CalibrationStatsNode.
+ * \sa CalibrationStatsNode
+ */
+class CalibrationStats : public ObjectRef {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param num_bins The number of bins of each histogram, which should be odd so that zero is
+   *  the center of a bin.
+   */
+  explicit CalibrationStats(int num_bins) {
+    CHECK(num_bins > 0 && num_bins % 2 == 1) << "The number of bins should be odd";
+    auto n = make_object<CalibrationStatsNode>();
+    n->num_bins = num_bins;
+    data_ = std::move(n);
+  }
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CalibrationStats, ObjectRef, CalibrationStatsNode);
+};
+
 class StatsCollector : private ExprMutator {
  public:
   StatsCollector() : simulated_quantize_op_(Op::Get("relay.op.annotation.simulated_quantize")) {}
@@ -174,6 +511,7 @@ class StatsCollector : private ExprMutator {
       new_attrs->kind = QAnnotateKind::kQIdentity;
       new_attrs->sign = attrs->sign;
       new_attrs->rounding = attrs->rounding;
+      new_attrs->nbit = attrs->nbit;
       Expr identity_quantize = Call(new_call->op, new_args, Attrs{new_attrs}, {});
 
       // add non-const expressions to profile data
@@ -209,11 +547,50 @@ TVM_REGISTER_GLOBAL("relay._quantize.FindScaleByKLMinimization")
       float* hist_edges_ptr = static_cast<float*>(static_cast<void*>(args[1]));
       int num_bins = args[2];
       int num_quantized_bins = args[3];
-      std::vector<int> hist(hist_ptr, hist_ptr + num_bins);
+      std::vector<int64_t> hist(hist_ptr, hist_ptr + num_bins);
       std::vector<float> hist_edges(hist_edges_ptr, hist_edges_ptr + num_bins + 1);
       ret[0] = MinimizeKL(hist, hist_edges, num_bins, num_quantized_bins);
     });
 
+TVM_REGISTER_NODE_TYPE(CalibrationStatsNode);
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStats").set_body_typed([](int num_bins) {
+  return CalibrationStats(num_bins);
+});
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStatsUpdate")
+    .set_body_typed([](CalibrationStats stats, Array<runtime::NDArray> outputs,
+                       int64_t batch_size) { stats->Update(outputs, batch_size); });
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStatsFindScales")
+    .set_body_typed([](CalibrationStats stats, String mode, double percentile,
+                       int num_quantized_bins) {
+      return stats->FindScales(mode, percentile, num_quantized_bins);
+    });
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStatsFindDivergences")
+    .set_body_typed([](CalibrationStats stats, int num_quantized_bins) {
+      return stats->FindDivergences(num_quantized_bins);
+    });
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStatsSave")
+    .set_body_typed([](CalibrationStats stats, String path) {
+      std::ofstream fout(path);
+      CHECK(fout.is_open()) << "Cannot open " << path;
+      fout.precision(std::numeric_limits<double>::max_digits10);
+      dmlc::JSONWriter writer(&fout);
+      stats->Save(&writer);
+    });
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStatsLoad").set_body_typed([](String path) {
+  std::ifstream fin(path);
+  CHECK(fin.is_open()) << "Cannot open " << path;
+  CalibrationStats stats(1);
+  dmlc::JSONReader reader(&fin);
+  stats->Load(&reader);
+  return stats;
+});
+
 }  // namespace quantize
 }  // namespace relay
 }  // namespace tvm
@@ -45,6 +45,14 @@ class QPartitionExprNode : public TempExprNode {
 
   Expr Realize() const final;
 
+  /*!
+   * \brief Realize the expression with a cast hint to the given data type instead of the input
+   *  data type of the qconfig, e.g. for the layers selected for 16-bit precision.
+   * \param dtype The data type of the cast hint.
+   * \return The realized expression.
+   */
+  Expr RealizeAs(DataType dtype) const;
+
   static constexpr const char* _type_key = "relay.QPartitionExpr";
   TVM_DECLARE_FINAL_OBJECT_INFO(QPartitionExprNode, TempExprNode);
 };
@@ -60,10 +68,11 @@ class QPartitionExpr : public TempExpr {
   TVM_DEFINE_OBJECT_REF_METHODS(QPartitionExpr, TempExpr, QPartitionExprNode);
 };
 
-Expr QPartitionExprNode::Realize() const {
+Expr QPartitionExprNode::Realize() const { return RealizeAs(QConfig::Current()->dtype_input); }
+
+Expr QPartitionExprNode::RealizeAs(DataType dtype) const {
   // insert cast hint and stop fusion
-  const QConfig& cfg = QConfig::Current();
-  Expr ret = CastHint(this->expr, cfg->dtype_input);
+  Expr ret = CastHint(this->expr, dtype);
   return StopFusion(ret);
 }
 
@@ -77,6 +86,9 @@ TVM_REGISTER_GLOBAL("relay._quantize.make_partition_expr").set_body_typed([](Exp
   return QPartitionExpr(expr);
 });
 
+TVM_REGISTER_GLOBAL("relay._quantize.realize_partition_expr")
+    .set_body_typed([](QPartitionExpr expr, DataType dtype) { return expr->RealizeAs(dtype); });
+
 Pass QuantizePartition() {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) {
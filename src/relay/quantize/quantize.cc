@@ -71,11 +71,12 @@ RELAY_REGISTER_OP("relay.op.annotation.simulated_quantize")
 
 TVM_REGISTER_GLOBAL("relay._quantize.simulated_quantize")
     .set_body_typed([](Expr data, Expr dom_scale, Expr clip_min, Expr clip_max, int kind, bool sign,
-                       String rounding) {
+                       String rounding, int nbit) {
       auto attrs = make_object<SimulatedQuantizeAttrs>();
       attrs->kind = kind;
       attrs->sign = sign;
       attrs->rounding = rounding;
+      attrs->nbit = nbit;
       static const Op& op = Op::Get("relay.op.annotation.simulated_quantize");
       return Call(op, {data, dom_scale, clip_min, clip_max}, Attrs(attrs), {});
     });
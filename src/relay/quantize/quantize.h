@@ -43,12 +43,15 @@ struct SimulatedQuantizeAttrs : public tvm::AttrsNode<SimulatedQuantizeAttrs> {
   int kind;
   bool sign;
   std::string rounding;
+  int nbit;
 
   TVM_DECLARE_ATTRS(SimulatedQuantizeAttrs, "relay.attrs.SimulatedQuantizeAttrs") {
     TVM_ATTR_FIELD(kind).describe("kind of field, hint for nbit/dtype configuration.");
     TVM_ATTR_FIELD(sign).set_default(true).describe("whether to use signed data type.");
     TVM_ATTR_FIELD(rounding).set_default("round").describe(
         "rounding mode. Can be 'floor', 'ceil', 'round'");
+    TVM_ATTR_FIELD(nbit).set_default(0).describe(
+        "number of bits of the quantized values, 0 to use the qconfig setting of the kind.");
   }
 };
 
@@ -69,11 +72,15 @@ class QConfigNode : public Object {
   std::string weight_scale = "power2";
   bool skip_dense_layer = true;
   Array<Expr> skip_conv_layers = Array<Expr>(ObjectPtr<Object>(nullptr));
+  Array<String> layer_precisions = Array<String>(ObjectPtr<Object>(nullptr));
   bool do_simulation = false;
   bool round_for_shift = true;
   Array<Expr> debug_enabled_ops = Array<Expr>(ObjectPtr<Object>(nullptr));
   std::string rounding = "UPWARD";
+  // Deprecated and ignored, the calibration statistics are streaming histograms.
   int calibrate_chunk_by = -1;
+  double calibrate_percentile = 99.99;
+  std::string calibrate_checkpoint = "";
   std::string partition_conversions = "disabled";
 
   void VisitAttrs(AttrVisitor* v) {
@@ -88,11 +95,14 @@ class QConfigNode : public Object {
     v->Visit("weight_scale", &weight_scale);
     v->Visit("skip_dense_layer", &skip_dense_layer);
     v->Visit("skip_conv_layers", &skip_conv_layers);
+    v->Visit("layer_precisions", &layer_precisions);
     v->Visit("do_simulation", &do_simulation);
     v->Visit("round_for_shift", &round_for_shift);
     v->Visit("debug_enabled_ops", &debug_enabled_ops);
     v->Visit("rounding", &rounding);
     v->Visit("calibrate_chunk_by", &calibrate_chunk_by);
+    v->Visit("calibrate_percentile", &calibrate_percentile);
+    v->Visit("calibrate_checkpoint", &calibrate_checkpoint);
     v->Visit("partition_conversions", &partition_conversions);
   }
 
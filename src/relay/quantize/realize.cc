@@ -203,6 +203,25 @@ Expr FoldConstantOpt(const Expr& expr) {
 RELAY_REGISTER_OP("relay.op.annotation.simulated_quantize")
     .set_attr<FForwardRewrite>("FQRealizeRewrite", QuantizeRealize);
 
+/* \brief The data type of the input of a conv2d. The layers selected for 16-bit precision (see
+ * qconfig layer_precisions) have their input quantized to 16 bits, either by their own
+ * simulated_quantize or by an int16 cast hint at the partition boundary. */
+DataType Conv2dInputDType(const Call& ref_call, const QRealizeIntExprNode* lhs) {
+  static const Op& simulated_quantize = Op::Get("relay.op.annotation.simulated_quantize");
+  const QConfig& cfg = QConfig::Current();
+  if (lhs->dtype == DataType::Int(16)) {
+    return lhs->dtype;
+  }
+  const auto* ref_arg = ref_call->args[0].as<CallNode>();
+  if (ref_arg && ref_arg->op.same_as(simulated_quantize)) {
+    int nbit = ref_arg->attrs.as<SimulatedQuantizeAttrs>()->nbit;
+    if (nbit > 0 && nbit != cfg->nbit_input) {
+      return DataType::Int(nbit);
+    }
+  }
+  return cfg->dtype_input;
+}
+
 Expr Conv2dRealize(const Call& ref_call, const Array<Expr>& new_args, const ObjectRef& ctx) {
   const QConfig& cfg = QConfig::Current();
   CHECK_EQ(new_args.size(), 2);
@@ -215,8 +234,9 @@ Expr Conv2dRealize(const Call& ref_call, const Array<Expr>& new_args, const Obje
   CHECK(rhs);
 
   Expr ldata = lhs->data;
-  if (lhs->dtype != cfg->dtype_input) {
-    ldata = Cast(ldata, cfg->dtype_input);
+  DataType in_dtype = Conv2dInputDType(ref_call, lhs);
+  if (lhs->dtype != in_dtype) {
+    ldata = Cast(ldata, in_dtype);
   }
   Expr rdata = Cast(rhs->data, cfg->dtype_weight);
 
@@ -61,21 +61,23 @@ namespace relay {
 //   (%3, 4)
 // }
 // \endcode
-class CastCanonicalizer : public ExprMutator {
+class CastCanonicalizer : public MixedModeMutator {
  public:
   CastCanonicalizer() : cast_op_(Op::Get("cast")) {}
 
-  Expr VisitExpr_(const CallNode* call) {
+  Expr Rewrite_(const CallNode* call, const Expr& post) final {
     static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
 
     if (const OpNode* opnode = call->op.as<OpNode>()) {
       auto pattern = fpattern[GetRef<Op>(opnode)];
       if (pattern <= kBroadcast) {
+        const auto* new_call = post.as<CallNode>();
+        CHECK(new_call);
         Array<Expr> call_args = call->args;
         bool unchanged = true;
         for (size_t i = 0; i < call_args.size(); ++i) {
           Expr arg = call_args[i];
-          Expr new_arg = GetNewCallArg(arg);
+          Expr new_arg = GetNewCallArg(arg, new_call->args[i]);
           if (!arg.same_as(new_arg)) {
             call_args.Set(i, new_arg);
             unchanged = false;
@@ -88,8 +90,7 @@ class CastCanonicalizer : public ExprMutator {
       }
     }
 
-    Expr new_expr = ExprMutator::VisitExpr_(call);
-    return new_expr;
+    return post;
   }
 
  private:
@@ -98,10 +99,8 @@ class CastCanonicalizer : public ExprMutator {
   // reduce lookup overhead.
   const Op& cast_op_;
 
-  Expr GetNewCallArg(const Expr& e) {
-    // if e is a upcast and ref count > 1, create an copy; otherwise call the default visitor
-    Expr new_expr = this->VisitExpr(e);
-
+  Expr GetNewCallArg(const Expr& e, const Expr& new_expr) {
+    // if e is a upcast and ref count > 1, create an copy; otherwise use the mutated arg
     if (const CallNode* call = e.as<CallNode>()) {
       if (call->op == cast_op_) {
         auto attrs = call->attrs.as<CastAttrs>();
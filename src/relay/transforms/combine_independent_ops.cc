@@ -0,0 +1,547 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *
+ * \file combine_independent_ops.cc
+ * \brief Combine independent ops of the same kind into a single op.
+ *
+ * The CombineParallel* passes combine the branches that share the same input.
+ * Multi-head networks, e.g. the heads of SSD and YOLO, also run many small
+ * elementwise ops and pools on different inputs, each of them as a separate
+ * kernel whose latency is dominated by the launch. This pass replaces the
+ * independent calls of the same op with the same attributes and argument
+ * types by a single call on the concatenation of their inputs along the batch
+ * axis, and splits its output. For example:
+ *
+ *      x (1,C,H,W)      y (1,C,H,W)            x       y
+ *           |                |                  \     /
+ *      sigmoid (1,C,H,W) sigmoid (1,C,H,W)   concatenate (2,C,H,W)
+ *           |                |                     |
+ *                                               sigmoid
+ *                                                  |
+ *                                               split
+ *                                              /      \
+ *
+ * The independent NCHW convolutions with the same weight are combined along
+ * the batch axis too. The ones with different weights, e.g. the class and box
+ * predictors of the heads, are combined into a grouped convolution on the
+ * inputs concatenated along the channel axis. The weights are padded to the
+ * largest number of output channels, unless an elementwise op is fused into
+ * the convolutions. group_conv2d is not optimized for the CPUs, so they are
+ * only combined for the other targets.
+ *
+ * FuseOps fuses the elementwise ops into their producers, so an op is not
+ * combined if its inputs are computed by such producers, unless the producers
+ * were combined themselves. In that case the output of the combined producer
+ * is passed to the combined op without splitting and concatenating it, and
+ * the whole chain stays fused:
+ *
+ *      conv2d  conv2d  conv2d            concatenate
+ *        |       |       |                    |
+ *     sigmoid sigmoid sigmoid    =>     conv2d (groups=3)
+ *                                             |
+ *                                          sigmoid
+ *                                             |
+ *                                           split
+ *
+ * The calls on the same arguments are left to EliminateCommonSubexpr.
+ *
+ * The level of a call is the length of the longest path from the inputs to
+ * it. Calls of the same level never depend on each other, so only the calls
+ * of the same level are combined, which also guarantees that no cycle is
+ * created by combining several groups.
+ */
+
+#include <tvm/relay/analysis.h>
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
+#include <tvm/target/target.h>
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../op/make_op.h"
+#include "./expr_subst.h"
+#include "pattern_util.h"
+
+namespace tvm {
+namespace relay {
+namespace combine_independent_ops {
+
+/*! \brief Find the level of the calls of a function. */
+class LevelFinder : public MixedModeVisitor {
+ public:
+  /*! \brief The calls of every level, in post order. */
+  std::map<int, std::vector<const CallNode*>> calls;
+  /*! \brief The calls with a consumer that FuseOps fuses into them. */
+  std::unordered_set<const CallNode*> fused_producers;
+  /*! \brief Whether the function has control flow or references, which are not supported. */
+  bool unsupported = false;
+
+  void VisitExpr_(const CallNode* call) final {
+    static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    MixedModeVisitor::VisitExpr_(call);
+    int level = 0;
+    for (const auto& arg : call->args) {
+      level = std::max(level, Level(arg));
+    }
+    levels_[call] = level + 1;
+    if (const auto* op = call->op.as<OpNode>()) {
+      calls[level + 1].push_back(call);
+      if (fpattern.get(GetRef<Op>(op), kOpaque) <= kBroadcast) {
+        for (const auto& arg : call->args) {
+          if (const auto* producer = arg.as<CallNode>()) {
+            fused_producers.insert(producer);
+          }
+        }
+      }
+    }
+  }
+
+  void VisitExpr_(const TupleNode* tuple) final {
+    MixedModeVisitor::VisitExpr_(tuple);
+    int level = 0;
+    for (const auto& field : tuple->fields) {
+      level = std::max(level, Level(field));
+    }
+    levels_[tuple] = level;
+  }
+
+  void VisitExpr_(const TupleGetItemNode* get) final {
+    MixedModeVisitor::VisitExpr_(get);
+    levels_[get] = Level(get->tuple);
+  }
+
+  // The calls in the nested functions, e.g. the composite functions, are not combined.
+  void VisitExpr_(const FunctionNode* func) final {}
+
+  void VisitExpr_(const LetNode* op) final { unsupported = true; }
+  void VisitExpr_(const IfNode* op) final { unsupported = true; }
+  void VisitExpr_(const MatchNode* op) final { unsupported = true; }
+  void VisitExpr_(const RefCreateNode* op) final { unsupported = true; }
+  void VisitExpr_(const RefReadNode* op) final { unsupported = true; }
+  void VisitExpr_(const RefWriteNode* op) final { unsupported = true; }
+
+ private:
+  int Level(const Expr& expr) const {
+    auto it = levels_.find(expr.get());
+    return it == levels_.end() ? 0 : it->second;
+  }
+
+  std::unordered_map<const Object*, int> levels_;
+};
+
+/*! \brief Get the layout of the ops that are combined along the batch axis of their layout. */
+template <typename T>
+bool GetLayout(const Attrs& attrs, std::string* layout) {
+  if (const auto* a = attrs.as<T>()) {
+    *layout = a->layout;
+    return true;
+  }
+  return false;
+}
+
+/*! \brief Get the static shape of a tensor type. */
+bool GetStaticShape(const Type& type, std::vector<int64_t>* shape) {
+  const auto* ttype = type.as<TensorTypeNode>();
+  if (!ttype) return false;
+  shape->clear();
+  for (const auto& dim : ttype->shape) {
+    const auto* imm = dim.as<IntImmNode>();
+    if (!imm) return false;
+    shape->push_back(imm->value);
+  }
+  return true;
+}
+
+/*! \brief A group of calls that were combined into a single call. */
+struct CombinedGroup {
+  /*! \brief The calls of the group. */
+  std::vector<const CallNode*> calls;
+  /*! \brief The combined call. */
+  Expr combined;
+  /*! \brief The axis along which the outputs of the calls are concatenated in its output. */
+  int axis;
+};
+
+class IndependentOpCombiner {
+ public:
+  IndependentOpCombiner(uint64_t min_num_ops, int64_t max_num_elements)
+      : min_num_ops_(min_num_ops), max_num_elements_(max_num_elements) {}
+
+  Expr Combine(const Function& func) {
+    LevelFinder finder;
+    finder.VisitExpr(func->body);
+    if (finder.unsupported) {
+      return func;
+    }
+    fused_producers_ = std::move(finder.fused_producers);
+
+    ExprSubstMap subst_map;
+    for (const auto& it : finder.calls) {
+      std::vector<std::vector<const CallNode*>> groups;
+      for (const CallNode* call : it.second) {
+        if (!IsSupportedOp(call)) continue;
+        auto group = std::find_if(groups.begin(), groups.end(), [&](const auto& g) {
+          return CanOpsBeCombined(g[0], call);
+        });
+        if (group == groups.end()) {
+          groups.push_back({call});
+        } else {
+          group->push_back(call);
+        }
+      }
+      for (const auto& group : groups) {
+        if (group.size() >= std::max<uint64_t>(min_num_ops_, 2)) {
+          CombineGroup(group, &subst_map);
+        }
+      }
+    }
+    if (subst_map.empty()) {
+      return func;
+    }
+    return ExprSubst(func, std::move(subst_map));
+  }
+
+ private:
+  using ExprSubstMap = std::unordered_map<Expr, Expr, ObjectPtrHash, ObjectPtrEqual>;
+
+  static bool IsConv2D(const CallNode* call) {
+    static const Op& conv2d = Op::Get("nn.conv2d");
+    return call->op.same_as(conv2d);
+  }
+
+  /*!
+   * \brief Whether the target has a grouped convolution as fast as the convolution.
+   *  group_conv2d is not optimized for the CPUs.
+   */
+  static bool HasFastGroupConv2D() {
+    Target target = Target::Current(true);
+    return !target.defined() || target->kind->device_type != kDLCPU;
+  }
+
+  /*!
+   * \brief Whether the argument is computed by an op that FuseOps fuses into the consumer, in
+   * which case combining the consumer only adds kernels.
+   */
+  static bool FusesIntoConsumer(Expr arg, OpPatternKind max_pattern) {
+    static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    while (const auto* get = arg.as<TupleGetItemNode>()) {
+      arg = get->tuple;
+    }
+    const auto* call = arg.as<CallNode>();
+    if (!call) return false;
+    const auto* op = call->op.as<OpNode>();
+    if (!op) return false;
+    return fpattern.get(GetRef<Op>(op), kOpaque) <= max_pattern;
+  }
+
+  /*!
+   * \brief Get the pattern of the ops that FuseOps fuses into the call, or return false if the
+   *  call is not supported. The elementwise ops, the broadcast ops without attributes and
+   *  bias_add are pointwise, the pools and upsampling are independent along the batch and channel
+   *  axes of their layout.
+   */
+  static bool GetMaxInputPattern(const CallNode* call, OpPatternKind* max_input_pattern,
+                                 std::string* layout) {
+    static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    OpPatternKind pattern =
+        static_cast<OpPatternKind>(fpattern.get(Downcast<Op>(call->op), kOpaque));
+    if (pattern < kBroadcast || (pattern == kBroadcast && !call->attrs.defined()) ||
+        call->attrs.as<BiasAddAttrs>()) {
+      *max_input_pattern = kOutEWiseFusable;
+      return true;
+    }
+    if (!GetLayout<MaxPool2DAttrs>(call->attrs, layout) &&
+        !GetLayout<AvgPool2DAttrs>(call->attrs, layout) &&
+        !GetLayout<GlobalPool2DAttrs>(call->attrs, layout) &&
+        !GetLayout<AdaptivePool2DAttrs>(call->attrs, layout) &&
+        !GetLayout<UpSamplingAttrs>(call->attrs, layout)) {
+      return false;
+    }
+    if (layout->empty() || (*layout)[0] != 'N') return false;
+    *max_input_pattern = kInjective;
+    return true;
+  }
+
+  /*! \brief Only the NCHW convolutions without groups are combined, no op is fused into them. */
+  static bool IsSupportedConv2D(const CallNode* call) {
+    const auto* attrs = call->attrs.as<Conv2DAttrs>();
+    return attrs && attrs->groups == 1 && attrs->data_layout == "NCHW" &&
+           attrs->kernel_layout == "OIHW" &&
+           (attrs->out_layout.empty() || attrs->out_layout == "NCHW");
+  }
+
+  bool IsSupportedOp(const CallNode* call) const {
+    std::vector<int64_t> shape;
+    if (!GetStaticShape(call->checked_type(), &shape) || shape.empty()) return false;
+    int64_t num_elements = 1;
+    for (int64_t dim : shape) {
+      num_elements *= dim;
+    }
+    if (num_elements > max_num_elements_) return false;
+    for (const auto& arg : call->args) {
+      if (!GetStaticShape(arg->checked_type(), &shape)) return false;
+    }
+    if (IsConv2D(call)) return IsSupportedConv2D(call);
+
+    OpPatternKind max_input_pattern;
+    std::string layout;
+    if (!GetMaxInputPattern(call, &max_input_pattern, &layout)) return false;
+    for (const auto& arg : call->args) {
+      // The outputs of a combined group are passed to the consumers without splitting them.
+      const auto* producer = arg.as<CallNode>();
+      if (producer && chained_.count(producer)) continue;
+      if (FusesIntoConsumer(arg, max_input_pattern)) return false;
+    }
+    return true;
+  }
+
+  bool CanOpsBeCombined(const CallNode* a, const CallNode* b) const {
+    if (!a->op.same_as(b->op) || a->args.size() != b->args.size()) return false;
+    StructuralEqual eq;
+    if (IsConv2D(a)) {
+      // The convolutions may have different numbers of output channels.
+      auto attrs_a = make_object<Conv2DAttrs>(*a->attrs.as<Conv2DAttrs>());
+      auto attrs_b = make_object<Conv2DAttrs>(*b->attrs.as<Conv2DAttrs>());
+      attrs_a->channels = attrs_b->channels = NullValue<IndexExpr>();
+      std::vector<int64_t> weight_a, weight_b;
+      GetStaticShape(a->args[1]->checked_type(), &weight_a);
+      GetStaticShape(b->args[1]->checked_type(), &weight_b);
+      // The padded output channels are sliced away after the combined convolution, which keeps
+      // the consumers that FuseOps fuses into the convolutions from being combined with it.
+      if (weight_a[0] != weight_b[0] && (fused_producers_.count(a) || fused_producers_.count(b))) {
+        return false;
+      }
+      return eq(Attrs(attrs_a), Attrs(attrs_b)) &&
+             eq(a->args[0]->checked_type(), b->args[0]->checked_type()) &&
+             a->args[1]->checked_type().as<TensorTypeNode>()->dtype ==
+                 b->args[1]->checked_type().as<TensorTypeNode>()->dtype &&
+             std::equal(weight_a.begin() + 1, weight_a.end(), weight_b.begin() + 1);
+    }
+    if (!eq(a->attrs, b->attrs) || !eq(a->checked_type(), b->checked_type())) return false;
+    for (size_t i = 0; i < a->args.size(); ++i) {
+      if (!eq(a->args[i]->checked_type(), b->args[i]->checked_type())) return false;
+    }
+    return true;
+  }
+
+  /*!
+   * \brief Get the combined group whose calls are the i-th arguments of the calls of the group,
+   *  in the same order, or -1 if there is none.
+   */
+  int GetChainedGroup(const std::vector<const CallNode*>& group, size_t i) const {
+    int chained = -1;
+    for (size_t j = 0; j < group.size(); ++j) {
+      auto it = chained_.find(group[j]->args[i].as<CallNode>());
+      if (it == chained_.end() || it->second.second != j) return -1;
+      if (j > 0 && static_cast<int>(it->second.first) != chained) return -1;
+      chained = static_cast<int>(it->second.first);
+    }
+    return combined_[chained].calls.size() == group.size() ? chained : -1;
+  }
+
+  /*!
+   * \brief Get the axis of the i-th argument of a pointwise call that maps to the axis of its
+   *  output, or -1 if the argument is broadcast along it.
+   */
+  static int GetArgAxis(const CallNode* call, size_t i, int axis) {
+    std::vector<int64_t> arg_shape, out_shape;
+    GetStaticShape(call->args[i]->checked_type(), &arg_shape);
+    GetStaticShape(call->checked_type(), &out_shape);
+    int arg_axis = axis - static_cast<int>(out_shape.size() - arg_shape.size());
+    if (const auto* attrs = call->attrs.as<BiasAddAttrs>()) {
+      int bias_axis = attrs->axis < 0 ? attrs->axis + out_shape.size() : attrs->axis;
+      arg_axis = i == 0 ? axis : (axis == bias_axis ? 0 : -1);
+    }
+    if (arg_axis < 0 || (arg_shape[arg_axis] == 1 && out_shape[axis] != 1)) return -1;
+    return arg_axis;
+  }
+
+  void CombineGroup(const std::vector<const CallNode*>& group, ExprSubstMap* subst_map) {
+    const CallNode* first = group[0];
+    const int num_ops = static_cast<int>(group.size());
+    std::vector<int> chained(first->args.size());
+    for (size_t i = 0; i < first->args.size(); ++i) {
+      chained[i] = GetChainedGroup(group, i);
+    }
+    auto is_shared = [&](size_t i) {
+      return std::all_of(group.begin(), group.end(), [&](const CallNode* call) {
+        return call->args[i].same_as(first->args[i]);
+      });
+    };
+    auto concat = [&](size_t i, int axis) {
+      Array<Expr> fields;
+      for (const CallNode* call : group) {
+        fields.push_back(call->args[i]);
+      }
+      return MakeConcatenate(Tuple(fields), axis);
+    };
+
+    Array<Expr> new_args;
+    Attrs attrs = first->attrs;
+    std::vector<int64_t> out_channels;
+    int64_t max_channels = 0;
+    int axis = 0;
+    if (IsConv2D(first)) {
+      // The convolutions that share the data are combined by CombineParallelConv2D.
+      if (is_shared(0)) return;
+      if (is_shared(1)) {
+        // The convolutions with the same weight are combined along the batch axis.
+        new_args.push_back(chained[0] >= 0 && combined_[chained[0]].axis == 0
+                               ? combined_[chained[0]].combined
+                               : concat(0, 0));
+        new_args.push_back(first->args[1]);
+      } else {
+        // The convolutions with different weights are combined into a grouped convolution, the
+        // weights are padded to the largest number of output channels.
+        if (!HasFastGroupConv2D()) return;
+        std::vector<int64_t> weight_shape;
+        int64_t sum_channels = 0;
+        for (const CallNode* call : group) {
+          GetStaticShape(call->args[1]->checked_type(), &weight_shape);
+          out_channels.push_back(weight_shape[0]);
+          sum_channels += weight_shape[0];
+          max_channels = std::max(max_channels, weight_shape[0]);
+        }
+        // Most of the combined output channels are not padding.
+        if (2 * sum_channels < num_ops * max_channels) return;
+        axis = 1;
+        new_args.push_back(chained[0] >= 0 && combined_[chained[0]].axis == 1
+                               ? combined_[chained[0]].combined
+                               : concat(0, 1));
+        Array<Expr> weights;
+        for (size_t j = 0; j < group.size(); ++j) {
+          Expr weight = group[j]->args[1];
+          if (out_channels[j] < max_channels) {
+            Array<Array<Integer>> pad_width = {
+                {0, static_cast<int>(max_channels - out_channels[j])}, {0, 0}, {0, 0}, {0, 0}};
+            weight = MakePad(weight, pad_width, 0, "constant");
+          }
+          weights.push_back(weight);
+        }
+        new_args.push_back(MakeConcatenate(Tuple(weights), 0));
+        auto new_attrs = make_object<Conv2DAttrs>(*first->attrs.as<Conv2DAttrs>());
+        new_attrs->groups = num_ops;
+        new_attrs->channels = Integer(static_cast<int>(num_ops * max_channels));
+        attrs = Attrs(new_attrs);
+        if (std::all_of(out_channels.begin(), out_channels.end(),
+                        [&](int64_t c) { return c == max_channels; })) {
+          out_channels.clear();
+        }
+      }
+    } else {
+      OpPatternKind max_input_pattern;
+      std::string layout;
+      GetMaxInputPattern(first, &max_input_pattern, &layout);
+      // The outputs of a combined group are concatenated along its axis, the pools and upsampling
+      // are only independent along the batch and channel axes of their layout.
+      for (int g : chained) {
+        if (g >= 0) {
+          axis = combined_[g].axis;
+          break;
+        }
+      }
+      if (!layout.empty() && layout[axis] != 'N' && layout[axis] != 'C') axis = 0;
+      bool concatenated = false;
+      for (size_t i = 0; i < first->args.size(); ++i) {
+        if (chained[i] >= 0 && combined_[chained[i]].axis == axis) {
+          new_args.push_back(combined_[chained[i]].combined);
+          concatenated = true;
+          continue;
+        }
+        if (FusesIntoConsumer(first->args[i], max_input_pattern)) return;
+        int arg_axis = GetArgAxis(first, i, axis);
+        bool shared = is_shared(i);
+        if (shared && arg_axis < 0) {
+          new_args.push_back(first->args[i]);
+          continue;
+        }
+        if (arg_axis < 0) return;
+        new_args.push_back(concat(i, arg_axis));
+        concatenated = concatenated || !shared;
+      }
+      // The calls on the same arguments are left to EliminateCommonSubexpr.
+      if (!concatenated) return;
+    }
+
+    Expr combined = Call(first->op, new_args, attrs, first->type_args);
+    size_t group_index = combined_.size();
+    combined_.push_back({group, combined, axis});
+    Expr split = MakeSplit(combined, Integer(num_ops), axis);
+    for (size_t j = 0; j < group.size(); ++j) {
+      Expr out = TupleGetItem(split, j);
+      if (!out_channels.empty() && out_channels[j] < max_channels) {
+        out = MakeStridedSlice(out, {0, 0}, {-1, static_cast<int>(out_channels[j])}, {1, 1},
+                               "size");
+      }
+      if (out_channels.empty()) {
+        chained_[group[j]] = {group_index, j};
+      }
+      subst_map->insert({GetRef<Expr>(group[j]), out});
+    }
+  }
+
+  uint64_t min_num_ops_;
+  int64_t max_num_elements_;
+  /*! \brief The calls with a consumer that FuseOps fuses into them. */
+  std::unordered_set<const CallNode*> fused_producers_;
+  /*! \brief The combined groups. */
+  std::vector<CombinedGroup> combined_;
+  /*!
+   * \brief The group and the index in it of the calls whose outputs are concatenated in the
+   *  output of their combined group.
+   */
+  std::unordered_map<const CallNode*, std::pair<size_t, size_t>> chained_;
+};
+
+}  // namespace combine_independent_ops
+
+/*!
+ * \brief Combine the independent ops of the same kind if the number of them is not less than
+ * min_num_ops and their outputs have at most max_num_elements elements.
+ */
+Expr CombineIndependentOps(const Function& func, uint64_t min_num_ops, int64_t max_num_elements) {
+  return combine_independent_ops::IndependentOpCombiner(min_num_ops, max_num_elements)
+      .Combine(func);
+}
+
+namespace transform {
+
+Pass CombineIndependentOps(uint64_t min_num_ops, int64_t max_num_elements) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(relay::CombineIndependentOps(f, min_num_ops, max_num_elements));
+      };
+  return CreateFunctionPass(pass_func, 4, "CombineIndependentOps", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.CombineIndependentOps")
+    .set_body_typed(CombineIndependentOps);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -29,10 +29,15 @@
 #include <tvm/relay/transform.h>
 #include <tvm/te/operation.h>
 
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <map>
+#include <queue>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -60,6 +65,8 @@ class ConvertTransformMemorizerNode : public TransformMemorizerNode {
 
   /*! \brief A mapping of op_name to array of desired layouts for each input. */
   Map<String, Array<String>> desired_layouts_;
+  /*! \brief The calls that keep their layouts, as planned by PlanLayout. */
+  std::unordered_set<const Object*> keep_calls_;
 };
 
 /*!
@@ -87,7 +94,7 @@ class ConvertTransformMemorizer : public TransformMemorizer {
 
     Expr new_e;
     bool modified = false;
-    if (fconvert_layout.count(op)) {
+    if (fconvert_layout.count(op) && !operator->()->keep_calls_.count(ref_call.get())) {
       auto desired_layouts = operator->()->desired_layouts_;
       if (desired_layouts.find(op->name) != desired_layouts.end()) {
         tvm::Array<tvm::te::Tensor> tinfos;
@@ -124,14 +131,251 @@ class ConvertTransformMemorizer : public TransformMemorizer {
  * 1. The altered op should have the same number of arguments as the previous one.
  * 2. Do not support nested tuple arguments.
  */
-Expr ConvertLayout(const Expr& expr, const Map<String, Array<String>>& desired_layouts) {
+Expr ConvertLayout(const Expr& expr, const Map<String, Array<String>>& desired_layouts,
+                   std::unordered_set<const Object*> keep_calls = {}) {
   ConvertTransformMemorizer transformMemorizer(
       make_object<ConvertTransformMemorizerNode>(desired_layouts));
+  transformMemorizer->keep_calls_ = std::move(keep_calls);
   auto fcontext = [&](const Call& call) -> ObjectRef { return transformMemorizer; };
 
   return ForwardRewrite(expr, LayoutRewriter<ConvertTransformMemorizer>, fcontext);
 }
 
+using FMacCount = runtime::TypedPackedFunc<int64_t(const Call& call_node)>;
+
+/*!
+ * \brief Plan which calls of the ops in desired_layouts are converted, so that the total cost
+ *  of the calls and the layout_transforms between them is minimal.
+ *
+ * Every call either keeps its layout or is converted. The layout of a tensor produced by an op
+ * that adapts to its input layout, i.e. has FInferCorrectLayout, follows its inputs, so a
+ * layout_transform is needed on an argument whose producing calls chose a different layout.
+ * The inputs and outputs of the function and of the ops that cannot adapt are in the original
+ * layout. This is a labeling problem with two labels whose pairwise costs are the sizes of the
+ * transformed tensors, which is solved exactly as a minimum cut.
+ */
+class LayoutPlanner : private MixedModeVisitor {
+ public:
+  LayoutPlanner(Map<String, Array<String>> desired_layouts, PackedFunc op_cost,
+                double desired_speedup, double transform_cost_per_byte)
+      : desired_layouts_(std::move(desired_layouts)),
+        op_cost_(std::move(op_cost)),
+        desired_speedup_(desired_speedup),
+        transform_cost_per_byte_(transform_cost_per_byte) {}
+
+  /*!
+   * \brief Plan the layouts of a function.
+   * \param func The function.
+   * \return The calls that keep their layouts.
+   */
+  std::unordered_set<const Object*> Plan(const Function& func) {
+    // node 0 stands for the tensors that are in the original layout.
+    keep_cost_ = {0};
+    convert_cost_ = {0};
+    calls_ = {nullptr};
+    VisitExpr(func->body);
+    AddEdges(kOriginal, func->body);
+    std::vector<bool> keep = MinCut();
+    std::unordered_set<const Object*> keep_calls;
+    for (size_t i = 1; i < calls_.size(); ++i) {
+      if (keep[i]) keep_calls.insert(calls_[i]);
+    }
+    return keep_calls;
+  }
+
+ private:
+  static constexpr int kOriginal = 0;
+
+  void VisitExpr_(const ConstantNode* op) final { origins_[op] = {}; }
+
+  void VisitExpr_(const TupleNode* op) final {
+    MixedModeVisitor::VisitExpr_(op);
+    std::vector<int> origins;
+    for (const auto& field : op->fields) {
+      Merge(Origins(field), &origins);
+    }
+    origins_[op] = std::move(origins);
+  }
+
+  void VisitExpr_(const TupleGetItemNode* op) final {
+    MixedModeVisitor::VisitExpr_(op);
+    origins_[op] = Origins(op->tuple);
+  }
+
+  void VisitExpr_(const CallNode* call) final {
+    static auto finfer_layout = Op::GetAttrMap<FInferCorrectLayout>("FInferCorrectLayout");
+    MixedModeVisitor::VisitExpr_(call);
+    const auto* op = call->op.as<OpNode>();
+    if (op && desired_layouts_.count(op->name)) {
+      int id = static_cast<int>(calls_.size());
+      calls_.push_back(call);
+      double cost = OpCost(GetRef<Call>(call), false);
+      keep_cost_.push_back(cost);
+      convert_cost_.push_back(OpCost(GetRef<Call>(call), true));
+      for (const auto& arg : call->args) {
+        AddEdges(id, arg);
+      }
+      origins_[call] = {id};
+    } else if (op && finfer_layout.count(GetRef<Op>(op))) {
+      std::vector<int> origins;
+      for (const auto& arg : call->args) {
+        Merge(Origins(arg), &origins);
+      }
+      origins_[call] = std::move(origins);
+    } else {
+      for (const auto& arg : call->args) {
+        AddEdges(kOriginal, arg);
+      }
+      origins_[call] = {kOriginal};
+    }
+  }
+
+  // The calls whose outputs reach the expression through the ops that adapt to their input
+  // layouts, the variables and the other exprs are in the original layout.
+  std::vector<int> Origins(const Expr& expr) const {
+    auto it = origins_.find(expr.get());
+    return it == origins_.end() ? std::vector<int>{kOriginal} : it->second;
+  }
+
+  static void Merge(const std::vector<int>& src, std::vector<int>* dst) {
+    for (int id : src) {
+      if (std::find(dst->begin(), dst->end(), id) == dst->end()) dst->push_back(id);
+    }
+  }
+
+  static double TensorBytes(const Type& type) {
+    if (const auto* ttype = type.as<TensorTypeNode>()) {
+      double bytes = ttype->dtype.bytes() * ttype->dtype.lanes();
+      for (const auto& dim : ttype->shape) {
+        const auto* imm = dim.as<IntImmNode>();
+        if (imm == nullptr) return 0;
+        bytes *= imm->value;
+      }
+      return bytes;
+    }
+    double bytes = 0;
+    if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+      for (const auto& field : tuple_type->fields) {
+        bytes += TensorBytes(field);
+      }
+    }
+    return bytes;
+  }
+
+  // Add the cost of transforming the argument of a node if the layouts of the node and the
+  // producers of the argument differ.
+  void AddEdges(int node, const Expr& arg) {
+    double cost = TensorBytes(arg->checked_type()) * transform_cost_per_byte_;
+    for (int origin : Origins(arg)) {
+      if (origin != node) {
+        edges_[{std::min(node, origin), std::max(node, origin)}] += cost;
+      }
+    }
+  }
+
+  double OpCost(const Call& call, bool converted) const {
+    static const auto& fmac_count = Op::GetAttrMap<FMacCount>("FMacCount");
+    if (op_cost_ != nullptr) {
+      TVMRetValue ret = op_cost_(call, converted);
+      if (ret.type_code() != kTVMNullptr) {
+        return ret;
+      }
+    }
+    Op op = Downcast<Op>(call->op);
+    double cost = TensorBytes(call->checked_type());
+    if (fmac_count.count(op)) {
+      int64_t macs = fmac_count[op](call);
+      if (macs > 0) cost = static_cast<double>(macs);
+    }
+    return converted ? cost / desired_speedup_ : cost;
+  }
+
+  /*!
+   * \brief Solve the labeling by the maximum flow from the source to the sink, where a node
+   *  on the source side of the minimum cut keeps its layout. Cutting the edge from the source to
+   *  a node costs converting it, and cutting the edge from it to the sink costs keeping it.
+   * \return Whether each node keeps its layout.
+   */
+  std::vector<bool> MinCut() const {
+    const double kInf = std::numeric_limits<double>::infinity();
+    const int num_nodes = static_cast<int>(calls_.size()) + 2;
+    const int source = num_nodes - 2, sink = num_nodes - 1;
+    std::vector<std::map<int, double>> capacity(num_nodes);
+    capacity[source][kOriginal] = kInf;
+    for (size_t i = 1; i < calls_.size(); ++i) {
+      double base = std::min(keep_cost_[i], convert_cost_[i]);
+      capacity[source][i] += convert_cost_[i] - base;
+      capacity[i][sink] += keep_cost_[i] - base;
+    }
+    for (const auto& it : edges_) {
+      capacity[it.first.first][it.first.second] += it.second;
+      capacity[it.first.second][it.first.first] += it.second;
+    }
+
+    // Edmonds-Karp, the graphs are small enough.
+    const double kEps = 1e-9;
+    while (true) {
+      std::vector<int> parent(num_nodes, -1);
+      parent[source] = source;
+      std::queue<int> queue;
+      queue.push(source);
+      while (!queue.empty() && parent[sink] == -1) {
+        int u = queue.front();
+        queue.pop();
+        for (const auto& it : capacity[u]) {
+          if (parent[it.first] == -1 && it.second > kEps) {
+            parent[it.first] = u;
+            queue.push(it.first);
+          }
+        }
+      }
+      if (parent[sink] == -1) break;
+      double flow = kInf;
+      for (int v = sink; v != source; v = parent[v]) {
+        flow = std::min(flow, capacity[parent[v]][v]);
+      }
+      for (int v = sink; v != source; v = parent[v]) {
+        capacity[parent[v]][v] -= flow;
+        capacity[v][parent[v]] += flow;
+      }
+    }
+
+    std::vector<bool> keep(num_nodes, false);
+    std::vector<int> stack = {source};
+    keep[source] = true;
+    while (!stack.empty()) {
+      int u = stack.back();
+      stack.pop_back();
+      for (const auto& it : capacity[u]) {
+        if (!keep[it.first] && it.second > kEps) {
+          keep[it.first] = true;
+          stack.push_back(it.first);
+        }
+      }
+    }
+    return keep;
+  }
+
+  Map<String, Array<String>> desired_layouts_;
+  PackedFunc op_cost_;
+  double desired_speedup_;
+  double transform_cost_per_byte_;
+  /*! \brief The planned calls, index 0 is the original layout. */
+  std::vector<const CallNode*> calls_;
+  std::vector<double> keep_cost_;
+  std::vector<double> convert_cost_;
+  /*! \brief The cost of the transforms between two nodes if their layouts differ. */
+  std::map<std::pair<int, int>, double> edges_;
+  std::unordered_map<const Object*, std::vector<int>> origins_;
+};
+
+Expr PlanLayout(const Function& func, const Map<String, Array<String>>& desired_layouts,
+                PackedFunc op_cost, double desired_speedup, double transform_cost_per_byte) {
+  auto keep_calls =
+      LayoutPlanner(desired_layouts, op_cost, desired_speedup, transform_cost_per_byte).Plan(func);
+  return ConvertLayout(func, desired_layouts, std::move(keep_calls));
+}
+
 }  // namespace convert_op_layout
 
 namespace transform {
@@ -146,6 +390,18 @@ Pass ConvertLayout(const Map<String, Array<String>>& desired_layouts) {
 
 TVM_REGISTER_GLOBAL("relay._transform.ConvertLayout").set_body_typed(ConvertLayout);
 
+Pass PlanLayout(const Map<String, Array<String>>& desired_layouts, PackedFunc op_cost,
+                double desired_speedup, double transform_cost_per_byte) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(relay::convert_op_layout::PlanLayout(
+            f, desired_layouts, op_cost, desired_speedup, transform_cost_per_byte));
+      };
+  return CreateFunctionPass(pass_func, 3, "PlanLayout", {"InferType", "CanonicalizeOps"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.PlanLayout").set_body_typed(PlanLayout);
+
 }  // namespace transform
 
 }  // namespace relay
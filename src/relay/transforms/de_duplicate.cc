@@ -27,11 +27,14 @@
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/pattern_functor.h>
 
+#include <utility>
+#include <vector>
+
 namespace tvm {
 namespace relay {
 
 Expr DeDup(const Expr& e) {
-  class DeDupMutator : public TypeMutator, public ExprMutator, public PatternMutator {
+  class DeDupMutator : public TypeMutator, public MixedModeMutator, public PatternMutator {
    public:
     TypeVar Fresh(const TypeVar& tv) {
       TypeVar ret = TypeVar(tv->name_hint, tv->kind);
@@ -47,8 +50,8 @@ Expr DeDup(const Expr& e) {
       return ret;
     }
 
-    Expr VisitExpr(const Expr& e) final {
-      auto ret = ExprMutator::VisitExpr(e);
+    Expr DispatchVisitExpr(const Expr& e) final {
+      auto ret = MixedModeMutator::DispatchVisitExpr(e);
       ret->checked_type_ = e->checked_type_;
       return ret;
     }
@@ -59,8 +62,24 @@ Expr DeDup(const Expr& e) {
     }
 
     Expr VisitExpr_(const LetNode* op) final {
-      Var v = Fresh(op->var);
-      return Let(v, VisitExpr(op->value), VisitExpr(op->body));
+      // Rename the let chains iteratively, so that the recursion does not grow with their length.
+      std::vector<std::pair<const LetNode*, std::pair<Var, Expr>>> bindings;
+      Expr body = GetRef<Expr>(op);
+      while (const auto* let = body.as<LetNode>()) {
+        if (!bindings.empty() && memo_.count(body)) break;
+        Var v = Fresh(let->var);
+        bindings.push_back({let, {v, VisitExpr(let->value)}});
+        body = let->body;
+      }
+      Expr ret = VisitExpr(body);
+      for (auto it = bindings.rbegin(); it != bindings.rend(); ++it) {
+        ret = Let(it->second.first, it->second.second, ret);
+        if (it->first != op) {
+          ret->checked_type_ = it->first->checked_type_;
+          memo_[GetRef<Expr>(it->first)] = ret;
+        }
+      }
+      return ret;
     }
 
     Type VisitType(const Type& t) final { return t.defined() ? TypeMutator::VisitType(t) : t; }
@@ -354,6 +354,10 @@ class AnnotatationVisitor : private ExprVisitor {
 class DeviceInfo {
  public:
   static Map<Expr, Integer> GetDeviceMap(const Expr& expr) {
+    // The post order visitor recurses on the dataflow, skip it when there is nothing to collect.
+    if (!HasDeviceCopy(expr)) {
+      return Map<Expr, Integer>();
+    }
     DeviceInfo device_info;
     device_info.post_visitor_ = PostDfsOrderVisitor();
     device_info.post_visitor_.Visit(expr);
@@ -443,6 +447,16 @@ class DeviceInfo {
     friend DeviceInfo;
   };
 
+  // Check whether the expression has a device copy, without recursing on the dataflow.
+  static bool HasDeviceCopy(const Expr& expr) {
+    struct DeviceCopyFinder : MixedModeVisitor {
+      bool found = false;
+      void VisitExpr_(const CallNode* call) final { found |= GetDeviceCopyNode(call) != nullptr; }
+    } finder;
+    finder(expr);
+    return finder.found;
+  }
+
   /*
    * \brief Returns a device copy node based on the current expr node. It
    * returns a device copy node either the current expr node is a device copy
@@ -20,6 +20,8 @@
 /*!
  * \file constant_folding.cc
  */
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/transform.h>
 #include <tvm/relay/expr_functor.h>
@@ -31,6 +33,11 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/object.h>
 
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 #include "pattern_util.h"
 
 namespace tvm {
@@ -38,6 +45,51 @@ namespace relay {
 
 using FInterpreter = runtime::TypedPackedFunc<ObjectRef(Expr)>;
 
+struct FoldConstantConfigNode : public tvm::AttrsNode<FoldConstantConfigNode> {
+  bool batched;
+  int max_batch_size;
+
+  TVM_DECLARE_ATTRS(FoldConstantConfigNode, "relay.transform.FoldConstantConfig") {
+    TVM_ATTR_FIELD(batched)
+        .describe(
+            "Whether to evaluate all maximal constant subexpressions together in one module "
+            "instead of one module per subexpression")
+        .set_default(true);
+    TVM_ATTR_FIELD(max_batch_size)
+        .describe("The maximum number of subexpressions evaluated together in batched mode")
+        .set_default(256);
+  }
+};
+
+class FoldConstantConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(FoldConstantConfig, Attrs, FoldConstantConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(FoldConstantConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FoldConstant", FoldConstantConfig);
+
+/*!
+ * \brief Check whether a call to the op can be evaluated at compile time when all its arguments are
+ * constant. shape_of and ndarray_size are not included, they are folded from the types of their
+ * arguments instead.
+ */
+bool IsEvaluableOp(const Op& op) {
+  static auto op_stateful = Op::GetAttrMap<TOpIsStateful>("TOpIsStateful");
+  // It is harmful to fold ops creating tensors from scalars, e.g. full(shape=(4, 5)).
+  static const std::unordered_set<std::string> skip_list{"zeros_like", "ones_like", "full_like",
+                                                         "full"};
+  // We should think about potentially constant evaluation over these ops too.
+  static const std::unordered_set<std::string> unevaluable_list{
+      "device_copy", "shape_of", "vm.shape_of", "ndarray_size", "vm.invoke_tvm_op",
+      "vm.shape_func", "memory.alloc_tensor", "memory.alloc_storage"};
+  if (skip_list.count(op->name) || unevaluable_list.count(op->name)) {
+    return false;
+  }
+  // skip stateful ops.
+  return !op_stateful.get(op, false);
+}
+
 class ConstantChecker : private ExprVisitor {
  public:
   // Check whether an expression is constant. The results are memoized.
@@ -50,7 +102,10 @@ class ConstantChecker : private ExprVisitor {
     }
     const auto it = memo_.find(expr);
     if (it != memo_.end()) return it->second;
-    VisitExpr(expr);
+    // Only tuples of constants are constant, do not visit the inputs of other expressions.
+    if (expr.as<TupleNode>()) {
+      VisitExpr(expr);
+    }
     return memo_[expr];  // return memoized result or the default value false
   }
 
@@ -73,19 +128,105 @@ bool ConstantCheck(const Expr& e) { return ConstantChecker().Check(e); }
 
 TVM_REGISTER_GLOBAL("relay.analysis.check_constant").set_body_typed(ConstantCheck);
 
+/*!
+ * \brief Collect the maximal subexpressions that ConstantFolder would evaluate, i.e. the calls
+ * that only depend on constants and are not an argument of another such call.
+ */
+class ConstantSubexprCollector : private MixedModeVisitor {
+ public:
+  Array<Expr> Collect(const Expr& expr) {
+    VisitExpr(expr);
+    return roots_;
+  }
+
+ private:
+  Array<Expr> roots_;
+  std::unordered_map<Expr, bool, ObjectPtrHash, ObjectPtrEqual> memo_;
+
+  // Get the inputs which decide whether the expression is foldable.
+  static std::vector<Expr> FoldableInputs(const Expr& expr) {
+    std::vector<Expr> inputs;
+    if (const auto* tuple = expr.as<TupleNode>()) {
+      for (const Expr& field : tuple->fields) {
+        inputs.push_back(field);
+      }
+    } else if (const auto* get_item = expr.as<TupleGetItemNode>()) {
+      inputs.push_back(get_item->tuple);
+    } else if (const auto* call = expr.as<CallNode>()) {
+      // We don't constant fold function with zero arguments.
+      const auto* op = call->op.as<OpNode>();
+      if (op != nullptr && IsEvaluableOp(GetRef<Op>(op))) {
+        for (const Expr& arg : call->args) {
+          inputs.push_back(arg);
+        }
+      }
+    }
+    return inputs;
+  }
+
+  // Check whether the expression is folded into a constant by ConstantFolder.
+  bool IsFoldable(const Expr& expr) {
+    if (expr.as<ConstantNode>()) {
+      return true;
+    }
+    // Decide the inputs first in post order with a stack, so that the recursion does not grow
+    // with the depth of the dataflow.
+    std::vector<std::pair<Expr, bool>> stack = {{expr, false}};
+    while (!stack.empty()) {
+      Expr e = stack.back().first;
+      if (e.as<ConstantNode>() || memo_.count(e)) {
+        stack.pop_back();
+        continue;
+      }
+      std::vector<Expr> inputs = FoldableInputs(e);
+      if (!stack.back().second) {
+        stack.back().second = true;
+        for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+          stack.push_back({*it, false});
+        }
+        continue;
+      }
+      stack.pop_back();
+      bool result = false;
+      if (e.as<TupleNode>() || e.as<TupleGetItemNode>() || !inputs.empty()) {
+        result = std::all_of(inputs.begin(), inputs.end(), [this](const Expr& input) {
+          return input.as<ConstantNode>() || memo_.at(input);
+        });
+      }
+      memo_[e] = result;
+    }
+    return memo_.at(expr);
+  }
+
+  // The maximal foldable calls are collected instead of visited.
+  bool CheckVisited(const Expr& expr) final {
+    if (MixedModeVisitor::CheckVisited(expr)) {
+      return true;
+    }
+    if (expr.as<CallNode>() && IsFoldable(expr)) {
+      roots_.push_back(expr);
+      visit_counter_[expr.get()]++;
+      return true;
+    }
+    return false;
+  }
+
+  void VisitExpr_(const FunctionNode* op) final {
+    // ConstantFolder does not fold inside primitive functions.
+    if (!op->HasNonzeroAttr(attr::kPrimitive)) {
+      ExprVisitor::VisitExpr_(op);
+    }
+  }
+};
+
 // TODO(tvm-team) consider combine dead-code with constant folder.
 // or make a more powerful partial evaluator.
-class ConstantFolder : public ExprMutator {
+class ConstantFolder : public MixedModeMutator {
  public:
   explicit ConstantFolder(IRModule module)
       : module_(module),
-        device_copy_op_(Op::Get("device_copy")),
         shape_of_op_(Op::Get("shape_of")),
         vm_shape_of_op_(Op::Get("vm.shape_of")),
-        invoke_tvm_op_(Op::Get("vm.invoke_tvm_op")),
-        shape_func_op_(Op::Get("vm.shape_func")),
-        alloc_tensor_op_(Op::Get("memory.alloc_tensor")),
-        alloc_storage_op_(Op::Get("memory.alloc_storage")),
         cast_op_(Op::Get("cast")),
         ndarray_size_op_(Op::Get("ndarray_size")) {}
 
@@ -118,28 +259,19 @@ class ConstantFolder : public ExprMutator {
     }
   }
 
-  Expr VisitExpr_(const CallNode* call) final {
+  Expr Rewrite_(const CallNode* pre, const Expr& post) final {
     if (inside_primitive) {
-      return GetRef<Expr>(call);
+      return GetRef<Expr>(pre);
     }
-    static auto op_stateful = Op::GetAttrMap<TOpIsStateful>("TOpIsStateful");
-
-    std::unordered_set<std::string> skip_list{"zeros_like", "ones_like", "full_like", "full"};
-
-    auto origin_args = call->args;
-    Expr res = ExprMutator::VisitExpr_(call);
-    call = res.as<CallNode>();
+    auto origin_args = pre->args;
+    Expr res = post;
+    const CallNode* call = res.as<CallNode>();
     // We don't constant fold function with zero arguments.
     // This is a heuristic that is useful.
     // For example it is harmful to fold ones(shape=(4, 5)).
     if (call->args.size() == 0) return res;
     const OpNode* op = call->op.as<OpNode>();
     if (op == nullptr) return res;
-    if (skip_list.count(op->name)) {
-      return res;
-    }
-    // skip stateful ops.
-    if (op_stateful.get(GetRef<Op>(op), false)) return res;
     // Try to evaluate shape_of op
     if (call->op == shape_of_op_ || call->op == vm_shape_of_op_) {
       return EvaluateShapeOf(res, origin_args, call->attrs);
@@ -149,10 +281,8 @@ class ConstantFolder : public ExprMutator {
       return EvaluateNdarraySize(res, origin_args, call->attrs);
     }
 
-    // We should think about potentially constant evaluation over these ops too.
-    if (call->op == invoke_tvm_op_ || call->op == shape_func_op_ || call->op == alloc_tensor_op_ ||
-        call->op == alloc_storage_op_ || call->op == device_copy_op_) {
-      return GetRef<Call>(call);
+    if (!IsEvaluableOp(GetRef<Op>(op))) {
+      return res;
     }
 
     bool all_const_args = true;
@@ -168,9 +298,58 @@ class ConstantFolder : public ExprMutator {
     }
   }
 
-  Expr VisitExpr_(const TupleGetItemNode* op) final {
-    Expr res = ExprMutator::VisitExpr_(op);
-    op = res.as<TupleGetItemNode>();
+  /*!
+   * \brief Evaluate all maximal constant subexpressions of expr with a few modules, instead of
+   * one module per subexpression in the mutation. Structurally equal subexpressions are only
+   * evaluated once. The results are memoized, so they are directly used by the mutation.
+   * \param expr The expression to be folded.
+   * \param max_batch_size The maximum number of subexpressions evaluated in one module.
+   */
+  void BatchEvaluate(const Expr& expr, int max_batch_size) {
+    Array<Expr> roots = ConstantSubexprCollector().Collect(expr);
+
+    // Deduplicate structurally equal subexpressions, e.g. the same weight transform applied to
+    // shared weights.
+    std::unordered_map<Expr, size_t, StructuralHash, StructuralEqual> unique_index;
+    std::vector<Expr> unique_roots;
+    std::vector<size_t> root_to_unique;
+    root_to_unique.reserve(roots.size());
+    for (const Expr& root : roots) {
+      auto it = unique_index.find(root);
+      if (it == unique_index.end()) {
+        it = unique_index.emplace(root, unique_roots.size()).first;
+        unique_roots.push_back(root);
+      }
+      root_to_unique.push_back(it->second);
+    }
+    if (unique_roots.size() <= 1) {
+      // Nothing to batch, let the mutation handle it.
+      return;
+    }
+
+    std::vector<Expr> values(unique_roots.size());
+    size_t batch_size = max_batch_size > 0 ? max_batch_size : unique_roots.size();
+    for (size_t begin = 0; begin < unique_roots.size(); begin += batch_size) {
+      size_t end = std::min(begin + batch_size, unique_roots.size());
+      if (end - begin == 1) {
+        values[begin] = ConstEvaluate(unique_roots[begin]);
+        continue;
+      }
+      Array<Expr> fields(unique_roots.begin() + begin, unique_roots.begin() + end);
+      const auto* tuple = ConstEvaluate(Tuple(fields)).as<TupleNode>();
+      CHECK(tuple != nullptr && tuple->fields.size() == fields.size());
+      for (size_t i = begin; i < end; ++i) {
+        values[i] = tuple->fields[i - begin];
+      }
+    }
+    for (size_t i = 0; i < roots.size(); ++i) {
+      memo_[roots[i]] = values[root_to_unique[i]];
+    }
+  }
+
+  Expr Rewrite_(const TupleGetItemNode* pre, const Expr& post) final {
+    Expr res = post;
+    const auto* op = res.as<TupleGetItemNode>();
     if (const auto* tuple = op->tuple.as<TupleNode>()) {
       return tuple->fields[op->index];
     } else {
@@ -185,13 +364,8 @@ class ConstantFolder : public ExprMutator {
   IRModule module_;
 
   // Cache the following ops for equivalence checking in this pass.
-  const Op& device_copy_op_;
   const Op& shape_of_op_;
   const Op& vm_shape_of_op_;
-  const Op& invoke_tvm_op_;
-  const Op& shape_func_op_;
-  const Op& alloc_tensor_op_;
-  const Op& alloc_storage_op_;
   const Op& cast_op_;
   const Op& ndarray_size_op_;
 
@@ -358,7 +532,13 @@ class ConstantFolder : public ExprMutator {
 };
 
 Expr FoldConstant(const Expr& expr, const IRModule& mod) {
-  return ConstantFolder(mod).Mutate(expr);
+  auto cfg = transform::PassContext::Current()->GetConfig<FoldConstantConfig>(
+      "relay.FoldConstant", AttrsWithDefaultValues<FoldConstantConfig>());
+  ConstantFolder folder(mod);
+  if (cfg.value()->batched) {
+    folder.BatchEvaluate(expr, cfg.value()->max_batch_size);
+  }
+  return folder.Mutate(expr);
 }
 
 namespace transform {
@@ -202,7 +202,7 @@ using FForwardRewrite = TypedPackedFunc<Expr(const Call& ref_call, const Array<E
 //----------------------------------------------
 // Generic Visitors for FScaleAxisForward
 //----------------------------------------------
-class ForwardPrep : private ExprVisitor {
+class ForwardPrep : private MixedModeVisitor {
  public:
   std::unordered_map<const Object*, Message> Prepare(const Expr& body) {
     this->Update(body, NullValue<Message>());
@@ -252,7 +252,7 @@ class ForwardPrep : private ExprVisitor {
   }
 
   void VisitExpr_(const CallNode* call) {
-    ExprVisitor::VisitExpr_(call);
+    MixedModeVisitor::VisitExpr_(call);
     // function to be lazily invoked
     auto flazy = [this, call]() {
       static const auto& fprep = Op::GetAttrMap<FForwardPrep>("FScaleAxisForwardPrep");
@@ -282,7 +282,7 @@ class ForwardPrep : private ExprVisitor {
   }
 
   void VisitExpr_(const TupleNode* op) {
-    ExprVisitor::VisitExpr_(op);
+    MixedModeVisitor::VisitExpr_(op);
     // do not support pass scale through tuple for now.
     auto flazy = [this, op]() {
       for (const Expr& field : op->fields) {
@@ -607,7 +607,7 @@ using FBackwardTransform =
 // Generic Visitors for FScaleAxisBackward
 //----------------------------------------------
 
-class BackwardPrep : private ExprVisitor {
+class BackwardPrep : private MixedModeVisitor {
  public:
   // The message on each node.
   std::unordered_map<const Object*, Message> Prepare(const Expr& body) {
@@ -623,7 +623,7 @@ class BackwardPrep : private ExprVisitor {
   std::unordered_map<const Object*, size_t> ref_counter_;
   // Visit the expression.
   void VisitExpr_(const CallNode* call) {
-    ExprVisitor::VisitExpr_(call);
+    MixedModeVisitor::VisitExpr_(call);
     static const auto& fprep = Op::GetAttrMap<FBackwardPrep>("FScaleAxisBackwardPrep");
     auto f = fprep.get(call->op, nullptr);
     if (f == nullptr) return;
@@ -653,6 +653,20 @@ class BackwardTransformerNode : public Object, private ExprMutator {
   // Run forward transform.
   Expr Fold(Expr expr) {
     message_ = BackwardPrep().Prepare(expr);
+    // The calls which do not receive a message are transformed without a scale whoever
+    // consumes them. Transform them first in post order, so that the recursion of the
+    // transforms does not grow with the depth of the dataflow.
+    const auto* func = expr.as<FunctionNode>();
+    std::unordered_set<const Object*> visited;
+    ExpandDataflow(
+        func ? func->body : expr, [&](const Expr& e) { return visited.count(e.get()) != 0; },
+        [&](const Expr& e) {
+          visited.insert(e.get());
+          const auto* call = e.as<CallNode>();
+          if (call && !GetMessage(e).defined()) {
+            Transform(call, NullValue<Message>(), NullValue<Expr>());
+          }
+        });
     return this->Mutate(expr);
   }
   /*!
@@ -75,6 +75,11 @@ namespace relay {
       will still run correctly.
   - CommitFuse: mark all the nodes between source and post-dominator as the same group.
   - We use an Union-Find data structure to manage the groups.
+
+  Prologue fusion: when relay.FuseOps.fuse_prologue is set, an injective producer, e.g. pad,
+  cast or layout_transform, whose post-dominator is an op marked TFusePrologue, e.g. conv2d,
+  is fused into it. The compile engine inlines such producers into the input loading of the op,
+  so the producer no longer writes its output to memory.
 */
 using support::LinkedList;
 using support::LinkNode;
@@ -84,6 +89,7 @@ constexpr uint32_t kMaxFusedOps = 256;
 static const Op& stop_fusion_op = Op::Get("annotation.stop_fusion");
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.max_depth", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.fuse_prologue", Bool);
 
 /*!
  * \brief Indexed data flow graph in forward direction.
@@ -148,7 +154,7 @@ class IndexedForwardGraph {
 };
 
 // Creator of post dominator tree of the dataflow
-class IndexedForwardGraph::Creator : private ExprVisitor {
+class IndexedForwardGraph::Creator : private MixedModeVisitor {
  public:
   explicit Creator(support::Arena* arena) : arena_(arena) {}
 
@@ -165,17 +171,20 @@ class IndexedForwardGraph::Creator : private ExprVisitor {
   IndexedForwardGraph graph_;
   // attribute equal comparator
   StructuralEqual attr_equal_;
-  // Update the message stored at the node.
-  void Update(const Expr& node, IndexedForwardGraph::Node* parent, OpPatternKind pattern) {
-    const tvm::Object* key = node.get();
-    IndexedForwardGraph::Node* current;
+  // Get the node of an expression, the dataflow nodes are visited in post order, so the node may
+  // be created before its consumers update it.
+  IndexedForwardGraph::Node* GetNode(const tvm::Object* key) {
     auto it = graph_.node_map.find(key);
     if (it != graph_.node_map.end()) {
-      current = it->second;
-    } else {
-      current = arena_->make<IndexedForwardGraph::Node>();
-      graph_.node_map[key] = current;
+      return it->second;
     }
+    auto* node = arena_->make<IndexedForwardGraph::Node>();
+    graph_.node_map[key] = node;
+    return node;
+  }
+  // Update the message stored at the node.
+  void Update(const Expr& node, IndexedForwardGraph::Node* parent, OpPatternKind pattern) {
+    IndexedForwardGraph::Node* current = GetNode(node.get());
     if (parent != nullptr) {
       auto* link = arena_->make<LinkNode<IndexedForwardGraph::Edge> >();
       link->value.node = parent;
@@ -187,9 +196,7 @@ class IndexedForwardGraph::Creator : private ExprVisitor {
   }
 
   void AddNode(const tvm::Object* key) {
-    auto it = graph_.node_map.find(key);
-    CHECK(it != graph_.node_map.end()) << "Cannot find node " << GetRef<ObjectRef>(key);
-    IndexedForwardGraph::Node* node = it->second;
+    IndexedForwardGraph::Node* node = GetNode(key);
     CHECK(node->ref == nullptr);
     node->ref = key;
     node->index = graph_.post_dfs_order.size();
@@ -226,8 +233,7 @@ class IndexedForwardGraph::Creator : private ExprVisitor {
   }
 
   void VisitExpr_(const CallNode* call) final {
-    CHECK(graph_.node_map.count(call));
-    Node* node = graph_.node_map.at(call);
+    Node* node = GetNode(call);
     static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
     // Now we set the pattern of this call.
     //
@@ -265,13 +271,12 @@ class IndexedForwardGraph::Creator : private ExprVisitor {
       }
       this->Update(call->args[i], node, edge_pattern);
     }
-    ExprVisitor::VisitExpr_(call);
+    MixedModeVisitor::VisitExpr_(call);
     this->AddNode(call);
   }
 
   void VisitExpr_(const TupleNode* op) final {
-    CHECK(graph_.node_map.count(op));
-    Node* tuple_node = graph_.node_map.at(op);
+    Node* tuple_node = GetNode(op);
     tuple_node->pattern = kTuple;
     for (const Expr& field : op->fields) {
       if (field->checked_type().as<TensorTypeNode>()) {
@@ -280,7 +285,7 @@ class IndexedForwardGraph::Creator : private ExprVisitor {
         this->Update(field, nullptr, kOpaque);
       }
     }
-    ExprVisitor::VisitExpr_(op);
+    MixedModeVisitor::VisitExpr_(op);
     this->AddNode(op);
   }
 
@@ -302,12 +307,11 @@ class IndexedForwardGraph::Creator : private ExprVisitor {
     if (has_non_tensor) {
       this->Update(op->tuple, nullptr, kOpaque);
     } else {
-      CHECK(graph_.node_map.count(op));
-      Node* node = graph_.node_map.at(op);
+      Node* node = GetNode(op);
       node->pattern = kInjective;
       this->Update(op->tuple, node, kInjective);
     }
-    ExprVisitor::VisitExpr_(op);
+    MixedModeVisitor::VisitExpr_(op);
     this->AddNode(op);
   }
 
@@ -498,8 +502,12 @@ DominatorTree DominatorTree::PostDom(support::Arena* arena, const IndexedForward
  */
 class GraphPartitioner {
  public:
-  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth)
-      : arena_(arena), opt_level_(opt_level), max_fuse_depth_(max_fuse_depth) {}
+  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth,
+                            bool fuse_prologue)
+      : arena_(arena),
+        opt_level_(opt_level),
+        max_fuse_depth_(max_fuse_depth),
+        fuse_prologue_(fuse_prologue) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -553,6 +561,8 @@ class GraphPartitioner {
   int opt_level_;
   /*! \brief The maximum number of operations in one fused function */
   size_t max_fuse_depth_;
+  /*! \brief Whether to fuse the injective producers into the ops marked TFusePrologue */
+  bool fuse_prologue_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -673,6 +683,15 @@ class GraphPartitioner {
     return target->FindRoot()->num_nodes + CountNodesUptoSink_(child, dom_parent);
   }
 
+  // Whether the node is a call to an op that absorbs its injective producers.
+  static bool IsPrologueSink(const IndexedForwardGraph::Node* node) {
+    static auto ffuse_prologue = Op::GetAttrMap<TFusePrologue>("TFusePrologue");
+    if (!node->ref->IsInstance<CallNode>()) return false;
+    const auto* call = static_cast<const CallNode*>(node->ref);
+    const auto* op = call->op.as<OpNode>();
+    return op != nullptr && ffuse_prologue.get(GetRef<Op>(op), false);
+  }
+
   // Initialize the groups.
   void InitGroups(const IndexedForwardGraph& graph) {
     groups_.resize(graph.post_dfs_order.size());
@@ -734,6 +753,18 @@ class GraphPartitioner {
       }
       // Do not fuse into tuple for now
       if (groups_[dom_parent_gindex]->pattern == kTuple) continue;
+      // Fuse the injective producers into the op after it finishes fusing its outputs.
+      if (phase == 1 && fuse_prologue_ && group_node->pattern <= kInjective &&
+          group_node->FindRoot()->master_ref == nullptr &&
+          IsPrologueSink(dom_node->parent->gnode)) {
+        auto fcond = [](OpPatternKind kind, bool is_sink) {
+          return kind <= kInjective || (is_sink && kind == kOutEWiseFusable);
+        };
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+          CommitFuse(graph_node, dom_node->parent->gnode);
+          continue;
+        }
+      }
       // Try to fuse current node to its post-dominator.
       if (group_node->pattern == kOutEWiseFusable) {
         if (phase != 0) continue;
@@ -800,16 +831,27 @@ std::vector<GraphPartitioner::Group*> GraphPartitioner::Partition(
 class FuseMutator : private ExprMutator {
  public:
   // Run the transform
-  Expr Transform(const Expr& body, int fuse_opt_level, size_t max_fuse_depth) {
+  Expr Transform(const Expr& body, int fuse_opt_level, size_t max_fuse_depth,
+                 bool fuse_prologue) {
     // setup the group map.
     auto graph = IndexedForwardGraph::Create(&arena_, body);
-    auto groups = GraphPartitioner(&arena_, fuse_opt_level, max_fuse_depth).Partition(graph);
+    auto groups =
+        GraphPartitioner(&arena_, fuse_opt_level, max_fuse_depth, fuse_prologue).Partition(graph);
     for (size_t nid = 0; nid < graph.post_dfs_order.size(); ++nid) {
       CHECK(graph.post_dfs_order[nid]->ref != nullptr);
       gmap_[graph.post_dfs_order[nid]->ref] = groups[nid];
     }
     // The following line can be used for debug.
     // this->DebugDumpGroup(body);
+    // Mutate the roots of the groups in post order first. The inputs of a group are then
+    // memoized when it is mutated, so the recursion is bounded by the size of a group instead of
+    // the depth of the graph, and the parameters are allocated in the same order as before.
+    for (size_t nid = 0; nid < graph.post_dfs_order.size(); ++nid) {
+      const tvm::Object* ref = graph.post_dfs_order[nid]->ref;
+      if (groups[nid]->FindRoot()->root_ref == ref) {
+        this->Mutate(GetRef<Expr>(static_cast<const ExprNode*>(ref)));
+      }
+    }
     return this->Mutate(body);
   }
 
@@ -957,8 +999,9 @@ class FuseMutator : private ExprMutator {
   }
 };
 
-Expr FuseOps(const Expr& expr, int fuse_opt_level, size_t max_fuse_depth, const IRModule& module) {
-  return FuseMutator().Transform(expr, fuse_opt_level, max_fuse_depth);
+Expr FuseOps(const Expr& expr, int fuse_opt_level, size_t max_fuse_depth, bool fuse_prologue,
+             const IRModule& module) {
+  return FuseMutator().Transform(expr, fuse_opt_level, max_fuse_depth, fuse_prologue);
 }
 
 namespace transform {
@@ -968,7 +1011,10 @@ Pass FuseOps(int fuse_opt_level) {
       [=](Function f, IRModule m, PassContext pc) {
         int opt_level = fuse_opt_level == -1 ? pc->opt_level : fuse_opt_level;
         auto max_fuse_depth = pc->GetConfig("relay.FuseOps.max_depth", Integer(kMaxFusedOps));
-        return Downcast<Function>(FuseOps(f, opt_level, max_fuse_depth.value(), m));
+        bool fuse_prologue =
+            pc->GetConfig<Bool>("relay.FuseOps.fuse_prologue", Bool(false)).value();
+        return Downcast<Function>(
+            FuseOps(f, opt_level, max_fuse_depth.value(), fuse_prologue, m));
       };
   return CreateFunctionPass(pass_func, 1, "FuseOps", {"InferType"});
 }
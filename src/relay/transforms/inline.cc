@@ -53,6 +53,20 @@ class Inliner : ExprMutator {
   explicit Inliner(CallGraphEntry* cur_node, CallGraphNode* call_graph)
       : cur_node_(cur_node), call_graph_(call_graph) {}
 
+  Expr VisitExpr(const Expr& expr) final {
+    // Mutate the dataflow inputs first in post order, so that the recursion does not grow with
+    // the depth of the dataflow. The global vars are skipped, the callees of the inlined calls
+    // must not be visited.
+    if (!memo_.count(expr)) {
+      auto fcheck_visited = [this](const Expr& e) {
+        return memo_.count(e) != 0 || e.as<GlobalVarNode>() != nullptr;
+      };
+      auto fvisit_leaf = [this](const Expr& e) { ExprMutator::VisitExpr(e); };
+      ExpandDataflow(expr, fcheck_visited, fvisit_leaf);
+    }
+    return ExprMutator::VisitExpr(expr);
+  }
+
   Expr VisitExpr_(const CallNode* call_node) final {
     Expr op = call_node->op;
     const auto* gvn = op.as<GlobalVarNode>();
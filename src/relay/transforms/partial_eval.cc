@@ -97,6 +97,11 @@
 #include <tvm/relay/pattern_functor.h>
 #include <tvm/relay/transform.h>
 
+#include <list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "let_list.h"
 #include "pass_util.h"
 
@@ -588,15 +593,54 @@ Function AsFunc(const Expr& e) {
   }
 }
 
+/*! \brief Visit a let chain in a loop, in the order of ExprVisitor. */
+void VisitLetChain(ExprVisitor* v, const LetNode* op) {
+  Expr body = GetRef<Expr>(op);
+  while (const auto* let = body.as<LetNode>()) {
+    v->VisitExpr(let->var);
+    v->VisitExpr(let->value);
+    body = let->body;
+  }
+  v->VisitExpr(body);
+}
+
+/*! \brief Mutate a let chain in a loop, in the order of ExprMutator. */
+Expr MutateLetChain(ExprMutator* m, const LetNode* op) {
+  std::vector<std::tuple<const LetNode*, Var, Expr>> bindings;
+  Expr body = GetRef<Expr>(op);
+  while (const auto* let = body.as<LetNode>()) {
+    Var var = Downcast<Var>(m->Mutate(let->var));
+    bindings.emplace_back(let, var, m->Mutate(let->value));
+    body = let->body;
+  }
+  Expr ret = m->Mutate(body);
+  for (auto it = bindings.rbegin(); it != bindings.rend(); ++it) {
+    const LetNode* let = std::get<0>(*it);
+    const Var& var = std::get<1>(*it);
+    const Expr& value = std::get<2>(*it);
+    if (var.same_as(let->var) && value.same_as(let->value) && ret.same_as(let->body)) {
+      ret = GetRef<Expr>(let);
+    } else {
+      ret = Let(var, value, ret);
+    }
+  }
+  return ret;
+}
+
 class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>,
                          public PatternFunctor<MatchStatus(const Pattern&, const PStatic&)> {
  public:
   PartialEvaluator(const IRModule& mod) : mod_(mod) {}
 
   PStatic VisitExpr(const Expr& e, LetList* ll) final {
-    PStatic ret = ExprFunctor<PStatic(const Expr&, LetList*)>::VisitExpr(e, ll);
-    CHECK(IsAtomic(ret->dynamic)) << ret->dynamic;
-    return ret;
+    if (!inputs_.empty()) {
+      // An input of the dataflow expression evaluated by VisitDataflow, evaluated ahead of it.
+      CHECK(inputs_.back().first.same_as(e));
+      PStatic ret = inputs_.back().second;
+      inputs_.pop_back();
+      return ret;
+    }
+    return DataflowInputs(e) ? VisitDataflow(e, ll) : Dispatch(e, ll);
   }
 
   PStatic VisitExpr(const Expr& e, LetList* ll, const Var& name) {
@@ -662,8 +706,12 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
   }
 
   PStatic VisitExpr_(const LetNode* op, LetList* ll) final {
-    env_.Insert(op->var, VisitExpr(op->value, ll, op->var));
-    return VisitExpr(op->body, ll);
+    Expr body = GetRef<Expr>(op);
+    while (const auto* let = body.as<LetNode>()) {
+      env_.Insert(let->var, VisitExpr(let->value, ll, let->var));
+      body = let->body;
+    }
+    return VisitExpr(body, ll);
   }
 
   PStatic VisitExpr_(const IfNode* op, LetList* ll) final {
@@ -1048,8 +1096,79 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
     }
   }
 
+  PStatic Dispatch(const Expr& e, LetList* ll) {
+    PStatic ret = ExprFunctor<PStatic(const Expr&, LetList*)>::VisitExpr(e, ll);
+    CHECK(IsAtomic(ret->dynamic)) << ret->dynamic;
+    return ret;
+  }
+
+  /*!
+   * \brief Get the inputs of a dataflow expression, in the order VisitExpr_ visits them.
+   * \return Whether the expression is a dataflow expression.
+   */
+  static bool DataflowInputs(const Expr& e, std::vector<Expr>* inputs = nullptr) {
+    std::vector<Expr> ret;
+    if (const auto* call = e.as<CallNode>()) {
+      if (call->op == with_funcid_op) {
+        ret = {call->args[0]};
+      } else {
+        ret = {call->op};
+        for (const Expr& arg : call->args) {
+          ret.push_back(arg);
+        }
+      }
+    } else if (const auto* tuple = e.as<TupleNode>()) {
+      for (const Expr& field : tuple->fields) {
+        ret.push_back(field);
+      }
+    } else if (const auto* get = e.as<TupleGetItemNode>()) {
+      ret = {get->tuple};
+    } else {
+      return false;
+    }
+    if (inputs) {
+      *inputs = std::move(ret);
+    }
+    return true;
+  }
+
+  /*!
+   * \brief Evaluate a dataflow expression without recursing on its dataflow inputs.
+   *
+   * The inputs are evaluated in post order with a stack, in the order of VisitExpr_.
+   * Then their values are handed to the VisitExpr calls of their consumer through inputs_.
+   */
+  PStatic VisitDataflow(const Expr& e, LetList* ll) {
+    std::vector<std::pair<Expr, bool>> stack = {{e, false}};
+    std::vector<PStatic> values;
+    while (!stack.empty()) {
+      Expr expr = stack.back().first;
+      std::vector<Expr> inputs;
+      if (!DataflowInputs(expr, &inputs)) {
+        stack.pop_back();
+        values.push_back(Dispatch(expr, ll));
+      } else if (!stack.back().second) {
+        stack.back().second = true;
+        for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+          stack.push_back({*it, false});
+        }
+      } else {
+        stack.pop_back();
+        CHECK(inputs_.empty());
+        for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+          inputs_.push_back({*it, values.back()});
+          values.pop_back();
+        }
+        values.push_back(Dispatch(expr, ll));
+        CHECK(inputs_.empty());
+      }
+    }
+    CHECK_EQ(values.size(), 1);
+    return values.back();
+  }
+
   void InitializeFuncId(const Expr& e) {
-    struct InitializeFuncIdVisitor : ExprVisitor, PatternVisitor {
+    struct InitializeFuncIdVisitor : MixedModeVisitor, PatternVisitor {
       PartialEvaluator* pe;
       explicit InitializeFuncIdVisitor(PartialEvaluator* pe) : pe(pe) {}
 
@@ -1060,13 +1179,15 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
         VisitExpr(f->body);
       }
 
+      void VisitExpr_(const LetNode* op) final { VisitLetChain(this, op); }
+
       void VisitPattern(const Pattern& p) final { PatternVisitor::VisitPattern(p); }
     };
     InitializeFuncIdVisitor(this).VisitExpr(e);
   }
 
   Expr RegisterFuncId(const Expr& e) {
-    struct RegisterFuncIdVisitor : ExprVisitor, PatternVisitor {
+    struct RegisterFuncIdVisitor : MixedModeVisitor, PatternVisitor {
       PartialEvaluator* pe;
       explicit RegisterFuncIdVisitor(PartialEvaluator* pe) : pe(pe) {}
 
@@ -1082,7 +1203,7 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
           }
           pe->func_map_.insert({f, fid});
         }
-        ExprVisitor::VisitExpr_(op);
+        MixedModeVisitor::VisitExpr_(op);
       }
 
       void VisitExpr_(const FunctionNode* op) final {
@@ -1091,6 +1212,8 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
         ExprVisitor::VisitExpr_(op);
       }
 
+      void VisitExpr_(const LetNode* op) final { VisitLetChain(this, op); }
+
       void VisitPattern(const Pattern& p) final { PatternVisitor::VisitPattern(p); }
     };
     RegisterFuncIdVisitor(this).VisitExpr(e);
@@ -1098,7 +1221,7 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
   }
 
   Expr AnnotateFuncId(const Expr& e) {
-    struct AnnotateFuncIdMutator : ExprMutator, PatternMutator {
+    struct AnnotateFuncIdMutator : MixedModeMutator, PatternMutator {
       PartialEvaluator* pe;
       explicit AnnotateFuncIdMutator(PartialEvaluator* pe) : pe(pe) {}
 
@@ -1108,6 +1231,8 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
         return MkWithFuncId(ExprMutator::VisitExpr_(op), pe->func_map_.at(f));
       }
 
+      Expr VisitExpr_(const LetNode* op) final { return MutateLetChain(this, op); }
+
       Pattern VisitPattern(const Pattern& p) final { return PatternMutator::VisitPattern(p); }
 
       Var VisitVar(const Var& v) final { return v; }
@@ -1136,13 +1261,15 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
   std::unordered_map<Function, FuncId, ObjectPtrHash, ObjectPtrEqual> func_map_;
   std::unordered_map<FuncId, Fuel> fuel_map_;
   Store store_;
+  /*! \brief The values of the inputs of the dataflow expression being evaluated, see VisitExpr. */
+  std::vector<std::pair<Expr, PStatic>> inputs_;
   DLContext context_ = CPUContext();
   FInterpreter executor_ = CPUInterpreter();
 };
 
 /*! \brief Remap multiple Var sharing the same Id into the same Var. */
 Expr Remap(const Expr& e) {
-  class RemapMutator : public ExprMutator, public PatternMutator {
+  class RemapMutator : public MixedModeMutator, public PatternMutator {
     Expr VisitExpr_(const VarNode* op) final {
       Var v = GetRef<Var>(op);
       if (remap_.count(v) == 0) {
@@ -1153,6 +1280,8 @@ Expr Remap(const Expr& e) {
 
     Var VisitVar(const Var& v) final { return Downcast<Var>(VisitExpr(v)); }
 
+    Expr VisitExpr_(const LetNode* op) final { return MutateLetChain(this, op); }
+
    private:
     std::unordered_map<Var, Var, VarHash, VarEqual> remap_;
   };
@@ -1160,16 +1289,18 @@ Expr Remap(const Expr& e) {
 }
 
 Expr StripWithFuncId(const Expr& e) {
-  struct StripWithFuncIdMutator : ExprMutator, PatternMutator {
-    Expr VisitExpr_(const CallNode* op) final {
-      if (op->op == with_funcid_op) {
-        CHECK_EQ(op->args.size(), 1);
-        return VisitExpr(op->args[0]);
+  struct StripWithFuncIdMutator : MixedModeMutator, PatternMutator {
+    Expr Rewrite_(const CallNode* pre, const Expr& post) final {
+      if (pre->op == with_funcid_op) {
+        CHECK_EQ(pre->args.size(), 1);
+        return post.as<CallNode>()->args[0];
       } else {
-        return ExprMutator::VisitExpr_(op);
+        return post;
       }
     }
 
+    Expr VisitExpr_(const LetNode* op) final { return MutateLetChain(this, op); }
+
     Pattern VisitPattern(const Pattern& p) final { return PatternMutator::VisitPattern(p); }
 
     Var VisitVar(const Var& v) final { return v; }
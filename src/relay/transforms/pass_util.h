@@ -251,6 +251,8 @@ class Fill : ExprFunctor<Expr(const Expr&, const Var&)> {
 
   Expr VisitExpr(const Expr& e, const Var& v) final;
   Expr VisitExpr(const Expr& e);
+  // Fill the dataflow inputs of e that are not filled yet, without recursion.
+  void VisitDataflowInputs(const Expr& e);
 
   Expr Atomic(const Expr& e, const Var& v);
   // Bind expression `now` to var `v` if the original expression is in the include set, or if
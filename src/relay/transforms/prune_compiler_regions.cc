@@ -0,0 +1,369 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * \file src/relay/transforms/prune_compiler_regions.cc
+ *
+ * \brief After the compiler regions have been merged, this pass estimates the
+ * cost of running every region on its target, including the data transfers
+ * at the region boundaries, against the cost of running it on the host. The
+ * regions that are too small or not profitable fall back to the host, so that
+ * a few unsupported ops in the middle of a graph do not split it into many
+ * tiny external functions with host round trips in between.
+ *
+ * Like merge_compiler_regions, this pass only changes the annotations.
+ * partition_graph must subsequently be called to lift the remaining regions
+ * out as external functions.
+ */
+
+#include <tvm/relay/analysis.h>
+#include <tvm/relay/attrs/annotation.h>
+#include <tvm/relay/expr.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../analysis/annotated_region_set.h"
+#include "pass_util.h"
+
+namespace tvm {
+namespace relay {
+namespace prune_compiler_regions {
+
+using FMacCount = runtime::TypedPackedFunc<int64_t(const Call& call_node)>;
+
+/*!
+ * \brief The cost model used to decide whether a compiler region is offloaded. The costs are
+ * in an arbitrary unit shared by the ops and the transfers, the default estimates count MACs.
+ */
+class RegionCostModelNode : public Object {
+ public:
+  /*!
+   * \brief Estimate the costs of an op: (call, target) -> [host cost, target cost], where the
+   *  call is an op call or a call to a composite function. It can be null or return null for
+   *  the default estimate, which is the MAC count, or the number of output elements for the ops
+   *  without MACs, on the host divided by target_speedup on the target.
+   */
+  PackedFunc op_cost;
+  /*! \brief How many times a target runs an op faster than the host in the default estimate. */
+  double target_speedup;
+  /*! \brief The fixed cost of every tensor moved between the host and a target. */
+  double transfer_latency;
+  /*! \brief The cost of every byte moved between the host and a target. */
+  double transfer_cost_per_byte;
+  /*! \brief The smallest number of ops of a region to offload. */
+  int min_region_size;
+
+  void VisitAttrs(AttrVisitor* v) {
+    v->Visit("target_speedup", &target_speedup);
+    v->Visit("transfer_latency", &transfer_latency);
+    v->Visit("transfer_cost_per_byte", &transfer_cost_per_byte);
+    v->Visit("min_region_size", &min_region_size);
+  }
+
+  static constexpr const char* _type_key = "relay.transform.RegionCostModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(RegionCostModelNode, Object);
+};
+
+class RegionCostModel : public ObjectRef {
+ public:
+  RegionCostModel(PackedFunc op_cost, double target_speedup, double transfer_latency,
+                  double transfer_cost_per_byte, int min_region_size) {
+    CHECK_GT(target_speedup, 0) << "The target speedup should be positive";
+    auto n = make_object<RegionCostModelNode>();
+    n->op_cost = std::move(op_cost);
+    n->target_speedup = target_speedup;
+    n->transfer_latency = transfer_latency;
+    n->transfer_cost_per_byte = transfer_cost_per_byte;
+    n->min_region_size = min_region_size;
+    data_ = std::move(n);
+  }
+
+  TVM_DEFINE_OBJECT_REF_METHODS(RegionCostModel, ObjectRef, RegionCostModelNode);
+};
+
+/*! \brief The estimate of a compiler region, which is the partition report of the region. */
+class CompilerRegionEstimateNode : public Object {
+ public:
+  /*! \brief The region ID. */
+  int region_id;
+  /*! \brief The target of the region. */
+  String target;
+  /*! \brief The number of ops in the region, a composite function counts as one op. */
+  int num_ops;
+  /*! \brief The cost of running the ops on the host. */
+  double host_cost;
+  /*! \brief The cost of running the ops on the target, excluding the transfers. */
+  double target_cost;
+  /*! \brief The number of tensors moved between the host and the target per run. */
+  int num_transfers;
+  /*! \brief The number of bytes moved between the host and the target per run. */
+  int64_t transfer_bytes;
+  /*! \brief The cost of the transfers. */
+  double transfer_cost;
+  /*! \brief Whether the region is kept on the target. */
+  bool offload;
+
+  void VisitAttrs(AttrVisitor* v) {
+    v->Visit("region_id", &region_id);
+    v->Visit("target", &target);
+    v->Visit("num_ops", &num_ops);
+    v->Visit("host_cost", &host_cost);
+    v->Visit("target_cost", &target_cost);
+    v->Visit("num_transfers", &num_transfers);
+    v->Visit("transfer_bytes", &transfer_bytes);
+    v->Visit("transfer_cost", &transfer_cost);
+    v->Visit("offload", &offload);
+  }
+
+  static constexpr const char* _type_key = "relay.CompilerRegionEstimate";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CompilerRegionEstimateNode, Object);
+};
+
+class CompilerRegionEstimate : public ObjectRef {
+ public:
+  TVM_DEFINE_OBJECT_REF_METHODS(CompilerRegionEstimate, ObjectRef, CompilerRegionEstimateNode);
+};
+
+/*! \brief The number of elements and bytes of the tensors in a type. */
+std::pair<int64_t, int64_t> TypeSize(const Type& type) {
+  int64_t elems = 0, bytes = 0;
+  if (const auto* tt = type.as<TensorTypeNode>()) {
+    elems = 1;
+    for (const auto& dim : tt->shape) {
+      const auto* imm = dim.as<IntImmNode>();
+      // Dynamic dimensions are counted as 1.
+      elems *= imm ? imm->value : 1;
+    }
+    bytes = elems * ((tt->dtype.bits() * tt->dtype.lanes() + 7) / 8);
+  } else if (const auto* tuple = type.as<TupleTypeNode>()) {
+    for (const auto& field : tuple->fields) {
+      auto size = TypeSize(field);
+      elems += size.first;
+      bytes += size.second;
+    }
+  }
+  return {elems, bytes};
+}
+
+double AsDouble(const PrimExpr& value) {
+  if (const auto* imm = value.as<FloatImmNode>()) {
+    return imm->value;
+  }
+  const auto* imm = value.as<IntImmNode>();
+  CHECK(imm) << "The op cost should be numbers";
+  return static_cast<double>(imm->value);
+}
+
+class RegionEstimator {
+ public:
+  explicit RegionEstimator(RegionCostModel model) : model_(std::move(model)) {}
+
+  /*! \brief Estimate the regions of all targets but "default", ordered by the region ID. */
+  Array<CompilerRegionEstimate> Estimate(const AnnotatedRegionSet& regions) const {
+    std::vector<CompilerRegionEstimate> estimates;
+    for (const auto& region : regions) {
+      if (region->GetTarget() != "default") {
+        estimates.push_back(Estimate(region));
+      }
+    }
+    std::sort(estimates.begin(), estimates.end(),
+              [](const CompilerRegionEstimate& a, const CompilerRegionEstimate& b) {
+                return a->region_id < b->region_id;
+              });
+    return Array<CompilerRegionEstimate>(estimates.begin(), estimates.end());
+  }
+
+ private:
+  CompilerRegionEstimate Estimate(const AnnotatedRegion& region) const {
+    auto n = make_object<CompilerRegionEstimateNode>();
+    n->region_id = region->GetID();
+    n->target = region->GetTarget();
+    n->num_ops = 0;
+    n->host_cost = 0;
+    n->target_cost = 0;
+    for (const auto& node : region->GetNodes()) {
+      const auto* call = node.as<CallNode>();
+      if (call == nullptr || call->op == CompilerBeginOp() || call->op == CompilerEndOp()) {
+        continue;
+      }
+      if (!call->op->IsInstance<OpNode>() && !IsComposite(call->op)) {
+        continue;
+      }
+      double host_cost, target_cost;
+      std::tie(host_cost, target_cost) = OpCost(GetRef<Call>(call), n->target);
+      n->num_ops++;
+      n->host_cost += host_cost;
+      n->target_cost += target_cost;
+    }
+
+    // Every distinct non-constant input and every output is moved once per run.
+    n->num_transfers = 0;
+    n->transfer_bytes = 0;
+    std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual> inputs;
+    for (const auto& input : region->GetInputs()) {
+      Expr arg = Downcast<Call>(input)->args[0];
+      if (arg->IsInstance<ConstantNode>() || !inputs.insert(arg).second) {
+        continue;
+      }
+      n->num_transfers++;
+      n->transfer_bytes += TypeSize(arg->checked_type()).second;
+    }
+    for (const auto& output : region->GetOutputs()) {
+      n->num_transfers++;
+      n->transfer_bytes += TypeSize(output->checked_type()).second;
+    }
+    n->transfer_cost = n->num_transfers * model_->transfer_latency +
+                       n->transfer_bytes * model_->transfer_cost_per_byte;
+    n->offload = n->num_ops >= model_->min_region_size &&
+                 n->target_cost + n->transfer_cost < n->host_cost;
+    return CompilerRegionEstimate(n);
+  }
+
+  static bool IsComposite(const Expr& op) {
+    const auto* func = op.as<FunctionNode>();
+    return func && func->GetAttr<String>(attr::kComposite).defined();
+  }
+
+  std::pair<double, double> OpCost(const Call& call, const String& target) const {
+    if (model_->op_cost != nullptr) {
+      TVMRetValue ret = model_->op_cost(call, target);
+      if (ret.type_code() != kTVMNullptr) {
+        Array<PrimExpr> costs = ret;
+        CHECK_EQ(costs.size(), 2U) << "The op cost should be [host cost, target cost]";
+        return {AsDouble(costs[0]), AsDouble(costs[1])};
+      }
+    }
+    double host_cost = DefaultHostCost(call);
+    return {host_cost, host_cost / model_->target_speedup};
+  }
+
+  static double DefaultHostCost(const Call& call) {
+    static const auto& fmac_count = Op::GetAttrMap<FMacCount>("FMacCount");
+    if (const auto* func = call->op.as<FunctionNode>()) {
+      // A composite function costs as much as the ops in it.
+      double cost = 0;
+      PostOrderVisit(func->body, [&cost](const Expr& expr) {
+        const auto* inner = expr.as<CallNode>();
+        if (inner && inner->op->IsInstance<OpNode>()) {
+          cost += DefaultHostCost(GetRef<Call>(inner));
+        }
+      });
+      return cost;
+    }
+    Op op = Downcast<Op>(call->op);
+    if (fmac_count.count(op)) {
+      int64_t macs = fmac_count[op](call);
+      if (macs > 0) {
+        return static_cast<double>(macs);
+      }
+    }
+    return static_cast<double>(TypeSize(call->checked_type()).first);
+  }
+
+  RegionCostModel model_;
+};
+
+/*! \brief Retarget the annotations of the pruned regions to "default". */
+class RegionPruner : public ExprRewriter {
+ public:
+  RegionPruner(AnnotatedRegionSet regions, std::unordered_set<int> pruned)
+      : regions_(std::move(regions)), pruned_(std::move(pruned)) {}
+
+  Expr Rewrite_(const CallNode* call, const Expr& post) final {
+    if (call->op != CompilerBeginOp() && call->op != CompilerEndOp()) {
+      return post;
+    }
+    auto region = regions_->GetRegion(GetRef<Call>(call));
+    if (!region.defined() || pruned_.find(region->GetID()) == pruned_.end()) {
+      return post;
+    }
+    auto attrs = make_object<CompilerAttrs>();
+    attrs->compiler = "default";
+    const auto* post_call = post.as<CallNode>();
+    return Call(post_call->op, post_call->args, Attrs(attrs), post_call->type_args);
+  }
+
+ private:
+  AnnotatedRegionSet regions_;
+  std::unordered_set<int> pruned_;
+};
+
+Array<CompilerRegionEstimate> EstimateCompilerRegions(const Expr& expr,
+                                                      const RegionCostModel& model) {
+  AnnotatedRegionSet regions = AnnotatedRegionSet::Create(expr, CompilerBeginOp(), CompilerEndOp());
+  return RegionEstimator(model).Estimate(regions);
+}
+
+Expr PruneCompilerRegions(const Expr& expr, const RegionCostModel& model) {
+  AnnotatedRegionSet regions = AnnotatedRegionSet::Create(expr, CompilerBeginOp(), CompilerEndOp());
+  std::unordered_set<int> pruned;
+  for (const auto& estimate : RegionEstimator(model).Estimate(regions)) {
+    if (!estimate->offload) {
+      pruned.insert(estimate->region_id);
+    }
+  }
+  if (pruned.empty()) {
+    return expr;
+  }
+  RegionPruner pruner(regions, std::move(pruned));
+  return PostOrderRewrite(expr, &pruner);
+}
+
+TVM_REGISTER_NODE_TYPE(RegionCostModelNode);
+TVM_REGISTER_NODE_TYPE(CompilerRegionEstimateNode);
+
+TVM_REGISTER_GLOBAL("relay._transform.RegionCostModel")
+    .set_body_typed([](PackedFunc op_cost, double target_speedup, double transfer_latency,
+                       double transfer_cost_per_byte, int min_region_size) {
+      return RegionCostModel(op_cost, target_speedup, transfer_latency, transfer_cost_per_byte,
+                             min_region_size);
+    });
+
+TVM_REGISTER_GLOBAL("relay.analysis.EstimateCompilerRegions")
+    .set_body_typed(EstimateCompilerRegions);
+
+}  // namespace prune_compiler_regions
+
+namespace transform {
+
+Pass PruneCompilerRegions(prune_compiler_regions::RegionCostModel model) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(prune_compiler_regions::PruneCompilerRegions(f, model));
+      };
+  auto pruned = CreateFunctionPass(pass_func, 0, "PruneCompilerRegions", {"InferType"});
+  return Sequential({pruned, InferType()});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.PruneCompilerRegions")
+    .set_body_typed(transform::PruneCompilerRegions);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -122,8 +122,44 @@ Scope Fill::GetSubScope(const Expr& e, size_t i) {
   return node_scope_->at(h->value);
 }
 
+void Fill::VisitDataflowInputs(const Expr& e) {
+  // The inputs are visited in the same order as VisitExpr_ visits them, the arguments of a call
+  // before the callee, so that the bindings are pushed in the same order as by the recursion.
+  std::vector<std::pair<Expr, bool>> stack{{e, false}};
+  auto fpush = [&](const Expr& expr) {
+    if (memo.count(expr) == 0) stack.push_back({expr, false});
+  };
+  while (!stack.empty()) {
+    Expr expr = stack.back().first;
+    if (memo.count(expr) != 0) {
+      stack.pop_back();
+    } else if (stack.back().second) {
+      stack.pop_back();
+      if (!expr.same_as(e)) VisitExpr(expr);
+    } else if (const auto* call = expr.as<CallNode>()) {
+      stack.back().second = true;
+      fpush(call->op);
+      for (auto it = call->args.rbegin(); it != call->args.rend(); ++it) fpush(*it);
+    } else if (const auto* tuple = expr.as<TupleNode>()) {
+      stack.back().second = true;
+      for (auto it = tuple->fields.rbegin(); it != tuple->fields.rend(); ++it) fpush(*it);
+    } else if (const auto* get = expr.as<TupleGetItemNode>()) {
+      stack.back().second = true;
+      fpush(get->tuple);
+    } else {
+      stack.pop_back();
+      if (!expr.same_as(e)) VisitExpr(expr);
+    }
+  }
+}
+
 Expr Fill::VisitExpr(const Expr& e, const Var& v) {
   if (memo.count(e) == 0) {
+    if (e.as<CallNode>() || e.as<TupleNode>() || e.as<TupleGetItemNode>()) {
+      // Fill the dataflow inputs in post order iteratively, so that the recursion does not grow
+      // with the length of the chains of calls.
+      VisitDataflowInputs(e);
+    }
     memo.insert({e, ExprFunctor<Expr(const Expr&, const Var&)>::VisitExpr(e, v)});
   } else if (v.defined()) {
     GetScope(e)->let_list->Push(v, memo.at(e));
@@ -210,10 +246,22 @@ Expr Fill::VisitExpr_(const FunctionNode* f, const Var& v) {
 }
 
 Expr Fill::VisitExpr_(const LetNode* l, const Var& v) {
-  Expr e = GetRef<Expr>(l);
-  VisitExpr(l->value, l->var);
-  Expr ret = GetSubScope(e, 0)->let_list->Get(VisitExpr(l->body));
-  return Compound(e, ret, v);
+  // Fill the let chains iteratively, in the same order as the recursion on their bodies.
+  std::vector<const LetNode*> lets;
+  Expr body = GetRef<Expr>(l);
+  while (const auto* let = body.as<LetNode>()) {
+    if (!lets.empty() && memo.count(body) != 0) break;
+    VisitExpr(let->value, let->var);
+    lets.push_back(let);
+    body = let->body;
+  }
+  Expr ret = VisitExpr(body);
+  for (size_t i = lets.size(); i-- > 0;) {
+    Expr e = GetRef<Expr>(lets[i]);
+    ret = Compound(e, GetSubScope(e, 0)->let_list->Get(ret), i == 0 ? v : Var());
+    if (i > 0) memo.insert({e, ret});
+  }
+  return ret;
 }
 
 Expr Fill::VisitExpr_(const ConstantNode* c, const Var& v) {
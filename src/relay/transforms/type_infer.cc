@@ -44,6 +44,9 @@
 #include <tvm/relay/pattern_functor.h>
 #include <tvm/relay/transform.h>
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "../analysis/type_solver.h"
 #include "pass_util.h"
 
@@ -75,6 +78,56 @@ bool TupleGetItemRel(const Array<Type>& types, int num_inputs, const Attrs& attr
 TVM_REGISTER_NODE_TYPE(TupleGetItemAttrs);
 TVM_REGISTER_GLOBAL("tvm.relay.type_relation.TupleGetItem").set_body_typed(TupleGetItemRel);
 
+struct InferTypeConfigNode : public tvm::AttrsNode<InferTypeConfigNode> {
+  bool incremental;
+
+  TVM_DECLARE_ATTRS(InferTypeConfigNode, "relay.transform.InferTypeConfig") {
+    TVM_ATTR_FIELD(incremental)
+        .describe(
+            "Whether to reuse the checked types of the dataflow subgraphs that are unchanged "
+            "since the last inference instead of solving their constraints again")
+        .set_default(false);
+  }
+};
+
+class InferTypeConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(InferTypeConfig, Attrs, InferTypeConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(InferTypeConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.InferType", InferTypeConfig);
+
+bool IsIncrementalTypeInference() {
+  auto cfg = transform::PassContext::Current()->GetConfig<InferTypeConfig>(
+      "relay.InferType", AttrsWithDefaultValues<InferTypeConfig>());
+  return cfg.value()->incremental;
+}
+
+/*!
+ * \brief Check whether a type is made of tensor and tuple types only, i.e., it contains
+ *  neither incomplete types nor type variables to be solved.
+ */
+class ConcreteTypeChecker : public TypeVisitor {
+ public:
+  bool Check(const Type& t) {
+    concrete_ = true;
+    VisitType(t);
+    return concrete_;
+  }
+
+  void VisitType(const Type& t) final {
+    if (concrete_ && (t.as<TensorTypeNode>() || t.as<TupleTypeNode>())) {
+      TypeVisitor::VisitType(t);
+    } else {
+      concrete_ = false;
+    }
+  }
+
+ private:
+  bool concrete_{true};
+};
+
 struct ResolvedTypeInfo {
   explicit ResolvedTypeInfo(Type checked_type, Array<Type> type_args)
       : checked_type(checked_type), type_args(type_args) {}
@@ -98,9 +151,10 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
  public:
   // constructors
 
-  explicit TypeInferencer(IRModule mod, GlobalVar current_func)
+  explicit TypeInferencer(IRModule mod, GlobalVar current_func, bool incremental = false)
       : mod_(mod),
         current_func_(current_func),
+        incremental_(incremental),
         err_reporter(),
         solver_(current_func, mod, &this->err_reporter) {
     CHECK(mod.defined()) << "internal error: Module must be set in the type inferencer";
@@ -118,6 +172,17 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
   // The current function being type checked.
   GlobalVar current_func_;
 
+  // Whether to reuse the checked types of the unchanged subgraphs.
+  bool incremental_;
+
+  // The roots of the subgraphs whose checked types are reused.
+  std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual> reused_;
+
+  // Memoized results of IsReusable.
+  std::unordered_map<Expr, bool, ObjectPtrHash, ObjectPtrEqual> reusable_memo_;
+
+  ConcreteTypeChecker concrete_checker_;
+
   // The error reporter.
   ErrorReporter err_reporter;
 
@@ -150,6 +215,29 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
     if (it != type_map_.end() && it->second.checked_type.defined()) {
       return it->second.checked_type;
     }
+    if (expr.as<CallNode>() || expr.as<TupleNode>() || expr.as<TupleGetItemNode>()) {
+      // Populate the dataflow nodes in post order iteratively, so that the recursion does not
+      // grow with the length of the chains of calls.
+      auto fcheck_visited = [this](const Expr& e) {
+        // The types of the called ops are taken by PrimitiveCall directly.
+        if (e.as<OpNode>()) return true;
+        auto it = type_map_.find(e);
+        return it != type_map_.end() && it->second.checked_type.defined();
+      };
+      auto fvisit_leaf = [this](const Expr& e) { PopulateType(e); };
+      ExpandDataflow(expr, fcheck_visited, fvisit_leaf);
+      return type_map_.at(expr).checked_type;
+    }
+    return PopulateType(expr);
+  }
+
+  // Populate the type of expr, whose dataflow inputs may have been populated already.
+  Type PopulateType(const Expr& expr) {
+    if (incremental_ && IsReusable(expr)) {
+      reused_.insert(expr);
+      type_map_[expr].checked_type = expr->checked_type_;
+      return expr->checked_type_;
+    }
     Type ret = this->VisitExpr(expr);
     CHECK(ret.defined());
     KindCheck(ret, mod_);
@@ -158,6 +246,38 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
     return ret;
   }
 
+  // Check whether the checked type of expr from the last inference is still valid, so that its
+  // constraints need not be solved again. As expressions are immutable, this holds for a
+  // dataflow subgraph of operator calls whose nodes all have concrete checked types, as long as
+  // the types of its free variables are fixed by their annotations. Anything else, including
+  // calls to global functions whose signatures may have changed, is inferred from scratch.
+  bool IsReusable(const Expr& expr) {
+    auto it = reusable_memo_.find(expr);
+    if (it != reusable_memo_.end()) {
+      return it->second;
+    }
+    bool reusable = false;
+    if (expr->checked_type_.defined() && concrete_checker_.Check(expr->checked_type_)) {
+      if (const auto* var = expr.as<VarNode>()) {
+        reusable = var->type_annotation.defined() &&
+                   StructuralEqual()(var->type_annotation, expr->checked_type_);
+      } else if (expr.as<ConstantNode>()) {
+        reusable = true;
+      } else if (const auto* call = expr.as<CallNode>()) {
+        reusable = call->op.as<OpNode>() != nullptr &&
+                   std::all_of(call->args.begin(), call->args.end(),
+                               [this](const Expr& arg) { return IsReusable(arg); });
+      } else if (const auto* tuple = expr.as<TupleNode>()) {
+        reusable = std::all_of(tuple->fields.begin(), tuple->fields.end(),
+                               [this](const Expr& field) { return IsReusable(field); });
+      } else if (const auto* get = expr.as<TupleGetItemNode>()) {
+        reusable = IsReusable(get->tuple);
+      }
+    }
+    reusable_memo_[expr] = reusable;
+    return reusable;
+  }
+
   void ReportFatalError(const ObjectRef& expr, const Error& err) {
     CHECK(this->current_func_.defined());
     this->err_reporter.ReportAt(this->current_func_, expr, err);
@@ -557,8 +677,28 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
 class TypeInferencer::Resolver : public ExprMutator, PatternMutator {
  public:
   Resolver(const std::unordered_map<Expr, ResolvedTypeInfo, ObjectPtrHash, ObjectPtrEqual>& tmap,
+           const std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual>& reused,
            TypeSolver* solver)
-      : tmap_(tmap), solver_(solver) {}
+      : tmap_(tmap), reused_(reused), solver_(solver) {}
+
+  Expr VisitExpr(const Expr& expr) final {
+    // The reused subgraphs already carry their checked types.
+    if (reused_.count(expr)) {
+      return expr;
+    }
+    if (!memo_.count(expr) &&
+        (expr.as<CallNode>() || expr.as<TupleNode>() || expr.as<TupleGetItemNode>())) {
+      // Resolve the dataflow nodes in post order iteratively, so that the recursion does not
+      // grow with the length of the chains of calls.
+      auto fcheck_visited = [this](const Expr& e) { return memo_.count(e) || reused_.count(e); };
+      auto fvisit_leaf = [this](const Expr& e) {
+        if (!reused_.count(e)) ExprMutator::VisitExpr(e);
+      };
+      ExpandDataflow(expr, fcheck_visited, fvisit_leaf);
+      return memo_.at(expr);
+    }
+    return ExprMutator::VisitExpr(expr);
+  }
 
   Expr VisitExpr_(const VarNode* op) final { return VisitVar(GetRef<Var>(op)); }
 
@@ -680,6 +820,7 @@ class TypeInferencer::Resolver : public ExprMutator, PatternMutator {
  private:
   std::unordered_map<Var, Var, ObjectPtrHash, ObjectPtrEqual> vmap_;
   const std::unordered_map<Expr, ResolvedTypeInfo, ObjectPtrHash, ObjectPtrEqual>& tmap_;
+  const std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual>& reused_;
   TypeSolver* solver_;
   // whether attach the checked type as type_annotation
   // if original type anntation is missing.
@@ -694,7 +835,7 @@ Expr TypeInferencer::Infer(Expr expr) {
   Solve();
 
   // Step 3: Attach resolved types to checked_type field.
-  auto resolved_expr = Resolver(type_map_, &solver_).VisitExpr(expr);
+  auto resolved_expr = Resolver(type_map_, reused_, &solver_).VisitExpr(expr);
   CHECK(WellFormed(resolved_expr));
   return resolved_expr;
 }
@@ -719,7 +860,7 @@ void EnsureCheckedType(const Expr& e) { AllCheckTypePopulated().VisitExpr(e); }
 
 Expr InferType(const Expr& expr, const IRModule& mod) {
   auto main = mod->GetGlobalVar("main");
-  auto inferencer = TypeInferencer(mod, main);
+  auto inferencer = TypeInferencer(mod, main, IsIncrementalTypeInference());
   auto e = inferencer.Infer(expr);
   CHECK(WellFormed(e));
   auto free_tvars = FreeTypeVars(e, mod);
@@ -733,7 +874,7 @@ Function InferType(const Function& func, const IRModule& mod, const GlobalVar& v
   Function func_copy = Function(make_object<FunctionNode>(*func.operator->()));
   func_copy->checked_type_ = func_copy->func_type_annotation();
   mod->AddUnchecked(var, func_copy);
-  Expr func_ret = TypeInferencer(mod, var).Infer(func_copy);
+  Expr func_ret = TypeInferencer(mod, var, IsIncrementalTypeInference()).Infer(func_copy);
   mod->Remove(var);
   CHECK(WellFormed(func_ret));
   auto free_tvars = FreeTypeVars(func_ret, mod);
@@ -0,0 +1,446 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file nms.cc
+ * \brief CPU kernels of the detection post-processing: get_valid_counts, non_max_suppression
+ *  and multibox_transform_loc. They compute the same results as the hybrid script versions in
+ *  topi.vision, but run in parallel over the batches and the classes on the thread pool, keep the
+ *  boxes in the layouts that the compiler vectorizes, and select the top k boxes without sorting
+ *  all of them.
+ */
+#include <dlpack/dlpack.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "parallel_for.h"
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+template <typename DType>
+void GetValidCounts(DLTensor* data, DLTensor* valid_count, DLTensor* out, DLTensor* out_indices,
+                    double score_threshold, int id_index, int score_index) {
+  const int64_t batch_size = data->shape[0];
+  const int64_t num_anchors = data->shape[1];
+  const int64_t box_size = data->shape[2];
+  const DType* data_ptr = static_cast<DType*>(data->data);
+  int32_t* count_ptr = static_cast<int32_t*>(valid_count->data);
+  DType* out_ptr = static_cast<DType*>(out->data);
+  int32_t* indices_ptr = static_cast<int32_t*>(out_indices->data);
+  const DType threshold = static_cast<DType>(score_threshold);
+
+  ParallelFor(0, batch_size, [&](int64_t i) {
+    const DType* batch_data = data_ptr + i * num_anchors * box_size;
+    DType* batch_out = out_ptr + i * num_anchors * box_size;
+    int32_t* batch_indices = indices_ptr + i * num_anchors;
+    int32_t count = 0;
+    for (int64_t j = 0; j < num_anchors; ++j) {
+      const DType* box = batch_data + j * box_size;
+      if (box[score_index] > threshold && (id_index < 0 || box[id_index] >= 0)) {
+        std::copy(box, box + box_size, batch_out + count * box_size);
+        batch_indices[count++] = static_cast<int32_t>(j);
+      }
+    }
+    std::fill(batch_out + count * box_size, batch_out + num_anchors * box_size, DType(-1));
+    std::fill(batch_indices + count, batch_indices + num_anchors, -1);
+    count_ptr[i] = count;
+  });
+}
+
+// Get valid count of bounding boxes given a score threshold,
+// and move the valid boxes to the top of the output.
+TVM_REGISTER_GLOBAL("tvm.contrib.vision.get_valid_counts")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      DLTensor* data = args[0];
+      DLTensor* valid_count = args[1];
+      DLTensor* out = args[2];
+      DLTensor* out_indices = args[3];
+      double score_threshold = args[4];
+      int id_index = args[5];
+      int score_index = args[6];
+      CHECK_EQ(data->ndim, 3) << "get_valid_counts only supports 3-D input";
+      auto data_dtype = DLDataType2String(data->dtype);
+      if (data_dtype == "float32") {
+        GetValidCounts<float>(data, valid_count, out, out_indices, score_threshold, id_index,
+                              score_index);
+      } else if (data_dtype == "float64") {
+        GetValidCounts<double>(data, valid_count, out, out_indices, score_threshold, id_index,
+                               score_index);
+      } else {
+        LOG(FATAL) << "Unsupported input dtype: " << data_dtype;
+      }
+    });
+
+/*! \brief The attributes of non_max_suppression. */
+struct NMSParam {
+  int64_t max_output_size;
+  double iou_threshold;
+  bool force_suppress;
+  int top_k;
+  int coord_start;
+  int score_index;
+  int id_index;
+  bool return_indices;
+  bool invalid_to_bottom;
+};
+
+/*!
+ * \brief The boxes kept by the greedy suppression of a class. They are stored as arrays of the
+ *  coordinates so that the IoU of a box with all of them is computed by a vectorized loop.
+ */
+template <typename DType>
+class KeptBoxes {
+ public:
+  void Add(DType l, DType t, DType r, DType b) {
+    left_.push_back(l);
+    top_.push_back(t);
+    right_.push_back(r);
+    bottom_.push_back(b);
+    area_.push_back((r - l) * (b - t));
+  }
+
+  size_t size() const { return left_.size(); }
+
+  /*! \brief Whether the IoU of the box with any of the kept boxes reaches the threshold. */
+  bool Overlaps(DType l, DType t, DType r, DType b, DType threshold) const {
+    const DType area = (r - l) * (b - t);
+    const size_t num_boxes = left_.size();
+    int overlap = 0;
+    for (size_t k = 0; k < num_boxes; ++k) {
+      DType w = std::max(DType(0), std::min(r, right_[k]) - std::max(l, left_[k]));
+      DType h = std::max(DType(0), std::min(b, bottom_[k]) - std::max(t, top_[k]));
+      DType inter = h * w;
+      DType u = area + area_[k] - inter;
+      DType iou = u <= DType(0) ? DType(0) : inter / u;
+      overlap |= iou >= threshold;
+    }
+    return overlap != 0;
+  }
+
+ private:
+  std::vector<DType> left_, top_, right_, bottom_, area_;
+};
+
+template <typename DType>
+void NonMaxSuppression(DLTensor* data, DLTensor* valid_count, DLTensor* indices,
+                       DLTensor* out_boxes, DLTensor* out_indices, DLTensor* out_count,
+                       const NMSParam& param) {
+  const int64_t batch_size = data->shape[0];
+  const int64_t num_anchors = data->shape[1];
+  const int64_t box_size = data->shape[2];
+  const int64_t batch_stride = num_anchors * box_size;
+  const DType* data_ptr = static_cast<DType*>(data->data);
+  const int32_t* count_ptr = static_cast<int32_t*>(valid_count->data);
+  const int32_t* indices_ptr = static_cast<int32_t*>(indices->data);
+  const DType iou_threshold = static_cast<DType>(param.iou_threshold);
+  const int coord_start = param.coord_start;
+  const int score_index = param.score_index;
+  const int id_index = param.id_index;
+  // Without suppression across the classes, the classes are suppressed independently.
+  const bool per_class = !param.force_suppress && id_index >= 0;
+
+  // The boxes are suppressed in the output buffer, unless the output is rearranged afterwards.
+  std::vector<DType> work_buffer;
+  DType* work_ptr = nullptr;
+  if (out_boxes != nullptr && !param.invalid_to_bottom) {
+    work_ptr = static_cast<DType*>(out_boxes->data);
+  } else {
+    work_buffer.resize(batch_size * batch_stride);
+    work_ptr = work_buffer.data();
+  }
+  std::vector<int32_t> box_indices(batch_size * num_anchors);
+  std::vector<int64_t> num_valid(batch_size);
+  // The candidate boxes of every class of every batch, in the descending order of the scores.
+  std::vector<std::vector<std::vector<int32_t>>> groups(batch_size);
+  std::vector<std::vector<uint8_t>> suppressed(batch_size);
+
+  // Order the valid boxes by score and group the candidates by class.
+  ParallelFor(0, batch_size, [&](int64_t i) {
+    const DType* batch_data = data_ptr + i * batch_stride;
+    DType* work = work_ptr + i * batch_stride;
+    int32_t* batch_indices = box_indices.data() + i * num_anchors;
+    const int64_t n = std::min<int64_t>(std::max(count_ptr[i], 0), num_anchors);
+    num_valid[i] = n;
+    if (param.iou_threshold <= 0) {
+      std::copy(batch_data, batch_data + n * box_size, work);
+      std::iota(batch_indices, batch_indices + n, 0);
+      return;
+    }
+
+    std::vector<int32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    // Ties are broken by the index, which gives the order of a stable sort.
+    auto compare = [&](int32_t a, int32_t b) {
+      DType score_a = batch_data[a * box_size + score_index];
+      DType score_b = batch_data[b * box_size + score_index];
+      return score_a > score_b || (score_a == score_b && a < b);
+    };
+    int64_t nkeep = (param.top_k > 0 && param.top_k < n) ? param.top_k : n;
+    if (nkeep < n) {
+      // Select the top k boxes in linear time, and only sort them.
+      std::nth_element(order.begin(), order.begin() + nkeep, order.end(), compare);
+    }
+    std::sort(order.begin(), order.begin() + nkeep, compare);
+    for (int64_t j = 0; j < nkeep; ++j) {
+      const DType* box = batch_data + order[j] * box_size;
+      std::copy(box, box + box_size, work + j * box_size);
+      batch_indices[j] = order[j];
+    }
+    std::fill(work + nkeep * box_size, work + n * box_size, DType(-1));
+    std::fill(batch_indices + nkeep, batch_indices + n, -1);
+
+    std::map<DType, std::vector<int32_t>> classes;
+    for (int64_t j = 0; j < nkeep; ++j) {
+      const DType* box = work + j * box_size;
+      if (box[score_index] <= 0) continue;
+      if (!per_class) {
+        classes[DType(0)].push_back(static_cast<int32_t>(j));
+      } else if (box[id_index] >= 0) {
+        // The boxes of negative class ids neither suppress nor are suppressed by other boxes.
+        classes[box[id_index]].push_back(static_cast<int32_t>(j));
+      }
+    }
+    for (auto& kv : classes) {
+      groups[i].push_back(std::move(kv.second));
+    }
+    suppressed[i].assign(n, 0);
+  });
+
+  // Run the greedy suppression of every class of every batch in parallel.
+  std::vector<std::pair<int64_t, const std::vector<int32_t>*>> tasks;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    for (const auto& group : groups[i]) {
+      tasks.emplace_back(i, &group);
+    }
+  }
+  ParallelFor(0, static_cast<int64_t>(tasks.size()), [&](int64_t task) {
+    const int64_t i = tasks[task].first;
+    const DType* work = work_ptr + i * batch_stride;
+    KeptBoxes<DType> kept;
+    for (int32_t j : *tasks[task].second) {
+      // No more box of the class can be in the output once the class alone fills it.
+      if (param.max_output_size >= 0 &&
+          static_cast<int64_t>(kept.size()) >= param.max_output_size) {
+        break;
+      }
+      const DType* box = work + j * box_size + coord_start;
+      DType l = std::min(box[0], box[2]);
+      DType t = std::min(box[1], box[3]);
+      DType r = std::max(box[0], box[2]);
+      DType b = std::max(box[1], box[3]);
+      if (kept.Overlaps(l, t, r, b, iou_threshold)) {
+        suppressed[i][j] = 1;
+      } else if (id_index < 0 || work[j * box_size + id_index] >= 0) {
+        kept.Add(l, t, r, b);
+      }
+    }
+  });
+
+  // Apply the suppression and max_output_size in the order of the scores, and write the outputs.
+  ParallelFor(0, batch_size, [&](int64_t i) {
+    DType* work = work_ptr + i * batch_stride;
+    int32_t* batch_indices = box_indices.data() + i * num_anchors;
+    const int64_t n = num_valid[i];
+    if (param.iou_threshold > 0) {
+      int64_t num_kept = 0;
+      for (int64_t j = 0; j < n; ++j) {
+        DType* box = work + j * box_size;
+        bool remove = false;
+        if (num_kept == param.max_output_size) {
+          remove = true;
+        } else if (box[score_index] > 0) {
+          remove = suppressed[i][j] != 0;
+          num_kept += !remove;
+        }
+        if (remove) {
+          std::fill(box, box + box_size, DType(-1));
+          batch_indices[j] = -1;
+        }
+      }
+    }
+    std::fill(work + n * box_size, work + batch_stride, DType(-1));
+    std::fill(batch_indices + n, batch_indices + num_anchors, -1);
+
+    if (param.return_indices) {
+      // Map the indices back to the input data and move the valid ones to the top.
+      int32_t* out = static_cast<int32_t*>(out_indices->data) + i * num_anchors;
+      const int32_t* batch_input_indices = indices_ptr + i * num_anchors;
+      int32_t count = 0;
+      for (int64_t j = 0; j < n; ++j) {
+        if (batch_indices[j] >= 0) {
+          out[count++] = batch_input_indices[batch_indices[j]];
+        }
+      }
+      std::fill(out + count, out + num_anchors, -1);
+      static_cast<int32_t*>(out_count->data)[i] = count;
+    } else if (param.invalid_to_bottom) {
+      DType* out = static_cast<DType*>(out_boxes->data) + i * batch_stride;
+      int64_t count = 0;
+      for (int64_t j = 0; j < num_anchors; ++j) {
+        const DType* box = work + j * box_size;
+        if (box[0] >= 0) {
+          std::copy(box, box + box_size, out + count * box_size);
+          ++count;
+        }
+      }
+      std::fill(out + count * box_size, out + batch_stride, DType(-1));
+    }
+  });
+}
+
+// Non-maximum suppression of the bounding boxes.
+// The outputs are the indices of the kept boxes in the input data and their number if
+// return_indices is true, or the boxes otherwise.
+TVM_REGISTER_GLOBAL("tvm.contrib.vision.non_max_suppression")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      DLTensor* data = args[0];
+      DLTensor* valid_count = args[1];
+      DLTensor* indices = args[2];
+      NMSParam param;
+      int num_args = args.num_args;
+      param.max_output_size = args[num_args - 9];
+      param.iou_threshold = args[num_args - 8];
+      param.force_suppress = args[num_args - 7];
+      param.top_k = args[num_args - 6];
+      param.coord_start = args[num_args - 5];
+      param.score_index = args[num_args - 4];
+      param.id_index = args[num_args - 3];
+      param.return_indices = args[num_args - 2];
+      param.invalid_to_bottom = args[num_args - 1];
+      DLTensor* out_boxes = nullptr;
+      DLTensor* out_indices = nullptr;
+      DLTensor* out_count = nullptr;
+      if (param.return_indices) {
+        out_indices = args[3];
+        out_count = args[4];
+      } else {
+        out_boxes = args[3];
+      }
+      CHECK_EQ(data->ndim, 3) << "non_max_suppression only supports 3-D input";
+      CHECK_GE(data->shape[2], param.coord_start + 4) << "The box data has too few elements";
+      auto data_dtype = DLDataType2String(data->dtype);
+      if (data_dtype == "float32") {
+        NonMaxSuppression<float>(data, valid_count, indices, out_boxes, out_indices, out_count,
+                                 param);
+      } else if (data_dtype == "float64") {
+        NonMaxSuppression<double>(data, valid_count, indices, out_boxes, out_indices, out_count,
+                                  param);
+      } else {
+        LOG(FATAL) << "Unsupported input dtype: " << data_dtype;
+      }
+    });
+
+template <typename DType>
+void MultiboxTransformLoc(DLTensor* cls_prob, DLTensor* loc_pred, DLTensor* anchor,
+                          DLTensor* out_loc, DLTensor* valid_count, bool clip, double threshold,
+                          const double variances[4]) {
+  const int64_t batch_size = cls_prob->shape[0];
+  const int64_t num_classes = cls_prob->shape[1];
+  const int64_t num_anchors = cls_prob->shape[2];
+  const DType* cls_ptr = static_cast<DType*>(cls_prob->data);
+  const DType* loc_ptr = static_cast<DType*>(loc_pred->data);
+  const DType* anchor_ptr = static_cast<DType*>(anchor->data);
+  DType* out_ptr = static_cast<DType*>(out_loc->data);
+  int32_t* count_ptr = static_cast<int32_t*>(valid_count->data);
+  const DType score_threshold = static_cast<DType>(threshold);
+  const DType vx = static_cast<DType>(variances[0]);
+  const DType vy = static_cast<DType>(variances[1]);
+  const DType vw = static_cast<DType>(variances[2]);
+  const DType vh = static_cast<DType>(variances[3]);
+  auto clip_coord = [clip](DType x) {
+    return clip ? std::max(DType(0), std::min(DType(1), x)) : x;
+  };
+
+  ParallelFor(0, batch_size, [&](int64_t i) {
+    // Find the best class of all anchors at once, the probabilities of a class are contiguous.
+    std::vector<DType> best_score(num_anchors, DType(-1));
+    std::vector<int32_t> best_id(num_anchors, 0);
+    for (int64_t k = 1; k < num_classes; ++k) {
+      const DType* prob = cls_ptr + (i * num_classes + k) * num_anchors;
+      for (int64_t j = 0; j < num_anchors; ++j) {
+        best_id[j] = prob[j] > best_score[j] ? static_cast<int32_t>(k) : best_id[j];
+        best_score[j] = std::max(prob[j], best_score[j]);
+      }
+    }
+
+    const DType* batch_loc = loc_ptr + i * num_anchors * 4;
+    DType* batch_out = out_ptr + i * num_anchors * 6;
+    int64_t count = 0;
+    for (int64_t j = 0; j < num_anchors; ++j) {
+      // Remove the background and the predictions below the threshold.
+      if (best_id[j] == 0 || best_score[j] < score_threshold) continue;
+      const DType* box = anchor_ptr + j * 4;
+      const DType* pred = batch_loc + j * 4;
+      DType aw = box[2] - box[0];
+      DType ah = box[3] - box[1];
+      DType ax = (box[0] + box[2]) / DType(2);
+      DType ay = (box[1] + box[3]) / DType(2);
+      DType ox = pred[0] * vx * aw + ax;
+      DType oy = pred[1] * vy * ah + ay;
+      DType ow = std::exp(pred[2] * vw) * aw / DType(2);
+      DType oh = std::exp(pred[3] * vh) * ah / DType(2);
+      // [id, prob, xmin, ymin, xmax, ymax]
+      DType* out = batch_out + count * 6;
+      out[0] = static_cast<DType>(best_id[j] - 1);
+      out[1] = best_score[j];
+      out[2] = clip_coord(ox - ow);
+      out[3] = clip_coord(oy - oh);
+      out[4] = clip_coord(ox + ow);
+      out[5] = clip_coord(oy + oh);
+      ++count;
+    }
+    std::fill(batch_out + count * 6, batch_out + num_anchors * 6, DType(-1));
+    count_ptr[i] = static_cast<int32_t>(count);
+  });
+}
+
+// Decode the boxes of the multibox detection from the anchors and the location predictions.
+TVM_REGISTER_GLOBAL("tvm.contrib.vision.multibox_transform_loc")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      DLTensor* cls_prob = args[0];
+      DLTensor* loc_pred = args[1];
+      DLTensor* anchor = args[2];
+      DLTensor* out_loc = args[3];
+      DLTensor* valid_count = args[4];
+      bool clip = args[5];
+      double threshold = args[6];
+      const double variances[4] = {args[7], args[8], args[9], args[10]};
+      auto data_dtype = DLDataType2String(cls_prob->dtype);
+      if (data_dtype == "float32") {
+        MultiboxTransformLoc<float>(cls_prob, loc_pred, anchor, out_loc, valid_count, clip,
+                                    threshold, variances);
+      } else if (data_dtype == "float64") {
+        MultiboxTransformLoc<double>(cls_prob, loc_pred, anchor, out_loc, valid_count, clip,
+                                     threshold, variances);
+      } else {
+        LOG(FATAL) << "Unsupported input dtype: " << data_dtype;
+      }
+    });
+
+}  // namespace contrib
+}  // namespace tvm
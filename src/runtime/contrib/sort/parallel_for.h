@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file parallel_for.h
+ * \brief Run the iterations of a loop of the contrib kernels on the TVM thread pool.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_SORT_PARALLEL_FOR_H_
+#define TVM_RUNTIME_CONTRIB_SORT_PARALLEL_FOR_H_
+
+#include <dmlc/logging.h>
+#include <tvm/runtime/c_backend_api.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace tvm {
+namespace contrib {
+
+/*!
+ * \brief Call f(i) for every i in [begin, end) on the thread pool, every task runs a contiguous
+ *  range of the iterations.
+ * \param begin The first iteration.
+ * \param end The end of the iterations.
+ * \param f The body of the loop.
+ */
+template <typename F>
+void ParallelFor(int64_t begin, int64_t end, const F& f) {
+  if (end - begin <= 1) {
+    for (int64_t i = begin; i < end; ++i) {
+      f(i);
+    }
+    return;
+  }
+  struct Closure {
+    int64_t begin;
+    int64_t end;
+    const F* f;
+  } closure{begin, end, &f};
+  auto flambda = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) -> int {
+    const Closure* closure = static_cast<const Closure*>(cdata);
+    int64_t num_iters = closure->end - closure->begin;
+    int64_t step = (num_iters + penv->num_task - 1) / penv->num_task;
+    int64_t task_begin = closure->begin + task_id * step;
+    int64_t task_end = std::min(closure->end, task_begin + step);
+    for (int64_t i = task_begin; i < task_end; ++i) {
+      (*closure->f)(i);
+    }
+    return 0;
+  };
+  // Launch as many tasks as the workers of the pool.
+  CHECK_EQ(TVMBackendParallelLaunch(flambda, &closure, 0), 0);
+}
+
+}  // namespace contrib
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_CONTRIB_SORT_PARALLEL_FOR_H_
@@ -21,25 +21,198 @@
  * \file Use standard C library call.
  */
 
+#include <builtin_fp16.h>
 #include <dlpack/dlpack.h>
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "parallel_for.h"
+
 namespace tvm {
 namespace contrib {
 
 using namespace runtime;
 
-template <typename DType>
-bool CompareAscend(const std::pair<int64_t, DType>& lhs, const std::pair<int64_t, DType>& rhs) {
-  return lhs.second < rhs.second;
+/*! \brief The storage of a float16 element, which is compared as float. */
+struct Float16 {
+  uint16_t bits;
+};
+
+// The key to compare of an element.
+template <typename DataType>
+inline DataType SortKey(DataType value) {
+  return value;
+}
+
+inline float SortKey(Float16 value) {
+  return __extendXfYf2__<uint16_t, uint16_t, 10, float, uint32_t, 23>(value.bits);
+}
+
+// Convert an index to the output dtype.
+template <typename OutType>
+inline OutType CastIndex(int64_t index) {
+  return static_cast<OutType>(index);
+}
+
+template <>
+inline Float16 CastIndex<Float16>(int64_t index) {
+  return Float16{__truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(index)};
+}
+
+// The order of the keys. NaN is greater than the other floats, so that the order is strict
+// weak, which std::sort and std::nth_element require.
+template <typename KeyType>
+inline bool KeyLess(KeyType lhs, KeyType rhs) {
+  return lhs < rhs;
+}
+
+inline bool KeyLess(float lhs, float rhs) {
+  return lhs < rhs || (std::isnan(rhs) && !std::isnan(lhs));
+}
+
+inline bool KeyLess(double lhs, double rhs) {
+  return lhs < rhs || (std::isnan(rhs) && !std::isnan(lhs));
+}
+
+// The ties are broken by the index, which gives the order of a stable sort.
+template <typename KeyType>
+bool CompareAscend(const std::pair<int64_t, KeyType>& lhs, const std::pair<int64_t, KeyType>& rhs) {
+  if (KeyLess(lhs.second, rhs.second)) return true;
+  if (KeyLess(rhs.second, lhs.second)) return false;
+  return lhs.first < rhs.first;
 }
 
-template <typename DType>
-bool CompareDescend(const std::pair<int64_t, DType>& lhs, const std::pair<int64_t, DType>& rhs) {
-  return lhs.second > rhs.second;
+template <typename KeyType>
+bool CompareDescend(const std::pair<int64_t, KeyType>& lhs,
+                    const std::pair<int64_t, KeyType>& rhs) {
+  if (KeyLess(rhs.second, lhs.second)) return true;
+  if (KeyLess(lhs.second, rhs.second)) return false;
+  return lhs.first < rhs.first;
+}
+
+template <typename KeyType, typename Compare>
+void SelectAndSort(std::vector<std::pair<int64_t, KeyType>>* sorter, int64_t k, Compare compare) {
+  auto first = sorter->begin();
+  auto last = sorter->end();
+  if (k < static_cast<int64_t>(sorter->size())) {
+    std::nth_element(first, first + k, last, compare);
+    last = first + k;
+  }
+  std::sort(first, last, compare);
+}
+
+/*!
+ * \brief Sort the first k elements of the sorter. When k is less than the number of elements,
+ *  they are selected in linear time first, and only they are sorted.
+ */
+template <typename KeyType>
+void SortTopK(std::vector<std::pair<int64_t, KeyType>>* sorter, int64_t k, bool is_ascend) {
+  using Pair = std::pair<int64_t, KeyType>;
+  if (is_ascend) {
+    SelectAndSort(sorter, k,
+                  [](const Pair& lhs, const Pair& rhs) { return CompareAscend(lhs, rhs); });
+  } else {
+    SelectAndSort(sorter, k,
+                  [](const Pair& lhs, const Pair& rhs) { return CompareDescend(lhs, rhs); });
+  }
+}
+
+/*!
+ * \brief Call f(i, j, axis_mul_after) for every row of the tensor along the axis in parallel,
+ *  where i and j are the indices of the row in the dimensions before and after the axis.
+ */
+template <typename F>
+void ParallelForRows(const DLTensor* input, int axis, const F& f) {
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
+  for (int i = 0; i < input->ndim; ++i) {
+    if (i < axis) {
+      axis_mul_before *= input->shape[i];
+    } else if (i > axis) {
+      axis_mul_after *= input->shape[i];
+    }
+  }
+  ParallelFor(0, axis_mul_before * axis_mul_after, [&](int64_t row) {
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    f(i, j, axis_mul_after);
+  });
+}
+
+// Call f with a null pointer of the storage type of the data dtype.
+template <typename F>
+void DispatchDataType(DLDataType dtype, const F& f) {
+  auto data_dtype = DLDataType2String(dtype);
+  if (data_dtype == "float32") {
+    f(static_cast<float*>(nullptr));
+  } else if (data_dtype == "float64") {
+    f(static_cast<double*>(nullptr));
+  } else if (data_dtype == "float16") {
+    f(static_cast<Float16*>(nullptr));
+  } else if (data_dtype == "int32") {
+    f(static_cast<int32_t*>(nullptr));
+  } else if (data_dtype == "int64") {
+    f(static_cast<int64_t*>(nullptr));
+  } else if (data_dtype == "int8") {
+    f(static_cast<int8_t*>(nullptr));
+  } else if (data_dtype == "uint8") {
+    f(static_cast<uint8_t*>(nullptr));
+  } else {
+    LOG(FATAL) << "Unsupported input dtype: " << data_dtype;
+  }
+}
+
+// Call f with a null pointer of the storage type of the output indices dtype.
+template <typename F>
+void DispatchIndicesType(DLDataType dtype, const F& f) {
+  auto out_dtype = DLDataType2String(dtype);
+  if (out_dtype == "int32") {
+    f(static_cast<int32_t*>(nullptr));
+  } else if (out_dtype == "int64") {
+    f(static_cast<int64_t*>(nullptr));
+  } else if (out_dtype == "float32") {
+    f(static_cast<float*>(nullptr));
+  } else if (out_dtype == "float64") {
+    f(static_cast<double*>(nullptr));
+  } else if (out_dtype == "float16") {
+    f(static_cast<Float16*>(nullptr));
+  } else {
+    LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
+  }
+}
+
+template <typename DataType>
+using KeyTypeOf = decltype(SortKey(std::declval<DataType>()));
+
+template <typename DataType>
+void argsort_nms(DLTensor* input, DLTensor* sort_num, DLTensor* output, int32_t axis,
+                 bool is_ascend) {
+  using KeyType = KeyTypeOf<DataType>;
+  auto data_ptr = static_cast<DataType*>(input->data);
+  auto sort_num_ptr = static_cast<int32_t*>(sort_num->data);
+  auto out_ptr = static_cast<int32_t*>(output->data);
+  const int64_t axis_size = input->shape[axis];
+
+  ParallelForRows(input, axis, [&](int64_t i, int64_t j, int64_t axis_mul_after) {
+    std::vector<std::pair<int64_t, KeyType>> sorter;
+    int32_t current_sort_num = *(sort_num_ptr + i * axis_mul_after + j);
+    int64_t base_idx = i * axis_size * axis_mul_after + j;
+    sorter.reserve(current_sort_num);
+    for (int64_t k = 0; k < current_sort_num; ++k) {
+      int64_t full_idx = base_idx + k * axis_mul_after;
+      sorter.emplace_back(k, SortKey(data_ptr[full_idx]));
+    }
+    SortTopK(&sorter, current_sort_num, is_ascend);
+    for (int32_t k = 0; k < axis_size; ++k) {
+      out_ptr[base_idx + k * axis_mul_after] =
+          k < static_cast<int32_t>(sorter.size()) ? sorter[k].first : k;
+    }
+  });
 }
 
 // Argsort implemented C library sort for nms.
@@ -56,108 +229,39 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
   int32_t axis = args[3];
   bool is_ascend = args[4];
 
-  auto dtype = input->dtype;
-  auto data_ptr = static_cast<float*>(input->data);
-  auto sort_num_ptr = static_cast<int32_t*>(sort_num->data);
-  std::vector<std::pair<int32_t, float>> sorter;
-  int64_t axis_mul_before = 1;
-  int64_t axis_mul_after = 1;
-
   if (axis < 0) {
     axis = input->ndim + axis;
   }
-
-  // Currently only supports input dtype to be float32.
-  CHECK_EQ(dtype.code, 2) << "Currently only supports input dtype "
-                             "to be float.";
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC != 1)
-  CHECK_EQ(dtype.bits, 32) << "Currently only supports input dtype "
-                              "to be float32.";
-#endif
   CHECK_LT(axis, input->ndim) << "Axis out of boundary for "
                                  "input ndim "
                               << input->ndim;
 
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
-
-  for (int64_t i = 0; i < axis_mul_before; ++i) {
-    for (int64_t j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int32_t current_sort_num = *(sort_num_ptr + i * axis_mul_after + j);
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < current_sort_num; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, *(data_ptr + full_idx)));
-      }
-      if (is_ascend) {
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        if (dtype.bits == 16) {
-          std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<__fp16>);
-        } else {
-#endif
-          std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<float>);
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        }
-#endif
-      } else {
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        if (dtype.bits == 16) {
-          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<__fp16>);
-        } else {
-#endif
-          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<float>);
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        }
-#endif
-      }
-      for (int32_t k = 0; k < input->shape[axis]; ++k) {
-        *(static_cast<int32_t*>(output->data) + base_idx + k * axis_mul_after) =
-            k < static_cast<int32_t>(sorter.size()) ? sorter[k].first : k;
-      }
-    }
-  }
+  DispatchDataType(input->dtype, [&](auto* data_tag) {
+    using DataType = std::remove_pointer_t<decltype(data_tag)>;
+    argsort_nms<DataType>(input, sort_num, output, axis, is_ascend);
+  });
 });
 
 template <typename DataType, typename OutType>
 void argsort(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend) {
+  using KeyType = KeyTypeOf<DataType>;
   auto data_ptr = static_cast<DataType*>(input->data);
   auto out_ptr = static_cast<OutType*>(output->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
+  const int64_t axis_size = input->shape[axis];
 
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
+  ParallelForRows(input, axis, [&](int64_t i, int64_t j, int64_t axis_mul_after) {
+    std::vector<std::pair<int64_t, KeyType>> sorter;
+    sorter.reserve(axis_size);
+    int64_t base_idx = i * axis_size * axis_mul_after + j;
+    for (int64_t k = 0; k < axis_size; ++k) {
+      int64_t full_idx = base_idx + k * axis_mul_after;
+      sorter.emplace_back(k, SortKey(data_ptr[full_idx]));
     }
-  }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, data_ptr[full_idx]));
-      }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
-      }
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        out_ptr[base_idx + k * axis_mul_after] = static_cast<OutType>(sorter[k].first);
-      }
+    SortTopK(&sorter, axis_size, is_ascend);
+    for (int64_t k = 0; k < axis_size; ++k) {
+      out_ptr[base_idx + k * axis_mul_after] = CastIndex<OutType>(sorter[k].first);
     }
-  }
+  });
 }
 
 // Argsort implemented C library sort.
@@ -179,119 +283,50 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort").set_body([](TVMArgs args, TVMRet
                                  "input ndim "
                               << input->ndim;
 
-  auto data_dtype = DLDataType2String(input->dtype);
-  auto out_dtype = DLDataType2String(output->dtype);
-
-  if (data_dtype == "float32") {
-    if (out_dtype == "int32") {
-      argsort<float, int32_t>(input, output, axis, is_ascend);
-    } else if (out_dtype == "int64") {
-      argsort<float, int64_t>(input, output, axis, is_ascend);
-    } else if (out_dtype == "float32") {
-      argsort<float, float>(input, output, axis, is_ascend);
-    } else if (out_dtype == "float64") {
-      argsort<float, double>(input, output, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-  } else if (data_dtype == "float64") {
-    if (out_dtype == "int32") {
-      argsort<double, int32_t>(input, output, axis, is_ascend);
-    } else if (out_dtype == "int64") {
-      argsort<double, int64_t>(input, output, axis, is_ascend);
-    } else if (out_dtype == "float32") {
-      argsort<double, float>(input, output, axis, is_ascend);
-    } else if (out_dtype == "float64") {
-      argsort<double, double>(input, output, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-  } else if (data_dtype == "float16") {
-    if (out_dtype == "float16") {
-      argsort<__fp16, __fp16>(input, output, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-#endif
-  } else if (data_dtype == "int32") {
-    if (out_dtype == "int32") {
-      argsort<int32_t, int32_t>(input, output, axis, is_ascend);
-    } else if (out_dtype == "int64") {
-      argsort<int32_t, int64_t>(input, output, axis, is_ascend);
-    } else if (out_dtype == "float32") {
-      argsort<int32_t, float>(input, output, axis, is_ascend);
-    } else if (out_dtype == "float64") {
-      argsort<int32_t, double>(input, output, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-  } else if (data_dtype == "int64") {
-    if (out_dtype == "int32") {
-      argsort<int64_t, int32_t>(input, output, axis, is_ascend);
-    } else if (out_dtype == "int64") {
-      argsort<int64_t, int64_t>(input, output, axis, is_ascend);
-    } else if (out_dtype == "float32") {
-      argsort<int64_t, float>(input, output, axis, is_ascend);
-    } else if (out_dtype == "float64") {
-      argsort<int64_t, double>(input, output, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-  } else {
-    LOG(FATAL) << "Unsupported input dtype: " << data_dtype;
-  }
+  DispatchDataType(input->dtype, [&](auto* data_tag) {
+    DispatchIndicesType(output->dtype, [&](auto* out_tag) {
+      using DataType = std::remove_pointer_t<decltype(data_tag)>;
+      using OutType = std::remove_pointer_t<decltype(out_tag)>;
+      argsort<DataType, OutType>(input, output, axis, is_ascend);
+    });
+  });
 });
 
 template <typename DataType, typename IndicesType>
 void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, int axis,
           bool is_ascend) {
+  using KeyType = KeyTypeOf<DataType>;
   DataType* data_ptr = static_cast<DataType*>(input->data);
   DataType* values_ptr =
       (out_values == nullptr) ? nullptr : static_cast<DataType*>(out_values->data);
   IndicesType* indices_ptr =
       (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
-
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
+  const int64_t axis_size = input->shape[axis];
   if (k < 1) {
-    k = input->shape[axis];
+    k = axis_size;
   }
 
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t src_base_idx = i * input->shape[axis] * axis_mul_after + j;
-      int64_t dst_base_idx = i * k * axis_mul_after + j;
-      for (int64_t kk = 0; kk < input->shape[axis]; ++kk) {
-        int64_t full_idx = src_base_idx + kk * axis_mul_after;
-        sorter.emplace_back(std::make_pair(kk, data_ptr[full_idx]));
-      }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
+  ParallelForRows(input, axis, [&](int64_t i, int64_t j, int64_t axis_mul_after) {
+    std::vector<std::pair<int64_t, KeyType>> sorter;
+    sorter.reserve(axis_size);
+    int64_t src_base_idx = i * axis_size * axis_mul_after + j;
+    int64_t dst_base_idx = i * k * axis_mul_after + j;
+    for (int64_t kk = 0; kk < axis_size; ++kk) {
+      int64_t full_idx = src_base_idx + kk * axis_mul_after;
+      sorter.emplace_back(kk, SortKey(data_ptr[full_idx]));
+    }
+    SortTopK(&sorter, k, is_ascend);
+    for (int64_t kk = 0; kk < k; ++kk) {
+      if (indices_ptr != nullptr) {
+        indices_ptr[dst_base_idx + kk * axis_mul_after] = CastIndex<IndicesType>(sorter[kk].first);
       }
-      int64_t cnt = k > 0 ? k : input->shape[axis];
-      for (int64_t kk = 0; kk < cnt; ++kk) {
-        if (indices_ptr != nullptr) {
-          indices_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<IndicesType>(sorter[kk].first);
-        }
-        if (values_ptr != nullptr) {
-          values_ptr[dst_base_idx + kk * axis_mul_after] = static_cast<DataType>(sorter[kk].second);
-        }
+      if (values_ptr != nullptr) {
+        // Copy the element rather than the key, which keeps the bits of float16 values.
+        values_ptr[dst_base_idx + kk * axis_mul_after] =
+            data_ptr[src_base_idx + sorter[kk].first * axis_mul_after];
       }
     }
-  }
+  });
 }
 
 // Argsort implemented C library sort.
@@ -324,60 +359,14 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.topk").set_body([](TVMArgs args, TVMRetVal
   }
   CHECK(axis >= 0 && axis < input->ndim) << "Axis out of boundary for input ndim " << input->ndim;
 
-  auto data_dtype = DLDataType2String(input->dtype);
-  auto out_dtype = (indices_out == nullptr) ? "int64" : DLDataType2String(indices_out->dtype);
-
-  if (data_dtype == "float32") {
-    if (out_dtype == "int32") {
-      topk<float, int32_t>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "int64") {
-      topk<float, int64_t>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "float32") {
-      topk<float, float>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "float64") {
-      topk<float, double>(input, values_out, indices_out, k, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-  } else if (data_dtype == "float64") {
-    if (out_dtype == "int32") {
-      topk<double, int32_t>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "int64") {
-      topk<double, int64_t>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "float32") {
-      topk<double, float>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "float64") {
-      topk<double, double>(input, values_out, indices_out, k, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-  } else if (data_dtype == "int32") {
-    if (out_dtype == "int32") {
-      topk<int32_t, int32_t>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "int64") {
-      topk<int32_t, int64_t>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "float32") {
-      topk<int32_t, float>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "float64") {
-      topk<int32_t, double>(input, values_out, indices_out, k, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-  } else if (data_dtype == "int64") {
-    if (out_dtype == "int32") {
-      topk<int64_t, int32_t>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "int64") {
-      topk<int64_t, int64_t>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "float32") {
-      topk<int64_t, float>(input, values_out, indices_out, k, axis, is_ascend);
-    } else if (out_dtype == "float64") {
-      topk<int64_t, double>(input, values_out, indices_out, k, axis, is_ascend);
-    } else {
-      LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
-    }
-  } else {
-    LOG(FATAL) << "Unsupported input dtype: " << data_dtype;
-  }
+  DLDataType out_dtype = (indices_out == nullptr) ? DLDataType{kDLInt, 64, 1} : indices_out->dtype;
+  DispatchDataType(input->dtype, [&](auto* data_tag) {
+    DispatchIndicesType(out_dtype, [&](auto* out_tag) {
+      using DataType = std::remove_pointer_t<decltype(data_tag)>;
+      using IndicesType = std::remove_pointer_t<decltype(out_tag)>;
+      topk<DataType, IndicesType>(input, values_out, indices_out, k, axis, is_ascend);
+    });
+  });
 });
 
 }  // namespace contrib
@@ -932,8 +932,14 @@ class VsiNpuJSONRuntime : public JSONRuntimeBase {
 
     if (tvm_dtype.code == DLDataTypeCode::kDLFloat && tvm_dtype.bits == 32) {
       vsi_dtype = tim::vx::DataType::FLOAT32;
+    } else if (tvm_dtype.code == DLDataTypeCode::kDLFloat && tvm_dtype.bits == 16) {
+      vsi_dtype = tim::vx::DataType::FLOAT16;
     } else if (tvm_dtype.code == DLDataTypeCode::kDLUInt && tvm_dtype.bits == 8) {
       vsi_dtype = tim::vx::DataType::UINT8;
+    } else if (tvm_dtype.code == DLDataTypeCode::kDLInt && tvm_dtype.bits == 8) {
+      vsi_dtype = tim::vx::DataType::INT8;
+    } else if (tvm_dtype.code == DLDataTypeCode::kDLInt && tvm_dtype.bits == 16) {
+      vsi_dtype = tim::vx::DataType::INT16;
     } else if (tvm_dtype.code == DLDataTypeCode::kDLInt && tvm_dtype.bits == 32) {
       vsi_dtype = tim::vx::DataType::INT32;
     } else {
@@ -24,11 +24,23 @@
 #include <dmlc/logging.h>
 #include <tvm/support/parallel_for.h>
 
-#include <future>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace tvm {
 namespace support {
 
@@ -47,50 +59,220 @@ std::vector<std::vector<int>> rr_partitioner(int begin, int end, int step, int n
   return ret;
 }
 
-void parallel_for(int begin, int end, const std::function<void(int)>& f, int step,
-                  const PartitionerFuncType partitioner) {
-  static bool GLOBAL_PARALLEL_FOR_FLAG{false};
-  static std::mutex M_GLOBAL_PARALLEL_FOR_FLAG;
-  {
-    std::unique_lock<std::mutex> l(M_GLOBAL_PARALLEL_FOR_FLAG);
-    CHECK(!GLOBAL_PARALLEL_FOR_FLAG) << "There's another parallel_for running. Maybe you're "
-                                     << "currently inside another parallel_for loop.";
-    GLOBAL_PARALLEL_FOR_FLAG = true;
-  }
+/*! \brief Whether the current thread is running the body of a parallel_for */
+static thread_local bool in_parallel_region = false;
 
-  int default_num_threads = std::thread::hardware_concurrency();
-  const auto& run_partitions = partitioner(begin, end, step, default_num_threads);
-
-  std::vector<std::thread> threads;
-  threads.reserve(run_partitions.size());
-  std::vector<std::future<void>> res_vec;
-  res_vec.reserve(run_partitions.size());
-  for (const auto& run_partition : run_partitions) {
-    std::packaged_task<void(const std::vector<int>&, const std::function<void(int)>&)> task(
-        [](const std::vector<int>& run_pattition, const std::function<void(int)>& f) {
-          for (const auto& i : run_pattition) {
-            f(i);
+/*!
+ * \brief A parallel job: a number of chunks claimed dynamically by the workers and the caller.
+ */
+class ParallelJob {
+ public:
+  ParallelJob(int num_chunks, std::function<void(int)> run_chunk)
+      : num_chunks_(num_chunks), run_chunk_(std::move(run_chunk)) {}
+
+  /*! \return The number of chunks of this job. */
+  int num_chunks() const { return num_chunks_; }
+
+  /*! \brief Claim and run chunks until all chunks are claimed. */
+  void Work() {
+    bool prev = in_parallel_region;
+    in_parallel_region = true;
+    int chunk;
+    while ((chunk = next_chunk_.fetch_add(1)) < num_chunks_) {
+      if (!failed_.load()) {
+        try {
+          run_chunk_(chunk);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (!error_) {
+            error_ = std::current_exception();
           }
-        });
-    res_vec.emplace_back(task.get_future());
-    threads.emplace_back(std::move(task), run_partition, f);
+          failed_ = true;
+        }
+      }
+      if (finished_chunks_.fetch_add(1) + 1 == num_chunks_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+      }
+    }
+    in_parallel_region = prev;
   }
 
-  for (auto&& thread : threads) {
-    thread.join();
+  /*! \brief Wait until all chunks finish, and rethrow the first exception raised by a chunk. */
+  void Wait() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return finished_chunks_.load() == num_chunks_; });
+    }
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
   }
-  {
-    std::unique_lock<std::mutex> l(M_GLOBAL_PARALLEL_FOR_FLAG);
-    CHECK(GLOBAL_PARALLEL_FOR_FLAG);
-    GLOBAL_PARALLEL_FOR_FLAG = false;
+
+ private:
+  const int num_chunks_;
+  std::function<void(int)> run_chunk_;
+  std::atomic<int> next_chunk_{0};
+  std::atomic<int> finished_chunks_{0};
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+/*!
+ * \brief A persistent pool of compiler-side worker threads shared by all parallel_for calls.
+ * The thread calling parallel_for also works on its own job, so a job always makes progress
+ * even when all workers are busy with other jobs.
+ */
+class ParallelForPool {
+ public:
+  static ParallelForPool* Global() {
+    static ParallelForPool inst;
+    return &inst;
+  }
+
+  /*! \return The number of threads that run a job, including the calling thread. */
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  /*! \return Whether the pool can be used from the current process. */
+  bool usable() const {
+#ifndef _WIN32
+    // The workers do not exist in a forked child process
+    return getpid() == pid_;
+#else
+    return true;
+#endif
   }
-  try {
-    for (auto&& i : res_vec) {
-      i.get();
+
+  /*! \brief Run a job with the help of at most `num_helpers` workers. */
+  void Run(const std::shared_ptr<ParallelJob>& job, int num_helpers) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (int i = 0; i < num_helpers; ++i) {
+        queue_.push_back(job);
+      }
     }
-  } catch (const std::exception& e) {
-    LOG(FATAL) << "Parallel_for error with " << e.what();
+    if (num_helpers == 1) {
+      cv_.notify_one();
+    } else if (num_helpers > 1) {
+      cv_.notify_all();
+    }
+    job->Work();
+    job->Wait();
+  }
+
+  ~ParallelForPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      exit_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+  }
+
+ private:
+  ParallelForPool() {
+#ifndef _WIN32
+    pid_ = getpid();
+#endif
+    int num_workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    for (int i = 0; i < num_workers; ++i) {
+      workers_.emplace_back([this] { WorkerLoop(); });
+    }
+  }
+
+  void WorkerLoop() {
+    while (true) {
+      std::shared_ptr<ParallelJob> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return exit_ || !queue_.empty(); });
+        if (exit_) {
+          return;
+        }
+        job = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      job->Work();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::deque<std::shared_ptr<ParallelJob>> queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool exit_{false};
+#ifndef _WIN32
+  pid_t pid_;
+#endif
+};
+
+void parallel_for(int begin, int end, const std::function<void(int)>& f, int step,
+                  const PartitionerFuncType partitioner) {
+  CHECK_GT(step, 0) << "Infinite loop condition with begin: " << begin << " end: " << end
+                    << " step: " << step;
+  int total_task_count = (end - begin + step - 1) / step;
+  if (total_task_count <= 0) {
+    return;
+  }
+
+  ParallelForPool* pool = ParallelForPool::Global();
+  // Nested parallel_for runs inline in the calling worker
+  if (in_parallel_region || total_task_count == 1 || pool->num_threads() == 1 ||
+      !pool->usable()) {
+    bool prev = in_parallel_region;
+    in_parallel_region = true;
+    try {
+      for (int i = begin; i < end; i += step) {
+        f(i);
+      }
+    } catch (...) {
+      in_parallel_region = prev;
+      throw;
+    }
+    in_parallel_region = prev;
+    return;
+  }
+
+  // TVM_PARALLEL_FOR_STATIC=1 splits the loops without a partitioner round-robin, as the
+  // implementation before the dynamic scheduling did. It is only meant for benchmarking.
+  static const bool use_static_partition = [] {
+    const char* val = getenv("TVM_PARALLEL_FOR_STATIC");
+    return val != nullptr && atoi(val) != 0;
+  }();
+
+  int num_threads = pool->num_threads();
+  std::shared_ptr<ParallelJob> job;
+  if (partitioner != nullptr || use_static_partition) {
+    // Static partitions, each partition is one chunk.
+    auto run_partitions = std::make_shared<std::vector<std::vector<int>>>(
+        partitioner != nullptr ? partitioner(begin, end, step, num_threads)
+                               : rr_partitioner(begin, end, step, num_threads));
+    job = std::make_shared<ParallelJob>(static_cast<int>(run_partitions->size()),
+                                        [run_partitions, &f](int chunk) {
+                                          for (int i : (*run_partitions)[chunk]) {
+                                            f(i);
+                                          }
+                                        });
+  } else {
+    // Dynamic scheduling: several small chunks per thread balance uneven iterations
+    int chunk_size = std::max(1, total_task_count / (num_threads * 4));
+    int num_chunks = (total_task_count + chunk_size - 1) / chunk_size;
+    job = std::make_shared<ParallelJob>(num_chunks, [begin, end, step, chunk_size, &f](int chunk) {
+      int64_t chunk_begin = begin + static_cast<int64_t>(chunk) * chunk_size * step;
+      int64_t chunk_end =
+          std::min<int64_t>(end, chunk_begin + static_cast<int64_t>(chunk_size) * step);
+      for (int64_t i = chunk_begin; i < chunk_end; i += step) {
+        f(static_cast<int>(i));
+      }
+    });
   }
+  pool->Run(job, std::min(num_threads, job->num_chunks()) - 1);
 }
 
 }  // namespace support
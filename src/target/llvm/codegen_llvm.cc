@@ -1037,6 +1037,9 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const LoadNode* op) {
   llvm::Value* buffer = MakeValue(op->buffer_var);
   llvm::Value* index = MakeValue(op->index);
 
+  if (!is_one(op->predicate)) {
+    return CreateMaskedLoad(op, buffer, index);
+  }
   if (t.lanes() == 1) {
     int alignment, native_bits;
     GetAlignment(t, op->buffer_var.get(), op->index, &alignment, &native_bits);
@@ -1086,6 +1089,79 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const LoadNode* op) {
   return ret;
 }
 
+llvm::Value* CodeGenLLVM::CreateMaskedLoad(const LoadNode* op, llvm::Value* buffer,
+                                           llvm::Value* index) {
+  DataType t = op->dtype;
+  CHECK_GT(t.lanes(), 1) << "Predicated scalar load is not supported";
+  CHECK(!volatile_buf_.count(op->buffer_var.get())) << "Predicated volatile load is not supported";
+  llvm::Value* mask = MakeValue(op->predicate);
+  llvm::Instruction* load = nullptr;
+  const RampNode* ramp = op->index.as<RampNode>();
+  if (ramp && is_one(ramp->stride)) {
+    // contiguous lanes, llvm.masked.load
+    int alignment, native_bits;
+    GetAlignment(t, op->buffer_var.get(), ramp->base, &alignment, &native_bits);
+    CHECK_EQ(ramp->lanes, t.lanes());
+    unsigned addrspace = llvm::dyn_cast<llvm::PointerType>(buffer->getType())->getAddressSpace();
+    llvm::Value* ptr = CreateBufferPtr(t.element_of(), buffer, MakeValue(ramp->base));
+    ptr = builder_->CreatePointerCast(ptr, DTypeToLLVMType(t)->getPointerTo(addrspace));
+#if TVM_LLVM_VERSION >= 110
+    load = builder_->CreateMaskedLoad(ptr, llvm::Align(alignment), mask);
+#else
+    load = builder_->CreateMaskedLoad(ptr, alignment, mask);
+#endif
+    AddAliasInfo(load, op->buffer_var.get(), op->index);
+  } else {
+    // any other lanes, llvm.masked.gather on the vector of the lane addresses.
+    int basic_align = t.bits() / 8;
+    llvm::Value* ptrs = CreateBufferPtr(t.element_of(), buffer, index);
+#if TVM_LLVM_VERSION >= 110
+    load = builder_->CreateMaskedGather(ptrs, llvm::Align(basic_align), mask);
+#else
+    load = builder_->CreateMaskedGather(ptrs, basic_align, mask);
+#endif
+    AddAliasInfo(load, op->buffer_var.get(), PrimExpr());
+  }
+  return load;
+}
+
+void CodeGenLLVM::CreateMaskedStore(const StoreNode* op, llvm::Value* buffer, llvm::Value* index,
+                                    llvm::Value* value) {
+  DataType t = op->value.dtype();
+  CHECK_GT(t.lanes(), 1) << "Predicated scalar store is not supported";
+  CHECK(!volatile_buf_.count(op->buffer_var.get()))
+      << "Predicated volatile store is not supported";
+  llvm::Value* mask = MakeValue(op->predicate);
+  const RampNode* ramp = op->index.as<RampNode>();
+  if (ramp && is_one(ramp->stride)) {
+    // contiguous lanes, llvm.masked.store
+    int alignment, native_bits;
+    GetAlignment(t, op->buffer_var.get(), ramp->base, &alignment, &native_bits);
+    CHECK_EQ(ramp->lanes, t.lanes());
+    unsigned addrspace = llvm::dyn_cast<llvm::PointerType>(buffer->getType())->getAddressSpace();
+    llvm::Value* ptr = CreateBufferPtr(t.element_of(), buffer, MakeValue(ramp->base));
+    ptr = builder_->CreatePointerCast(ptr, DTypeToLLVMType(t)->getPointerTo(addrspace));
+#if TVM_LLVM_VERSION >= 110
+    llvm::Instruction* store =
+        builder_->CreateMaskedStore(value, ptr, llvm::Align(alignment), mask);
+#else
+    llvm::Instruction* store = builder_->CreateMaskedStore(value, ptr, alignment, mask);
+#endif
+    AddAliasInfo(store, op->buffer_var.get(), op->index);
+  } else {
+    // any other lanes, llvm.masked.scatter on the vector of the lane addresses.
+    int basic_align = t.bits() / 8;
+    llvm::Value* ptrs = CreateBufferPtr(t.element_of(), buffer, index);
+#if TVM_LLVM_VERSION >= 110
+    llvm::Instruction* store =
+        builder_->CreateMaskedScatter(value, ptrs, llvm::Align(basic_align), mask);
+#else
+    llvm::Instruction* store = builder_->CreateMaskedScatter(value, ptrs, basic_align, mask);
+#endif
+    AddAliasInfo(store, op->buffer_var.get(), PrimExpr());
+  }
+}
+
 llvm::Value* CodeGenLLVM::VisitExpr_(const CallNode* op) {
   if (auto* ptr_op = op->op.as<OpNode>()) {
     auto call_op = GetRef<Op>(ptr_op);
@@ -1147,13 +1223,16 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const BroadcastNode* op) {
 }
 
 void CodeGenLLVM::VisitStmt_(const StoreNode* op) {
-  CHECK(is_one(op->predicate));
   DataType t = op->value.dtype();
   bool is_volatile = volatile_buf_.count(op->buffer_var.get());
   llvm::Value* buffer = MakeValue(op->buffer_var);
   llvm::Value* index = MakeValue(op->index);
   llvm::Value* value = MakeValue(op->value);
 
+  if (!is_one(op->predicate)) {
+    CreateMaskedStore(op, buffer, index, value);
+    return;
+  }
   if (t.lanes() == 1) {
     int alignment, native_bits;
     GetAlignment(t, op->buffer_var.get(), op->index, &alignment, &native_bits);
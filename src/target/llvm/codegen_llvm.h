@@ -267,6 +267,10 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
   llvm::Value* CreateMul(DataType t, llvm::Value* a, llvm::Value* b);
   llvm::Value* CreateBroadcast(llvm::Value* value, int lanes);
   llvm::Value* CreateBufferPtr(DataType t, llvm::Value* buffer, llvm::Value* index);
+  // Predicated vector load and store with the masked intrinsics.
+  llvm::Value* CreateMaskedLoad(const LoadNode* op, llvm::Value* buffer, llvm::Value* index);
+  void CreateMaskedStore(const StoreNode* op, llvm::Value* buffer, llvm::Value* index,
+                         llvm::Value* value);
   // Vector concatenation.
   llvm::Value* CreateVecSlice(llvm::Value* vec, int begin, int extent);
   llvm::Value* CreateVecFlip(llvm::Value* vec);
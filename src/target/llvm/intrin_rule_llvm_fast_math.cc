@@ -0,0 +1,267 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file intrin_rule_llvm_fast_math.cc
+ * \brief Polynomial approximations of the float32 transcendentals.
+ *
+ *  LowerIntrin looks up tvm.intrin.rule.llvm.fast_math.<op> when the pass config
+ *  tir.LowerIntrin sets fast_math_max_ulp, and calls the rule with the call and the
+ *  max error in ulp. The rule returns the cheapest tier whose error bound is within
+ *  the max error, or the call itself when no tier is accurate enough.
+ *
+ *  The approximations only use arithmetic, compares and selects, so they are
+ *  vectorized with the loop instead of calling libm per lane.
+ *
+ *    op        tier bounds (ulp)
+ *    exp       2, 8
+ *    log       2, 16
+ *    sigmoid   4, 8
+ *    tanh      2, 8
+ *    erf       8
+ *
+ *  The bounds hold on the inputs with a normal float32 result, and leave a margin
+ *  over the max error measured on a dense sweep of the inputs.
+ */
+#ifdef TVM_LLVM_VERSION
+
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace codegen {
+namespace llvm {
+
+using tir::make_const;
+
+// An approximation of an op, and the bound of its error in ulp.
+struct FastMathTier {
+  int max_ulp;
+  std::function<PrimExpr(const PrimExpr&)> fapprox;
+};
+
+// Bind the value to a var, so that it is computed once when used several times.
+PrimExpr LetBind(const PrimExpr& value, const std::string& name,
+                 std::function<PrimExpr(const PrimExpr&)> fbody) {
+  if (value.as<tir::VarNode>() || value.as<FloatImmNode>() || value.as<tir::BroadcastNode>()) {
+    return fbody(value);
+  }
+  tir::Var var(name, value.dtype());
+  return tir::Let(var, value, fbody(var));
+}
+
+// Evaluate the polynomial with the coefficients from the highest degree.
+PrimExpr Horner(const PrimExpr& x, const std::vector<double>& coeffs) {
+  PrimExpr y = make_const(x.dtype(), coeffs[0]);
+  for (size_t i = 1; i < coeffs.size(); ++i) {
+    y = y * x + make_const(x.dtype(), coeffs[i]);
+  }
+  return y;
+}
+
+// exp(x) = 2^n * exp(r), n = round(x / ln2), r = x - n * ln2 with ln2 split in two
+// constants so that r is exact, and exp(r) = 1 + r + r^2 * p(r) on [-ln2/2, ln2/2].
+// 2^n is made from the exponent bits in two halves, so that it does not overflow
+// for the subnormal results.
+PrimExpr ExpPoly(const PrimExpr& x, const std::vector<double>& coeffs) {
+  DataType t = x.dtype();
+  DataType it = DataType::Int(32, t.lanes());
+  auto c = [&](double v) { return make_const(t, v); };
+  PrimExpr xc = max(min(x, c(88.72283935546875)), c(-104.0));
+  return LetBind(floor(xc * c(1.44269504088896341) + c(0.5)), "n", [&](const PrimExpr& n) {
+    PrimExpr r = xc - n * c(0.693359375) - n * c(-2.12194440e-4);
+    return LetBind(r, "r", [&](const PrimExpr& r) {
+      PrimExpr y = Horner(r, coeffs) * r * r + r + c(1.0);
+      return LetBind(cast(it, n), "ni", [&](const PrimExpr& ni) {
+        PrimExpr n1 = ni >> 1;
+        PrimExpr n2 = ni - n1;
+        PrimExpr e1 = reinterpret(t, (n1 + make_const(it, 127)) << make_const(it, 23));
+        PrimExpr e2 = reinterpret(t, (n2 + make_const(it, 127)) << make_const(it, 23));
+        return tir::Select(isnan(x), x, y * e1 * e2);
+      });
+    });
+  });
+}
+
+// log(x) = e * ln2 + log(1 + f), with 1 + f the mantissa of x in [sqrt(0.5), sqrt(2)),
+// and log(1 + f) = f - f^2 / 2 + f^3 * p(f). The subnormal inputs are scaled by 2^23.
+PrimExpr LogPoly(const PrimExpr& x, const std::vector<double>& coeffs) {
+  DataType t = x.dtype();
+  DataType it = DataType::Int(32, t.lanes());
+  auto c = [&](double v) { return make_const(t, v); };
+  PrimExpr subnormal = x < c(std::numeric_limits<float>::min());
+  PrimExpr xs = tir::Select(subnormal, x * c(8388608.0), x);
+  PrimExpr ret = LetBind(reinterpret(it, xs), "bits", [&](const PrimExpr& bits) {
+    PrimExpr e = cast(t, ((bits >> 23) & make_const(it, 0xff)) - make_const(it, 126));
+    e = e - tir::Select(subnormal, c(23.0), c(0.0));
+    // Keep the mantissa bits, and set the exponent of 0.5.
+    PrimExpr mantissa = bits & make_const(it, static_cast<int32_t>(0x807fffff));
+    PrimExpr m = reinterpret(t, mantissa | make_const(it, 0x3f000000));
+    return LetBind(m, "m", [&](const PrimExpr& m) {
+      PrimExpr small = m < c(0.707106781186547524);
+      PrimExpr f = tir::Select(small, m + m, m) - c(1.0);
+      e = tir::Select(small, e - c(1.0), e);
+      return LetBind(e, "e", [&](const PrimExpr& e) {
+        return LetBind(f, "f", [&](const PrimExpr& f) {
+          PrimExpr z = f * f;
+          PrimExpr y = Horner(f, coeffs) * f * z + e * c(-2.12194440e-4) - c(0.5) * z;
+          return f + y + e * c(0.693359375);
+        });
+      });
+    });
+  });
+  PrimExpr inf = c(std::numeric_limits<float>::infinity());
+  PrimExpr nan = c(std::numeric_limits<float>::quiet_NaN());
+  // x < inf is false for inf and nan, which are returned as is.
+  return tir::Select(x < c(0.0), nan,
+                     tir::Select(x == c(0.0), -inf, tir::Select(x < inf, ret, x)));
+}
+
+// The odd rational approximations of tanh and erf, clamped to [-bound, bound].
+PrimExpr OddRational(const PrimExpr& x, double bound, const std::vector<double>& alpha,
+                     const std::vector<double>& beta) {
+  DataType t = x.dtype();
+  PrimExpr xc = max(min(x, make_const(t, bound)), make_const(t, -bound));
+  PrimExpr ret = LetBind(xc, "xc", [&](const PrimExpr& xc) {
+    return LetBind(xc * xc, "x2", [&](const PrimExpr& x2) {
+      return xc * Horner(x2, alpha) / Horner(x2, beta);
+    });
+  });
+  return tir::Select(isnan(x), x, ret);
+}
+
+// Cephes expf, the coefficients of p(r) from the highest degree.
+const std::vector<double> kExpCoeffs = {1.9875691500E-4, 1.3981999507E-3, 8.3334519073E-3,
+                                        4.1665795894E-2, 1.6666665459E-1, 5.0000001201E-1};
+// The degree 3 least squares fit of p(r) on the Chebyshev nodes of [-ln2/2, ln2/2].
+const std::vector<double> kFastExpCoeffs = {8.363175205886364E-3, 4.1833825409412384E-2,
+                                            1.6666576266288757E-1, 4.9999749660491943E-1};
+// Cephes logf, the coefficients of p(f) from the highest degree.
+const std::vector<double> kLogCoeffs = {7.0376836292E-2,  -1.1514610310E-1, 1.1676998740E-1,
+                                        -1.2420140846E-1, 1.4249322787E-1,  -1.6668057665E-1,
+                                        2.0000714765E-1,  -2.4999993993E-1, 3.3333331174E-1};
+// The degree 5 least squares fit of p(f) on the Chebyshev nodes of
+// [sqrt(0.5) - 1, sqrt(2) - 1].
+const std::vector<double> kFastLogCoeffs = {-1.0743682086467743E-1, 1.5903149545192719E-1,
+                                            -1.6973306238651276E-1, 1.994013488292694E-1,
+                                            -2.499254196882248E-1,  3.333369791507721E-1};
+
+PrimExpr FastMathExp(const PrimExpr& x) { return ExpPoly(x, kFastExpCoeffs); }
+
+PrimExpr AccurateExp(const PrimExpr& x) { return ExpPoly(x, kExpCoeffs); }
+
+PrimExpr FastMathLog(const PrimExpr& x) { return LogPoly(x, kFastLogCoeffs); }
+
+PrimExpr AccurateLog(const PrimExpr& x) { return LogPoly(x, kLogCoeffs); }
+
+PrimExpr Sigmoid(const PrimExpr& x, const std::vector<double>& exp_coeffs) {
+  PrimExpr one = make_const(x.dtype(), 1.0);
+  return one / (one + ExpPoly(-x, exp_coeffs));
+}
+
+// The rational approximation of Eigen, the same as topi fast_tanh.
+PrimExpr FastMathTanh(const PrimExpr& x) {
+  return OddRational(x, 9.0,
+                     {-2.76076847742355e-16, 2.00018790482477e-13, -8.60467152213735e-11,
+                      5.12229709037114e-08, 1.48572235717979e-05, 6.37261928875436e-04,
+                      4.89352455891786e-03},
+                     {1.19825839466702e-06, 1.18534705686654e-04, 2.26843463243900e-03,
+                      4.89352518554385e-03});
+}
+
+// Cephes tanhf, an odd polynomial for |x| < 0.625, and 1 - 2 / (exp(2|x|) + 1) otherwise.
+PrimExpr AccurateTanh(const PrimExpr& x) {
+  DataType t = x.dtype();
+  auto c = [&](double v) { return make_const(t, v); };
+  return LetBind(x, "x", [&](const PrimExpr& x) {
+    PrimExpr z = x * x;
+    PrimExpr small = Horner(z,
+                            {-5.70498872745E-3, 2.06390887954E-2, -5.37397155531E-2,
+                             1.33314422036E-1, -3.33332819422E-1}) *
+                         z * x +
+                     x;
+    PrimExpr abs_x = abs(x);
+    PrimExpr large = c(1.0) - c(2.0) / (AccurateExp(abs_x + abs_x) + c(1.0));
+    return tir::Select(abs_x < c(0.625), small, tir::Select(x < c(0.0), -large, large));
+  });
+}
+
+// The rational approximation of Eigen, the same as topi fast_erf.
+PrimExpr FastMathErf(const PrimExpr& x) {
+  return OddRational(x, 4.0,
+                     {-2.72614225801306e-10, 2.77068142495902e-08, -2.10102402082508e-06,
+                      -5.69250639462346e-05, -7.34990630326855e-04, -2.95459980854025e-03,
+                      -1.60960333262415e-02},
+                     {-1.45660718464996e-05, -2.13374055278905e-04, -1.68282697438203e-03,
+                      -7.37332916720468e-03, -1.42647390514189e-02});
+}
+
+// Return the first tier within the max error, the tiers are ordered from the cheapest.
+PrimExpr DispatchFastMath(const PrimExpr& e, int max_ulp, const std::vector<FastMathTier>& tiers) {
+  const tir::CallNode* call = e.as<tir::CallNode>();
+  CHECK(call != nullptr);
+  if (call->dtype.element_of() != DataType::Float(32)) return e;
+  for (const FastMathTier& tier : tiers) {
+    if (tier.max_ulp <= max_ulp) {
+      return tier.fapprox(call->args[0]);
+    }
+  }
+  return e;
+}
+
+TVM_REGISTER_GLOBAL("tvm.intrin.rule.llvm.fast_math.exp")
+    .set_body_typed([](PrimExpr e, int max_ulp) {
+      return DispatchFastMath(e, max_ulp, {{8, FastMathExp}, {2, AccurateExp}});
+    });
+
+TVM_REGISTER_GLOBAL("tvm.intrin.rule.llvm.fast_math.log")
+    .set_body_typed([](PrimExpr e, int max_ulp) {
+      return DispatchFastMath(e, max_ulp, {{16, FastMathLog}, {2, AccurateLog}});
+    });
+
+TVM_REGISTER_GLOBAL("tvm.intrin.rule.llvm.fast_math.sigmoid")
+    .set_body_typed([](PrimExpr e, int max_ulp) {
+      return DispatchFastMath(
+          e, max_ulp,
+          {{8, [](const PrimExpr& x) { return Sigmoid(x, kFastExpCoeffs); }},
+           {4, [](const PrimExpr& x) { return Sigmoid(x, kExpCoeffs); }}});
+    });
+
+TVM_REGISTER_GLOBAL("tvm.intrin.rule.llvm.fast_math.tanh")
+    .set_body_typed([](PrimExpr e, int max_ulp) {
+      return DispatchFastMath(e, max_ulp, {{8, FastMathTanh}, {2, AccurateTanh}});
+    });
+
+TVM_REGISTER_GLOBAL("tvm.intrin.rule.llvm.fast_math.erf")
+    .set_body_typed([](PrimExpr e, int max_ulp) {
+      return DispatchFastMath(e, max_ulp, {{8, FastMathErf}});
+    });
+
+}  // namespace llvm
+}  // namespace codegen
+}  // namespace tvm
+
+#endif  // LLVM_VERSION
@@ -0,0 +1,236 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file insert_prefetch.cc
+ * \brief Insert software prefetch for the strided loads of the innermost loops.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/pattern.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <cstdlib>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+
+struct InsertPrefetchConfigNode : public tvm::AttrsNode<InsertPrefetchConfigNode> {
+  int distance;
+  int cache_line_size;
+
+  TVM_DECLARE_ATTRS(InsertPrefetchConfigNode, "tir.transform.InsertPrefetchConfig") {
+    TVM_ATTR_FIELD(distance)
+        .describe(
+            "The number of iterations ahead to prefetch in the innermost loops, "
+            "0 only prefetches in the loops annotated with pragma prefetch_distance")
+        .set_default(0);
+    TVM_ATTR_FIELD(cache_line_size)
+        .describe("The size of the CPU cache line in bytes")
+        .set_default(64);
+  }
+};
+
+class InsertPrefetchConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(InsertPrefetchConfig, Attrs,
+                                            InsertPrefetchConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(InsertPrefetchConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.InsertPrefetch", InsertPrefetchConfig);
+
+// Collect the loads of a loop body, and the vars that are defined in it.
+class LoopBodyLoadCollector : public StmtExprVisitor {
+ public:
+  void VisitStmt_(const LetStmtNode* op) final {
+    defined_.insert(op->var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const LetNode* op) final {
+    defined_.insert(op->var.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    defined_.insert(op->buffer_var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const LoadNode* op) final {
+    loads_.push_back(op);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::address_of())) {
+      // Taking the address does not read the memory.
+      const LoadNode* l = op->args[0].as<LoadNode>();
+      CHECK(l != nullptr);
+      this->VisitExpr(l->index);
+    } else {
+      StmtExprVisitor::VisitExpr_(op);
+    }
+  }
+
+  std::vector<const LoadNode*> loads_;
+  std::unordered_set<const VarNode*> defined_;
+};
+
+class PrefetchInserter : public StmtMutator {
+ public:
+  PrefetchInserter(int distance, int cache_line_size)
+      : distance_(distance), cache_line_size_(cache_line_size) {}
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == "pragma_prefetch_distance") {
+      int value = static_cast<int>(Downcast<Integer>(op->value)->value);
+      std::swap(value, distance_);
+      Stmt ret = this->VisitStmt(op->body);
+      std::swap(value, distance_);
+      return ret;
+    } else {
+      return StmtMutator::VisitStmt_(op);
+    }
+  }
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    has_loop_ = false;
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    bool innermost = !has_loop_;
+    has_loop_ = true;
+    op = stmt.as<ForNode>();
+    if (!innermost || distance_ <= 0 ||
+        (op->for_type != ForType::Serial && op->for_type != ForType::Unrolled)) {
+      return stmt;
+    }
+    Array<Stmt> prefetches = MakePrefetches(op);
+    if (prefetches.empty()) return stmt;
+    prefetches.push_back(op->body);
+    return For(op->loop_var, op->min, op->extent, op->for_type, op->device_api,
+               SeqStmt(prefetches));
+  }
+
+ private:
+  // A strided access of the loop, address = base + stride * loop_var.
+  struct StridedAccess {
+    Var buffer_var;
+    DataType dtype;
+    PrimExpr base;
+    int64_t stride;
+  };
+
+  // Make a prefetch for every strided load of the loop that moves by at least a
+  // cache line per iteration. Accesses with a smaller stride are left to the
+  // hardware prefetcher.
+  Array<Stmt> MakePrefetches(const ForNode* op) {
+    LoopBodyLoadCollector collector;
+    collector(op->body);
+    auto defined_in_body = [&](const VarNode* v) { return collector.defined_.count(v) != 0; };
+
+    std::vector<StridedAccess> accesses;
+    for (const LoadNode* load : collector.loads_) {
+      if (defined_in_body(load->buffer_var.get())) continue;
+      PrimExpr index = load->index;
+      if (const RampNode* ramp = index.as<RampNode>()) {
+        index = ramp->base;
+      }
+      if (index.dtype().lanes() != 1 || ExprUseVar(index, defined_in_body)) continue;
+      Array<PrimExpr> coeff = arith::DetectLinearEquation(index, {op->loop_var});
+      if (coeff.size() != 2) continue;
+      const int64_t* stride = as_const_int(analyzer_.Simplify(coeff[0]));
+      if (stride == nullptr || *stride == 0) continue;
+      DataType dtype = load->dtype.element_of();
+      if (std::abs(*stride) * dtype.bytes() < cache_line_size_) continue;
+      StridedAccess access{load->buffer_var, dtype, coeff[1], *stride};
+      if (!CoveredBy(access, accesses)) {
+        accesses.push_back(access);
+      }
+    }
+
+    Array<Stmt> prefetches;
+    for (const StridedAccess& access : accesses) {
+      PrimExpr offset = op->loop_var + make_const(op->loop_var.dtype(), distance_);
+      PrimExpr index = analyzer_.Simplify(
+          access.base + make_const(access.base.dtype(), access.stride) *
+                            cast(access.base.dtype(), offset));
+      PrimExpr load = Load(access.dtype, access.buffer_var, index, const_true());
+      PrimExpr address = Call(DataType::Handle(), builtin::address_of(), {load});
+      prefetches.push_back(
+          Evaluate(Call(access.dtype, builtin::prefetch(), {address, 0, 3, 1})));
+    }
+    return prefetches;
+  }
+
+  // Whether the cache line of the access is already prefetched for another access.
+  bool CoveredBy(const StridedAccess& access, const std::vector<StridedAccess>& accesses) {
+    for (const StridedAccess& other : accesses) {
+      if (!other.buffer_var.same_as(access.buffer_var) || other.stride != access.stride ||
+          other.dtype != access.dtype || other.base.dtype() != access.base.dtype()) {
+        continue;
+      }
+      const int64_t* diff = as_const_int(analyzer_.Simplify(access.base - other.base));
+      if (diff != nullptr && std::abs(*diff) * access.dtype.bytes() < cache_line_size_) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // the number of iterations ahead to prefetch.
+  int distance_;
+  // the size of the cache line in bytes.
+  int cache_line_size_;
+  // whether a loop is found in the visited statements.
+  bool has_loop_{false};
+  // analyzer
+  arith::Analyzer analyzer_;
+};
+
+namespace transform {
+
+Pass InsertPrefetch() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    auto cfg = ctx->GetConfig<InsertPrefetchConfig>("tir.InsertPrefetch");
+    if (!cfg.defined()) {
+      cfg = AttrsWithDefaultValues<InsertPrefetchConfig>();
+    }
+    n->body = PrefetchInserter(cfg.value()->distance, cfg.value()->cache_line_size)(
+        std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.InsertPrefetch", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.InsertPrefetch").set_body_typed(InsertPrefetch);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
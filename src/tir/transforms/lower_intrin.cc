@@ -35,13 +35,34 @@
 namespace tvm {
 namespace tir {
 
+struct LowerIntrinConfigNode : public tvm::AttrsNode<LowerIntrinConfigNode> {
+  int fast_math_max_ulp;
+
+  TVM_DECLARE_ATTRS(LowerIntrinConfigNode, "tir.transform.LowerIntrinConfig") {
+    TVM_ATTR_FIELD(fast_math_max_ulp)
+        .describe(
+            "The max error in ulp of the float32 approximations of the transcendentals "
+            "that the target can lower to, 0 disables the approximations")
+        .set_default(0);
+  }
+};
+
+class LowerIntrinConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(LowerIntrinConfig, Attrs, LowerIntrinConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(LowerIntrinConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.LowerIntrin", LowerIntrinConfig);
+
 class IntrinInjecter : public tvm::arith::IRMutatorWithAnalyzer {
  public:
   using IRMutatorWithAnalyzer::VisitExpr_;
   using IRMutatorWithAnalyzer::VisitStmt_;
 
-  IntrinInjecter(arith::Analyzer* analyzer, std::string target, std::string mtriple = "")
-      : IRMutatorWithAnalyzer(analyzer) {
+  IntrinInjecter(arith::Analyzer* analyzer, std::string target, std::string mtriple = "",
+                 int fast_math_max_ulp = 0)
+      : IRMutatorWithAnalyzer(analyzer), fast_math_max_ulp_(fast_math_max_ulp) {
     patterns_.push_back("tvm.intrin.rule." + target + ".");
 
     bool is_llvm_aarch64 = (mtriple.find("aarch64") != std::string::npos);
@@ -62,6 +83,10 @@ class IntrinInjecter : public tvm::arith::IRMutatorWithAnalyzer {
       // TODO(tvm-team): migrate the pattern application from global function look up
       // to an OpAttrMap<PackedFunc>
       std::string name = ptr_op->name;
+      if (fast_math_max_ulp_ > 0 && op->dtype.element_of() == DataType::Float(32)) {
+        PrimExpr r = ApplyFastMathPattern(name, GetRef<PrimExpr>(op));
+        if (r.defined()) return r;
+      }
       PrimExpr r = ApplyPattern(name, GetRef<PrimExpr>(op));
       if (r.defined()) return r;
     }
@@ -290,10 +315,25 @@ class IntrinInjecter : public tvm::arith::IRMutatorWithAnalyzer {
     return PrimExpr();
   }
 
+  // Lower to the approximation of the target within the max error, if there is one.
+  PrimExpr ApplyFastMathPattern(std::string name, const PrimExpr& e) {
+    if (name.compare(0, 4, "tir.") == 0) {
+      name = name.substr(4);
+    }
+    const runtime::PackedFunc* f = runtime::Registry::Get(patterns_[0] + "fast_math." + name);
+    if (f == nullptr) return PrimExpr();
+    PrimExpr r = (*f)(e, fast_math_max_ulp_);
+    CHECK(r.defined()) << "intrinsic rule must always return valid Expr";
+    if (r.same_as(e)) return PrimExpr();
+    return this->VisitExpr(r);
+  }
+
   // patterns
   std::vector<std::string> patterns_;
   const PackedFunc* fma_{nullptr};
   bool support_bitwise_op_{true};
+  // the max error in ulp of the float32 approximations, 0 disables them.
+  int fast_math_max_ulp_;
 };
 
 Stmt LowerIntrinStmt(Stmt stmt, const std::string& target) {
@@ -310,8 +350,12 @@ Pass LowerIntrin() {
     CHECK(target.defined()) << "LowerIntrin: Require the target attribute";
     arith::Analyzer analyzer;
     auto mtriple = target.value()->GetAttr<runtime::String>("mtriple", "");
-    n->body =
-        IntrinInjecter(&analyzer, target.value()->kind->name, mtriple.value())(std::move(n->body));
+    auto cfg = ctx->GetConfig<LowerIntrinConfig>("tir.LowerIntrin");
+    if (!cfg.defined()) {
+      cfg = AttrsWithDefaultValues<LowerIntrinConfig>();
+    }
+    n->body = IntrinInjecter(&analyzer, target.value()->kind->name, mtriple.value(),
+                             cfg.value()->fast_math_max_ulp)(std::move(n->body));
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.LowerIntrin", {});
@@ -177,6 +177,9 @@ class LinearAccessPatternFinder final : public StmtExprVisitor {
       VisitNewScope(op);
     } else if (op->attr_key == attr::virtual_thread) {
       VisitNewScope(op);
+    } else if (op->attr_key == "pragma_parallel_launch_point" && !in_thread_env_) {
+      // the allocations of the parallel loops in the launch are made once per task.
+      VisitNewScope(op);
     } else if (op->attr_key == attr::storage_scope) {
       const VarNode* buf = op->node.as<VarNode>();
       alloc_info_[buf].storage_scope = StorageScope::Create(op->value.as<StringImmNode>()->value);
@@ -754,9 +757,12 @@ class StoragePlanRewriter : public StmtExprMutator {
       // enter/exit new scope
       if (s.stmt->IsInstance<AttrStmtNode>()) {
         const auto* op = static_cast<const AttrStmtNode*>(s.stmt);
-        if (op->attr_key == attr::thread_extent || op->attr_key == attr::virtual_thread ||
-            attr::IsPragmaKey(op->attr_key)) {
+        if (op->attr_key == attr::thread_extent || op->attr_key == attr::virtual_thread) {
           PlanNewScope(op);
+        } else if (attr::IsPragmaKey(op->attr_key)) {
+          if (thread_scope_ == nullptr || thread_scope_ == op) {
+            PlanNewScope(op);
+          }
         } else {
           CHECK(op->attr_key == attr::extern_scope);
         }
@@ -951,7 +957,132 @@ class VectorAllocRewriter : public StmtExprMutator {
   arith::Analyzer analyzer_;
 };
 
+// Group the top level parallel loops that allocate per-iteration scratch
+// into parallel launch points, so that the storage planner attaches the
+// scratch to the launch instead of to every iteration of the loop.
+// Each task then allocates the scratch once per launch and reuses it over
+// the iterations it runs. Consecutive sibling loops share the launch, they
+// are separated by barriers, so their scratch can also share storage.
+class ParallelScratchHoister : public StmtMutator {
+ public:
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::thread_extent || op->attr_key == attr::virtual_thread ||
+        op->attr_key == "pragma_parallel_launch_point") {
+      return GetRef<Stmt>(op);
+    }
+    return StmtMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    if (op->for_type != ForType::Parallel) {
+      return StmtMutator::VisitStmt_(op);
+    }
+    bool has_scratch = false;
+    if (CanHoist(op, &has_scratch) && has_scratch) {
+      return MakeLaunch({GetRef<Stmt>(op)});
+    }
+    return GetRef<Stmt>(op);
+  }
+
+  Stmt VisitStmt_(const SeqStmtNode* op) final {
+    Array<Stmt> seq;
+    Array<Stmt> loops;
+    bool has_scratch = false;
+    auto flush = [&]() {
+      if (has_scratch) {
+        seq.push_back(MakeLaunch(loops));
+      } else {
+        for (Stmt loop : loops) seq.push_back(loop);
+      }
+      loops.clear();
+      has_scratch = false;
+    };
+    for (Stmt stmt : op->seq) {
+      const ForNode* loop = stmt.as<ForNode>();
+      bool loop_has_scratch = false;
+      if (loop != nullptr && loop->for_type == ForType::Parallel &&
+          CanHoist(loop, &loop_has_scratch)) {
+        has_scratch = has_scratch || loop_has_scratch;
+        loops.push_back(stmt);
+      } else {
+        flush();
+        seq.push_back(this->VisitStmt(stmt));
+      }
+    }
+    flush();
+    return SeqStmt::Flatten(seq);
+  }
+
+ private:
+  // Whether the loop can run in a launch point with all its allocations hoisted.
+  bool CanHoist(const ForNode* op, bool* has_scratch) {
+    ScratchCollector collector = ScratchCollector::Collect(op);
+    *has_scratch = collector.allocs.size() != 0;
+    if (collector.nested_parallel) return false;
+    auto defined_in_loop = [&](const VarNode* v) { return collector.defined.count(v) != 0; };
+    for (const AllocateNode* alloc : collector.allocs) {
+      for (const PrimExpr& extent : alloc->extents) {
+        if (ExprUseVar(extent, defined_in_loop)) return false;
+      }
+      if (ExprUseVar(alloc->condition, defined_in_loop)) return false;
+    }
+    return true;
+  }
+
+  // All the loops but the last wait for the other tasks before the next loop starts.
+  Stmt MakeLaunch(const Array<Stmt>& loops) {
+    Array<Stmt> seq;
+    for (size_t i = 0; i < loops.size(); ++i) {
+      if (i + 1 == loops.size()) {
+        seq.push_back(loops[i]);
+      } else {
+        seq.push_back(AttrStmt(make_zero(DataType::Int(32)), "pragma_parallel_barrier_when_finish",
+                               1, loops[i]));
+      }
+    }
+    return AttrStmt(make_zero(DataType::Int(32)), "pragma_parallel_launch_point", 1,
+                    SeqStmt::Flatten(seq));
+  }
+
+  // Collect the allocations of a parallel loop and the vars defined in it.
+  struct ScratchCollector : public StmtExprVisitor {
+    static ScratchCollector Collect(const ForNode* op) {
+      ScratchCollector collector;
+      collector.defined.insert(op->loop_var.get());
+      collector(op->body);
+      return collector;
+    }
+
+    void VisitStmt_(const ForNode* op) final {
+      if (op->for_type == ForType::Parallel) nested_parallel = true;
+      defined.insert(op->loop_var.get());
+      StmtExprVisitor::VisitStmt_(op);
+    }
+
+    void VisitStmt_(const LetStmtNode* op) final {
+      defined.insert(op->var.get());
+      StmtExprVisitor::VisitStmt_(op);
+    }
+
+    void VisitExpr_(const LetNode* op) final {
+      defined.insert(op->var.get());
+      StmtExprVisitor::VisitExpr_(op);
+    }
+
+    void VisitStmt_(const AllocateNode* op) final {
+      defined.insert(op->buffer_var.get());
+      allocs.push_back(op);
+      StmtExprVisitor::VisitStmt_(op);
+    }
+
+    std::vector<const AllocateNode*> allocs;
+    std::unordered_set<const VarNode*> defined;
+    bool nested_parallel{false};
+  };
+};
+
 Stmt StorageRewrite(Stmt stmt) {
+  stmt = ParallelScratchHoister()(std::move(stmt));
   stmt = StoragePlanRewriter().Rewrite(std::move(stmt), true);
   return VectorAllocRewriter()(std::move(stmt));
 }
@@ -1000,6 +1131,7 @@ namespace transform {
 Pass StorageRewrite() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
+    n->body = ParallelScratchHoister()(std::move(n->body));
     n->body = StoragePlanRewriter().Rewrite(std::move(n->body), true);
     n->body = VectorAllocRewriter()(std::move(n->body));
     return f;
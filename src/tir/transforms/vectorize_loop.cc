@@ -38,6 +38,27 @@
 namespace tvm {
 namespace tir {
 
+struct VectorizeLoopConfigNode : public tvm::AttrsNode<VectorizeLoopConfigNode> {
+  bool enable_predication;
+
+  TVM_DECLARE_ATTRS(VectorizeLoopConfigNode, "tir.transform.VectorizeLoopConfig") {
+    TVM_ATTR_FIELD(enable_predication)
+        .describe(
+            "Keep the conditional stores and if_then_else that depend on the vectorized loop var "
+            "vectorized with predicated loads and stores, instead of scalarizing them. "
+            "Only the LLVM backend can generate predicated accesses.")
+        .set_default(false);
+  }
+};
+
+class VectorizeLoopConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(VectorizeLoopConfig, Attrs, VectorizeLoopConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(VectorizeLoopConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.VectorizeLoop", VectorizeLoopConfig);
+
 inline PrimExpr BroadcastTo(PrimExpr e, int lanes) {
   if (e.dtype().lanes() == lanes) return e;
   if (const BroadcastNode* op = e.as<BroadcastNode>()) {
@@ -92,6 +113,67 @@ class VecAllocAccess : public StmtExprMutator {
   int var_lanes_;
 };
 
+// Check whether a statement can run on all the lanes under a predicate.
+// Only stores are allowed, and the expressions must be safe to evaluate
+// in the lanes that are masked off, which excludes integer division by
+// a non-constant and calls with side effects.
+class PredicableChecker : public StmtExprVisitor {
+ public:
+  static bool Check(const Stmt& stmt) {
+    PredicableChecker checker;
+    checker(stmt);
+    return checker.predicable_;
+  }
+
+  static bool Check(const PrimExpr& expr) {
+    PredicableChecker checker;
+    checker(expr);
+    return checker.predicable_;
+  }
+
+  void VisitStmt(const Stmt& stmt) final {
+    if (!predicable_) return;
+    if (stmt.as<StoreNode>() || stmt.as<SeqStmtNode>() || stmt.as<IfThenElseNode>()) {
+      StmtExprVisitor::VisitStmt(stmt);
+    } else {
+      predicable_ = false;
+    }
+  }
+
+  void VisitExpr(const PrimExpr& expr) final {
+    if (!predicable_) return;
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  void VisitExpr_(const DivNode* op) final { VisitDivision(op); }
+  void VisitExpr_(const ModNode* op) final { VisitDivision(op); }
+  void VisitExpr_(const FloorDivNode* op) final { VisitDivision(op); }
+  void VisitExpr_(const FloorModNode* op) final { VisitDivision(op); }
+
+  void VisitExpr_(const CallNode* op) final {
+    auto* op_ptr = op->op.as<OpNode>();
+    if (!op->op.same_as(builtin::if_then_else()) &&
+        !(op_ptr && op_vectorizable_.get(GetRef<Op>(op_ptr), false))) {
+      predicable_ = false;
+      return;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+ private:
+  template <typename T>
+  void VisitDivision(const T* op) {
+    if (!op->dtype.is_float() && !is_const_int(op->b)) {
+      predicable_ = false;
+      return;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  bool predicable_{true};
+  OpAttrMap<TVectorizable> op_vectorizable_ = Op::GetAttrMap<TVectorizable>("TVectorizable");
+};
+
 // We use ExprFunctor directly instead of StmtExprMutator
 // This is because the transformation can change the dtype of the Expr
 // The existing ExprMutator transformation rules may not be well defined.
@@ -100,7 +182,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   using ExprFunctor::VisitExpr;
   using StmtMutator::operator();
 
-  Vectorizer(Var var, int var_lanes) : var_(var), var_lanes_(var_lanes) {
+  Vectorizer(Var var, int var_lanes, bool enable_predication)
+      : var_(var), var_lanes_(var_lanes), enable_predication_(enable_predication) {
     ramp_ = Ramp(0, 1, var_lanes);
   }
 
@@ -247,6 +330,16 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   PrimExpr MutateIfThenElseExpr_(const CallNode* op) {
     PrimExpr cond = this->VisitExpr(op->args[0]);
     if (cond.dtype().is_vector()) {
+      if (enable_predication_ && PredicableChecker::Check(op->args[1]) &&
+          PredicableChecker::Check(op->args[2])) {
+        // Evaluate both branches and select, the loads of a branch are
+        // predicated so that the masked off lanes do not access memory.
+        Var mask("mask", cond.dtype());
+        PrimExpr t = VisitUnderPredicate(mask, op->args[1]);
+        PrimExpr f = VisitUnderPredicate(!mask, op->args[2]);
+        int lanes = cond.dtype().lanes();
+        return Let(mask, cond, Select(mask, BroadcastTo(t, lanes), BroadcastTo(f, lanes)));
+      }
       need_scalarize_ = true;
       return GetRef<PrimExpr>(op);
     }
@@ -300,6 +393,9 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   PrimExpr VisitExpr_(const LoadNode* op) final {
     PrimExpr index = this->VisitExpr(op->index);
     PrimExpr pred = this->VisitExpr(op->predicate);
+    if (predicate_.defined()) {
+      pred = is_one(pred) ? predicate_ : BroadcastTo(pred, var_lanes_) && predicate_;
+    }
     if (index.same_as(op->index) && pred.same_as(op->predicate)) {
       return GetRef<PrimExpr>(op);
     } else {
@@ -341,7 +437,16 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     PrimExpr value = this->VisitExpr(op->value);
     PrimExpr index = this->VisitExpr(op->index);
     PrimExpr pred = this->VisitExpr(op->predicate);
-    if (value.same_as(op->value) && index.same_as(op->index)) {
+    if (predicate_.defined()) {
+      // A store to the same address from every lane is not a vector store, the
+      // branch runs on the scalar lanes instead.
+      if (index.dtype().lanes() == 1) {
+        need_scalarize_ = true;
+        return GetRef<Stmt>(op);
+      }
+      pred = is_one(pred) ? predicate_ : BroadcastTo(pred, var_lanes_) && predicate_;
+    }
+    if (value.same_as(op->value) && index.same_as(op->index) && pred.same_as(op->predicate)) {
       return GetRef<Stmt>(op);
     } else {
       int lanes = std::max(value.dtype().lanes(), index.dtype().lanes());
@@ -373,6 +478,10 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     CHECK(!op->condition.dtype().is_vector());
     PrimExpr condition = this->VisitExpr(op->condition);
     if (condition.dtype().is_vector()) {
+      if (enable_predication_) {
+        Stmt stmt = PredicateIfThenElse(op, condition);
+        if (stmt.defined()) return stmt;
+      }
       return Scalarize(GetRef<Stmt>(op));
     }
     Stmt then_case = this->VisitStmt(op->then_case);
@@ -431,8 +540,43 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     return Allocate(op->buffer_var, op->dtype, extents, condition, body);
   }
 
+  // Vectorize both branches of an IfThenElse with a vector condition into
+  // stores predicated by the condition, returns an undefined Stmt when
+  // a branch cannot be predicated.
+  Stmt PredicateIfThenElse(const IfThenElseNode* op, PrimExpr condition) {
+    if (!PredicableChecker::Check(op->then_case) ||
+        (op->else_case.defined() && !PredicableChecker::Check(op->else_case))) {
+      return Stmt();
+    }
+    int num_scalarized = num_scalarized_;
+    // Bind the condition, it is evaluated once before the stores of the branches.
+    Var mask("mask", condition.dtype());
+    Stmt then_case = VisitUnderPredicate(mask, op->then_case);
+    Stmt body = then_case;
+    if (op->else_case.defined()) {
+      Stmt else_case = VisitUnderPredicate(!mask, op->else_case);
+      body = SeqStmt({then_case, else_case});
+    }
+    // A part of the branches was scalarized without the predicate.
+    if (num_scalarized_ != num_scalarized) return Stmt();
+    return LetStmt(mask, condition, body);
+  }
+
+  // Vectorize a node of the lanes where mask is true.
+  template <typename T>
+  T VisitUnderPredicate(PrimExpr mask, const T& node) {
+    PrimExpr outer = predicate_;
+    predicate_ = outer.defined() ? outer && mask : mask;
+    T ret = Mutate(node);
+    predicate_ = outer;
+    return ret;
+  }
+  Stmt Mutate(const Stmt& stmt) { return this->VisitStmt(stmt); }
+  PrimExpr Mutate(const PrimExpr& expr) { return this->VisitExpr(expr); }
+
   // scalarize the statment
   Stmt Scalarize(Stmt stmt) {
+    ++num_scalarized_;
     Var idx(var_->name_hint + ".s", var_->dtype);
     Map<Var, PrimExpr> values{{var_, idx}};
     stmt = Substitute(stmt, values);
@@ -455,8 +599,14 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   int var_lanes_;
   // ramp representing the var.
   PrimExpr ramp_;
+  // whether conditional accesses can be vectorized with predicates.
+  bool enable_predication_;
   // flag to mark requirment of scalarization.
   bool need_scalarize_{false};
+  // the lanes that are active in the current conditional region.
+  PrimExpr predicate_;
+  // the number of statements that are scalarized.
+  int num_scalarized_{0};
   // Let binding
   std::unordered_map<Var, PrimExpr, ObjectPtrHash, ObjectPtrEqual> let_binding_;
   // vectorizable property
@@ -524,6 +674,9 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
 
 class LoopVectorizer : public StmtMutator {
  public:
+  explicit LoopVectorizer(bool enable_predication = false)
+      : enable_predication_(enable_predication) {}
+
   Stmt VisitStmt_(const ForNode* op) final {
     if (op->for_type == ForType::Vectorized) {
       CHECK(is_zero(op->min));
@@ -531,11 +684,15 @@ class LoopVectorizer : public StmtMutator {
       if (!extent_as_int || extent_as_int->value < 1) {
         LOG(FATAL) << "Failed to vectorize loop with extent " << op->extent;
       }
-      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value))(op->body);
+      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value),
+                        enable_predication_)(op->body);
     } else {
       return StmtMutator::VisitStmt_(op);
     }
   }
+
+ private:
+  bool enable_predication_;
 };
 
 Stmt VectorizeLoop(Stmt stmt) { return LoopVectorizer()(std::move(stmt)); }
@@ -562,7 +719,11 @@ Pass VectorizeLoop(bool enable_vectorize) {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
     if (enable_vectorize) {
-      n->body = LoopVectorizer()(std::move(n->body));
+      auto cfg = ctx->GetConfig<VectorizeLoopConfig>("tir.VectorizeLoop");
+      if (!cfg.defined()) {
+        cfg = AttrsWithDefaultValues<VectorizeLoopConfig>();
+      }
+      n->body = LoopVectorizer(cfg.value()->enable_predication)(std::move(n->body));
     } else {
       n->body = VectorizeSkipper()(std::move(n->body));
     }
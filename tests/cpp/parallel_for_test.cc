@@ -21,6 +21,7 @@
 #include <gtest/gtest.h>
 #include <tvm/support/parallel_for.h>
 
+#include <atomic>
 #include <vector>
 
 TEST(ParallelFor, Basic) {
@@ -89,21 +90,56 @@ TEST(ParallelFor, NestedWithNormalForLoop) {
   }
 }
 
-TEST(Parallelfor, NestedWithParallelFor) {
-  // Currently do not support using nested parallel_for
+TEST(ParallelFor, NestedWithParallelFor) {
   using tvm::support::parallel_for;
 
-  bool exception = false;
-  try {
-    parallel_for(0, 100, [](int i) {
-      parallel_for(0, 100, [](int j) {
-        // Blank loop
-      });
-    });
-  } catch (const std::exception& e) {
-    exception = true;
+  int a[100][100], b[100][100];
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j < 100; j++) {
+      a[i][j] = i * j;
+    }
+  }
+
+  // The inner parallel_for runs inline in the worker of the outer one
+  parallel_for(0, 100, [&b](int i) { parallel_for(0, 100, [&b, i](int j) { b[i][j] = i * j; }); });
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j < 100; j++) {
+      CHECK_EQ(a[i][j], b[i][j]);
+    }
+  }
+}
+
+TEST(ParallelFor, DynamicScheduling) {
+  using tvm::support::parallel_for;
+
+  // Uneven iterations and a step that does not divide the range
+  std::atomic<int> sum(0);
+  std::vector<int> visited(1001, 0);
+  parallel_for(
+      3, 1001,
+      [&sum, &visited](int i) {
+        volatile int spin = 0;
+        for (int k = 0; k < (i % 17) * 100; k++) {
+          spin = spin + k;
+        }
+        visited[i]++;
+        sum += i;
+      },
+      7);
+  int expected = 0;
+  for (int i = 3; i < 1001; i += 7) {
+    expected += i;
+    CHECK_EQ(visited[i], 1);
+  }
+  CHECK_EQ(sum.load(), expected);
+
+  // Custom static partitioner
+  std::vector<int> c(100, 0);
+  parallel_for(
+      0, 100, [&c](int i) { c[i] = i; }, 1, tvm::support::rr_partitioner);
+  for (int i = 0; i < 100; i++) {
+    CHECK_EQ(c[i], i);
   }
-  CHECK(exception);
 }
 
 TEST(ParallelFor, Exception) {
@@ -116,6 +152,11 @@ TEST(ParallelFor, Exception) {
     exception = true;
   }
   CHECK(exception);
+
+  // The pool keeps working after an exception
+  std::atomic<int> count(0);
+  parallel_for(0, 100, [&count](int i) { count++; });
+  CHECK_EQ(count.load(), 100);
 }
 
 int main(int argc, char** argv) {
@@ -90,6 +90,35 @@ def test_sort_np():
     tvm.testing.assert_allclose(c.asnumpy(), np_out, rtol=1e-5)
 
 
+def test_topk_dtypes():
+    rows, n, k = 6, 300, 7
+    ctx = tvm.cpu(0)
+    for dtype in ["float32", "float16", "int8"]:
+        data = te.placeholder((rows, n), name="data", dtype=dtype)
+        out = te.extern(
+            [(rows, k), (rows, k)],
+            [data],
+            lambda ins, outs: tvm.tir.call_packed(
+                "tvm.contrib.sort.topk", ins[0], outs[0], outs[1], k, 1, "both", False
+            ),
+            dtype=[dtype, "int32"],
+            name="topk_cpu",
+        )
+        s = te.create_schedule(out[0].op)
+        f = tvm.build(s, [data] + list(out), "llvm")
+
+        # many ties, which are ordered by the index as a stable sort does
+        np_data = np.random.randint(-100, 100, size=(rows, n)).astype(dtype)
+        np_indices = np.argsort(-np_data.astype("float32"), axis=1, kind="stable")[:, :k]
+        a = tvm.nd.array(np_data, ctx)
+        b = tvm.nd.array(np.zeros((rows, k), dtype=dtype), ctx)
+        c = tvm.nd.array(np.zeros((rows, k), dtype="int32"), ctx)
+        f(a, b, c)
+        tvm.testing.assert_allclose(c.asnumpy(), np_indices)
+        tvm.testing.assert_allclose(b.asnumpy(), np.take_along_axis(np_data, np_indices, axis=1))
+
+
 if __name__ == "__main__":
     test_sort()
     test_sort_np()
+    test_topk_dtypes()
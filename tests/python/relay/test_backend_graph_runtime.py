@@ -182,6 +182,24 @@ def test_gru_like():
             tvm.testing.assert_allclose(out, ref, rtol=1e-5, atol=1e-5)
 
 
+def test_deep_chain():
+    """Build and run a chain deeper than the native stack allows the passes to recurse."""
+    n = 100000
+    x = relay.var("x", shape=(10,))
+    y = x
+    for _ in range(n):
+        y = relay.negative(y)
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(mod, "llvm")
+    m = graph_runtime.GraphModule(lib["default"](tvm.cpu()))
+    x_np = np.random.uniform(size=(10,)).astype("float32")
+    m.set_input("x", x_np)
+    m.run()
+    # an even number of negatives
+    tvm.testing.assert_allclose(m.get_output(0).asnumpy(), x_np)
+
+
 if __name__ == "__main__":
     test_plan_memory()
     test_with_params()
@@ -189,3 +207,4 @@ if __name__ == "__main__":
     test_add_op_tensor()
     test_add_op_broadcast()
     test_gru_like()
+    test_deep_chain()
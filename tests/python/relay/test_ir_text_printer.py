@@ -249,6 +249,18 @@ def test_null_attribute():
     assert "TestAttribute=(nullptr)" in txt
 
 
+def test_deep_chain():
+    # The dataflow is printed without recursing on its depth.
+    n = 20000
+    x = relay.var("x", shape=(1,))
+    y = x
+    for _ in range(n):
+        y = relay.negative(y)
+    txt = relay.Function([x], y).astext()
+    assert txt.count("negative(") == n
+    assert "%0 = negative(%x)" in txt
+
+
 if __name__ == "__main__":
     import sys
 
@@ -432,6 +432,49 @@ def test_conv2d_winograd():
     )
 
 
+@tvm.testing.requires_llvm
+def test_conv2d_winograd_int8():
+    """AlterOpLayout rewrites the conv2d to the winograd conv2d with the int16 weight
+    transform when the tuning records pick conv2d_nchw_winograd_int8.x86."""
+    target = tvm.target.Target("llvm")
+
+    def run_test(data_dtype, dshape, kshape, padding):
+        x = relay.var("x", shape=dshape, dtype=data_dtype)
+        w = relay.var("w", shape=kshape, dtype="int8")
+        y = relay.nn.conv2d(
+            x, w, padding=padding, channels=kshape[0], kernel_size=(3, 3), out_dtype="int32"
+        )
+        mod = tvm.IRModule.from_expr(relay.Function([x, w], y))
+        a_min, a_max = (0, 255) if data_dtype == "uint8" else (-128, 127)
+        data = np.random.randint(a_min, a_max + 1, size=dshape).astype(data_dtype)
+        kernel = np.random.randint(-128, 128, size=kshape).astype("int8")
+        params = {"w": tvm.nd.array(kernel)}
+        ref_res = tvm.topi.testing.conv2d_nchw_python(
+            data.astype("int32"), kernel.astype("int32"), 1, padding
+        )
+
+        # a hand-written record of the winograd template, the only one with a tuned config
+        tasks = autotvm.task.extract_from_program(
+            mod, params, target, ops=(relay.op.get("nn.conv2d"),)
+        )
+        task = [t for t in tasks if t.name == "conv2d_nchw_winograd_int8.x86"][0]
+        inp = autotvm.measure.MeasureInput(target, task, task.config_space.get(0))
+        res = autotvm.measure.MeasureResult((1e-4,), 0, 0, 0)
+
+        with autotvm.apply_history_best([(inp, res)]):
+            with tvm.transform.PassContext(opt_level=3):
+                lib = relay.build(mod, target=target, params=params)
+        assert "winograd_without_weight_transform" in lib.get_json()
+        module = tvm.contrib.graph_runtime.GraphModule(lib["default"](tvm.cpu()))
+        module.set_input("x", data)
+        module.run()
+        # the integer transforms are exact
+        tvm.testing.assert_allclose(module.get_output(0).asnumpy(), ref_res, rtol=0, atol=0)
+
+    run_test("uint8", (1, 16, 14, 14), (32, 16, 3, 3), (1, 1))
+    run_test("int8", (2, 8, 9, 9), (16, 8, 3, 3), (0, 0))
+
+
 @tvm.testing.uses_gpu
 def test_conv3d_infer_type():
     # symbolic in batch dimension
@@ -1741,6 +1784,7 @@ if __name__ == "__main__":
     test_conv1d_run()
     test_conv2d_run()
     test_conv2d_winograd()
+    test_conv2d_winograd_int8()
     test_conv3d_run()
     test_conv3d_ndhwc_run()
     test_conv3d_winograd()
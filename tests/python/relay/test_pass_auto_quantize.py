@@ -96,14 +96,92 @@ def test_calibrate_target(create_target):
             relay.quantize.quantize(mod, params, dataset)
 
 
-def test_calibrate_memory_bound():
+def test_calibrate_chunk_by_deprecated():
     mod, params = testing.synthetic.get_workload()
     dataset = get_calibration_dataset(mod, "data")
-    import multiprocessing
+    with pytest.warns(DeprecationWarning):
+        config = relay.quantize.qconfig(calibrate_mode="kl_divergence", calibrate_chunk_by=2)
+    with config:
+        relay.quantize.quantize(mod, params, dataset)
+
+
+def test_calibration_stats():
+    from tvm.relay.quantize._calibrate import CalibrationStats
+    from tvm.relay.quantize.kl_divergence import _find_scale_by_kl
+
+    np.random.seed(0)
+    batches = [np.random.normal(size=(4, 1000)).astype("float32") for _ in range(3)]
+    batches[0][0, 0] = 8.0
+    stats = CalibrationStats()
+    for batch in batches:
+        stats.update([tvm.nd.array(batch), tvm.nd.array(np.zeros(10, "float32"))], batch.shape[0])
+    assert stats.num_batches == 3
+    assert stats.num_samples == 12
+
+    # The range is fixed by the first batch, so the result matches the one-shot histogram
+    kl_scale, zero_scale = stats.find_scales("kl_divergence")
+    expected = _find_scale_by_kl(np.concatenate(batches).reshape(-1))
+    np.testing.assert_allclose(kl_scale, expected, rtol=0.05)
+    assert zero_scale > 0
 
-    num_cpu = multiprocessing.cpu_count()
-    with relay.quantize.qconfig(calibrate_mode="kl_divergence", calibrate_chunk_by=num_cpu):
+    percentile_scale = stats.find_scales("percentile", percentile=99.0)[0]
+    expected = np.percentile(np.abs(np.concatenate(batches)), 99.0)
+    np.testing.assert_allclose(percentile_scale, expected, rtol=0.05)
+
+    # NaN is rejected in both the vectorized part and the tail of a batch
+    for size in [16, 13]:
+        batch = np.ones(size, "float32")
+        batch[size - 1] = np.nan
+        with pytest.raises(tvm.error.TVMError):
+            CalibrationStats().update([tvm.nd.array(batch)], 1)
+
+
+def test_calibrate_resume(tmpdir):
+    mod, params = testing.synthetic.get_workload()
+    dataset = get_calibration_dataset(mod, "data")
+    checkpoint = str(tmpdir.join("calibration.json"))
+    with relay.quantize.qconfig(calibrate_mode="percentile", calibrate_checkpoint=checkpoint):
         relay.quantize.quantize(mod, params, dataset)
+        stats = relay.quantize._calibrate.CalibrationStats.load(checkpoint)
+        assert stats.num_batches == len(dataset)
+
+        # The collected batches are skipped when resuming
+        relay.quantize.quantize(mod, params, dataset + dataset[:1])
+        stats = relay.quantize._calibrate.CalibrationStats.load(checkpoint)
+        assert stats.num_batches == len(dataset) + 1
+
+
+def test_mixed_precision():
+    data = relay.var("data", shape=(1, 16, 16, 16))
+    out = data
+    for i in range(3):
+        out = relay.nn.conv2d(
+            out, relay.var("weight%d" % i), kernel_size=(3, 3), padding=(1, 1), channels=16
+        )
+        out = relay.nn.relu(out)
+    mod, params = testing.create_workload(relay.Function(relay.analysis.free_vars(out), out))
+    dataset = get_calibration_dataset(mod, "data")
+
+    # Every layer is accurate enough in int8 with a loose threshold, and only float16 is exact
+    precisions = relay.quantize.search_layer_precisions(mod, params, dataset, kl_threshold=1e9)
+    assert precisions == ["int8"] * 3
+    precisions = relay.quantize.search_layer_precisions(
+        mod, params, dataset, kl_threshold=0.0, candidates=["int8", "int16", "float16"]
+    )
+    assert precisions == ["float16"] * 3
+
+    with relay.quantize.qconfig(skip_conv_layers=[], layer_precisions=["int16", "float16", "int8"]):
+        qmod = relay.quantize.quantize(mod, params)
+
+    conv_dtypes = []
+
+    def _visit(node):
+        if isinstance(node, Call) and node.op.name == "nn.conv2d":
+            conv_dtypes.append(node.args[0].checked_type.dtype)
+
+    relay.analysis.post_order_visit(qmod["main"], _visit)
+    assert conv_dtypes == ["int16", "float16", "int8"]
+    relay.build(qmod, "llvm", params=params)
 
 
 ####################################
@@ -312,7 +390,9 @@ if __name__ == "__main__":
     test_batch_flatten_rewrite()
     test_calibrate_target(False)
     test_calibrate_target(True)
-    test_calibrate_memory_bound()
+    test_calibrate_chunk_by_deprecated()
+    test_calibration_stats()
+    test_mixed_precision()
 
     test_add_partition()
     test_conv2d_partition()
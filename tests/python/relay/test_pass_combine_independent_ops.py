@@ -0,0 +1,241 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,missing-module-docstring
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.relay import transform
+from tvm.contrib import graph_runtime
+
+
+def run_opt_pass(expr, opt_pass):
+    assert isinstance(opt_pass, tvm.transform.Pass)
+    mod = tvm.IRModule.from_expr(expr)
+    mod = transform.InferType()(mod)
+    mod = opt_pass(mod)
+    return mod["main"]
+
+
+def test_combine_elemwise():
+    shape = (1, 8, 4, 4)
+    xs = [relay.var("x%d" % i, shape=shape) for i in range(3)]
+    bias = relay.var("bias", shape=(8, 1, 1))
+
+    def before():
+        y = relay.Tuple([relay.add(x, bias) for x in xs])
+        return relay.Function(xs + [bias], y)
+
+    def expected():
+        y = relay.add(relay.concatenate(xs, axis=0), bias)
+        y = relay.split(y, 3, axis=0)
+        return relay.Function(xs + [bias], relay.Tuple([y[i] for i in range(3)]))
+
+    y = run_opt_pass(before(), transform.CombineIndependentOps(min_num_ops=3))
+    y_expected = run_opt_pass(expected(), transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+    mod = tvm.IRModule.from_expr(before())
+    inputs = {"x%d" % i: np.random.uniform(size=shape).astype("float32") for i in range(3)}
+    inputs["bias"] = np.random.uniform(size=(8, 1, 1)).astype("float32")
+    results = []
+    for opt_level in [3, 4]:
+        with tvm.transform.PassContext(opt_level=opt_level):
+            lib = relay.build(mod, "llvm")
+        m = graph_runtime.GraphModule(lib["default"](tvm.cpu()))
+        m.set_input(**inputs)
+        m.run()
+        results.append([m.get_output(i).asnumpy() for i in range(3)])
+    for a, b in zip(*results):
+        tvm.testing.assert_allclose(a, b, rtol=1e-5)
+
+
+def test_combine_pool():
+    shape = (1, 4, 8, 8)
+    xs = [relay.var("x%d" % i, shape=shape) for i in range(3)]
+
+    def before():
+        y = relay.Tuple([relay.nn.max_pool2d(x, pool_size=(2, 2), strides=(2, 2)) for x in xs])
+        return relay.Function(xs, y)
+
+    def expected():
+        y = relay.nn.max_pool2d(relay.concatenate(xs, axis=0), pool_size=(2, 2), strides=(2, 2))
+        y = relay.split(y, 3, axis=0)
+        return relay.Function(xs, relay.Tuple([y[i] for i in range(3)]))
+
+    y = run_opt_pass(before(), transform.CombineIndependentOps(min_num_ops=3))
+    y_expected = run_opt_pass(expected(), transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+
+def test_combine_conv():
+    xs = [relay.var("x%d" % i, shape=(1, 4, 4, 4)) for i in range(3)]
+    ws = [relay.var("w%d" % i, shape=(8, 4, 3, 3)) for i in range(3)]
+    bs = [relay.var("b%d" % i, shape=(8,)) for i in range(3)]
+
+    def before():
+        y = [relay.nn.conv2d(x, w, padding=(1, 1)) for x, w in zip(xs, ws)]
+        y = [relay.sigmoid(relay.nn.bias_add(y_i, b)) for y_i, b in zip(y, bs)]
+        return relay.Function(xs + ws + bs, relay.Tuple(y))
+
+    def expected():
+        # The outputs of the grouped conv2d are passed to the combined consumers without splitting.
+        y = relay.nn.conv2d(
+            relay.concatenate(xs, axis=1),
+            relay.concatenate(ws, axis=0),
+            padding=(1, 1),
+            groups=3,
+            channels=24,
+        )
+        y = relay.sigmoid(relay.nn.bias_add(y, relay.concatenate(bs, axis=0)))
+        y = relay.split(y, 3, axis=1)
+        return relay.Function(xs + ws + bs, relay.Tuple([y[i] for i in range(3)]))
+
+    y = run_opt_pass(before(), transform.CombineIndependentOps(min_num_ops=3))
+    y_expected = run_opt_pass(expected(), transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+    # The convolutions with the same weight are combined along the batch axis.
+    w = relay.var("w", shape=(8, 4, 1, 1))
+
+    def before():
+        y = relay.Tuple([relay.sigmoid(relay.nn.conv2d(x, w)) for x in xs])
+        return relay.Function(xs + [w], y)
+
+    def expected():
+        y = relay.sigmoid(relay.nn.conv2d(relay.concatenate(xs, axis=0), w))
+        y = relay.split(y, 3, axis=0)
+        return relay.Function(xs + [w], relay.Tuple([y[i] for i in range(3)]))
+
+    y = run_opt_pass(before(), transform.CombineIndependentOps(min_num_ops=3))
+    y_expected = run_opt_pass(expected(), transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+
+def test_combine_conv_padded():
+    xs = [relay.var("x%d" % i, shape=(1, 4, 4, 4)) for i in range(3)]
+    ws = [relay.var("w%d" % i, shape=(c, 4, 3, 3)) for i, c in enumerate([8, 8, 6])]
+
+    def before():
+        y = relay.Tuple([relay.nn.conv2d(x, w, padding=(1, 1)) for x, w in zip(xs, ws)])
+        return relay.Function(xs + ws, y)
+
+    def expected():
+        w2 = relay.nn.pad(ws[2], ((0, 2), (0, 0), (0, 0), (0, 0)))
+        y = relay.nn.conv2d(
+            relay.concatenate(xs, axis=1),
+            relay.concatenate(ws[:2] + [w2], axis=0),
+            padding=(1, 1),
+            groups=3,
+            channels=24,
+        )
+        y = relay.split(y, 3, axis=1)
+        y2 = relay.strided_slice(y[2], [0, 0], [-1, 6], [1, 1], slice_mode="size")
+        return relay.Function(xs + ws, relay.Tuple([y[0], y[1], y2]))
+
+    y = run_opt_pass(before(), transform.CombineIndependentOps(min_num_ops=3))
+    y_expected = run_opt_pass(expected(), transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+    inputs = [np.random.uniform(size=x.type_annotation.concrete_shape) for x in xs + ws]
+    inputs = [i.astype("float32") for i in inputs]
+    results = []
+    for func in [before(), y]:
+        intrp = relay.create_executor("graph", mod=tvm.IRModule.from_expr(func), target="llvm")
+        results.append([r.asnumpy() for r in intrp.evaluate()(*inputs)])
+    for a, b in zip(*results):
+        tvm.testing.assert_allclose(a, b, rtol=1e-5)
+
+
+def test_num_kernels():
+    """The heads of a detector, a feature, a class and a box conv2d on every feature map."""
+    num_heads = 3
+    xs = [relay.var("x%d" % i, shape=(1, 16, 8, 8)) for i in range(num_heads)]
+    params = {}
+
+    def conv2d(x, name, channels, in_channels):
+        w = relay.var(name + "_weight", shape=(channels, in_channels, 3, 3))
+        b = relay.var(name + "_bias", shape=(channels,))
+        params[w.name_hint] = np.random.uniform(size=(channels, in_channels, 3, 3))
+        params[b.name_hint] = np.random.uniform(size=(channels,))
+        return relay.nn.bias_add(relay.nn.conv2d(x, w, padding=(1, 1)), b)
+
+    outputs = []
+    for i, x in enumerate(xs):
+        feature = relay.nn.relu(conv2d(x, "feature%d" % i, 16, 16))
+        outputs.append(relay.sigmoid(conv2d(feature, "class%d" % i, 12, 16)))
+        outputs.append(conv2d(feature, "box%d" % i, 8, 16))
+    func = relay.Function(relay.analysis.free_vars(relay.Tuple(outputs)), relay.Tuple(outputs))
+    params = {k: tvm.nd.array(v.astype("float32")) for k, v in params.items()}
+    func = relay.build_module.bind_params_by_name(func, params)
+
+    def num_kernels(passes):
+        mod = tvm.IRModule.from_expr(func)
+        for opt_pass in passes + [transform.FoldConstant(), transform.FuseOps(fuse_opt_level=2)]:
+            mod = transform.InferType()(mod)
+            mod = opt_pass(mod)
+        funcs = []
+        relay.analysis.post_order_visit(
+            mod["main"],
+            lambda expr: funcs.append(expr)
+            if isinstance(expr, relay.Function) and expr.attrs and "Primitive" in expr.attrs
+            else None,
+        )
+        return len(funcs)
+
+    # One kernel per conv2d, fused with its bias_add and activation.
+    assert num_kernels([]) == 3 * num_heads
+    # The concatenation of the feature maps, the feature, class and box conv2d, which take the
+    # combined features without splitting them, and the split of the class and box outputs.
+    assert num_kernels([transform.CombineIndependentOps(min_num_ops=num_heads)]) == 6
+
+
+def test_not_combined():
+    shape = (1, 8, 4, 4)
+    xs = [relay.var("x%d" % i, shape=shape) for i in range(3)]
+    w = relay.var("w", shape=(8, 8, 1, 1))
+
+    def check(func, **kwargs):
+        y = run_opt_pass(func, transform.CombineIndependentOps(**kwargs))
+        y_expected = run_opt_pass(func, transform.InferType())
+        tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+    # too few ops
+    check(relay.Function(xs, relay.Tuple([relay.sigmoid(x) for x in xs[:2]])), min_num_ops=3)
+    # too large ops
+    check(relay.Function(xs, relay.Tuple([relay.sigmoid(x) for x in xs])), max_num_elements=64)
+    # fused into the producers, which are not combined
+    ws = [relay.var("w%d" % k, shape=(8, 8, k, k)) for k in [1, 3, 5]]
+    y = [relay.nn.conv2d(x, w, padding=(k // 2, k // 2)) for x, w, k in zip(xs, ws, [1, 3, 5])]
+    y = relay.Tuple([relay.sigmoid(y_i) for y_i in y])
+    check(relay.Function(xs + ws, y), min_num_ops=3)
+    # the same arguments
+    y = relay.Tuple([relay.sigmoid(xs[0]) for _ in range(3)])
+    check(relay.Function(xs[:1], y), min_num_ops=3)
+    # dependent ops
+    y = relay.sigmoid(relay.sigmoid(relay.sigmoid(xs[0])))
+    check(relay.Function(xs[:1], y), min_num_ops=2)
+
+
+if __name__ == "__main__":
+    test_combine_elemwise()
+    test_combine_pool()
+    test_combine_conv()
+    test_combine_conv_padded()
+    test_num_kernels()
+    test_not_combined()
@@ -1117,6 +1117,53 @@ def test_no_desired_layout():
     assert tvm.ir.structural_equal(a, b), "Actual = \n" + str(a)
 
 
+def test_plan_layout():
+    def before():
+        x = relay.var("x", shape=(1, 64, 56, 56))
+        weight1 = relay.var("weight1", shape=(64, 64, 3, 3))
+        weight2 = relay.var("weight2", shape=(64, 64, 3, 3))
+        y = relay.nn.conv2d(x, weight1, channels=64, kernel_size=(3, 3), padding=(1, 1))
+        y = relay.nn.relu(y)
+        y = relay.nn.conv2d(y, weight2, channels=64, kernel_size=(3, 3), padding=(1, 1))
+        y = relay.nn.relu(y)
+        return relay.Function(analysis.free_vars(y), y)
+
+    def conv_layouts(func):
+        layouts = []
+
+        def fvisit(expr):
+            if isinstance(expr, relay.Call) and expr.op.name == "nn.conv2d":
+                layouts.append(expr.attrs.data_layout)
+
+        relay.analysis.post_order_visit(func, fvisit)
+        return layouts
+
+    desired_layouts = {"nn.conv2d": ["NHWC", "HWIO"]}
+
+    # the convolutions are converted when it pays off, the same as ConvertLayout
+    a = run_opt_pass(before(), transform.PlanLayout(desired_layouts))
+    b = run_opt_pass(before(), transform.ConvertLayout(desired_layouts))
+    assert tvm.ir.structural_equal(a, b), "Actual = \n" + str(a)
+
+    # nothing is converted without a speedup, as the conversion only adds transforms
+    a = run_opt_pass(before(), transform.PlanLayout(desired_layouts, desired_speedup=1.0))
+    b = run_opt_pass(before(), transform.InferType())
+    assert tvm.ir.structural_equal(a, b), "Actual = \n" + str(a)
+
+    # the second convolution is slower in NHWC
+    convs = []
+
+    def op_cost(call, converted):
+        if call not in convs:
+            convs.append(call)
+        if convs.index(call) == 0:
+            return 1e3 if converted else 1e9
+        return 1e9 if converted else 1e3
+
+    a = run_opt_pass(before(), transform.PlanLayout(desired_layouts, op_cost=op_cost))
+    assert conv_layouts(a) == ["NHWC", "NCHW"], "Actual = \n" + str(a)
+
+
 if __name__ == "__main__":
     test_qnn_binary_no_convert_layout()
     test_no_convert_layout()
@@ -1139,3 +1186,4 @@ if __name__ == "__main__":
     test_default_keyword()
     test_different_ops_convert_layout()
     test_no_desired_layout()
+    test_plan_layout()
@@ -251,6 +251,38 @@ def test_fold_batch_norm():
     assert tvm.ir.structural_equal(mod["main"], expect)
 
 
+def test_fold_batched():
+    c_data = np.random.uniform(size=(4, 8)).astype("float32")
+    t = relay.TensorType([8, 4], "float32")
+
+    def before():
+        x = relay.var("x", t)
+        c = relay.const(c_data)
+        # Structurally equal subexpressions on different constant nodes
+        w0 = relay.transpose(relay.const(c_data))
+        w1 = relay.transpose(relay.const(c_data))
+        w2 = relay.reshape(relay.multiply(c, relay.const(2, "float32")), (8, 4))
+        parts = relay.split(c, 2, axis=1)
+        w3 = relay.transpose(relay.concatenate([parts[1], parts[0]], axis=1))
+        y = relay.add(relay.add(x, w0), relay.add(w1, x))
+        y = relay.subtract(relay.multiply(y, w2), w3)
+        return relay.Function([x], y)
+
+    def expected():
+        x = relay.var("x", t)
+        y = relay.add(relay.add(x, relay.const(c_data.T)), relay.add(relay.const(c_data.T), x))
+        w2 = relay.const((c_data * 2).reshape(8, 4))
+        w3 = relay.const(np.concatenate([c_data[:, 4:], c_data[:, :4]], axis=1).T)
+        y = relay.subtract(relay.multiply(y, w2), w3)
+        return relay.Function([x], y)
+
+    zexpected = run_opt_pass(expected(), transform.InferType())
+    for batched in [True, False]:
+        with tvm.transform.PassContext(config={"relay.FoldConstant": {"batched": batched}}):
+            zz = run_opt_pass(before(), transform.FoldConstant())
+        assert tvm.ir.structural_equal(zz, zexpected)
+
+
 if __name__ == "__main__":
     test_fold_const()
     test_fold_let()
@@ -260,3 +292,4 @@ if __name__ == "__main__":
     test_fold_full()
     test_fold_batch_norm()
     test_fold_ndarray_size()
+    test_fold_batched()
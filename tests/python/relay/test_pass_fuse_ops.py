@@ -14,6 +14,8 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
+
 import tvm
 from tvm import te
 from tvm import relay
@@ -752,6 +754,71 @@ def test_fuse_max_diamond():
     assert tvm.ir.structural_equal(fused, expected)
 
 
+def test_fuse_prologue():
+    """Test fusion of the injective producers into conv2d"""
+    dshape = (1, 16, 8, 8)
+
+    def before():
+        x = relay.var("x", shape=dshape, dtype="int8")
+        w = relay.var("w", shape=(16, 16, 3, 3), dtype="int8")
+        y = relay.cast(x, "int32")
+        y = relay.nn.pad(y, ((0, 0), (0, 0), (1, 1), (1, 1)))
+        y = relay.nn.conv2d(relay.cast(y, "int8"), w, kernel_size=(3, 3), out_dtype="int32")
+        y = relay.nn.relu(y)
+        return relay.Function([x, w], y)
+
+    def expected():
+        x = relay.var("p0", shape=dshape, dtype="int8")
+        w = relay.var("p1", shape=(16, 16, 3, 3), dtype="int8")
+        y = relay.cast(x, "int32")
+        y = relay.nn.pad(y, ((0, 0), (0, 0), (1, 1), (1, 1)))
+        y = relay.nn.conv2d(relay.cast(y, "int8"), w, kernel_size=(3, 3), out_dtype="int32")
+        y = relay.nn.relu(y)
+        f0 = relay.Function([x, w], y)
+        f0 = f0.with_attr("Primitive", tvm.tir.IntImm("int32", 1))
+
+        x = relay.var("x", shape=dshape, dtype="int8")
+        w = relay.var("w", shape=(16, 16, 3, 3), dtype="int8")
+        return relay.Function([x, w], relay.Call(f0, [x, w]))
+
+    with tvm.transform.PassContext(config={"relay.FuseOps.fuse_prologue": True}):
+        zz = run_opt_pass(before(), transform.FuseOps())
+    after = run_opt_pass(expected(), transform.InferType())
+    assert tvm.ir.structural_equal(zz, after)
+
+    # the producers are separate kernels by default
+    zz = run_opt_pass(before(), transform.FuseOps())
+    assert not tvm.ir.structural_equal(zz, after)
+
+    x = np.random.randint(-128, 127, size=dshape).astype("int8")
+    w = np.random.randint(-128, 127, size=(16, 16, 3, 3)).astype("int8")
+    mod = tvm.IRModule.from_expr(before())
+    results = []
+    for fuse_prologue in [False, True]:
+        with tvm.transform.PassContext(
+            opt_level=3, config={"relay.FuseOps.fuse_prologue": fuse_prologue}
+        ):
+            intrp = relay.create_executor("graph", mod=mod, ctx=tvm.cpu(), target="llvm")
+            results.append(intrp.evaluate()(x, w).asnumpy())
+    tvm.testing.assert_allclose(results[0], results[1])
+
+
+def test_fuse_deep_chain():
+    """Type inference and fusion of a chain deeper than the native stack allows to recurse."""
+    n = 20000
+    x = relay.var("x", shape=(10,))
+    y = x
+    for _ in range(n):
+        y = relay.exp(y)
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    mod = transform.InferType()(mod)
+    assert mod["main"].body.checked_type == relay.TensorType((10,), "float32")
+    mod = transform.FuseOps(fuse_opt_level=2)(mod)
+    # the chain is cut into the groups of the largest fuse depth
+    body = mod["main"].body
+    assert isinstance(body.op, relay.Function) and body.op.attrs["Primitive"] == 1
+
+
 if __name__ == "__main__":
     test_fuse_simple()
     test_conv2d_fuse()
@@ -772,3 +839,5 @@ if __name__ == "__main__":
     test_fuse_gather_nd()
     test_fuse_bcast_reduce_scalar()
     test_fuse_max_diamond()
+    test_fuse_prologue()
+    test_fuse_deep_chain()
@@ -0,0 +1,91 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Unit tests for the pass instrumentation."""
+import json
+
+import tvm
+from tvm import relay
+from tvm.relay import transform
+
+
+def get_test_module():
+    x = relay.var("x", shape=(1, 16))
+    c = relay.const(1.0)
+    y = relay.add(x, relay.multiply(c, relay.const(2.0)))
+    y = relay.nn.relu(y)
+    return tvm.IRModule.from_expr(relay.Function([x], y))
+
+
+def test_pass_instrument_callbacks():
+    calls = []
+
+    class MyInstrument(tvm.instrument.PassInstrument):
+        def enter_pass_ctx(self):
+            calls.append("enter")
+
+        def exit_pass_ctx(self):
+            calls.append("exit")
+
+        def run_before_pass(self, mod, info):
+            calls.append("before " + info.name)
+
+        def run_after_pass(self, mod, info):
+            calls.append("after " + info.name)
+
+    seq = tvm.transform.Sequential([transform.InferType(), transform.FoldConstant()], name="my_seq")
+    with tvm.transform.PassContext(opt_level=3, instruments=[MyInstrument()]):
+        seq(get_test_module())
+
+    assert calls[0] == "enter" and calls[-1] == "exit"
+    assert calls[1] == "before my_seq" and calls[-2] == "after my_seq"
+    assert "before FoldConstant" in calls and "after FoldConstant" in calls
+    assert calls.index("before FoldConstant") < calls.index("after FoldConstant")
+
+
+def test_pass_profiler():
+    profiler = tvm.instrument.PassProfiler()
+    seq = tvm.transform.Sequential(
+        [transform.InferType(), transform.FoldConstant(), transform.FuseOps()], name="my_seq"
+    )
+    with tvm.transform.PassContext(opt_level=3, instruments=[profiler]):
+        seq(get_test_module())
+
+    events = profiler.events
+    names = [e["name"] for e in events]
+    assert names[-1] == "my_seq"
+    assert "FoldConstant" in names and "FuseOps" in names
+    for event in events:
+        assert event["duration_us"] >= 0
+        assert event["nodes_before"] > 0 and event["nodes_after"] > 0
+    assert events[-1]["depth"] == 0
+    assert all(e["depth"] >= 1 for e in events[:-1])
+    # FoldConstant removes the multiply
+    fold = events[names.index("FoldConstant")]
+    assert fold["nodes_after"] < fold["nodes_before"]
+
+    assert "FoldConstant" in profiler.render()
+    trace = json.loads(profiler.as_chrome_trace())
+    assert len(trace["traceEvents"]) == len(events)
+    assert all(e["ph"] == "X" for e in trace["traceEvents"])
+
+    profiler.reset()
+    assert not profiler.events
+
+
+if __name__ == "__main__":
+    test_pass_instrument_callbacks()
+    test_pass_profiler()
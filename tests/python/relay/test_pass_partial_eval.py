@@ -338,5 +338,22 @@ def test_tuple_match():
     tvm.ir.assert_structural_equal(dcpe(x), const(2))
 
 
+def test_deep_chain():
+    # The dataflow and the let chains are evaluated without recursing on their length.
+    n = 20000
+    x = relay.var("x", shape=(1,))
+    y = x
+    for _ in range(n):
+        y = op.negative(y)
+    func = Function([x], y)
+    for expr in [func, run_opt_pass(func, transform.ToANormalForm())]:
+        body = run_opt_pass(expr, transform.PartialEvaluate()).body
+        num_calls = 0
+        while isinstance(body, Let):
+            num_calls += isinstance(body.value, Call)
+            body = body.body
+        assert num_calls == n
+
+
 if __name__ == "__main__":
     pytest.main([__file__])
@@ -0,0 +1,87 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Unit tests for pruning compiler regions by cost."""
+import tvm
+from tvm import relay
+from tvm.relay import transform
+
+target = "prune_test"
+
+
+@tvm.ir.register_op_attr("nn.conv2d", "target." + target)
+def conv2d(attrs, args):  # pylint: disable=unused-variable
+    return True
+
+
+@tvm.ir.register_op_attr("nn.relu", "target." + target)
+def relu(attrs, args):  # pylint: disable=unused-variable
+    return True
+
+
+def annotated():
+    # A large conv region, then a single relu isolated between two unsupported tanh ops
+    x = relay.var("x", shape=(1, 16, 32, 32))
+    w = relay.var("w", shape=(16, 16, 3, 3))
+    out = relay.nn.relu(relay.nn.conv2d(x, w, kernel_size=(3, 3), padding=(1, 1)))
+    out = relay.tanh(relay.nn.relu(relay.tanh(out)))
+    mod = tvm.IRModule.from_expr(relay.Function([x, w], out))
+    seq = tvm.transform.Sequential(
+        [transform.InferType(), transform.AnnotateTarget(target), transform.MergeCompilerRegions()]
+    )
+    return seq(mod)
+
+
+def num_external_functions(mod):
+    return sum(1 for gv in mod.get_global_vars() if mod[gv].attrs and "Compiler" in mod[gv].attrs)
+
+
+def test_estimate_compiler_regions():
+    mod = annotated()
+    estimates = relay.analysis.estimate_compiler_regions(mod["main"])
+    assert [x.num_ops for x in estimates] == [2, 1]
+    assert [x.num_transfers for x in estimates] == [3, 2]
+    assert estimates[0].transfer_bytes == (16 * 32 * 32 + 16 * 16 * 3 * 3 + 16 * 32 * 32) * 4
+    assert [bool(x.offload) for x in estimates] == [True, False]
+
+
+def test_prune_small_region():
+    mod = annotated()
+    assert num_external_functions(transform.PartitionGraph()(mod)) == 2
+    mod = transform.PruneCompilerRegions()(mod)
+    assert num_external_functions(transform.PartitionGraph()(mod)) == 1
+
+
+def test_static_cost_table():
+    # The relu region is kept if the table says the target runs relu much faster
+    cost_model = transform.RegionCostModel(op_cost={"nn.relu": (1e9, 1.0)})
+    mod = transform.PruneCompilerRegions(cost_model)(annotated())
+    assert num_external_functions(transform.PartitionGraph()(mod)) == 2
+
+    # Nothing is offloaded if the transfers are too expensive
+    cost_model = transform.RegionCostModel(transfer_latency=1e12)
+    mod = transform.PruneCompilerRegions(cost_model)(annotated())
+    assert num_external_functions(transform.PartitionGraph()(mod)) == 0
+
+    cost_model = transform.RegionCostModel(min_region_size=3)
+    mod = transform.PruneCompilerRegions(cost_model)(annotated())
+    assert num_external_functions(transform.PartitionGraph()(mod)) == 0
+
+
+if __name__ == "__main__":
+    test_estimate_compiler_regions()
+    test_prune_small_region()
+    test_static_cost_table()
@@ -0,0 +1,112 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.contrib import graph_runtime
+
+
+def random_sparse_kernel(shape, density, block_size, out_axis):
+    """A kernel whose 2-D (out_channels, rest) view keeps only random blocks."""
+    kernel = np.random.randn(*shape).astype("float32")
+    w = np.moveaxis(kernel, out_axis, 0).reshape((shape[out_axis], -1))
+    bs_r, bs_c = block_size
+    mask = np.random.uniform(size=(w.shape[0] // bs_r, w.shape[1] // bs_c)) < density
+    w = w * np.kron(mask, np.ones(block_size)).astype("float32")
+    return np.moveaxis(w.reshape(np.moveaxis(kernel, out_axis, 0).shape), 0, out_axis).copy()
+
+
+def run_func(func, params, x):
+    with tvm.transform.PassContext(opt_level=3):
+        graph, lib, new_params = relay.build(func, "llvm", params=params)
+
+    ctx = tvm.cpu(0)
+    m = graph_runtime.create(graph, lib, ctx)
+    m.set_input("data", tvm.nd.array(x))
+    m.set_input(**new_params)
+    m.run()
+    return m.get_output(0).asnumpy()
+
+
+def verify_bsr_sparse_conv2d(layout, kernel_size, block_size, density):
+    ci, co, size = 32, 64, 8
+    padding = (kernel_size - 1) // 2
+    if layout == "NHWC":
+        data_shape = (1, size, size, ci)
+        kernel_shape = (kernel_size, kernel_size, ci, co)
+        kernel_layout, out_axis = "HWIO", 3
+    else:
+        data_shape = (1, ci, size, size)
+        kernel_shape = (co, ci, kernel_size, kernel_size)
+        kernel_layout, out_axis = "OIHW", 0
+    data = relay.var("data", shape=data_shape, dtype="float32")
+    x = relay.nn.relu(data)
+    w = relay.var("weight", shape=kernel_shape, dtype="float32")
+    y = relay.nn.conv2d(
+        x,
+        w,
+        channels=co,
+        kernel_size=(kernel_size, kernel_size),
+        padding=(padding, padding),
+        data_layout=layout,
+        kernel_layout=kernel_layout,
+    )
+    z = relay.nn.relu(y)
+    func = relay.Function(relay.analysis.free_vars(z), z)
+
+    params = {
+        "weight": tvm.nd.array(random_sparse_kernel(kernel_shape, density, block_size, out_axis))
+    }
+    x_np = np.random.randn(*data_shape).astype("float32")
+    dense_output = run_func(func, params, x_np)
+
+    sparse_func, params = relay.data_dep_optimization.bsr_conv2d.convert(
+        func, params, block_size, 0.5, layout, kernel_size
+    )
+    assert "nn.sparse_conv2d" in sparse_func.astext()
+    assert "weight" not in params
+    sparse_output = run_func(sparse_func, params, x_np)
+    np.testing.assert_allclose(sparse_output, dense_output, atol=1e-4, rtol=1e-4)
+
+
+def test_bsr_sparse_conv2d():
+    for layout in ["NHWC", "NCHW"]:
+        verify_bsr_sparse_conv2d(layout, 1, (16, 1), 0.2)
+        verify_bsr_sparse_conv2d(layout, 3, (8, 4), 0.2)
+
+
+def test_bsr_sparse_conv2d_threshold():
+    data = relay.var("data", shape=(1, 8, 8, 16), dtype="float32")
+    w = relay.var("weight", shape=(1, 1, 16, 32), dtype="float32")
+    y = relay.nn.conv2d(
+        data, w, channels=32, kernel_size=(1, 1), data_layout="NHWC", kernel_layout="HWIO"
+    )
+    func = relay.Function(relay.analysis.free_vars(y), y)
+    params = {"weight": tvm.nd.array(np.random.randn(1, 1, 16, 32).astype("float32"))}
+    # the dense weight is below the sparsity threshold and stays dense
+    new_func, params = relay.data_dep_optimization.bsr_conv2d.convert(
+        func, params, (16, 1), 0.7, "NHWC", 1
+    )
+    assert "nn.sparse_conv2d" not in new_func.astext()
+    assert "weight" in params
+
+
+if __name__ == "__main__":
+    test_bsr_sparse_conv2d()
+    test_bsr_sparse_conv2d_threshold()
@@ -393,5 +393,47 @@ def @main(%f: float32) -> float32 {
     tvm.ir.assert_structural_equal(mod["main"].body.type_args, [relay.TensorType((), "float32")])
 
 
+def test_incremental_infer():
+    x = relay.var("x", shape=(1, 8, 16, 16))
+    w = relay.var("w", shape=(8, 8, 3, 3))
+    y = relay.nn.relu(relay.nn.conv2d(x, w, padding=(1, 1)))
+    y = relay.add(y, relay.const(1.0))
+    mod = tvm.IRModule.from_expr(relay.Function([x, w], relay.nn.max_pool2d(y)))
+    mod = transform.InferType()(mod)
+
+    # Rewrite the pooling on top of the typed subgraph, which changes the output type
+    typed = mod["main"].body.args[0]
+    new_body = relay.nn.avg_pool2d(typed, pool_size=(2, 2), strides=(2, 2))
+    func = relay.Function(mod["main"].params, new_body)
+
+    with tvm.transform.PassContext(config={"relay.InferType": {"incremental": True}}):
+        incremental = transform.InferType()(tvm.IRModule.from_expr(func))
+    full = transform.InferType()(tvm.IRModule.from_expr(func))
+    tvm.ir.assert_structural_equal(incremental, full, map_free_vars=True)
+    tvm.ir.assert_structural_equal(
+        incremental["main"].body.checked_type, relay.TensorType((1, 8, 8, 8), "float32")
+    )
+    # The unchanged subgraph keeps its nodes and checked types
+    assert incremental["main"].body.args[0].same_as(typed)
+
+
+def test_incremental_infer_changed_binding():
+    x = relay.var("x", shape=(4, 4))
+    v = relay.var("v")
+    body = relay.Let(v, relay.add(x, x), relay.multiply(v, v))
+    mod = tvm.IRModule.from_expr(relay.Function([x], body))
+    mod = transform.InferType()(mod)
+
+    # The let binding is rewritten to a new shape, so its uses are inferred again
+    let = mod["main"].body
+    new_v = relay.var("v")
+    new_body = relay.Let(new_v, relay.sum(let.value, axis=0), relay.multiply(new_v, new_v))
+    func = relay.Function(mod["main"].params, new_body)
+
+    with tvm.transform.PassContext(config={"relay.InferType": {"incremental": True}}):
+        mod = transform.InferType()(tvm.IRModule.from_expr(func))
+    tvm.ir.assert_structural_equal(mod["main"].body.checked_type, relay.TensorType((4,), "float32"))
+
+
 if __name__ == "__main__":
     pytest.main([__file__])
@@ -15,7 +15,12 @@
 # specific language governing permissions and limitations
 # under the License.
 """Common utility for topi test"""
+import os
 
+import numpy as np
+
+import tvm
+import tvm.testing
 from tvm import autotvm
 from tvm.autotvm.task.space import FallbackConfigEntity
 
@@ -29,3 +34,57 @@ class Int8Fallback(autotvm.FallbackContext):
         self.memory[key] = cfg
         cfg.is_fallback = False
         return cfg
+
+
+def host_has_cpu_flag(flag):
+    """Whether the cpu of the host has the feature flag, e.g. avx2, on Linux"""
+    if not os.path.exists("/proc/cpuinfo"):
+        return False
+    with open("/proc/cpuinfo") as f:
+        for line in f:
+            if line.startswith("flags"):
+                return flag in line.split()
+    return False
+
+
+# The x86 targets of the int8 dot product microkernels, the instruction of the
+# microkernel and the cpu flag to run it.
+INT8_DOT_TARGETS = [
+    ("llvm -mcpu=core-avx2", "vpmaddwd", "avx2"),
+    ("llvm -mcpu=skylake-avx512", "vpmaddwd", "avx2"),
+    ("llvm -mcpu=cascadelake", "vpdpbusd", "avx512_vnni"),
+]
+
+
+def random_uint8_int8(data_shape, weight_shape, extreme=False):
+    """Random uint8 data and int8 weight. The extreme data is the largest uint8 and the
+    extreme weights have the largest magnitudes, most of their pairs of products overflow
+    int16."""
+    if extreme:
+        data = np.full(data_shape, 255).astype("uint8")
+        weight = np.random.choice([-128, 127], size=weight_shape).astype("int8")
+    else:
+        data = np.random.randint(0, 256, size=data_shape).astype("uint8")
+        weight = np.random.randint(-128, 128, size=weight_shape).astype("int8")
+    return data, weight
+
+
+def verify_int8_dot_targets(fbuild, inputs, expected):
+    """Build an int8 kernel for every target of INT8_DOT_TARGETS with fbuild(target), and
+    check the instruction of the microkernel in the asm. Run the kernel on the numpy inputs
+    when the host cpu has the feature, the output is the last argument and must be equal
+    to expected."""
+    for target, inst, flag in INT8_DOT_TARGETS:
+        f = fbuild(target)
+        asm = f.get_source("asm")
+        assert inst in asm
+        # the sums of pairs of vpmaddubsw saturate to int16
+        assert "vpmaddubsw" not in asm
+        if not host_has_cpu_flag(flag):
+            print("Skip running %s because the host cpu has no %s" % (target, flag))
+            continue
+        ctx = tvm.cpu(0)
+        args = [tvm.nd.array(x, ctx) for x in inputs]
+        out = tvm.nd.array(np.zeros(expected.shape, dtype=expected.dtype), ctx)
+        f(*args, out)
+        tvm.testing.assert_allclose(out.asnumpy(), expected, rtol=0, atol=0)
@@ -25,6 +25,8 @@ from tvm.contrib.pickle_memoize import memoize
 
 import tvm.testing
 
+from common import random_uint8_int8, verify_int8_dot_targets
+
 _batch_matmul_implement = {
     "generic": (topi.nn.batch_matmul, topi.generic.schedule_batch_matmul),
     "cpu": (topi.x86.batch_matmul, topi.x86.schedule_batch_matmul),
@@ -73,5 +75,66 @@ def test_batch_matmul():
     verify_batch_matmul(30, 16, 20, 32)
 
 
+def verify_batch_matmul_small_x86(batch, M, N, K, fuse_relu=False):
+    x = te.placeholder((batch, M, K), name="x")
+    y = te.placeholder((batch, N, K), name="y")
+    a_np = np.random.uniform(size=(batch, M, K)).astype(x.dtype)
+    b_np = np.random.uniform(size=(batch, N, K)).astype(y.dtype)
+    c_np = tvm.topi.testing.batch_matmul(a_np, b_np)
+    if fuse_relu:
+        c_np = np.maximum(c_np, 0)
+
+    target = "llvm"
+    with tvm.target.Target(target):
+        out = topi.x86.batch_matmul_small(x, y)
+        if fuse_relu:
+            out = topi.nn.relu(out)
+        s = topi.x86.schedule_batch_matmul_small([out])
+    ctx = tvm.cpu(0)
+    a = tvm.nd.array(a_np, ctx)
+    b = tvm.nd.array(b_np, ctx)
+    c = tvm.nd.array(np.zeros(get_const_tuple(out.shape), dtype=out.dtype), ctx)
+    f = tvm.build(s, [x, y, out], target, name="batch_matmul")
+    f(a, b, c)
+    tvm.testing.assert_allclose(c.asnumpy(), c_np, rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_batch_matmul_small_x86():
+    assert topi.x86.is_small_batch_matmul(96, 64, 64, 64)
+    assert not topi.x86.is_small_batch_matmul(1, 64, 64, 64)
+    assert not topi.x86.is_small_batch_matmul(8, 64, 64, 64)
+    assert not topi.x86.is_small_batch_matmul(8, 512, 512, 512)
+    verify_batch_matmul_small_x86(96, 64, 64, 64)
+    verify_batch_matmul_small_x86(12, 128, 64, 128, fuse_relu=True)
+    verify_batch_matmul_small_x86(5, 7, 13, 20)
+
+
+def verify_batch_matmul_int8_x86(batch, M, N, K, extreme=False):
+    x = te.placeholder((batch, M, K), name="x", dtype="uint8")
+    y = te.placeholder((batch, N, K), name="y", dtype="int8")
+
+    a_np, b_np = random_uint8_int8((batch, M, K), (batch, N, K), extreme)
+    c_np = tvm.topi.testing.batch_matmul(a_np.astype("int32"), b_np.astype("int32"))
+
+    def build(target):
+        with tvm.target.Target(target):
+            out = topi.x86.batch_matmul_int8(x, y)
+            s = topi.x86.schedule_batch_matmul_int8([out])
+        return tvm.build(s, [x, y, out], target, name="batch_matmul")
+
+    verify_int8_dot_targets(build, [a_np, b_np], c_np)
+
+
+@tvm.testing.requires_llvm
+def test_batch_matmul_int8_x86():
+    verify_batch_matmul_int8_x86(1, 16, 16, 32)
+    verify_batch_matmul_int8_x86(12, 64, 64, 64)
+    verify_batch_matmul_int8_x86(5, 7, 32, 20)
+    verify_batch_matmul_int8_x86(2, 8, 16, 64, extreme=True)
+
+
 if __name__ == "__main__":
     test_batch_matmul()
+    test_batch_matmul_small_x86()
+    test_batch_matmul_int8_x86()
@@ -27,6 +27,8 @@ import tvm.topi.testing
 from tvm.contrib.pickle_memoize import memoize
 from tvm.topi.util import get_const_tuple
 
+from common import random_uint8_int8, verify_int8_dot_targets
+
 
 def verify_conv2d_1x1_nhwc_pack_int8(
     batch, in_channel, in_size, num_filter, kernel, stride, padding, dilation=1
@@ -73,6 +75,31 @@ def verify_conv2d_1x1_nhwc_pack_int8(
         check_device(device)
 
 
+def verify_conv2d_nhwc_1x1_int8(batch, in_channel, in_size, num_filter, stride, extreme=False):
+    A = te.placeholder((batch, in_size, in_size, in_channel), name="A", dtype="uint8")
+    W = te.placeholder((1, 1, in_channel, num_filter), name="W", dtype="int8")
+
+    a_np, w_np = random_uint8_int8(get_const_tuple(A.shape), get_const_tuple(W.shape), extreme)
+    b_np = tvm.topi.testing.conv2d_nhwc_python(
+        a_np.astype("int32"), w_np.astype("int32"), stride, 0
+    ).astype("int32")
+
+    def build(target):
+        with tvm.target.Target(target):
+            B = topi.x86.conv2d_nhwc_1x1_int8(A, W, stride, 0, 1, "int32")
+            s = topi.x86.schedule_conv2d_nhwc_1x1_int8([B])
+        return tvm.build(s, [A, W, B], target)
+
+    verify_int8_dot_targets(build, [a_np, w_np], b_np)
+
+
+@tvm.testing.requires_llvm
+def test_conv2d_nhwc_1x1_int8():
+    verify_conv2d_nhwc_1x1_int8(1, 64, 28, 128, 1)
+    verify_conv2d_nhwc_1x1_int8(2, 32, 15, 64, 2)
+    verify_conv2d_nhwc_1x1_int8(1, 128, 7, 32, 1, extreme=True)
+
+
 # TODO(@llyfacebook): Please fix https://github.com/apache/incubator-tvm/issues/4122 to enable this test.
 @pytest.mark.skip
 def test_conv2d_nhwc():
@@ -81,4 +108,4 @@ def test_conv2d_nhwc():
 
 if __name__ == "__main__":
     # test_conv2d_nhwc()
-    pass
+    test_conv2d_nhwc_1x1_int8()
@@ -25,6 +25,7 @@ from tvm import topi
 import tvm.topi.testing
 from tvm.contrib.pickle_memoize import memoize
 from tvm.topi.nn.util import get_pad_tuple
+from tvm.topi.nn.winograd_util import winograd_integer_transform_matrices
 from tvm.topi.util import get_const_tuple
 import tvm.testing
 
@@ -170,5 +171,71 @@ def test_conv2d_nchw():
     verify_conv2d_nchw(1, 48, 35, 48, 5, 1, "VALID", devices=["cuda"])
 
 
+def verify_conv2d_nchw_winograd_int8(
+    batch, in_channel, in_size, num_filter, padding, data_dtype="uint8", extreme=False
+):
+    in_height = in_width = in_size
+    A = te.placeholder((batch, in_channel, in_height, in_width), name="A", dtype=data_dtype)
+    W = te.placeholder((num_filter, in_channel, 3, 3), name="W", dtype="int8")
+
+    a_shape = get_const_tuple(A.shape)
+    w_shape = get_const_tuple(W.shape)
+    a_min, a_max = (0, 255) if data_dtype == "uint8" else (-128, 127)
+    if extreme:
+        # Every channel of the tile has the signs of the column of B and the row of G at the
+        # position of the largest product of the transforms, so the channels add up in the
+        # same accumulator of the batched GEMM, close to the bound of the overflow guard.
+        _, B, G, _ = winograd_integer_transform_matrices(2, 3)
+        bound = np.outer(np.abs(G).sum(axis=1), np.abs(G).sum(axis=1)) * np.outer(
+            np.abs(B).sum(axis=0), np.abs(B).sum(axis=0)
+        )
+        xi, nu = np.unravel_index(np.argmax(bound), bound.shape)
+        a_sign = np.outer(np.sign(B[:, xi]), np.sign(B[:, nu]))
+        w_sign = np.outer(np.sign(G[xi]), np.sign(G[nu]))
+        a_tile = np.where(a_sign > 0, a_max, a_min)
+        w_tile = np.where(w_sign > 0, 127, -128)
+        a_np = np.broadcast_to(a_tile, a_shape).astype(data_dtype)
+        w_np = np.broadcast_to(w_tile, w_shape).astype("int8")
+        V = B.T.dot(a_tile).dot(B)[xi, nu]
+        U = G.dot(w_tile).dot(G.T)[xi, nu]
+        assert in_channel * U * V > 0.95 * (2 ** 31 - 1)
+    else:
+        a_np = np.random.randint(a_min, a_max + 1, size=a_shape).astype(data_dtype)
+        w_np = np.random.randint(-128, 128, size=w_shape).astype("int8")
+    c_np = tvm.topi.testing.conv2d_nchw_python(
+        a_np.astype("int32"), w_np.astype("int32"), 1, padding
+    ).astype("int32")
+
+    device = "llvm"
+    ctx = tvm.cpu(0)
+    with tvm.target.Target(device):
+        C = topi.x86.conv2d_nchw_winograd_int8(A, W, 1, padding, 1, "int32")
+        s = topi.x86.schedule_conv2d_nchw_winograd_int8([C])
+
+    a = tvm.nd.array(a_np, ctx)
+    w = tvm.nd.array(w_np, ctx)
+    c = tvm.nd.array(np.zeros(get_const_tuple(C.shape), dtype=C.dtype), ctx)
+    func = tvm.build(s, [A, W, C], device)
+    func(a, w, c)
+    # the integer transforms are exact
+    tvm.testing.assert_allclose(c.asnumpy(), c_np, rtol=0, atol=0)
+
+
+def test_conv2d_nchw_winograd_int8():
+    assert topi.x86.winograd_int8_max_in_channel("uint8", "int8") == 1827
+    assert topi.x86.winograd_int8_max_in_channel("int8", "int8") == 3640
+
+    verify_conv2d_nchw_winograd_int8(1, 32, 14, 32, 1)
+    verify_conv2d_nchw_winograd_int8(1, 16, 7, 24, 1, data_dtype="int8")
+    verify_conv2d_nchw_winograd_int8(2, 13, 15, 16, 0)
+    # A single 4x4 tile at the max number of channels of the overflow guard
+    for data_dtype in ["uint8", "int8"]:
+        max_in_channel = topi.x86.winograd_int8_max_in_channel(data_dtype, "int8")
+        verify_conv2d_nchw_winograd_int8(
+            1, max_in_channel, 4, 4, 0, data_dtype=data_dtype, extreme=True
+        )
+
+
 if __name__ == "__main__":
     test_conv2d_nchw()
+    test_conv2d_nchw_winograd_int8()
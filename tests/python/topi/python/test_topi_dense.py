@@ -23,7 +23,7 @@ import tvm.topi.testing
 from tvm.topi.util import get_const_tuple
 from tvm.contrib.pickle_memoize import memoize
 
-from common import Int8Fallback
+from common import Int8Fallback, random_uint8_int8, verify_int8_dot_targets
 import tvm.testing
 
 _dense_implement = {
@@ -128,6 +128,28 @@ def verify_dense_int8(batch, in_dim, out_dim, use_bias=True):
         check_device(device)
 
 
+def verify_dense_int8_x86(batch, in_dim, out_dim, use_bias=True, extreme=False):
+    A = te.placeholder((batch, in_dim), name="A", dtype="uint8")
+    B = te.placeholder((out_dim, in_dim), name="B", dtype="int8")
+    C = te.placeholder((out_dim,), name="C", dtype="int32")
+
+    a_np, b_np = random_uint8_int8((batch, in_dim), (out_dim, in_dim), extreme)
+    c_np = np.random.randint(low=-128, high=128, size=(out_dim,)).astype(C.dtype)
+    d_np = np.dot(a_np.astype("int32"), b_np.T.astype("int32"))
+    if use_bias:
+        d_np += c_np
+    d_np = np.maximum(d_np, 0)
+
+    def build(target):
+        with tvm.target.Target(target):
+            D = topi.x86.dense_int8(A, B, C if use_bias else None, "int32")
+            D = topi.nn.relu(D)
+            s = topi.x86.schedule_dense_int8([D])
+        return tvm.build(s, [A, B, C, D], target, name="dense")
+
+    verify_int8_dot_targets(build, [a_np, b_np, c_np], d_np)
+
+
 @tvm.testing.uses_gpu
 def test_dense():
     verify_dense(1, 1024, 1000, use_bias=True)
@@ -145,6 +167,15 @@ def test_dense_int8():
         verify_dense_int8(2, 1024, 1000, use_bias=False)
 
 
+@tvm.testing.requires_llvm
+def test_dense_int8_x86():
+    verify_dense_int8_x86(1, 1024, 1008, use_bias=True)
+    verify_dense_int8_x86(16, 512, 256, use_bias=False)
+    verify_dense_int8_x86(37, 132, 64, use_bias=True)
+    verify_dense_int8_x86(4, 256, 64, use_bias=False, extreme=True)
+
+
 if __name__ == "__main__":
     test_dense()
     test_dense_int8()
+    test_dense_int8_x86()
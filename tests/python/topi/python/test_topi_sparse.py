@@ -33,6 +33,11 @@ _sparse_dense_implement = {
     "x86": (topi.nn.sparse_dense, topi.x86.schedule_sparse_dense),
 }
 
+_sparse_conv2d_implement = [
+    (topi.nn.sparse_conv2d, topi.generic.schedule_sparse_conv2d),
+    (topi.x86.sparse_conv2d, topi.x86.schedule_sparse_conv2d),
+]
+
 
 def verify_dynamic_csrmv(batch, in_dim, out_dim, use_bias=True):
     nr, nc, n = te.var("nr"), te.var("nc"), te.var("n")
@@ -421,6 +426,90 @@ def test_sparse_dense_bsr_randomized():
             check_device(device)
 
 
+def verify_sparse_dense_bsr_x86(M, N, K, BS_R, BS_C, density, use_relu):
+    X_np = np.random.randn(M, K).astype("float32")
+    W_sp_np = random_bsr_matrix(N, K, BS_R, BS_C, density=density, dtype="float32")
+    Y_np = X_np.dot(W_sp_np.todense().T)
+    if use_relu:
+        Y_np = np.maximum(Y_np, 0.0)
+
+    W_data = te.placeholder(shape=W_sp_np.data.shape, dtype=str(W_sp_np.data.dtype))
+    W_indices = te.placeholder(shape=W_sp_np.indices.shape, dtype=str(W_sp_np.indices.dtype))
+    W_indptr = te.placeholder(shape=W_sp_np.indptr.shape, dtype=str(W_sp_np.indptr.dtype))
+    X = te.placeholder(shape=X_np.shape, dtype=str(X_np.dtype))
+
+    ctx = tvm.cpu(0)
+    with tvm.target.Target("llvm"):
+        Y = topi.x86.sparse_dense_bsr(X, W_data, W_indices, W_indptr)
+        if use_relu:
+            Y = topi.nn.relu(Y)
+        s = topi.x86.schedule_sparse_dense_bsr([Y])
+    func = tvm.build(s, [X, W_data, W_indices, W_indptr, Y], "llvm")
+    Y_tvm = tvm.nd.array(np.zeros(Y_np.shape, dtype=Y_np.dtype), ctx=ctx)
+    func(
+        tvm.nd.array(X_np, ctx=ctx),
+        tvm.nd.array(W_sp_np.data, ctx=ctx),
+        tvm.nd.array(W_sp_np.indices, ctx=ctx),
+        tvm.nd.array(W_sp_np.indptr, ctx=ctx),
+        Y_tvm,
+    )
+    tvm.testing.assert_allclose(Y_tvm.asnumpy(), Y_np, atol=1e-4, rtol=1e-4)
+
+
+@tvm.testing.requires_llvm
+def test_sparse_dense_bsr_x86():
+    verify_sparse_dense_bsr_x86(1, 64, 128, 8, 16, 0.9, use_relu=True)
+    verify_sparse_dense_bsr_x86(37, 128, 96, 16, 1, 0.2, use_relu=False)
+    verify_sparse_dense_bsr_x86(128, 48, 64, 4, 4, 0.3, use_relu=True)
+
+def verify_sparse_conv2d_bsr(N, H, W, CI, CO, kernel_size, layout, BS_R, BS_C, density, use_relu):
+    K = CI * kernel_size * kernel_size
+    W_sp_np = random_bsr_matrix(CO, K, BS_R, BS_C, density=density, dtype="float32")
+    W_np = np.asarray(W_sp_np.todense())
+    padding = (kernel_size - 1) // 2
+    if layout == "NHWC":
+        X_np = np.random.randn(N, H, W, CI).astype("float32")
+        kernel_np = W_np.reshape((CO, kernel_size, kernel_size, CI)).transpose((1, 2, 3, 0))
+        Y_np = tvm.topi.testing.conv2d_nhwc_python(X_np, kernel_np, 1, padding)
+    else:
+        X_np = np.random.randn(N, CI, H, W).astype("float32")
+        kernel_np = W_np.reshape((CO, CI, kernel_size, kernel_size))
+        Y_np = tvm.topi.testing.conv2d_nchw_python(X_np, kernel_np, 1, padding)
+    if use_relu:
+        Y_np = np.maximum(Y_np, 0.0)
+
+    W_data = te.placeholder(shape=W_sp_np.data.shape, dtype=str(W_sp_np.data.dtype))
+    W_indices = te.placeholder(shape=W_sp_np.indices.shape, dtype=str(W_sp_np.indices.dtype))
+    W_indptr = te.placeholder(shape=W_sp_np.indptr.shape, dtype=str(W_sp_np.indptr.dtype))
+    X = te.placeholder(shape=X_np.shape, dtype=str(X_np.dtype))
+
+    ctx = tvm.cpu(0)
+    for fcompute, fschedule in _sparse_conv2d_implement:
+        with tvm.target.Target("llvm"):
+            Y = fcompute(X, W_data, W_indices, W_indptr, layout, kernel_size)
+            if use_relu:
+                Y = topi.nn.relu(Y)
+            s = fschedule([Y])
+            func = tvm.build(s, [X, W_data, W_indices, W_indptr, Y])
+        Y_tvm = tvm.nd.array(np.zeros(Y_np.shape, dtype=Y_np.dtype), ctx=ctx)
+        func(
+            tvm.nd.array(X_np, ctx=ctx),
+            tvm.nd.array(W_sp_np.data, ctx=ctx),
+            tvm.nd.array(W_sp_np.indices, ctx=ctx),
+            tvm.nd.array(W_sp_np.indptr, ctx=ctx),
+            Y_tvm,
+        )
+        tvm.testing.assert_allclose(Y_tvm.asnumpy(), Y_np, atol=1e-4, rtol=1e-4)
+
+
+def test_sparse_conv2d_bsr():
+    for layout in ["NHWC", "NCHW"]:
+        verify_sparse_conv2d_bsr(1, 14, 14, 64, 128, 1, layout, 16, 1, 0.1, False)
+        verify_sparse_conv2d_bsr(1, 7, 9, 32, 48, 1, layout, 8, 4, 0.3, True)
+        verify_sparse_conv2d_bsr(2, 8, 8, 16, 32, 3, layout, 16, 1, 0.2, False)
+        verify_sparse_conv2d_bsr(1, 7, 7, 8, 16, 3, layout, 4, 4, 0.25, True)
+
+
 if __name__ == "__main__":
     test_csrmv()
     test_csrmm()
@@ -428,4 +517,6 @@ if __name__ == "__main__":
     test_sparse_dense_csr()
     test_sparse_dense_bsr()
     test_sparse_dense_bsr_randomized()
+    test_sparse_dense_bsr_x86()
     test_sparse_transpose_csr()
+    test_sparse_conv2d_bsr()
@@ -300,6 +300,82 @@ def test_non_max_suppression():
     )
 
 
+def test_native_vision_cpu():
+    """Compare the native CPU kernels with the hybrid script versions on random boxes."""
+    if not topi.x86.nms.native_vision_enabled():
+        print("Skip because the native vision kernels are not enabled")
+        return
+    ctx = tvm.cpu(0)
+
+    def run(fcompute, fschedule, inputs, np_inputs, **kwargs):
+        with tvm.target.Target("llvm"):
+            outs = fcompute(*inputs, **kwargs)
+            outs = outs if isinstance(outs, (list, tuple)) else [outs]
+            s = fschedule(outs)
+        f = tvm.build(s, list(inputs) + list(outs), "llvm")
+        args = [tvm.nd.array(x, ctx) for x in np_inputs]
+        args += [tvm.nd.empty(get_const_tuple(x.shape), x.dtype, ctx) for x in outs]
+        f(*args)
+        return [x.asnumpy() for x in args[len(inputs) :]]
+
+    batch, num_anchors, num_classes = 2, 300, 4
+    np_data = np.random.uniform(0, 1, size=(batch, num_anchors, 6)).astype("float32")
+    np_data[:, :, 0] = np.random.randint(-1, num_classes, size=(batch, num_anchors))
+    np_data[:, :, 2:] *= 100
+    data = te.placeholder(np_data.shape, name="data")
+    kwargs = {"score_threshold": 0.2, "id_index": 0, "score_index": 1}
+    implements = [
+        _get_valid_counts_implement["generic"],
+        (topi.x86.nms.get_valid_counts, topi.generic.schedule_extern),
+    ]
+    valid = [run(f, s, [data], [np_data], **kwargs) for f, s in implements]
+    for expected, actual in zip(*valid):
+        tvm.testing.assert_allclose(actual, expected)
+
+    np_valid_count, np_boxes, np_indices = valid[0]
+    boxes = te.placeholder(np_boxes.shape, name="boxes")
+    valid_count = te.placeholder((batch,), dtype="int32", name="valid_count")
+    indices = te.placeholder((batch, num_anchors), dtype="int32", name="indices")
+    np_inputs = [np_boxes, np_valid_count, np_indices]
+    for max_output_size, top_k, force_suppress, return_indices in [
+        (-1, -1, False, False),
+        (10, -1, False, True),
+        (-1, 50, True, False),
+        (5, 20, True, True),
+    ]:
+        kwargs = {
+            "max_output_size": max_output_size,
+            "iou_threshold": 0.5,
+            "force_suppress": force_suppress,
+            "top_k": top_k,
+            "return_indices": return_indices,
+        }
+        implements = [
+            _nms_implement["generic"],
+            (topi.x86.nms.non_max_suppression, topi.generic.schedule_extern),
+        ]
+        nms = [run(f, s, [boxes, valid_count, indices], np_inputs, **kwargs) for f, s in implements]
+        for expected, actual in zip(*nms):
+            tvm.testing.assert_allclose(actual, expected)
+
+    np_cls_prob = np.random.uniform(size=(batch, num_classes, num_anchors)).astype("float32")
+    np_loc_pred = np.random.uniform(-1, 1, size=(batch, num_anchors * 4)).astype("float32")
+    np_anchor = np.sort(np.random.uniform(size=(1, num_anchors, 4)), axis=2).astype("float32")
+    cls_prob = te.placeholder(np_cls_prob.shape, name="cls_prob")
+    loc_pred = te.placeholder(np_loc_pred.shape, name="loc_pred")
+    anchor = te.placeholder(np_anchor.shape, name="anchor")
+    implements = [
+        (ssd.multibox_transform_loc, topi.generic.schedule_multibox_transform_loc),
+        (topi.x86.nms.multibox_transform_loc, topi.generic.schedule_extern),
+    ]
+    inputs = [cls_prob, loc_pred, anchor]
+    np_inputs = [np_cls_prob, np_loc_pred, np_anchor]
+    decoded = [run(f, s, inputs, np_inputs, threshold=0.3) for f, s in implements]
+    tvm.testing.assert_allclose(decoded[1][1], decoded[0][1])
+    for i, count in enumerate(decoded[0][1]):
+        tvm.testing.assert_allclose(decoded[1][0][i, :count], decoded[0][0][i, :count], rtol=1e-5)
+
+
 def verify_multibox_prior(
     dshape, sizes=(1,), ratios=(1,), steps=(-1, -1), offsets=(0.5, 0.5), clip=False
 ):
@@ -637,3 +713,4 @@ if __name__ == "__main__":
     test_roi_pool()
     test_proposal()
     test_non_max_suppression()
+    test_native_vision_cpu()
@@ -78,6 +78,63 @@ def test_xgb_model():
         model.load(fp.name)
 
 
+def test_gbdt_model():
+    task, dag, inputs, results = get_sample_records(50)
+
+    model = auto_scheduler.GBDTModel(num_warmup_sample=-1)
+    model.update(inputs, results)
+    preds = model.predict(task, [x.state for x in inputs])
+    assert len(preds) == len(inputs)
+
+    costs = [np.mean([x.value for x in res.costs]) for res in results]
+    throughputs = np.min(costs) / costs
+
+    rmse = np.sqrt(np.mean([np.square(pred - label) for pred, label in zip(preds, throughputs)]))
+    assert rmse <= 0.3
+
+    # Incremental update on top of the trained trees
+    model.update(inputs[:10], results[:10])
+
+    with tempfile.NamedTemporaryFile() as fp:
+        auto_scheduler.save_records(fp.name, inputs, results)
+        model.update_from_file(fp.name)
+
+    with tempfile.NamedTemporaryFile() as fp:
+        model.save(fp.name)
+        new_model = auto_scheduler.GBDTModel()
+        new_model.load(fp.name)
+        new_preds = new_model.predict(task, [x.state for x in inputs])
+        expected = model.predict(task, [x.state for x in inputs])
+        np.testing.assert_allclose(new_preds, expected, rtol=1e-5)
+
+
+def test_gbdt_model_update_after_load():
+    task, dag, inputs, results = get_sample_records(50)
+    num_boost_round, num_incremental_round = 20, 5
+
+    def make_model():
+        return auto_scheduler.GBDTModel(
+            num_boost_round=num_boost_round,
+            num_incremental_round=num_incremental_round,
+            num_warmup_sample=-1,
+        )
+
+    model = make_model()
+    model.update(inputs, results)
+    with tempfile.NamedTemporaryFile() as fp:
+        model.save(fp.name)
+        model = make_model()
+        model.load(fp.name)
+
+    # The model is retrained from scratch whenever the samples collected after Load double,
+    # so the incremental trees do not pile up on the loaded ones.
+    for i in range(0, len(inputs), 10):
+        model.update(inputs[i : i + 10], results[i : i + 10])
+        assert model.num_trees() <= num_boost_round + num_incremental_round
+
+
 if __name__ == "__main__":
     test_random_model()
     test_xgb_model()
+    test_gbdt_model()
+    test_gbdt_model_update_after_load()
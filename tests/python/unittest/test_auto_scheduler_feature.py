@@ -132,6 +132,31 @@ def test_cpu_fusion():
     assert found
 
 
+def test_feature_cache():
+    dag = auto_scheduler.ComputeDAG(matmul_auto_scheduler_test(128, 128, 128))
+    s = dag.get_init_state()
+    s.split(2, s.stages[2].iters[0], [16])
+
+    target = tvm.target.Target("llvm")
+    task = auto_scheduler.SearchTask(dag, "test_feature_cache", target)
+
+    auto_scheduler.feature.set_per_store_feature_cache_capacity(0)
+    expected = auto_scheduler.feature.get_per_store_features_from_states([s], task)[0]
+
+    auto_scheduler.feature.set_per_store_feature_cache_capacity(16)
+    hit_before, miss_before = auto_scheduler.feature.get_per_store_feature_cache_stats()
+    fea_1 = auto_scheduler.feature.get_per_store_features_from_states([s, s], task)
+    hit_after, miss_after = auto_scheduler.feature.get_per_store_feature_cache_stats()
+    assert hit_after + miss_after - hit_before - miss_before == 2
+
+    fea_2 = auto_scheduler.feature.get_per_store_features_from_states([s], task)[0]
+    assert auto_scheduler.feature.get_per_store_feature_cache_stats()[0] > hit_after
+    for fea in [fea_1[0], fea_1[1], fea_2]:
+        assert len(fea) == len(expected)
+        for row, expected_row in zip(fea, expected):
+            assert all(fequal(x, y) for x, y in zip(row, expected_row))
+
+
 def test_gpu_feature():
     # Use records to build a complicated GPU program
     json_records = "\n".join(
@@ -204,4 +229,5 @@ def test_gpu_feature():
 if __name__ == "__main__":
     test_cpu_matmul()
     test_cpu_fusion()
+    test_feature_cache()
     test_gpu_feature()
@@ -167,6 +167,35 @@ def test_record_pragma_storage_align_rfactor():
     record_common(dag, s)
 
 
+def test_record_pragma_prefetch_distance():
+    if not tvm.testing.device_enabled("llvm"):
+        return
+
+    A = te.placeholder((512, 512), name="A")
+    B = te.placeholder((512, 512), name="B")
+    k = te.reduce_axis((0, 512), name="k")
+    C = te.compute((512, 512), lambda i, j: te.sum(A[i][k] * B[k][j], axis=[k]), name="C")
+
+    dag = auto_scheduler.ComputeDAG([A, B, C])
+    s = dag.get_init_state()
+    s.pragma(C, s[C].iters[0], "prefetch_distance$8")
+
+    record_common(dag, s)
+
+    sch, args = dag.apply_steps_from_state(s)
+    mod = tvm.driver.build_module.form_irmodule(sch, args, "main", None)
+    assert "pragma_prefetch_distance" in str(mod["main"].body)
+
+    # InsertPrefetch turns the pragma into a prefetch of the strided loads of B
+    prefetches = []
+
+    def fvisit(op):
+        if isinstance(op, tvm.tir.Call) and op.op.same_as(tvm.ir.Op.get("tir.prefetch")):
+            prefetches.append(op)
+
+    tvm.tir.stmt_functor.post_order_visit(tvm.lower(sch, args)["main"].body, fvisit)
+    assert prefetches
+
 def test_measure_local_builder_runner(enable_cpu_cache_flush=False):
     if not tvm.testing.device_enabled("llvm"):
         return
@@ -213,6 +242,7 @@ if __name__ == "__main__":
     test_record_compute_at_root_inline_cache_read_write()
     test_record_follow_split_follow_fused_split()
     test_record_pragma_storage_align_rfactor()
+    test_record_pragma_prefetch_distance()
     test_measure_local_builder_runner(enable_cpu_cache_flush=True)
     test_measure_local_builder_runner(enable_cpu_cache_flush=False)
     test_measure_local_builder_rpc_runner(enable_cpu_cache_flush=True)
@@ -0,0 +1,123 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""Test the task scheduler"""
+
+import tempfile
+
+import tvm
+import tvm.testing
+from tvm import auto_scheduler
+
+from test_auto_scheduler_common import matmul_auto_scheduler_test, PropagatingThread
+
+
+def task_scheduler_common(strategy):
+    tasks = []
+    for n in [2, 4, 8]:
+        tasks.append(auto_scheduler.create_task(matmul_auto_scheduler_test, (n, n, n), "llvm"))
+
+    with tempfile.NamedTemporaryFile() as fp:
+        log_file = fp.name
+
+        num_trials_per_task = 2
+        n_trials = num_trials_per_task * len(tasks)
+        search_policies = [
+            auto_scheduler.SketchPolicy(task, auto_scheduler.RandomModel(), verbose=0)
+            for task in tasks
+        ]
+        scheduler = auto_scheduler.TaskScheduler(
+            tasks, task_weights=[1, 2, 3], search_policies=search_policies, strategy=strategy
+        )
+        tuning_options = auto_scheduler.TuningOptions(
+            num_measure_trials=n_trials,
+            runner="local",
+            verbose=0,
+            measure_callbacks=[auto_scheduler.RecordToFile(log_file)],
+        )
+        scheduler.tune(tuning_options)
+
+        # Every task is tuned in the warm up rounds and the budget is respected
+        task_trials = scheduler.task_trials
+        assert sum(task_trials) <= n_trials
+        assert all(x > 0 for x in task_trials)
+        assert all(x < 1e10 for x in scheduler.best_costs)
+
+        # All tasks share one measurer, so their records are in the same log
+        counters = {}
+        for inp, _ in auto_scheduler.load_records(log_file):
+            counters[inp.task.workload_key] = counters.get(inp.task.workload_key, 0) + 1
+        for task, trials in zip(tasks, task_trials):
+            assert counters[task.workload_key] == trials
+
+
+@tvm.testing.requires_llvm
+def test_task_scheduler_round_robin():
+    # wrap the search in a new thread to avoid the conflict
+    # between python's multiprocessing and tvm's thread pool
+    t = PropagatingThread(target=task_scheduler_common, args=("round-robin",))
+    t.start()
+    t.join()
+
+
+@tvm.testing.requires_llvm
+def test_task_scheduler_gradient():
+    t = PropagatingThread(target=task_scheduler_common, args=("gradient",))
+    t.start()
+    t.join()
+
+
+def task_scheduler_failed_task():
+    # The programs of the cross compiled task cannot run on the host, so every
+    # measurement of it fails.
+    tasks = [
+        auto_scheduler.create_task(matmul_auto_scheduler_test, (4, 4, 4), "llvm"),
+        auto_scheduler.create_task(
+            matmul_auto_scheduler_test, (8, 8, 8), "llvm -mtriple=aarch64-linux-gnu"
+        ),
+    ]
+    search_policies = [
+        auto_scheduler.SketchPolicy(task, auto_scheduler.RandomModel(), verbose=0)
+        for task in tasks
+    ]
+    scheduler = auto_scheduler.TaskScheduler(tasks, search_policies=search_policies)
+    n_trials = 40
+    tuning_options = auto_scheduler.TuningOptions(
+        num_measure_trials=n_trials, num_measures_per_round=2, runner="local", verbose=0
+    )
+    scheduler.tune(tuning_options)
+
+    # The failed task is retired after 3 rounds of 2 trials, and the rest of the
+    # budget goes to the other task.
+    task_trials = scheduler.task_trials
+    assert scheduler.best_costs[0] < 1e10
+    assert scheduler.best_costs[1] >= 1e10
+    assert task_trials[1] <= 3 * 2
+    assert task_trials[0] > task_trials[1]
+
+
+@tvm.testing.requires_llvm
+def test_task_scheduler_failed_task():
+    t = PropagatingThread(target=task_scheduler_failed_task)
+    t.start()
+    t.join()
+
+
+if __name__ == "__main__":
+    test_task_scheduler_round_robin()
+    test_task_scheduler_gradient()
+    test_task_scheduler_failed_task()
@@ -0,0 +1,99 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""Test the tuning database and the cross-workload warm start"""
+
+import os
+import tempfile
+
+import numpy as np
+
+import tvm
+from tvm import auto_scheduler
+
+from test_auto_scheduler_common import matmul_auto_scheduler_test
+
+
+def get_sample_records(N, number):
+    workload_key = auto_scheduler.make_workload_key(matmul_auto_scheduler_test, (N, N, N))
+    dag = auto_scheduler.ComputeDAG(workload_key)
+    target = tvm.target.Target("llvm")
+    task = auto_scheduler.SearchTask(dag, workload_key, target)
+    policy = auto_scheduler.SketchPolicy(task, verbose=0)
+    states = policy.sample_initial_population(number)
+
+    inputs = [auto_scheduler.MeasureInput(task, s) for s in states]
+    results = [
+        auto_scheduler.MeasureResult([np.random.uniform(0.5, 1.0)], 0, "", 0.1, 0)
+        for _ in range(len(inputs))
+    ]
+    return task, inputs, results
+
+
+def test_workload_distance():
+    distance = auto_scheduler.tuning_database.workload_distance
+    assert distance([128, 128, "float32"], [128, 128, "float32"]) == 0
+    assert abs(distance([128, 256], [256, 256]) - 0.5) < 1e-6
+    assert distance([128, "float32"], [128, "int8"]) == float("inf")
+    assert distance([128], [128, 128]) == float("inf")
+
+
+def test_tuning_database():
+    task_128, inputs, results = get_sample_records(128, 20)
+    task_160, _, _ = get_sample_records(160, 1)
+    task_1024, _, _ = get_sample_records(1024, 1)
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        db_path = os.path.join(tmpdir, "tuning.db")
+        db = auto_scheduler.TuningDatabase(db_path)
+        assert db.add(inputs, results) == len(inputs)
+        # Duplicated records are ignored
+        assert db.add(inputs, results) == 0
+
+        log_file = os.path.join(tmpdir, "log.json")
+        auto_scheduler.save_records(log_file, inputs, results)
+        assert db.add_from_file(log_file) == 0
+        db.close()
+
+        # The database persists across runs
+        db = auto_scheduler.TuningDatabase(db_path)
+        assert len(db) == len(inputs)
+
+        exact_inputs, exact_results = db.query(task_128, top_k=5)
+        assert len(exact_inputs) == 5
+        costs = [np.mean([x.value for x in res.costs]) for res in exact_results]
+        assert costs == sorted(costs)
+
+        similar_inputs, _ = db.query_similar(task_160)
+        assert len(similar_inputs) == len(inputs)
+        assert not db.query_similar(task_1024)[0]
+        assert not db.query_similar(task_128)[0]
+
+        # Warm start the policy of a similar task
+        model = auto_scheduler.RandomModel()
+        callbacks = db.warm_start(task_160, cost_model=model)
+        assert len(callbacks) == 1
+        policy = auto_scheduler.SketchPolicy(
+            task_160, program_cost_model=model, init_search_callbacks=callbacks, verbose=0
+        )
+        assert len(policy.sample_initial_population(4)) > 0
+        db.close()
+
+
+if __name__ == "__main__":
+    test_workload_distance()
+    test_tuning_database()
@@ -0,0 +1,104 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import tvm
+import tvm.testing
+from tvm import te
+
+
+def _column_sum(n):
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    B = ib.pointer("float32", name="B")
+    with ib.for_range(0, n, name="j") as j:
+        with ib.for_range(0, n, name="i") as i:
+            # strided by a row, and contiguous
+            B[j] = B[j] + A[i * n + j] + A[i * n + j + 1] + B[i]
+    return tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B], ib.get()))
+
+
+def _prefetches(stmt):
+    calls = []
+
+    def fvisit(op):
+        if isinstance(op, tvm.tir.Call) and op.op.same_as(tvm.ir.Op.get("tir.prefetch")):
+            calls.append(op)
+
+    tvm.tir.stmt_functor.post_order_visit(stmt, fvisit)
+    return calls
+
+
+def test_insert_prefetch():
+    mod = _column_sum(128)
+    # disabled by default
+    stmt = tvm.tir.transform.InsertPrefetch()(mod)["main"].body
+    assert not _prefetches(stmt)
+
+    with tvm.transform.PassContext(config={"tir.InsertPrefetch": {"distance": 4}}):
+        stmt = tvm.tir.transform.InsertPrefetch()(mod)["main"].body
+    calls = _prefetches(stmt)
+    # A[i * n + j] and A[i * n + j + 1] share a cache line, B[i] is contiguous.
+    assert len(calls) == 1
+    load = calls[0].args[0].args[0]
+    assert load.buffer_var.name_hint == "A"
+    inner = stmt.body
+    assert isinstance(inner.body, tvm.tir.SeqStmt)
+    tvm.ir.assert_structural_equal(
+        tvm.arith.Analyzer().simplify(load.index - (inner.loop_var + 4) * 128 - stmt.loop_var),
+        tvm.tir.const(0, "int32"),
+    )
+
+
+def test_insert_prefetch_pragma():
+    n = 128
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    B = ib.pointer("float32", name="B")
+    with ib.for_range(0, n, name="j") as j:
+        ib.scope_attr(tvm.tir.const(0, "int32"), "pragma_prefetch_distance", 8)
+        with ib.for_range(0, n, name="i") as i:
+            B[j] = B[j] + A[i * n + j]
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B], ib.get()))
+    stmt = tvm.tir.transform.InsertPrefetch()(mod)["main"].body
+    assert len(_prefetches(stmt)) == 1
+    # the pragma is consumed.
+    assert isinstance(stmt.body, tvm.tir.For)
+
+
+def test_insert_prefetch_llvm():
+    if not tvm.testing.device_enabled("llvm"):
+        return
+    n = 256
+    A = te.placeholder((n, n), name="A")
+    k = te.reduce_axis((0, n), name="k")
+    B = te.compute((n,), lambda j: te.sum(A[k, j], axis=k), name="B")
+    s = te.create_schedule(B.op)
+    s[B].pragma(B.op.axis[0], "prefetch_distance", 8)
+    f = tvm.build(s, [A, B], "llvm")
+    assert "llvm.prefetch" in f.get_source()
+
+    ctx = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=(n, n)).astype(A.dtype), ctx)
+    b = tvm.nd.empty((n,), B.dtype, ctx)
+    f(a, b)
+    tvm.testing.assert_allclose(b.asnumpy(), a.asnumpy().sum(axis=0), rtol=1e-4)
+
+
+if __name__ == "__main__":
+    test_insert_prefetch()
+    test_insert_prefetch_pragma()
+    test_insert_prefetch_llvm()
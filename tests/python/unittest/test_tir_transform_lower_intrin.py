@@ -119,6 +119,62 @@ def test_lower_floormod():
         check_value(res, x, y, [(a, b) for a, b in data if b == 8], lambda a, b: a % b)
 
 
+def build_fast_math(op, n, max_ulp):
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: op(A[i]), name="B")
+    s = te.create_schedule(B.op)
+    xo, xi = s[B].split(B.op.axis[0], factor=8)
+    s[B].vectorize(xi)
+    with tvm.transform.PassContext(config={"tir.LowerIntrin": {"fast_math_max_ulp": max_ulp}}):
+        return tvm.build(s, [A, B], "llvm")
+
+
+@tvm.testing.requires_llvm
+def test_lower_fast_math():
+    import math
+
+    n = 1 << 16
+    np_erf = np.vectorize(math.erf)
+    ops = [
+        (te.exp, np.exp, np.linspace(-87, 88, n), [2, 8]),
+        (te.log, np.log, np.exp(np.linspace(-87, 88, n)), [2, 16]),
+        (te.sigmoid, lambda x: 1 / (1 + np.exp(-x)), np.linspace(-80, 80, n), [4, 8]),
+        (te.tanh, np.tanh, np.linspace(-10, 10, n), [2, 8]),
+        (te.erf, np_erf, np.linspace(-5, 5, n), [8]),
+    ]
+    for op, fref, data, bounds in ops:
+        a_np = data.astype("float32")
+        ref = fref(a_np.astype("float64"))
+        for max_ulp in bounds:
+            f = build_fast_math(op, n, max_ulp)
+            a = tvm.nd.array(a_np)
+            b = tvm.nd.array(np.zeros(n, dtype="float32"))
+            f(a, b)
+            ulp = np.spacing(np.abs(ref.astype("float32"))).astype("float64")
+            err = np.abs(b.asnumpy().astype("float64") - ref) / ulp
+            assert err.max() <= max_ulp, "%s: %f ulp > %d" % (op.__name__, err.max(), max_ulp)
+
+    # No tier of erf is within 1 ulp, the call is lowered as before.
+    x = te.var("x", dtype="float32")
+    for max_ulp in [1, 8]:
+        with tvm.transform.PassContext(config={"tir.LowerIntrin": {"fast_math_max_ulp": max_ulp}}):
+            res = lower_intrin([x], te.erf(x))
+        assert isinstance(res, tvm.tir.Call) == (max_ulp == 1)
+
+    # The special values of exp and log.
+    special = np.array([-np.inf, -1, 0, np.inf, np.nan, -200, 200, 1e-40], dtype="float32")
+    for op, fref in [(te.exp, np.exp), (te.log, np.log)]:
+        for max_ulp in [2, 16]:
+            f = build_fast_math(op, len(special), max_ulp)
+            a = tvm.nd.array(special)
+            b = tvm.nd.array(np.zeros(len(special), dtype="float32"))
+            f(a, b)
+            with np.errstate(all="ignore"):
+                ref = fref(special.astype("float64")).astype("float32")
+            np.testing.assert_allclose(b.asnumpy(), ref, rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_lower_floordiv()
     test_lower_floormod()
+    test_lower_fast_math()
@@ -14,7 +14,9 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
 import tvm
+import tvm.testing
 from tvm import te
 
 
@@ -278,7 +280,11 @@ def test_parallel_alloc():
     mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], body))
     body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
 
+    # the scratch of the parallel loop is allocated once per task of the launch
+    assert isinstance(body, tvm.tir.AttrStmt)
+    assert body.attr_key == "pragma_parallel_launch_point"
     assert isinstance(body.body.body, tvm.tir.Allocate)
+    assert isinstance(body.body.body.body, tvm.tir.For)
 
     ib = tvm.tir.ir_builder.create()
     n = te.var("n")
@@ -295,9 +301,63 @@ def test_parallel_alloc():
     mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], body))
     body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
 
+    assert body.body.body.attr_key == "pragma_parallel_launch_point"
     assert isinstance(body.body.body.body.body, tvm.tir.Allocate)
 
 
+def test_parallel_alloc_sibling_loops():
+    ib = tvm.tir.ir_builder.create()
+    n = te.var("n")
+    with ib.for_range(0, n, name="i", for_type="parallel") as i:
+        A = ib.allocate("float32", 200, name="A", scope="global")
+        with ib.for_range(0, 200, name="j") as j:
+            A[j] = A[j] + 2
+    with ib.for_range(0, n, name="i", for_type="parallel") as i:
+        B = ib.allocate("float32", 200, name="B", scope="global")
+        with ib.for_range(0, 200, name="j") as j:
+            B[j] = B[j] + 3
+
+    body = ib.get()
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], body))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+
+    # the sibling loops share one launch, and their scratch shares one allocation
+    assert isinstance(body, tvm.tir.AttrStmt)
+    assert body.attr_key == "pragma_parallel_launch_point"
+    num_alloc = [0]
+
+    def verify(n):
+        if isinstance(n, tvm.tir.Allocate):
+            num_alloc[0] += 1
+
+    tvm.tir.stmt_functor.post_order_visit(body, verify)
+    assert num_alloc[0] == 1
+    seq = body.body.body.body
+    assert isinstance(seq, tvm.tir.SeqStmt)
+    assert seq[0].attr_key == "pragma_parallel_barrier_when_finish"
+    assert isinstance(seq[1], tvm.tir.For)
+
+
+def test_parallel_alloc_llvm():
+    if not tvm.testing.device_enabled("llvm"):
+        return
+    n = te.var("n")
+    A = te.placeholder((n, 64), name="A")
+    B = te.compute((n, 64), lambda i, j: A[i, j] * 2, name="B")
+    C = te.compute((n, 64), lambda i, j: B[i, j] + 1, name="C")
+    s = te.create_schedule(C.op)
+    s[B].compute_at(s[C], C.op.axis[0])
+    s[C].parallel(C.op.axis[0])
+    f = tvm.build(s, [A, C], "llvm")
+
+    ctx = tvm.cpu(0)
+    a_np = np.random.uniform(size=(37, 64)).astype(A.dtype)
+    a = tvm.nd.array(a_np, ctx)
+    c = tvm.nd.empty((37, 64), C.dtype, ctx)
+    f(a, c)
+    tvm.testing.assert_allclose(c.asnumpy(), a_np * 2 + 1, rtol=1e-6)
+
+
 def test_inplace_rule2(scope_tb="local_TB2", max_bits=1024 * 1024 * 1024):
     # Test Buffer
     register_mem(scope_tb, max_bits)
@@ -576,6 +636,8 @@ if __name__ == "__main__":
     test_alloc_different_dtypes()
     test_inplace_rule()
     test_parallel_alloc()
+    test_parallel_alloc_sibling_loops()
+    test_parallel_alloc_llvm()
     test_storage_combine()
     test_storage_share_gpu()
     test_inplace_rule2()
@@ -14,7 +14,9 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
 import tvm
+import tvm.testing
 from tvm import te
 
 
@@ -158,6 +160,112 @@ def test_vectorize_if_then_else():
     assert isinstance(stmt.body.value.args[2], tvm.tir.Broadcast)
 
 
+def test_vectorize_predicated_tail():
+    n = te.var("n")
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    B = ib.pointer("float32", name="B")
+    with ib.for_range(0, tvm.tir.indexdiv(n + 7, 8)) as k:
+        with ib.for_range(0, 8, for_type="vectorize") as i:
+            with ib.if_scope(k * 8 + i < n):
+                B[k * 8 + i] = A[k * 8 + i] + 1
+    stmt = ib.get()
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B, n], stmt))
+    # scalarized without predication
+    body = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(body.body, tvm.tir.For)
+
+    with tvm.transform.PassContext(config={"tir.VectorizeLoop": {"enable_predication": True}}):
+        body = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(body.body, tvm.tir.LetStmt)
+    assert body.body.value.dtype == "boolx8"
+    store = body.body.body
+    assert isinstance(store, tvm.tir.Store)
+    assert store.value.dtype == "float32x8"
+    assert store.predicate.same_as(body.body.var)
+    assert store.value.a.predicate.same_as(body.body.var)
+
+
+def test_vectorize_predicated_if_then_else():
+    n = te.var("n")
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    B = ib.pointer("float32", name="B")
+    with ib.for_range(0, 4, for_type="vectorize") as i:
+        B[i] = tvm.tir.call_intrin("float32", "tir.if_then_else", i < n, A[i] + 1, 0.0)
+        with ib.if_scope(i < n):
+            B[i] = A[i]
+        with ib.else_scope():
+            B[i] = tvm.tir.call_extern("float32", "f", i)
+    stmt = ib.get()
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B, n], stmt))
+    with tvm.transform.PassContext(config={"tir.VectorizeLoop": {"enable_predication": True}}):
+        stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(stmt, tvm.tir.SeqStmt)
+    # the if_then_else becomes a select of the predicated branches.
+    value = stmt[0].value
+    assert isinstance(value, tvm.tir.Let)
+    assert isinstance(value.body, tvm.tir.Select)
+    assert value.body.true_value.a.predicate.same_as(value.var)
+    # the extern call cannot be predicated.
+    assert isinstance(stmt[1], tvm.tir.For)
+
+
+def test_vectorize_predicated_invariant_store():
+    n = te.var("n")
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    B = ib.pointer("float32", name="B")
+    with ib.for_range(0, 8, for_type="vectorize") as i:
+        with ib.if_scope(A[i] > 0):
+            B[0] = 1.0
+    stmt = ib.get()
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B, n], stmt))
+    with tvm.transform.PassContext(config={"tir.VectorizeLoop": {"enable_predication": True}}):
+        stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    # the store of every lane goes to B[0], the loop is scalarized.
+    assert isinstance(stmt, tvm.tir.For)
+    assert isinstance(stmt.body, tvm.tir.IfThenElse)
+    assert stmt.body.then_case.index.dtype == "int32"
+
+
+def test_vectorize_predicated_llvm():
+    if not tvm.testing.device_enabled("llvm"):
+        return
+
+    def check(n, factor):
+        A = te.placeholder((n,), name="A")
+        B = te.compute((n,), lambda i: A[i] * 2 + 1, name="B")
+        C = te.compute(
+            (n,),
+            lambda i: tvm.tir.if_then_else(i > 0, A[tvm.te.max(i - 1, 0)], 0.0) + B[i],
+            name="C",
+        )
+        s = te.create_schedule(C.op)
+        s[B].compute_inline()
+        _, xi = s[C].split(C.op.axis[0], factor=factor)
+        s[C].vectorize(xi)
+        with tvm.transform.PassContext(
+            config={"tir.VectorizeLoop": {"enable_predication": True}}
+        ):
+            f = tvm.build(s, [A, C], "llvm")
+        ctx = tvm.cpu(0)
+        a_np = np.random.uniform(size=n).astype(A.dtype)
+        c_np = a_np * 2 + 1
+        c_np[1:] += a_np[:-1]
+        a = tvm.nd.array(a_np, ctx)
+        c = tvm.nd.empty((n,), C.dtype, ctx)
+        f(a, c)
+        tvm.testing.assert_allclose(c.asnumpy(), c_np, rtol=1e-5)
+
+    for n in [3, 21, 91]:
+        check(n, 8)
+    check(91, 16)
+
+
 if __name__ == "__main__":
     test_vectorize_vector()
     test_vectorize_with_if()
@@ -166,3 +274,7 @@ if __name__ == "__main__":
     test_vectorize_with_le_cond()
     test_vectorize_with_ge_cond()
     test_vectorize_let()
+    test_vectorize_predicated_tail()
+    test_vectorize_predicated_if_then_else()
+    test_vectorize_predicated_invariant_store()
+    test_vectorize_predicated_llvm()